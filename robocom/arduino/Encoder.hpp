@@ -7,42 +7,81 @@ class Encoder
 {
 public:
 
+	enum
+	{
+		// Number of tick timestamps kept per encoder between updates;
+		// must be a power of 2
+		TICK_BUFFER_SIZE = 8,
+
+		// Number of ticks reported in one batch; matches
+		// EncoderTicksNotice::MAX_TICK_COUNT
+		MAX_BATCH_SIZE = 4,
+
+		// The longest interval between two ticks of one batch; matches
+		// EncoderTicksNotice::MAX_INTERVAL_MICROS
+		MAX_BATCH_INTERVAL_MICROS = 0xFFFF,
+
+		// A batch that is not full is reported once its first tick is
+		// this old
+		MAX_BATCH_DELAY_MICROS = 50000
+	};
+
 	Encoder (int pin)
 		: _pin(pin)
 		, _intr(pin-2)
 		, _total(0)
-		, _millis(0)
 		, _micros(0)
-		, _serial(0)
-		, _has_serial(false)
+		, _lost_ticks(0)
+		, _batch_size(0)
+		, _is_batching(false)
 	{ }
   
 	void setup ();
 	bool update ();
 	int getId () const { return _intr; }
 	unsigned long getTotal () const { return _total; }
-	unsigned long getMillis () const { return _millis; }
 	unsigned long getMicros () const { return _micros; }
 
-	word getSubscriber () const { return _serial; }
-	void setSubscriber (word s) { _serial = s; _has_serial = true; }
-	void clearSubscriber () { _has_serial = false; }
+	// Number of ticks whose timestamps were overwritten before
+	// they could be batched
+	unsigned long getLostTicks () const { return _lost_ticks; }
+
+	// The batch of ticks consumed since the last clearBatch(),
+	// oldest first; the last of them is the tick getTotal() - 1
+	byte getBatchSize () const { return _batch_size; }
+	const unsigned long* getBatchMicros () const { return _batch_micros; }
+	void clearBatch () { _batch_size = 0; }
+
+	// When batching, update() collects ticks into batches and returns
+	// true when a batch is ready; otherwise it returns true whenever
+	// the total changed
+	bool isBatching () const { return _is_batching; }
+	void setBatching (bool is_batching)
+	{
+		_is_batching = is_batching;
+		_batch_size = 0;
+	}
 
 private:
+	bool _updateBatch ();
+
 	int _pin;
 	int _intr;
 	unsigned long _total;
-	unsigned long _millis;
 	unsigned long _micros;
-	word _serial;
-	bool _has_serial;
+	unsigned long _lost_ticks;
+	unsigned long _batch_micros[MAX_BATCH_SIZE];
+	byte _batch_size;
+	bool _is_batching;
 
 	static void _intrHandler0 ();
 	static void _intrHandler1 ();
 
+	// Written only by the interrupt handlers. The timestamp of tick
+	// number n is kept in _s_ticks[n % TICK_BUFFER_SIZE] until the
+	// handler wraps around the buffer.
 	static volatile unsigned long _s_total[2];
-	static volatile unsigned long _s_millis[2];
-	static volatile unsigned long _s_micros[2];
+	static volatile unsigned long _s_ticks[2][TICK_BUFFER_SIZE];
 };
 
 #endif
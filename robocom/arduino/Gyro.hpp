@@ -7,22 +7,51 @@
 
 #include <I2Cdev.h>
 
+#include "robocom/shared/Angle.hpp"
+#include "robocom/shared/MpuFifoReader.hxx"
+
 #define MPU6050_INCLUDE_DMP_MOTIONAPPS20
 #include <helper_3dmath.h>
 #include <MPU6050.h>
 
 /**
  * Helper class to encapsulate gyro functionality.
+ *
+ * The INT pin of the MPU6050 is wired to INTERRUPT_PIN; both external
+ * interrupts of the Uno are taken by the encoders, so it uses the pin
+ * change interrupt of port B. The interrupt tells the gyro when the DMP
+ * has written a packet, so that the FIFO is not polled over I2C when
+ * there is nothing to read.
  */
 class Gyro {
 	static const int MPU6050_ADDRESS = 0x68;
-	static const uint8_t MPU6050_INT_STATUS_DATA_READY = 0x02;
+	typedef robocom::shared::MpuFifoReader<MPU6050> FifoReader;
 public:
+	enum {
+		// The pin connected to the INT pin of the MPU6050. Only the
+		// port B pins 8 to 13 are served by the PCINT0 interrupt.
+		INTERRUPT_PIN = 8,
+
+		// Poll the FIFO at least this often even without an interrupt,
+		// in case an edge was missed
+		MAX_POLL_INTERVAL_MILLIS = FifoReader::MAX_POLL_INTERVAL_MILLIS,
+
+		// The size of the packets the DMP firmware of MotionApps 2.0
+		// writes to the FIFO
+		DMP_PACKET_SIZE = 42
+	};
+
 	/**
 	 * Represents a single reading of all data from the gyro.
+	 *
+	 * The raw quaternion and the fixed-point yaw are always valid. The
+	 * floating point fields are only computed when someone needs them,
+	 * see updateOrientation().
 	 */
 	class Reading {
 	public:
+		int16_t raw_quaternion[4]; // [w, x, y, z]      raw DMP quaternion, 16384 == 1.0
+		int32_t yaw;            // yaw in robocom::shared::Angle units
 		Quaternion quaternian;  // [w, x, y, z]         quaternion container
 		VectorFloat gravity;    // [x, y, z]            gravity vector
 		float ypr[3];           // [yaw, pitch, roll]   yaw/pitch/roll container and gravity vector
@@ -33,7 +62,7 @@ public:
 		explicit Reading (const Reading& other) throw ();
 		Reading& operator= (const Reading& other) throw ();
 
-		float getYawDegrees() const throw () { return ypr[0] * 180.0f/M_PI; }
+		float getYawDegrees() const throw () { return robocom::shared::Angle::toDegrees(yaw); }
 		float getPitchDegrees() const throw () { return ypr[1] * 180.0f/M_PI; }
 		float getRollDegrees() const throw () { return ypr[2] * 180.0f/M_PI; }
 	};
@@ -68,15 +97,44 @@ public:
 	 * Wait for the first reading to be available, and update it.
 	 * This method has no effect if the first reading was arleady taken.
 	 * This should from loop().  It hangs if called from setup().
+	 *
+	 * Only call this where a reading is really needed; it blocks the
+	 * whole loop until the DMP produces its first packet.
 	 */
 	void awaitFirstReading () throw ();
   
 	/**
 	 * Checks for new input and updates the latest Gyro reading.
 	 *
+	 * No I2C transfers are done unless the MPU6050 signalled new data
+	 * with an interrupt. All complete packets waiting in the FIFO are
+	 * then read in one burst, and the newest one becomes the reading.
+	 *
+	 * The fixed-point yaw is computed for every reading. The floating
+	 * point yaw, pitch and roll are left for updateOrientation().
+	 *
 	 * @return true if the reading changed
 	 */
 	bool updateReading () throw ();
+
+	/**
+	 * Returns whether the MPU6050 signalled new data with an interrupt
+	 * since the last updateReading().
+	 *
+	 * This only checks a flag, so it is cheap enough to call on
+	 * every loop.
+	 */
+	bool isDataReady () const throw ();
+
+	/**
+	 * Computes the quaternion, gravity and yaw/pitch/roll fields of the
+	 * latest reading from its raw quaternion.
+	 *
+	 * The computation is done in software floating point, which is slow
+	 * on arduino. This method has no effect if the fields are already
+	 * up to date.
+	 */
+	void updateOrientation () throw ();
   
 	/**
 	 * Gets the latest reading.
@@ -90,17 +148,6 @@ public:
 	 */
 	static void printReading(HardwareSerial& serial, const Reading& reading) throw ();
 
-	void setSubscriber (uint16_t task_id, uint32_t min_delay_millis) throw ();
-
-	void clearSubscriber () throw ();
-
-	bool shouldReport () const throw ();
-	void setReported () throw ();
-
-	uint16_t getSubscriberTaskId () const throw () {
-		return m_subscriber_task_id;
-	}
-
 private:
 	Gyro(const Gyro&) throw ();
 	Gyro& operator=(const Gyro&) throw ();
@@ -108,17 +155,12 @@ private:
 	Reading m_latest;
   
 	MPU6050 m_mpu;
-	uint8_t m_fifo_buffer[64]; // FIFO storage buffer
-	uint16_t m_fifo_count;
-	uint16_t m_packet_size;
+	FifoReader m_fifo_reader;
+	uint8_t m_fifo_buffer[DMP_PACKET_SIZE]; // FIFO storage buffer
 
-	uint16_t m_subscriber_task_id;
-	unsigned long m_min_report_delay_millis;
-	unsigned long m_last_report_millis;
-	
 	bool m_initialized;
 	bool m_has_reading;
-	bool m_has_subscriber;
+	bool m_has_orientation;
 };
 
 #endif // GYRO_HPP
@@ -7,6 +7,8 @@
 
 #include "arduino_base.hpp"
 
+#include "robocom/shared/LogoInterpreter.hpp"
+
 /**
  * An abstract class implementing the LOGO command control protocol
  */
@@ -36,6 +38,13 @@ public:
 	 */
 	virtual bool update () throw () = 0;
 
+	/**
+	 * Stops the command at once, turning off its motors
+	 *
+	 * The command can be started again afterwards.
+	 */
+	virtual void stop () throw () = 0;
+
 protected:
 
 	/**
@@ -61,8 +70,8 @@ class LogoTurn
 	const Gyro * m_p_gyro;
 	Motor* m_p_motor_1;
 	Motor* m_p_motor_2;
-	float m_start_yaw;
-	float m_target_angle;
+	SInt32 m_start_yaw;
+	SInt32 m_target_angle;
 	int m_motor_speed;
 	bool m_is_active;
 
@@ -83,16 +92,20 @@ public:
 	bool isDone() const throw ();
   
 	/**
-	 * Returns the current turn angle.
+	 * Returns the current turn angle, in robocom::shared::Angle units.
 	 */
-	float getAngle() const throw ();
+	SInt32 getAngle() const throw ();
 
 	/**
 	 * Starts a turn by the given angle.
 	 *
+	 * @param task_id the ID of the task associated with this command
+	 * @param target_angle the angle to turn by, in robocom::shared::Angle
+	 *   units; positive values turn right, negative values turn left
+	 *
 	 * @return true if the turn was started, false otherwise
 	 */
-	bool start (UInt16 task_id, float target_angle) throw ();
+	bool start (UInt16 task_id, SInt32 target_angle) throw ();
 
 	/**
 	 * Updates the state of this command
@@ -102,10 +115,15 @@ public:
 	 */
 	virtual bool update () throw ();
 
+	/**
+	 * Stops this command at once
+	 */
+	virtual void stop () throw ();
+
 private:
 
-	float _maxAngle() const throw ();
-	float _minAngle() const throw ();
+	SInt32 _maxAngle() const throw ();
+	SInt32 _minAngle() const throw ();
 
 	void _turnMotorsOn (UInt8 direction) throw ();
 	void _turnMotorsOff () throw ();
@@ -124,7 +142,7 @@ class LogoMove
 	Motor* m_p_motor_2;
 	Encoder* m_p_encoder_1;
 	Encoder* m_p_encoder_2;
-	float m_start_angle;
+	SInt32 m_start_angle;
 	UInt32 m_start_tick_1;
 	UInt32 m_start_tick_2;
 	UInt32 m_target_distance;
@@ -179,6 +197,11 @@ public:
 	 */
 	virtual bool update () throw ();
 
+	/**
+	 * Stops this command at once
+	 */
+	virtual void stop () throw ();
+
 private:
 
 	void _turnMotorsOn (UInt8 direction) throw ();
@@ -221,6 +244,93 @@ public:
 	 *   if the command is still executing
 	 */
 	virtual bool update () throw ();
+
+	/**
+	 * Stops this command at once
+	 */
+	virtual void stop () throw ();
+};
+
+
+/**
+ * LOGO command running a whole program uploaded to the robot
+ *
+ * The program is interpreted by robocom::shared::LogoInterpreter. Its
+ * motion steps are carried out by the other LOGO commands, one after
+ * another, without a round trip to the client between them.
+ */
+class LogoRun
+	: public LogoCommand
+{
+	// Steps that take no time, such as turns by less than a degree,
+	// are skipped; this bounds the number of them skipped in one update
+	enum { MAX_STEPS_PER_UPDATE = 8 };
+
+	LogoTurn* m_p_turn;
+	LogoMove* m_p_move;
+	LogoPen* m_p_pen;
+	robocom::shared::LogoInterpreter m_interpreter;
+	LogoCommand* m_p_step;
+	UInt32 m_wait_start_millis;
+	UInt16 m_wait_millis;
+	bool m_is_waiting;
+	bool m_is_active;
+
+public:
+
+	/**
+	 * Creates an object using the specified commands for the steps
+	 */
+	LogoRun(
+		LogoTurn& turn,
+		LogoMove& move,
+		LogoPen& pen
+	) throw ();
+
+	/**
+	 * Returns the interpreter holding the program
+	 */
+	robocom::shared::LogoInterpreter& getInterpreter () throw ()
+	{
+		return m_interpreter;
+	}
+
+	/**
+	 * Returns whether the program is running
+	 */
+	bool isActive () const throw ()
+	{
+		return m_is_active;
+	}
+
+	/**
+	 * Starts the program from the beginning
+	 *
+	 * @param task_id the ID of the task associated with this command
+	 *
+	 * @return true if the program was started, false if it is not
+	 *   well formed or is already running
+	 */
+	bool start (UInt16 task_id) throw ();
+
+	/**
+	 * Updates the state of this command
+	 *
+	 * @returns true if this command has completed execution, false
+	 *   if the command is still executing
+	 */
+	virtual bool update () throw ();
+
+	/**
+	 * Stops this command at once
+	 */
+	virtual void stop () throw ();
+
+private:
+
+	bool _startStep (
+		const robocom::shared::LogoInterpreter::Action& action
+	) throw ();
 };
 
 
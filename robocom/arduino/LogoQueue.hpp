@@ -0,0 +1,100 @@
+#ifndef LOGO_QUEUE_HPP
+#define LOGO_QUEUE_HPP
+
+#include "arduino_base.hpp"
+
+/**
+ * A bounded queue of LOGO commands waiting for the active one to complete
+ *
+ * The commands are kept in a compact form: only the parameters needed
+ * to start them once their turn comes.
+ */
+class LogoQueue
+{
+public:
+
+	/// The maximum number of commands waiting in the queue
+	enum { CAPACITY = 4 };
+
+	/**
+	 * A LOGO command waiting to be started
+	 */
+	class Entry
+	{
+	public:
+		UInt16 task_id;
+		UInt8 message_type;  // the type of the request that queued it
+		UInt8 direction;
+		UInt16 amount;       // angle in degrees or distance in ticks
+	};
+
+	/**
+	 * Creates an empty queue
+	 */
+	LogoQueue () throw ()
+		: m_head( 0 )
+		, m_size( 0 )
+	{ }
+
+	/**
+	 * Returns whether there are no commands in the queue
+	 */
+	bool isEmpty () const throw ()
+	{
+		return 0 == m_size;
+	}
+
+	/**
+	 * Returns whether the queue is full
+	 */
+	bool isFull () const throw ()
+	{
+		return CAPACITY == m_size;
+	}
+
+	/**
+	 * Adds a command at the end of the queue
+	 *
+	 * @return false if the queue is full
+	 */
+	bool push (
+		UInt16 task_id,
+		UInt8 message_type,
+		UInt8 direction,
+		UInt16 amount
+	) throw ();
+
+	/**
+	 * Returns the command at the front of the queue
+	 *
+	 * @pre ! isEmpty()
+	 */
+	const Entry& front () const throw ()
+	{
+		return m_entries[m_head];
+	}
+
+	/**
+	 * Removes the command at the front of the queue
+	 *
+	 * @pre ! isEmpty()
+	 */
+	void pop () throw ();
+
+	/**
+	 * Removes all commands from the queue
+	 */
+	void clear () throw ()
+	{
+		m_head = 0;
+		m_size = 0;
+	}
+
+private:
+
+	Entry m_entries[CAPACITY];
+	UInt8 m_head;
+	UInt8 m_size;
+};
+
+#endif
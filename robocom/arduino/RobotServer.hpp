@@ -1,12 +1,16 @@
 #ifndef ROBOT_SERVER_HPP
 #define ROBOT_SERVER_HPP
 
+#include "robocom/shared/SensorLog.hpp"
+#include "robocom/shared/msg/BlobFragment.hpp"
 #include "robocom/shared/Server.hpp"
+#include "robocom/shared/Subscriptions.hpp"
 #include "Motor.hpp"
 #include "Encoder.hpp"
 #include "Gyro.hpp"
 #include "Servo.hpp"
 #include "LogoCommands.hpp"
+#include "LogoQueue.hpp"
 
 /**
  * This class defines a robocom server for a particular 2WD mobile platform
@@ -37,6 +41,33 @@ public:
 		SERVO_PIN = 11
 	};
 
+	/**
+	 * Defines the periods and deadlines of the tasks run by the server
+	 */
+	enum TaskTimings
+	{
+		// The interrupt buffer of an encoder holds 8 ticks
+		ENCODER_PERIOD_MICROS = 1000,
+		ENCODER_DEADLINE_MICROS = 1000,
+
+		// The gyro runs on its interrupt, polling is only a fallback
+		GYRO_PERIOD_MICROS = Gyro::MAX_POLL_INTERVAL_MILLIS * 1000,
+		GYRO_DEADLINE_MICROS = 2000,
+
+		LOGO_PERIOD_MICROS = 2000,
+		LOGO_DEADLINE_MICROS = 2000,
+
+		// The sensor log runs when a sample is due, see _isLogDue()
+		LOG_DEADLINE_MICROS = 1000
+	};
+
+	enum
+	{
+		// The largest blob sent for a SensorLogRequest; the loop waits
+		// while it goes out
+		MAX_LOG_FETCH_SIZE = 4 * robocom::shared::msg::BlobFragment::MAX_FRAGMENT_SIZE
+	};
+
 	///@}
 
 
@@ -64,7 +95,8 @@ public:
 	///@{
 
 	/**
-	 * Sets up motors and encoders
+	 * Sets up motors and encoders and registers the tasks that update
+	 * them
 	 */
 	virtual void setup () throw ();
 
@@ -93,22 +125,72 @@ protected:
 	 * Dispatches the application-specific requests:
 	 * - request to set wheel drive signals
 	 * - request to subscribe to encoder measurements
+	 * - LOGO commands, which are queued and executed one after another
+	 * - request to cancel the queued LOGO commands
+	 * - upload of a LOGO program and the request to run it
+	 * - requests to start, stop and fetch the sensor log
 	 *
 	 * @param msg the message to handle
+	 *
+	 * @return false if the type of the message has no route
 	 */
-	virtual void handleMessage (
+	virtual bool handleMessage (
 		const robocom::shared::Message& msg
 	) throw ();
 
+	///@}
+
+private:
+
 	/**
-	 * Adds responses for encoder measurements if any and if the
-	 * client subscribed for them
+	 * Task which calls member functions of the server
 	 */
-	virtual void handleStateUpdate () throw ();
+	class MemberTask
+		: public robocom::shared::Server::Task
+	{
+	public:
+
+		typedef void (RobotServer::*RunFunction) ();
+		typedef bool (RobotServer::*ReadyFunction) ();
+
+		MemberTask (
+			RobotServer& server,
+			RunFunction p_run,
+			ReadyFunction p_ready = 0
+		) throw ()
+			: m_server( server )
+			, m_p_run( p_run )
+			, m_p_ready( p_ready )
+		{ }
+
+		virtual bool isReady () throw ()
+		{
+			return 0 != m_p_ready && (m_server.*m_p_ready)();
+		}
+
+		virtual void run () throw ()
+		{
+			(m_server.*m_p_run)();
+		}
+
+	private:
+
+		RobotServer& m_server;
+		RunFunction m_p_run;
+		ReadyFunction m_p_ready;
+	};
 
-	///@}
+	typedef robocom::shared::MessageDispatch<RobotServer> Dispatch;
 
-private:
+	/**
+	 * Routes of the application messages to the _processMessage()
+	 * overloads, specialized in the implementation
+	 */
+	template <int MSGID> struct Route
+		: Dispatch::Unrouted
+	{ };
+
+	static const Dispatch::Handler ROUTES[Dispatch::TABLE_SIZE];
 
 	RobotServer (const RobotServer&);
 	void operator= (const RobotServer&);
@@ -157,15 +239,68 @@ private:
 		const robocom::shared::msg::LogoPenRequest& req
 	) throw ();
 
+	void _processMessage (
+		const robocom::shared::msg::LogoCancelRequest& req
+	) throw ();
+
+	void _processMessage (
+		const robocom::shared::msg::LogoProgramRequest& req
+	) throw ();
+
+	void _processMessage (
+		const robocom::shared::msg::LogoRunRequest& req
+	) throw ();
+
 	void _processMessage (
 		const robocom::shared::msg::GyroReadingRequest& req
 	) throw ();
 
+	void _processMessage (
+		const robocom::shared::msg::SensorLogRequest& req
+	) throw ();
+
+	void _queueLogoCommand (
+		UInt16 task_id,
+		UInt8 message_type,
+		UInt8 direction,
+		UInt16 amount
+	) throw ();
+
+	void _startNextLogoCommand () throw ();
+
+	void _runEncoderTask () throw ();
+
+	bool _isGyroReady () throw ();
+
+	void _runGyroTask () throw ();
+
+	void _runLogoTask () throw ();
+
+	bool _isLogDue () throw ();
+
+	void _runLogTask () throw ();
+
+	robocom::shared::msg::MessageStatus _startLogoCommand (
+		const LogoQueue::Entry& entry
+	) throw ();
+
 	void _notifyWheelDriveChanged (
 		UInt16 task_id
 	) throw ();
 
+	void _updateEncoder (
+		Encoder& encoder
+	) throw ();
+
+	void _updateGyro () throw ();
+
 	void _notifyEncoderReading (
+		UInt16 task_id,
+		const Encoder& encoder
+	) throw ();
+
+	void _notifyEncoderTicks (
+		UInt16 task_id,
 		const Encoder& encoder
 	) throw ();
 
@@ -176,9 +311,25 @@ private:
 	) throw ();
 
 	void _notifyGyroReading (
+		UInt16 task_id,
 		const Gyro& gyro
 	) throw ();
 
+	void _notifyGyroQuaternion (
+		UInt16 task_id,
+		const Gyro& gyro
+	) throw ();
+
+	void _notifySensorLog (
+		UInt16 task_id,
+		UInt8 status
+	) throw ();
+
+	void _notifySubscriptionStatus (
+		UInt16 task_id,
+		UInt8 status
+	) throw ();
+
 	void _setWheelDrive (
 		UInt8 motor_1_direction,
 		UInt8 motor_1_signal,
@@ -196,7 +347,11 @@ private:
 	Encoder m_encoder_1;
 	Encoder m_encoder_2;
 
+	// Indexed by the encoder ID
+	robocom::shared::Subscriptions m_encoder_subscriptions[2];
+
 	Gyro m_gyro;
+	robocom::shared::Subscriptions m_gyro_subscriptions;
 
 	Servo m_servo;
 
@@ -204,6 +359,15 @@ private:
     LogoTurn m_logo_turn;
 	LogoMove m_logo_move;
 	LogoPen m_logo_pen;
+	LogoRun m_logo_run;
+	LogoQueue m_logo_queue;
+
+	robocom::shared::SensorLog m_sensor_log;
+
+	MemberTask m_encoder_task;
+	MemberTask m_gyro_task;
+	MemberTask m_logo_task;
+	MemberTask m_log_task;
 };
 
 
@@ -4,6 +4,8 @@
 class Encoder;
 class Gyro;
 class LogoCommand;
+class LogoQueue;
+class LogoRun;
 class LogoTurn;
 class Motor;
 class RobotServer;
@@ -1,33 +1,32 @@
 #include "../Encoder.hpp"
 
 volatile unsigned long Encoder::_s_total[2] = { 0 };
-volatile unsigned long Encoder::_s_millis[2] = { 0 };
-volatile unsigned long Encoder::_s_micros[2] = { 0 };
+volatile unsigned long Encoder::_s_ticks[2][TICK_BUFFER_SIZE] = { { 0 } };
 
 
 void Encoder::_intrHandler0 ()
 {
-	_s_millis[0] = millis();
-	_s_micros[0] = micros();
-	_s_total[0]++;
+	const unsigned long total = _s_total[0];
+	_s_ticks[0][total & (TICK_BUFFER_SIZE - 1)] = micros();
+	_s_total[0] = total + 1;
 }
 
 
 void Encoder::_intrHandler1 ()
 {
-	_s_millis[1] = millis();
-	_s_micros[1] = micros();
-	_s_total[1]++;
+	const unsigned long total = _s_total[1];
+	_s_ticks[1][total & (TICK_BUFFER_SIZE - 1)] = micros();
+	_s_total[1] = total + 1;
 }
 
 
 void Encoder::setup ()
 {
 	_total = 0;
-	_millis = 0;
 	_micros = 0;
-	_serial = 0;
-	_has_serial = 0;
+	_lost_ticks = 0;
+	_batch_size = 0;
+	_is_batching = false;
 	
 	pinMode( _pin, INPUT );
 	digitalWrite( _pin, HIGH );
@@ -41,25 +40,74 @@ void Encoder::setup ()
 
 bool Encoder::update ()
 {
-	// If no one is waiting for updates, don't do any
-	if ( ! _has_serial ) {
+	if ( _is_batching ) {
+		return _updateBatch();
+	}
+
+	noInterrupts();
+	const unsigned long total = _s_total[_intr];
+	const unsigned long tick_micros =
+		_s_ticks[_intr][(total - 1) & (TICK_BUFFER_SIZE - 1)];
+	interrupts();
+
+	if ( _total == total ) {
 		return false;
 	}
 
-	bool changed = false;
+	_total = total;
+	_micros = tick_micros;
 
-	noInterrupts();
+	return true;
+}
+
+
+bool Encoder::_updateBatch ()
+{
+	// Moves ticks from the interrupt buffer to the batch one at a time.
+	// Returns true when the batch should be reported: it is full, the
+	// next tick does not fit in it, or it has been waiting for too long.
 
-	if ( _total != _s_total[_intr] )
+	while ( _batch_size < MAX_BATCH_SIZE )
 	{
-		_total = _s_total[_intr];
-		_millis = _s_millis[_intr];
-		_micros = _s_micros[_intr];
-		changed = true;
+		noInterrupts();
+		const unsigned long total = _s_total[_intr];
+		const unsigned long tick_micros =
+			_s_ticks[_intr][_total & (TICK_BUFFER_SIZE - 1)];
+		interrupts();
+
+		if ( _total == total ) {
+			break;
+		}
+
+		if ( total - _total > TICK_BUFFER_SIZE )
+		{
+			// The handler wrapped around the buffer; the ticks in
+			// between can't be reported with their timing
+			if ( _batch_size > 0 ) {
+				return true;
+			}
+
+			_lost_ticks += total - _total - TICK_BUFFER_SIZE;
+			_total = total - TICK_BUFFER_SIZE;
+			continue;
+		}
+
+		if ( _batch_size > 0
+			 	&&
+			 tick_micros - _micros > MAX_BATCH_INTERVAL_MICROS )
+		{
+			return true;
+		}
+
+		_batch_micros[_batch_size++] = tick_micros;
+		_micros = tick_micros;
+		++_total;
 	}
 
-	interrupts();
+	if ( _batch_size == MAX_BATCH_SIZE ) {
+		return true;
+	}
 
-	return changed;
+	return _batch_size > 0
+		&& micros() - _batch_micros[0] >= MAX_BATCH_DELAY_MICROS;
 }
-
@@ -7,17 +7,27 @@
 
 #include "../Gyro.hpp"
 
+// The ISR below only serves port B
+typedef char _GyroInterruptPinOnPortB[
+	(Gyro::INTERRUPT_PIN >= 8 && Gyro::INTERRUPT_PIN <= 13) ? 1 : -1];
+
+// Set by the pin change interrupt when the MPU6050 signals data ready
+static volatile bool _s_data_ready = false;
+
+ISR(PCINT0_vect) {
+	// The MPU6050 INT pin is the only pin change source on port B. The
+	// flag is set on both edges of the pulse; a spurious wake-up only
+	// costs one FIFO count check.
+	_s_data_ready = true;
+}
+
 Gyro::Gyro() throw ()
 	: m_mpu()
+	, m_fifo_reader(m_mpu)
 	, m_fifo_buffer()
-	, m_fifo_count(0)
-	, m_packet_size(0)
-	, m_subscriber_task_id(0)
-	, m_min_report_delay_millis(0)
-	, m_last_report_millis(0)
 	, m_initialized(false)
 	, m_has_reading(false)
-    , m_has_subscriber(false) {
+	, m_has_orientation(false) {
 }
 
 
@@ -29,8 +39,21 @@ bool Gyro::initialize() throw () {
 	if (0 != m_mpu.dmpInitialize()) {
 		return false;
 	}
+	if (m_mpu.dmpGetFIFOPacketSize() > DMP_PACKET_SIZE) {
+		return false;
+	}
 	m_mpu.setDMPEnabled(true);
-	m_packet_size = m_mpu.dmpGetFIFOPacketSize();
+	m_fifo_reader.setPacketSize(m_mpu.dmpGetFIFOPacketSize());
+
+	// Enable the pin change interrupt for the MPU6050 INT pin
+	pinMode(INTERRUPT_PIN, INPUT);
+	PCMSK0 |= _BV(INTERRUPT_PIN - 8);
+	PCIFR |= _BV(PCIF0);
+	PCICR |= _BV(PCIE0);
+
+	// Reading the status clears any interrupt raised so far
+	m_mpu.getIntStatus();
+	_s_data_ready = true;
 	return true;
 }
 
@@ -40,47 +63,47 @@ void Gyro::awaitFirstReading() throw () {
 	}
 }
 
-bool Gyro::updateReading() throw () {
-    // Get INT_STATUS byte
-    const uint8_t mpu_int_status = m_mpu.getIntStatus();
-
-    // get current FIFO count
-    m_fifo_count = m_mpu.getFIFOCount();
+bool Gyro::isDataReady() const throw () {
+    return _s_data_ready;
+}
 
-    // check for overflow (this should never happen unless our code is too inefficient)
-    if ((mpu_int_status & 0x10) || m_fifo_count >= 1024) {
-        // reset so we can continue cleanly
-        m_mpu.resetFIFO();
+bool Gyro::updateReading() throw () {
+    // Nothing to do until the MPU6050 raises its interrupt; this keeps
+    // the loop free of I2C traffic between packets. Only the newest
+    // packet in the FIFO is interpreted.
+    if (!m_fifo_reader.read(::millis(), _s_data_ready, m_fifo_buffer)) {
         return false;
     }
 
-    // otherwise, check for DMP data ready interrupt (this should happen frequently)
-    if (0 == (mpu_int_status & MPU6050_INT_STATUS_DATA_READY)) {
-		return false;
-    }
-    
-    // wait for correct available data length, should be a VERY short wait
-    while (m_fifo_count < m_packet_size) {
-		m_fifo_count = m_mpu.getFIFOCount();
-    }
-
-    // read a packet from FIFO
-    m_mpu.getFIFOBytes(m_fifo_buffer, m_packet_size);
-    
-    // track FIFO count here in case there is > 1 packet available
-    // (this lets us immediately read more without waiting for an interrupt)
-    m_fifo_count -= m_packet_size;
-
-    m_mpu.dmpGetQuaternion(&m_latest.quaternian, m_fifo_buffer);
-    m_mpu.dmpGetGravity(&m_latest.gravity, &m_latest.quaternian);
-    m_mpu.dmpGetYawPitchRoll(m_latest.ypr, &m_latest.quaternian, &m_latest.gravity);
+    m_mpu.dmpGetQuaternion(m_latest.raw_quaternion, m_fifo_buffer);
+    m_latest.yaw = robocom::shared::Angle::yawFromQuaternion(
+        m_latest.raw_quaternion[0],
+        m_latest.raw_quaternion[1],
+        m_latest.raw_quaternion[2],
+        m_latest.raw_quaternion[3]);
     m_latest.micros = ::micros();
     m_latest.millis = ::millis();
-	
+    m_has_orientation = false;
+
     m_has_reading = true;
     return true;
 }
 
+void Gyro::updateOrientation() throw () {
+	if (m_has_orientation) {
+		return;
+	}
+
+	m_latest.quaternian.w = (float)m_latest.raw_quaternion[0] / 16384.0f;
+	m_latest.quaternian.x = (float)m_latest.raw_quaternion[1] / 16384.0f;
+	m_latest.quaternian.y = (float)m_latest.raw_quaternion[2] / 16384.0f;
+	m_latest.quaternian.z = (float)m_latest.raw_quaternion[3] / 16384.0f;
+	m_mpu.dmpGetGravity(&m_latest.gravity, &m_latest.quaternian);
+	m_mpu.dmpGetYawPitchRoll(m_latest.ypr, &m_latest.quaternian, &m_latest.gravity);
+
+	m_has_orientation = true;
+}
+
 void Gyro::printReading(HardwareSerial& serial, const Reading& reading) throw () {
 	Serial.print("quat[");
 	Serial.print(reading.quaternian.w);
@@ -106,37 +129,12 @@ void Gyro::printReading(HardwareSerial& serial, const Reading& reading) throw ()
 }
 
 
-void
-Gyro::setSubscriber(uint16_t task_id, uint32_t min_delay_millis) throw () {
-	m_subscriber_task_id = task_id;
-	m_min_report_delay_millis = min_delay_millis;
-	m_has_subscriber = true;
-}
-
-
-void
-Gyro::clearSubscriber() throw () {
-	m_has_subscriber = false;
-}
-
-
-bool
-Gyro::shouldReport() const throw () {
-	if (!m_has_subscriber) {
-		return false;
-	}
-	return m_latest.millis >= m_last_report_millis + m_min_report_delay_millis;
-}
-
-void
-Gyro::setReported() throw () {
-	m_last_report_millis = m_latest.millis;
-}
-
 // Gyro::Reading helper class ////////////////////////////////////////////////////////
 
 Gyro::Reading::Reading() throw ()
-	: quaternian()
+	: raw_quaternion()
+	, yaw(0)
+	, quaternian()
 	, gravity()
 	, ypr()
 	, millis(0)
@@ -145,17 +143,22 @@ Gyro::Reading::Reading() throw ()
 
 
 Gyro::Reading::Reading(const Gyro::Reading& other) throw ()
-	: quaternian(other.quaternian)
+	: raw_quaternion()
+	, yaw(other.yaw)
+	, quaternian(other.quaternian)
 	, gravity(other.gravity)
 	, ypr()
 	, millis(other.millis)
 	, micros(other.micros) {
+	::memcpy(&raw_quaternion, &other.raw_quaternion, sizeof(raw_quaternion));
 	::memcpy(&ypr, &other.ypr, sizeof(ypr));
 }
 
 
 Gyro::Reading& Gyro::Reading::operator=(const Gyro::Reading& other) throw () {
 	if (this != &other) {
+		::memcpy(&raw_quaternion, &other.raw_quaternion, sizeof(raw_quaternion));
+		yaw = other.yaw;
 		quaternian = other.quaternian;
 		gravity = other.gravity;
 		::memcpy(&ypr, &other.ypr, sizeof(ypr));
@@ -18,7 +18,7 @@ LogoMove::LogoMove (
 	, m_p_motor_2( &motor_2 )
 	, m_p_encoder_1( &encoder_1 )
 	, m_p_encoder_2( &encoder_2 )
-	, m_start_angle(0.0f)
+	, m_start_angle(0)
 	, m_start_tick_1(0)
 	, m_start_tick_2(0)
 	, m_target_distance(0)
@@ -55,7 +55,7 @@ LogoMove::start (
 	}
 
 	m_is_active = true;
-	m_start_angle = m_p_gyro->getLatestReading().ypr[0];
+	m_start_angle = m_p_gyro->getLatestReading().yaw;
 	m_start_tick_1 = m_p_encoder_1->getTotal();
 	m_start_tick_2 = m_p_encoder_2->getTotal();
 	m_target_distance = distance_ticks;
@@ -80,6 +80,17 @@ LogoMove::update () throw ()
 }
 
 
+void
+LogoMove::stop () throw ()
+{
+	if ( m_is_active )
+	{
+		_turnMotorsOff();
+		m_is_active = false;
+	}
+}
+
+
 void
 LogoMove::_turnMotorsOn (UInt8 direction) throw ()
 {
@@ -42,3 +42,10 @@ LogoPen::update () throw ()
 	return ! m_is_active;
 }
 
+
+void
+LogoPen::stop () throw ()
+{
+	m_is_active = false;
+}
+
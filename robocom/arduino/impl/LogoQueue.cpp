@@ -0,0 +1,33 @@
+#include "../LogoQueue.hpp"
+
+bool
+LogoQueue::push (
+	UInt16 task_id,
+	UInt8 message_type,
+	UInt8 direction,
+	UInt16 amount
+) throw ()
+{
+	if ( isFull() ) {
+		return false;
+	}
+
+	Entry& entry = m_entries[(m_head + m_size) % CAPACITY];
+	entry.task_id = task_id;
+	entry.message_type = message_type;
+	entry.direction = direction;
+	entry.amount = amount;
+	++m_size;
+
+	return true;
+}
+
+
+void
+LogoQueue::pop () throw ()
+{
+	USE_CONTRACT_CHECK( ! isEmpty() );
+
+	m_head = (m_head + 1) % CAPACITY;
+	--m_size;
+}
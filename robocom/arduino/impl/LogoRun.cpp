@@ -0,0 +1,139 @@
+#include <Arduino.h>
+
+// External component includes
+#include "robocom/shared/Angle.hpp"
+
+// Module include
+#include "../LogoCommands.hpp"
+
+using robocom::shared::Angle;
+using robocom::shared::LogoInterpreter;
+
+LogoRun::LogoRun (
+	LogoTurn& turn,
+	LogoMove& move,
+	LogoPen& pen
+) throw ()
+	: m_p_turn( &turn )
+	, m_p_move( &move )
+	, m_p_pen( &pen )
+	, m_interpreter()
+	, m_p_step( 0 )
+	, m_wait_start_millis( 0 )
+	, m_wait_millis( 0 )
+	, m_is_waiting( false )
+	, m_is_active( false )
+{}
+
+
+bool
+LogoRun::start (UInt16 task_id) throw ()
+{
+	if ( m_is_active || ! m_interpreter.start() ) {
+		return false;
+	}
+
+	m_is_active = true;
+	m_is_waiting = false;
+	m_p_step = 0;
+	setTaskId( task_id );
+
+	return true;
+}
+
+
+bool
+LogoRun::update () throw ()
+{
+	if ( ! m_is_active ) {
+		return true;
+	}
+
+	if ( 0 != m_p_step )
+	{
+		if ( ! m_p_step->update() ) {
+			return false;
+		}
+		m_p_step = 0;
+	}
+
+	if ( m_is_waiting )
+	{
+		if ( millis() - m_wait_start_millis < m_wait_millis ) {
+			return false;
+		}
+		m_is_waiting = false;
+	}
+
+	for ( UInt8 i = 0; i < MAX_STEPS_PER_UPDATE; ++i )
+	{
+		LogoInterpreter::Action action;
+		if ( ! m_interpreter.next( action ) )
+		{
+			m_is_active = false;
+			return true;
+		}
+
+		if ( _startStep( action ) ) {
+			break;
+		}
+	}
+
+	return false;
+}
+
+
+void
+LogoRun::stop () throw ()
+{
+	if ( 0 != m_p_step )
+	{
+		m_p_step->stop();
+		m_p_step = 0;
+	}
+
+	m_is_waiting = false;
+	m_is_active = false;
+}
+
+
+bool
+LogoRun::_startStep (const LogoInterpreter::Action& action) throw ()
+{
+	switch ( action.type )
+	{
+	case LogoInterpreter::ACTION_MOVE:
+		if ( m_p_move->start( getTaskId(), action.direction, action.amount ) ) {
+			m_p_step = m_p_move;
+		}
+		break;
+
+	case LogoInterpreter::ACTION_TURN:
+	{
+		const SInt32 angle = Angle::fromDegrees(
+			action.direction == 0
+				? static_cast<SInt32>( action.amount )
+				: -static_cast<SInt32>( action.amount )
+		);
+
+		if ( m_p_turn->start( getTaskId(), angle ) ) {
+			m_p_step = m_p_turn;
+		}
+		break;
+	}
+
+	case LogoInterpreter::ACTION_PEN:
+		if ( m_p_pen->start( getTaskId(), action.direction ) ) {
+			m_p_step = m_p_pen;
+		}
+		break;
+
+	case LogoInterpreter::ACTION_WAIT:
+		m_wait_start_millis = millis();
+		m_wait_millis = action.amount;
+		m_is_waiting = true;
+		return true;
+	}
+
+	return 0 != m_p_step;
+}
@@ -1,3 +1,6 @@
+// External component includes
+#include "robocom/shared/Angle.hpp"
+
 // Component includes
 #include "../Gyro.hpp"
 #include "../Motor.hpp"
@@ -5,6 +8,8 @@
 // Module include
 #include "../LogoCommands.hpp"
 
+using robocom::shared::Angle;
+
 LogoTurn::LogoTurn (
 	const Gyro& gyro,
 	Motor& motor_1,
@@ -13,8 +18,8 @@ LogoTurn::LogoTurn (
 	: m_p_gyro( &gyro )
 	, m_p_motor_1( &motor_1 )
 	, m_p_motor_2( &motor_2 )
-	, m_start_yaw(0.0f)
-	, m_target_angle(0.0f)
+	, m_start_yaw(0)
+	, m_target_angle(0)
 	, m_motor_speed( 60 )	// TODO: choose something reasonable
 	, m_is_active( false )
 {}
@@ -29,28 +34,29 @@ LogoTurn::isDone () const throw ()
 }
 
 
-float
+SInt32
 LogoTurn::getAngle() const throw ()
 {
-	float angle = m_p_gyro->getLatestReading().ypr[0] - m_start_yaw;
+	SInt32 angle = m_p_gyro->getLatestReading().yaw - m_start_yaw;
 	if (angle > _maxAngle()) {
-		angle -= 2*M_PI;
+		angle -= Angle::FULL_TURN;
 	} else if (angle < _minAngle()) {
-		angle += 2*M_PI;
+		angle += Angle::FULL_TURN;
 	}
 	return angle;
 }
 
 
 bool
-LogoTurn::start (UInt16 task_id, float target_angle) throw ()
+LogoTurn::start (UInt16 task_id, SInt32 target_angle) throw ()
 {
-	if ( m_is_active || fabs(target_angle) < 1.0 ) {
+	const SInt32 min_angle = Angle::fromDegrees(1);
+	if ( m_is_active || (target_angle < min_angle && target_angle > -min_angle) ) {
 		return false;
 	}
 
 	m_is_active = true;
-	m_start_yaw = m_p_gyro->getLatestReading().ypr[0];
+	m_start_yaw = m_p_gyro->getLatestReading().yaw;
 	m_target_angle = target_angle;
 	setTaskId( task_id );
 	_turnMotorsOn( target_angle > 0 ? 0 : 1 );
@@ -72,17 +78,28 @@ LogoTurn::update () throw ()
 }
 
 
-float
+SInt32
 LogoTurn::_maxAngle() const throw ()
 {
-	return m_target_angle >= 0 ? (3.0f*M_PI/2.0f) : (M_PI/2.0f);
+	return m_target_angle >= 0 ? (3*Angle::QUARTER_TURN) : Angle::QUARTER_TURN;
 }
 
 
-float
+SInt32
 LogoTurn::_minAngle() const throw ()
 {
-	return m_target_angle >= 0 ? (-M_PI/2.0f) : (-3.0f*M_PI/2.0f);
+	return m_target_angle >= 0 ? -Angle::QUARTER_TURN : (-3*Angle::QUARTER_TURN);
+}
+
+
+void
+LogoTurn::stop () throw ()
+{
+	if ( m_is_active )
+	{
+		_turnMotorsOff();
+		m_is_active = false;
+	}
 }
 
 
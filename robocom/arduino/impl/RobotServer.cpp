@@ -1,15 +1,23 @@
 // External component includes
+#include "robocom/shared/Angle.hpp"
 #include "robocom/shared/msg/EncoderReadingNotice.hpp"
 #include "robocom/shared/msg/EncoderReadingRequest.hpp"
+#include "robocom/shared/msg/EncoderTicksNotice.hpp"
+#include "robocom/shared/msg/GyroQuaternionNotice.hpp"
 #include "robocom/shared/msg/GyroReadingNotice.hpp"
 #include "robocom/shared/msg/GyroReadingRequest.hpp"
+#include "robocom/shared/msg/SensorLogNotice.hpp"
+#include "robocom/shared/msg/SensorLogRequest.hpp"
 #include "robocom/shared/msg/SetWheelDriveRequest.hpp"
 #include "robocom/shared/msg/SetServoAngleRequest.hpp"
 #include "robocom/shared/msg/SimpleMessage.hxx"
+#include "robocom/shared/msg/SubscriptionStatusNotice.hpp"
 #include "robocom/shared/msg/WheelDriveChangedNotice.hpp"
 #include "robocom/shared/msg/LogoCompleteNotice.hpp"
 #include "robocom/shared/msg/LogoMoveRequest.hpp"
 #include "robocom/shared/msg/LogoPenRequest.hpp"
+#include "robocom/shared/msg/LogoProgramRequest.hpp"
+#include "robocom/shared/msg/LogoRunRequest.hpp"
 #include "robocom/shared/msg/LogoTurnRequest.hpp"
 
 // Component includes
@@ -23,6 +31,33 @@ using namespace robocom::shared;
 using namespace robocom::shared::msg;
 
 
+template <> struct RobotServer::Route<SetWheelDriveRequest::MSGID>
+	: Dispatch::To<SetWheelDriveRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<SetServoAngleRequest::MSGID>
+	: Dispatch::To<SetServoAngleRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<EncoderReadingRequest::MSGID>
+	: Dispatch::To<EncoderReadingRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<GyroReadingRequest::MSGID>
+	: Dispatch::To<GyroReadingRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoTurnRequest::MSGID>
+	: Dispatch::To<LogoTurnRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoMoveRequest::MSGID>
+	: Dispatch::To<LogoMoveRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoPenRequest::MSGID>
+	: Dispatch::To<LogoPenRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoCancelRequest::MSGID>
+	: Dispatch::To<LogoCancelRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoProgramRequest::MSGID>
+	: Dispatch::To<LogoProgramRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<LogoRunRequest::MSGID>
+	: Dispatch::To<LogoRunRequest, & RobotServer::_processMessage> { };
+template <> struct RobotServer::Route<SensorLogRequest::MSGID>
+	: Dispatch::To<SensorLogRequest, & RobotServer::_processMessage> { };
+
+const RobotServer::Dispatch::Handler RobotServer::ROUTES[] PROGMEM =
+	ROBOCOM_DISPATCH_TABLE( Route );
+
+
 RobotServer::RobotServer (StreamIO& stream) throw ()
 	: Server( stream )
 	, m_motor_1( MOTOR_1_DIR_PIN, MOTOR_1_SIGNAL_PIN )
@@ -35,6 +70,20 @@ RobotServer::RobotServer (StreamIO& stream) throw ()
     , m_logo_turn( m_gyro, m_motor_1, m_motor_2 )
 	, m_logo_move( m_gyro, m_motor_1, m_motor_2, m_encoder_1, m_encoder_2 )
 	, m_logo_pen( m_servo )
+	, m_logo_run( m_logo_turn, m_logo_move, m_logo_pen )
+	, m_sensor_log( )
+	, m_encoder_task( *this, & RobotServer::_runEncoderTask )
+	, m_gyro_task(
+		*this,
+		& RobotServer::_runGyroTask,
+		& RobotServer::_isGyroReady
+	)
+	, m_logo_task( *this, & RobotServer::_runLogoTask )
+	, m_log_task(
+		*this,
+		& RobotServer::_runLogTask,
+		& RobotServer::_isLogDue
+	)
 {
 }
 
@@ -51,74 +100,113 @@ RobotServer::setup () throw ()
 	m_servo.setup();
 
 	m_gyro.initialize(); // TODO: Error check?
+
+	addTask( m_encoder_task, ENCODER_PERIOD_MICROS, ENCODER_DEADLINE_MICROS );
+	addTask( m_gyro_task, GYRO_PERIOD_MICROS, GYRO_DEADLINE_MICROS );
+	addTask( m_logo_task, LOGO_PERIOD_MICROS, LOGO_DEADLINE_MICROS );
+	addTask( m_log_task, 0, LOG_DEADLINE_MICROS );
 }
 
 
 void
 RobotServer::handleReset (const ResetRequest& req) throw ()
 {
-	m_encoder_1.clearSubscriber();
-	m_encoder_2.clearSubscriber();
-	m_gyro.clearSubscriber();
+	m_encoder_subscriptions[0].clear();
+	m_encoder_subscriptions[1].clear();
+	m_encoder_1.setBatching( false );
+	m_encoder_2.setBatching( false );
+	m_gyro_subscriptions.clear();
+	m_sensor_log.stop();
 
 	m_servo.setBase();
 
+	// The command has to stop, or it would refuse to start again
+	if ( _hasLogoCommand() ) {
+		_getLogoCommand().stop();
+	}
 	_clearLogoCommand();
+	m_logo_queue.clear();
 
 	_setWheelDrive( 0, 0, 0, 0 );
 	_notifyWheelDriveChanged( req.getTaskId() );
 }
 
 
-void
+bool
 RobotServer::handleMessage (const Message& msg) throw ()
 {
-	switch ( msg.getMessageType() )
-	{
-	case SetWheelDriveRequest::MSGID:
-		_processMessage( SetWheelDriveRequest( msg ) );
-		break;
-	case SetServoAngleRequest::MSGID:
-		_processMessage( SetServoAngleRequest( msg ) );
-		break;
-	case EncoderReadingRequest::MSGID:
-		_processMessage( EncoderReadingRequest( msg ) );
-		break;
-	case GyroReadingRequest::MSGID:
-		_processMessage( GyroReadingRequest( msg ) );
-		break;
-	}
+	return Dispatch::dispatch( ROUTES, *this, msg );
 }
 
 
 void
-RobotServer::handleStateUpdate () throw ()
+RobotServer::_runEncoderTask () throw ()
 {
-	if ( m_encoder_1.update() ) {
-		_notifyEncoderReading( m_encoder_1 );
-	}
+	_updateEncoder( m_encoder_1 );
+	_updateEncoder( m_encoder_2 );
+}
+
 
-	if ( m_encoder_2.update() ) {
-		_notifyEncoderReading( m_encoder_2 );
+bool
+RobotServer::_isGyroReady () throw ()
+{
+	return m_gyro.isDataReady();
+}
+
+
+void
+RobotServer::_runGyroTask () throw ()
+{
+	if ( m_gyro.updateReading() ) {
+		_updateGyro();
 	}
+}
 
-	m_gyro.awaitFirstReading();
-	if (m_gyro.updateReading()) {
-		if (m_gyro.shouldReport()) {
-			_notifyGyroReading( m_gyro );
-			m_gyro.setReported();
-		}
-    }
 
+void
+RobotServer::_runLogoTask () throw ()
+{
 	if ( _hasLogoCommand() && _getLogoCommand().update() )
 	{
 		_notifyWheelDriveChanged( _getLogoCommand().getTaskId() );
 		_notifyLogoComplete( _getLogoCommand().getTaskId(), STATUS_OK );
 		_clearLogoCommand();
+
+		// Keep the motion going without waiting for the client
+		_startNextLogoCommand();
 	}
 }
 
 
+bool
+RobotServer::_isLogDue () throw ()
+{
+	return m_sensor_log.isRunning()
+		&& static_cast<SInt32>( getMillis() - m_sensor_log.getDueMillis() ) >= 0;
+}
+
+
+void
+RobotServer::_runLogTask () throw ()
+{
+	const Gyro::Reading& reading = m_gyro.getLatestReading();
+
+	SensorLog::Sample sample;
+	for ( int i = 0; i < 4; i++ ) {
+		sample.quaternion[i] = reading.raw_quaternion[i];
+	}
+	sample.yaw = static_cast<SInt16>( reading.yaw );
+	sample.encoder_ticks[0] = static_cast<UInt16>( m_encoder_1.getTotal() );
+	sample.encoder_ticks[1] = static_cast<UInt16>( m_encoder_2.getTotal() );
+
+	// The samples stay on the grid of the period; a run that comes more
+	// than a period late records the current values as the newest sample
+	// that was due, and the older ones are skipped and counted as missed
+	m_sensor_log.skipMissed( getMillis() );
+	m_sensor_log.append( sample );
+}
+
+
 void
 RobotServer::_processMessage (const SetWheelDriveRequest& req) throw ()
 {
@@ -164,12 +252,35 @@ RobotServer::_processMessage (const EncoderReadingRequest& req)
 	Encoder& encoder = req.getEncoderId() == m_encoder_1.getId()
 		? m_encoder_1
 		: m_encoder_2;
+	Subscriptions& subscriptions = m_encoder_subscriptions[encoder.getId()];
 
-	if ( ! req.getIsSubscribe() ) {
-		encoder.clearSubscriber();
+	// The batch is cleared once offered, so the rate limits would drop
+	// ticks; the batches themselves keep the rate of the notices down
+	const bool is_ticks =
+		req.getFormat() == EncoderReadingRequest::FORMAT_TICKS;
+
+	if ( ! req.getIsSubscribe() )
+	{
+		// Legacy clients unsubscribe with a new task ID
+		if ( ! subscriptions.unsubscribe( req.getTaskId() ) && req.isLegacy() ) {
+			subscriptions.clear();
+		}
 	}
-	else {
-		encoder.setSubscriber( req.getTaskId() );
+	else if ( ! subscriptions.subscribe(
+				  req.getTaskId(),
+				  req.getFormat(),
+				  is_ticks ? 0 : req.getMinIntervalMillis(),
+				  is_ticks ? 1 : req.getDecimation(),
+				  is_ticks ? 0 : req.getChangeThreshold() ) )
+	{
+		_notifySubscriptionStatus( req.getTaskId(), STATUS_E_SUBSCRIBERS );
+	}
+
+	// Batches of ticks are collected only while someone wants them
+	const bool is_batching =
+		subscriptions.hasFormat( EncoderReadingRequest::FORMAT_TICKS );
+	if ( is_batching != encoder.isBatching() ) {
+		encoder.setBatching( is_batching );
 	}
 }
 
@@ -183,26 +294,53 @@ RobotServer::_processMessage (const LogoTurnRequest& req) throw ()
 		return;
 	}
 
-	if ( _hasLogoCommand() )
+	_queueLogoCommand(
+		req.getTaskId(),
+		LogoTurnRequest::MSGID,
+		req.getDirection(),
+		req.getAngle()
+	);
+}
+
+
+void
+RobotServer::_processMessage (const LogoMoveRequest& req) throw ()
+{
+	if ( STATUS_OK != req.validate() )
 	{
-		_notifyLogoComplete( req.getTaskId(), STATUS_E_LOGO_ACTIVE );
+		_notifyLogoComplete( req.getTaskId(), req.validate() );
 		return;
 	}
 
-	const float angle = req.getDirection() == 0
-		? req.getAngle()
-		: -req.getAngle();
+	_queueLogoCommand(
+		req.getTaskId(),
+		LogoMoveRequest::MSGID,
+		req.getDirection(),
+		req.getDistance()
+	);
+}
 
-	if ( m_logo_turn.start( req.getTaskId(), angle ) )
+
+void
+RobotServer::_processMessage (const LogoPenRequest& req) throw ()
+{
+	if ( STATUS_OK != req.validate() )
 	{
-		_setLogoCommand( m_logo_turn );
-		_notifyWheelDriveChanged( req.getTaskId() );
+		_notifyLogoComplete( req.getTaskId(), req.validate() );
+		return;
 	}
+
+	_queueLogoCommand(
+		req.getTaskId(),
+		LogoPenRequest::MSGID,
+		req.getDirection(),
+		0
+	);
 }
 
 
 void
-RobotServer::_processMessage (const LogoMoveRequest& req) throw ()
+RobotServer::_processMessage (const LogoProgramRequest& req) throw ()
 {
 	if ( STATUS_OK != req.validate() )
 	{
@@ -210,23 +348,29 @@ RobotServer::_processMessage (const LogoMoveRequest& req) throw ()
 		return;
 	}
 
-	if ( _hasLogoCommand() )
+	// The program must not change under a run that is active or queued
+	if ( _hasLogoCommand() || ! m_logo_queue.isEmpty() )
 	{
 		_notifyLogoComplete( req.getTaskId(), STATUS_E_LOGO_ACTIVE );
 		return;
 	}
 
-	if ( m_logo_move.start(
-			 req.getTaskId(), req.getDirection(), req.getDistance() ) )
-	{
-		_setLogoCommand( m_logo_move );
-		_notifyWheelDriveChanged( req.getTaskId() );
+	LogoInterpreter& interpreter = m_logo_run.getInterpreter();
+	if ( 0 == req.getOffset() ) {
+		interpreter.clear();
+	}
+
+	UInt8 code[LogoProgramRequest::MAX_CODE_SIZE];
+	req.getCode( code );
+
+	if ( ! interpreter.write( req.getOffset(), code, req.getCodeSize() ) ) {
+		_notifyLogoComplete( req.getTaskId(), STATUS_E_LOGO_PROGRAM );
 	}
 }
 
 
 void
-RobotServer::_processMessage (const LogoPenRequest& req) throw ()
+RobotServer::_processMessage (const LogoRunRequest& req) throw ()
 {
 	if ( STATUS_OK != req.validate() )
 	{
@@ -234,15 +378,140 @@ RobotServer::_processMessage (const LogoPenRequest& req) throw ()
 		return;
 	}
 
-	if ( _hasLogoCommand() )
+	// A lost chunk shows up as a size mismatch or a malformed program
+	const LogoInterpreter& interpreter = m_logo_run.getInterpreter();
+	if ( req.getProgramSize() != interpreter.getSize() || ! interpreter.verify() )
 	{
-		_notifyLogoComplete( req.getTaskId(), STATUS_E_LOGO_ACTIVE );
+		_notifyLogoComplete( req.getTaskId(), STATUS_E_LOGO_PROGRAM );
 		return;
 	}
 
-	if ( m_logo_pen.start( req.getTaskId(), req.getDirection() ) ) {
-		_setLogoCommand( m_logo_pen );
+	_queueLogoCommand(
+		req.getTaskId(),
+		LogoRunRequest::MSGID,
+		0,
+		req.getProgramSize()
+	);
+}
+
+
+void
+RobotServer::_processMessage (const LogoCancelRequest&) throw ()
+{
+	// The active command runs to completion; only the waiting
+	// ones are dropped, each with its own notice
+	while ( ! m_logo_queue.isEmpty() )
+	{
+		_notifyLogoComplete(
+			m_logo_queue.front().task_id,
+			STATUS_E_LOGO_CANCELLED
+		);
+		m_logo_queue.pop();
+	}
+}
+
+
+void
+RobotServer::_queueLogoCommand (
+	UInt16 task_id,
+	UInt8 message_type,
+	UInt8 direction,
+	UInt16 amount
+) throw ()
+{
+	if ( ! m_logo_queue.push( task_id, message_type, direction, amount ) )
+	{
+		_notifyLogoComplete( task_id, STATUS_E_LOGO_QUEUE_FULL );
+		return;
+	}
+
+	if ( ! _hasLogoCommand() ) {
+		_startNextLogoCommand();
+	}
+}
+
+
+void
+RobotServer::_startNextLogoCommand () throw ()
+{
+	while ( ! _hasLogoCommand() && ! m_logo_queue.isEmpty() )
+	{
+		const LogoQueue::Entry entry = m_logo_queue.front();
+		m_logo_queue.pop();
+
+		const MessageStatus status = _startLogoCommand( entry );
+		if ( _hasLogoCommand() ) {
+			_notifyWheelDriveChanged( entry.task_id );
+		}
+		else {
+			// Nothing to do, e.g. a turn by less than a degree, or
+			// the command could not start
+			_notifyLogoComplete( entry.task_id, status );
+		}
+	}
+}
+
+
+MessageStatus
+RobotServer::_startLogoCommand (const LogoQueue::Entry& entry) throw ()
+{
+	// Returns STATUS_OK without setting the command when there is
+	// nothing to do
+	switch ( entry.message_type )
+	{
+	case LogoTurnRequest::MSGID:
+	{
+		if ( 0 == entry.amount ) {
+			return STATUS_OK;
+		}
+
+		// The turn is measured relative to the current yaw
+		m_gyro.awaitFirstReading();
+
+		const SInt32 angle = Angle::fromDegrees(
+			entry.direction == 0
+				? static_cast<SInt32>( entry.amount )
+				: -static_cast<SInt32>( entry.amount )
+		);
+
+		if ( m_logo_turn.start( entry.task_id, angle ) ) {
+			_setLogoCommand( m_logo_turn );
+		}
+		break;
+	}
+	case LogoMoveRequest::MSGID:
+		if ( 0 == entry.amount ) {
+			return STATUS_OK;
+		}
+
+		// The move records the current yaw
+		m_gyro.awaitFirstReading();
+
+		if ( m_logo_move.start( entry.task_id, entry.direction, entry.amount ) ) {
+			_setLogoCommand( m_logo_move );
+		}
+		break;
+	case LogoPenRequest::MSGID:
+		if ( m_logo_pen.start( entry.task_id, entry.direction ) ) {
+			_setLogoCommand( m_logo_pen );
+		}
+		break;
+	case LogoRunRequest::MSGID:
+		if ( ! m_logo_run.isActive() && ! m_logo_run.getInterpreter().verify() ) {
+			return STATUS_E_LOGO_PROGRAM;
+		}
+
+		// The turns and moves of the program record the current yaw
+		m_gyro.awaitFirstReading();
+
+		if ( m_logo_run.start( entry.task_id ) ) {
+			_setLogoCommand( m_logo_run );
+		}
+		break;
 	}
+
+	// The commands only refuse to start while they are still active
+	return _hasLogoCommand() ? STATUS_OK : STATUS_E_LOGO_ACTIVE;
 }
 
 
@@ -255,15 +524,90 @@ RobotServer::_processMessage (const GyroReadingRequest& req)
 		return;
 	}
 
-	if ( ! req.getIsSubscribe() ) {
-		m_gyro.clearSubscriber();
+	if ( ! req.getIsSubscribe() )
+	{
+		// Legacy clients unsubscribe with a new task ID
+		if ( ! m_gyro_subscriptions.unsubscribe( req.getTaskId() ) && req.isLegacy() ) {
+			m_gyro_subscriptions.clear();
+		}
 	}
-	else {
-		m_gyro.setSubscriber( req.getTaskId(), req.getMinDelayMillis() );
+	else if ( ! m_gyro_subscriptions.subscribe(
+				  req.getTaskId(),
+				  req.getFormat(),
+				  req.getMinDelayMillis(),
+				  req.getDecimation(),
+				  req.getChangeThreshold() ) )
+	{
+		_notifySubscriptionStatus( req.getTaskId(), STATUS_E_SUBSCRIBERS );
 	}
 }
 
 
+void
+RobotServer::_processMessage (const SensorLogRequest& req) throw ()
+{
+	if ( STATUS_OK != req.validate() )
+	{
+		_notifySensorLog( req.getTaskId(), req.validate() );
+		return;
+	}
+
+	switch ( req.getCommand() )
+	{
+	case SensorLogRequest::COMMAND_START:
+		m_sensor_log.start(
+			req.getChannels(),
+			req.getPeriodMillis(),
+			getMillis()
+		);
+		break;
+	case SensorLogRequest::COMMAND_STOP:
+		m_sensor_log.stop();
+		break;
+	case SensorLogRequest::COMMAND_FETCH:
+	{
+		UInt16 size = req.getFetchSize();
+		if ( size > MAX_LOG_FETCH_SIZE || 0 == size ) {
+			size = MAX_LOG_FETCH_SIZE;
+		}
+		else if ( size < SensorLog::HEADER_SIZE ) {
+			size = SensorLog::HEADER_SIZE;
+		}
+
+		UInt8 blob[MAX_LOG_FETCH_SIZE];
+		writeBlob( req.getTaskId(), blob, m_sensor_log.fetch( blob, size ) );
+		break;
+	}
+	}
+
+	_notifySensorLog( req.getTaskId(), STATUS_OK );
+}
+
+
+void
+RobotServer::_notifySensorLog (UInt16 task_id, UInt8 status) throw ()
+{
+	addResponse(
+		SensorLogNotice(
+			task_id,
+			status,
+			m_sensor_log.isRunning(),
+			m_sensor_log.getRecordCount(),
+			m_sensor_log.getOverflowCount(),
+			m_sensor_log.getNextIndex(),
+			m_sensor_log.getMissedCount()
+		).asMessage()
+	);
+}
+
+
+void
+RobotServer::_notifySubscriptionStatus (UInt16 task_id, UInt8 status) throw ()
+{
+	addResponse( SubscriptionStatusNotice( task_id, status ).asMessage() );
+}
+
+
 void
 RobotServer::_notifyWheelDriveChanged (UInt16 task_id) throw ()
 {
@@ -281,13 +625,101 @@ RobotServer::_notifyWheelDriveChanged (UInt16 task_id) throw ()
 
 
 void
-RobotServer::_notifyEncoderReading (const Encoder& encoder) throw ()
+RobotServer::_updateEncoder (Encoder& encoder) throw ()
+{
+	// The encoder is updated even without subscribers, LOGO moves
+	// depend on its total
+	if ( ! encoder.update() ) {
+		return;
+	}
+
+	Subscriptions& subscriptions = m_encoder_subscriptions[encoder.getId()];
+	const UInt8 mask = subscriptions.offer(
+		encoder.getTotal(),
+		getMillis(),
+		0
+	);
+
+	for ( UInt8 i = 0; i < subscriptions.getCount(); ++i )
+	{
+		if ( 0 == (mask & (1 << i)) ) {
+			continue;
+		}
+
+		const Subscriptions::Subscriber& subscriber = subscriptions.get( i );
+		if ( subscriber.format == EncoderReadingRequest::FORMAT_TICKS ) {
+			_notifyEncoderTicks( subscriber.task_id, encoder );
+		}
+		else {
+			_notifyEncoderReading( subscriber.task_id, encoder );
+		}
+	}
+
+	encoder.clearBatch();
+}
+
+
+void
+RobotServer::_updateGyro () throw ()
 {
-	// We only get here if the client subscribed to the encoder readings
+	const Gyro::Reading& reading = m_gyro.getLatestReading();
+	const UInt8 mask = m_gyro_subscriptions.offer(
+		reading.yaw,
+		reading.millis,
+		Angle::FULL_TURN
+	);
+
+	for ( UInt8 i = 0; i < m_gyro_subscriptions.getCount(); ++i )
+	{
+		if ( 0 == (mask & (1 << i)) ) {
+			continue;
+		}
+
+		const Subscriptions::Subscriber& subscriber = m_gyro_subscriptions.get( i );
+		if ( subscriber.format == GyroReadingRequest::FORMAT_QUATERNION ) {
+			_notifyGyroQuaternion( subscriber.task_id, m_gyro );
+		}
+		else {
+			// Only computed when a subscriber actually gets it
+			m_gyro.updateOrientation();
+			_notifyGyroReading( subscriber.task_id, m_gyro );
+		}
+	}
+}
+
+
+void
+RobotServer::_notifyEncoderTicks (
+	UInt16 task_id,
+	const Encoder& encoder
+) throw ()
+{
+	UInt32 tick_micros[Encoder::MAX_BATCH_SIZE];
+	for ( UInt8 i = 0; i < encoder.getBatchSize(); ++i ) {
+		tick_micros[i] = encoder.getBatchMicros()[i];
+	}
 
+	addResponse(
+		EncoderTicksNotice(
+			task_id,
+			encoder.getId(),
+			encoder.getTotal() - 1,
+			tick_micros,
+			encoder.getBatchSize()
+		).asMessage()
+	);
+}
+
+
+void
+RobotServer::_notifyEncoderReading (
+	UInt16 task_id,
+	const Encoder& encoder
+) throw ()
+{
 	addResponse(
 		EncoderReadingNotice(
-			encoder.getSubscriber(),
+			task_id,
 			getMillis(),
 			encoder.getId(),
 			encoder.getTotal(),
@@ -314,14 +746,15 @@ RobotServer::_notifyLogoComplete (
 
 
 void
-RobotServer::_notifyGyroReading (const Gyro& gyro) throw ()
+RobotServer::_notifyGyroReading (
+	UInt16 task_id,
+	const Gyro& gyro
+) throw ()
 {
-	// We only get here if the client subscribed to the gyro readings
-
 	const Gyro::Reading& reading = gyro.getLatestReading();
 	addResponse(
 		GyroReadingNotice(
-			gyro.getSubscriberTaskId(),
+			task_id,
 			reading.micros / 1000,
 			reading.getYawDegrees(),
 			reading.getPitchDegrees(),
@@ -332,6 +765,27 @@ RobotServer::_notifyGyroReading (const Gyro& gyro) throw ()
 }
 
 
+void
+RobotServer::_notifyGyroQuaternion (
+	UInt16 task_id,
+	const Gyro& gyro
+) throw ()
+{
+	const Gyro::Reading& reading = gyro.getLatestReading();
+	addResponse(
+		GyroQuaternionNotice(
+			task_id,
+			reading.micros / 1000,
+			reading.raw_quaternion[0],
+			reading.raw_quaternion[1],
+			reading.raw_quaternion[2],
+			reading.raw_quaternion[3],
+			reading.micros
+		).asMessage()
+	);
+}
+
+
 void
 RobotServer::_setWheelDrive (
 	UInt8 motor_1_direction,
@@ -0,0 +1,160 @@
+#ifndef ROBOCOM_CLIENT_GYRO_DECODER_HPP
+#define ROBOCOM_CLIENT_GYRO_DECODER_HPP
+
+#include "client_base.hpp"
+
+// System headers
+#include <vector>
+
+// External component headers
+#include "robocom/shared/msg/msg_fwds.hpp"
+
+
+namespace robocom {
+namespace client
+{
+
+	/**
+	 * This class converts raw gyro readings into yaw, pitch and roll
+	 *
+	 * Clients that subscribe to the gyro with
+	 * GyroReadingRequest::FORMAT_QUATERNION receive the DMP quaternion
+	 * in GyroQuaternionNotice messages, and arduino does not spend its
+	 * cycles on soft-float trigonometry. This class does the conversion
+	 * on the client instead, using the same formulas as the MPU6050
+	 * library.
+	 *
+	 * Notices are collected with add() and converted in one batch by
+	 * decode(). The quaternion components are kept in separate arrays
+	 * so that the arithmetic part of the conversion can be vectorized
+	 * by the compiler.
+	 */
+	class GyroDecoder
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an empty decoder
+		 */
+		GyroDecoder () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the number of readings collected so far
+		 */
+		UInt32 getSize () const throw ()
+		{
+			return m_w.size();
+		}
+
+		/**
+		 * Returns the yaw of each reading, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getYawDegrees () const throw ()
+		{
+			return m_yaw;
+		}
+
+		/**
+		 * Returns the pitch of each reading, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getPitchDegrees () const throw ()
+		{
+			return m_pitch;
+		}
+
+		/**
+		 * Returns the roll of each reading, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getRollDegrees () const throw ()
+		{
+			return m_roll;
+		}
+
+		/**
+		 * Returns the micros at the time of each reading
+		 */
+		const std::vector<UInt32>& getMeasurementMicros () const throw ()
+		{
+			return m_micros;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all collected readings
+		 */
+		void clear () throw ();
+
+		/**
+		 * Adds a reading to the batch
+		 *
+		 * @param notice the raw reading
+		 *
+		 * @pre notice.validate() == STATUS_OK
+		 */
+		void add (const shared::msg::GyroQuaternionNotice& notice);
+
+		/**
+		 * Converts all collected readings to yaw, pitch and roll
+		 */
+		void decode ();
+
+		/**
+		 * Converts raw quaternions to yaw, pitch and roll
+		 *
+		 * @param p_w the w components of the quaternions
+		 * @param p_x the x components of the quaternions
+		 * @param p_y the y components of the quaternions
+		 * @param p_z the z components of the quaternions
+		 * @param count the number of quaternions
+		 * @param p_yaw on output stores the yaw angles, in degrees
+		 * @param p_pitch on output stores the pitch angles, in degrees
+		 * @param p_roll on output stores the roll angles, in degrees
+		 */
+		static void decode (
+			const SInt16* p_w,
+			const SInt16* p_x,
+			const SInt16* p_y,
+			const SInt16* p_z,
+			UInt32 count,
+			float* p_yaw,
+			float* p_pitch,
+			float* p_roll
+		) throw ();
+
+		///@}
+
+	private:
+
+		std::vector<SInt16> m_w;
+		std::vector<SInt16> m_x;
+		std::vector<SInt16> m_y;
+		std::vector<SInt16> m_z;
+		std::vector<UInt32> m_micros;
+		std::vector<float> m_yaw;
+		std::vector<float> m_pitch;
+		std::vector<float> m_roll;
+	};
+
+} }
+
+#endif // ROBOCOM_CLIENT_GYRO_DECODER_HPP
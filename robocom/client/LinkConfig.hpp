@@ -0,0 +1,141 @@
+#ifndef ROBOCOM_CLIENT_LINK_CONFIG_HPP
+#define ROBOCOM_CLIENT_LINK_CONFIG_HPP
+
+#include "client_base.hpp"
+
+// External component headers
+#include "robocom/shared/MessageIO.hpp"
+#include "robocom/shared/msg/msg_fwds.hpp"
+
+
+namespace robocom {
+namespace client
+{
+
+	/**
+	 * This class holds the protocol options a client uses on its link
+	 * to the server
+	 *
+	 * The default configuration is what every server supports, including
+	 * firmware that predates the HelloRequest. After connecting, the
+	 * client sends a HelloRequest and passes the CapsResponse to choose(),
+	 * which picks the fastest options supported by both sides. The
+	 * client then:
+	 * - switches the codec, if it differs from the plain one, with
+	 *   a CodecRequest, and calls MessageIO::setCodec() after reading
+	 *   the response;
+	 * - calls apply();
+	 * - sends a ResetRequest, which starts the credit count.
+	 */
+	class LinkConfig
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates the configuration supported by every server
+		 */
+		LinkConfig () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the frame encoding (see MessageIO::Codec)
+		 */
+		UInt8 getCodec () const throw ()
+		{
+			return m_codec;
+		}
+
+		/**
+		 * Returns whether to use the credit-based flow control
+		 */
+		bool isFlowControl () const throw ()
+		{
+			return m_is_flow_control;
+		}
+
+		/**
+		 * Returns whether to use the reliable frames
+		 */
+		bool isReliable () const throw ()
+		{
+			return m_is_reliable;
+		}
+
+		/**
+		 * Returns the largest message data size both sides accept
+		 */
+		UInt8 getMaxDataSize () const throw ()
+		{
+			return m_max_data_size;
+		}
+
+		/**
+		 * Returns the size of the largest blob the server accepts
+		 * (see msg::BlobFragment), zero if it takes none
+		 */
+		UInt16 getMaxBlobSize () const throw ()
+		{
+			return m_max_blob_size;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Chooses the configuration for a server
+		 *
+		 * The COBS codec is chosen whenever both sides have it, since
+		 * it costs only three more bytes per frame and keeps noise from
+		 * turning into messages; the flow control too, since it lets the
+		 * client stream messages without waiting for a FlushResponse. The
+		 * reliable frames cost more of the link, so they are only used
+		 * when the caller asks for them.
+		 *
+		 * @param caps the response of the server
+		 * @param local_features the bit mask of the features of this
+		 *  client, as sent in the HelloRequest
+		 * @param is_reliable_wanted whether to use the reliable frames
+		 *  if both sides have them
+		 *
+		 * @pre caps.validate() == STATUS_OK
+		 */
+		static LinkConfig choose (
+			const shared::msg::CapsResponse& caps,
+			UInt8 local_features = shared::MessageIO::getFeatures(),
+			bool is_reliable_wanted = false
+		) throw ();
+
+		/**
+		 * Sets up the flow control and the reliable mode of the given
+		 * IO as configured
+		 *
+		 * The codec has to be switched before, see the class
+		 * description.
+		 */
+		void apply (shared::MessageIO& io) const;
+
+		///@}
+
+	private:
+
+		UInt8 m_codec;
+		bool m_is_flow_control;
+		bool m_is_reliable;
+		UInt8 m_max_data_size;
+		UInt16 m_max_blob_size;
+	};
+
+} }
+
+#endif // ROBOCOM_CLIENT_LINK_CONFIG_HPP
@@ -0,0 +1,105 @@
+#ifndef ROBOCOM_CLIENT_LOGO_COMPILER_HPP
+#define ROBOCOM_CLIENT_LOGO_COMPILER_HPP
+
+#include "client_base.hpp"
+
+// System headers
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// External component headers
+#include "robocom/shared/Message.hpp"
+
+
+namespace robocom {
+namespace client
+{
+
+	/**
+	 * This class compiles LOGO programs into the bytecode executed on
+	 * the robot by robocom::shared::LogoInterpreter
+	 *
+	 * The source uses the usual LOGO syntax, with case insensitive
+	 * commands separated by white space:
+	 * - FORWARD n, FD n, BACK n, BK n: move by n encoder ticks
+	 * - RIGHT n, RT n, LEFT n, LT n: turn by n degrees
+	 * - PENUP, PU, PENDOWN, PD: move the pen
+	 * - WAIT n: do nothing for n millis
+	 * - REPEAT n [ ... ]: run the commands in brackets n times; the
+	 *   brackets must hold a command other than a REPEAT 0
+	 *
+	 * For example, "REPEAT 4 [ FD 20 RT 90 ]" draws a square.
+	 *
+	 * A compiled program is sent to the robot with the messages made by
+	 * makeUploadRequests(), followed by a LogoRunRequest.
+	 */
+	class LogoCompiler
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a compiler with an empty program
+		 */
+		LogoCompiler () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the bytecode compiled so far
+		 */
+		const std::vector<UInt8>& getCode () const throw ()
+		{
+			return m_code;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards the compiled program
+		 */
+		void clear () throw ();
+
+		/**
+		 * Compiles the source and appends it to the program
+		 *
+		 * The program is left unchanged if the source has an error.
+		 *
+		 * @param source the LOGO source
+		 *
+		 * @throw std::invalid_argument if the source has a syntax error,
+		 *   a REPEAT with nothing to do, or the program does not fit on
+		 *   the robot
+		 */
+		void compile (const std::string& source)
+			throw (std::invalid_argument);
+
+		/**
+		 * Splits the program into immediate LogoProgramRequest messages
+		 *
+		 * @param task_id the task ID of the messages
+		 * @return the messages to send, in order
+		 */
+		std::vector<shared::Message> makeUploadRequests (UInt16 task_id) const;
+
+		///@}
+
+	private:
+
+		std::vector<UInt8> m_code;
+	};
+
+} }
+
+#endif // ROBOCOM_CLIENT_LOGO_COMPILER_HPP
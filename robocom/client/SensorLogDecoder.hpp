@@ -0,0 +1,180 @@
+#ifndef ROBOCOM_CLIENT_SENSOR_LOG_DECODER_HPP
+#define ROBOCOM_CLIENT_SENSOR_LOG_DECODER_HPP
+
+#include "client_base.hpp"
+
+// System headers
+#include <vector>
+
+
+namespace robocom {
+namespace client
+{
+
+	/**
+	 * This class collects the blobs fetched from the sensor log of
+	 * arduino and turns them into time series
+	 *
+	 * The blobs are added in the order they were fetched. Each one
+	 * continues where the previous one ended; the samples that were
+	 * overwritten on arduino before they were fetched, or skipped because
+	 * arduino took them too late, are missing from the series, which is
+	 * visible in getSampleMillis(). The encoder
+	 * totals are logged modulo 2^16 and are unwrapped here, which is
+	 * correct as long as an encoder moves less than 2^15 ticks between
+	 * two collected samples.
+	 *
+	 * The quaternions are converted to yaw, pitch and roll in one
+	 * batch by decode(), as in GyroDecoder.
+	 */
+	class SensorLogDecoder
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an empty decoder
+		 */
+		SensorLogDecoder () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the number of samples collected so far
+		 */
+		UInt32 getSize () const throw ()
+		{
+			return m_millis.size();
+		}
+
+		/**
+		 * Returns the channels of the last added blob
+		 */
+		UInt8 getChannels () const throw ()
+		{
+			return m_channels;
+		}
+
+		/**
+		 * Returns the number of samples lost on arduino, as reported
+		 * by the last added blob
+		 */
+		UInt16 getOverflowCount () const throw ()
+		{
+			return m_overflow_count;
+		}
+
+		/**
+		 * Returns the millis at which each sample was taken
+		 */
+		const std::vector<UInt32>& getSampleMillis () const throw ()
+		{
+			return m_millis;
+		}
+
+		/**
+		 * Returns the yaw logged by arduino for each sample, in Angle
+		 * units
+		 */
+		const std::vector<SInt16>& getYawAngles () const throw ()
+		{
+			return m_yaw_angle;
+		}
+
+		/**
+		 * Returns the tick total of an encoder at each sample
+		 *
+		 * @param encoder 0 for the first encoder, 1 for the second one
+		 */
+		const std::vector<SInt32>& getEncoderTotals (int encoder) const throw ()
+		{
+			return m_encoder_totals[encoder];
+		}
+
+		/**
+		 * Returns the yaw of each quaternion sample, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getYawDegrees () const throw ()
+		{
+			return m_yaw;
+		}
+
+		/**
+		 * Returns the pitch of each quaternion sample, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getPitchDegrees () const throw ()
+		{
+			return m_pitch;
+		}
+
+		/**
+		 * Returns the roll of each quaternion sample, in degrees
+		 *
+		 * The values are only valid after a call to decode().
+		 */
+		const std::vector<float>& getRollDegrees () const throw ()
+		{
+			return m_roll;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all collected samples
+		 */
+		void clear () throw ();
+
+		/**
+		 * Adds the samples of a fetched blob
+		 *
+		 * A series only holds the channels that were logged; the
+		 * blobs of a series should all have the same channels.
+		 *
+		 * @param p_blob the blob
+		 * @param size the size of the blob
+		 *
+		 * @return false if the blob is malformed, in which case
+		 *   nothing is added
+		 */
+		bool add (const UInt8* p_blob, UInt16 size);
+
+		/**
+		 * Converts all collected quaternions to yaw, pitch and roll
+		 */
+		void decode ();
+
+		///@}
+
+	private:
+
+		std::vector<UInt32> m_millis;
+		std::vector<SInt16> m_w;
+		std::vector<SInt16> m_x;
+		std::vector<SInt16> m_y;
+		std::vector<SInt16> m_z;
+		std::vector<SInt16> m_yaw_angle;
+		std::vector<SInt32> m_encoder_totals[2];
+		std::vector<float> m_yaw;
+		std::vector<float> m_pitch;
+		std::vector<float> m_roll;
+		UInt16 m_overflow_count;
+		UInt8 m_channels;
+	};
+
+} }
+
+#endif // ROBOCOM_CLIENT_SENSOR_LOG_DECODER_HPP
@@ -8,6 +8,7 @@
 #include <system_error>
 
 // External component headers
+#include "robocom/shared/MessageIO.hpp"
 #include "robocom/shared/StreamIO.hpp"
 
 // Component headers
@@ -102,6 +103,16 @@ namespace client
 		 */
 		void awaitAvailable () throw (std::system_error);
 
+		/**
+		 * Blocks until some data are available for reading or the given
+		 * time passed
+		 *
+		 * @param timeout_millis the longest time to wait
+		 *
+		 * @return true if data are available, false on the timeout
+		 */
+		bool awaitAvailable (UInt32 timeout_millis) throw (std::system_error);
+
 		/**
 		 * Returns the next byte available for reading without removing
 		 * it from the stream
@@ -227,6 +238,13 @@ namespace client
 		UInt8* const m_p_old_config;
 	};
 
+
+	/**
+	 * The message IO bound to a SerialPort at compile time,
+	 * instantiated in the library
+	 */
+	typedef shared::BasicMessageIO<SerialPort> SerialMessageIO;
+
 } }
 
 #endif // ROBOCOM_CLIENT_SERIAL_PORT_HPP
@@ -9,7 +9,11 @@ namespace robocom {
 namespace client
 {
 
+	class GyroDecoder;
 	class Handle;
+	class LinkConfig;
+	class LogoCompiler;
+	class SensorLogDecoder;
 	class SerialPort;
 
 	using namespace common;
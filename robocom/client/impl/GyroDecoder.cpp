@@ -0,0 +1,126 @@
+// System headers
+#include <cmath>
+
+// External component headers
+#include "robocom/shared/msg/GyroQuaternionNotice.hpp"
+
+// Module header
+#include "../GyroDecoder.hpp"
+
+namespace robocom {
+namespace client
+{
+	using namespace std;
+	using namespace robocom::shared::msg;
+
+
+	GyroDecoder::GyroDecoder () throw ()
+		: m_w( )
+		, m_x( )
+		, m_y( )
+		, m_z( )
+		, m_micros( )
+		, m_yaw( )
+		, m_pitch( )
+		, m_roll( )
+	{ }
+
+
+	void
+	GyroDecoder::clear () throw ()
+	{
+		m_w.clear();
+		m_x.clear();
+		m_y.clear();
+		m_z.clear();
+		m_micros.clear();
+		m_yaw.clear();
+		m_pitch.clear();
+		m_roll.clear();
+	}
+
+
+	void
+	GyroDecoder::add (const GyroQuaternionNotice& notice)
+	{
+		USE_CONTRACT_CHECK( STATUS_OK == notice.validate() );
+
+		m_w.push_back( notice.getW() );
+		m_x.push_back( notice.getX() );
+		m_y.push_back( notice.getY() );
+		m_z.push_back( notice.getZ() );
+		m_micros.push_back( notice.getMeasurementMicros() );
+	}
+
+
+	void
+	GyroDecoder::decode ()
+	{
+		const UInt32 count = getSize();
+
+		m_yaw.resize( count );
+		m_pitch.resize( count );
+		m_roll.resize( count );
+
+		if ( count > 0 )
+		{
+			decode(
+				& m_w[0], & m_x[0], & m_y[0], & m_z[0], count,
+				& m_yaw[0], & m_pitch[0], & m_roll[0]
+			);
+		}
+	}
+
+
+	void
+	GyroDecoder::decode (
+		const SInt16* p_w,
+		const SInt16* p_x,
+		const SInt16* p_y,
+		const SInt16* p_z,
+		UInt32 count,
+		float* p_yaw,
+		float* p_pitch,
+		float* p_roll
+	) throw ()
+	{
+		const float scale = 1.0f / GyroQuaternionNotice::QUATERNION_ONE;
+		const float to_degrees = 180.0f / M_PI;
+
+		// First pass: the arguments of the trigonometric functions. This
+		// is plain arithmetic over the arrays, so the compiler can use
+		// vector instructions. The output arrays hold the intermediate
+		// values: yaw gets the atan2() numerator, pitch and roll get
+		// the tangents of the angles.
+
+		vector<float> yaw_den( count );
+
+		for ( UInt32 i = 0; i < count; i++ )
+		{
+			const float w = p_w[i] * scale;
+			const float x = p_x[i] * scale;
+			const float y = p_y[i] * scale;
+			const float z = p_z[i] * scale;
+
+			// Gravity vector, as MPU6050::dmpGetGravity()
+			const float gx = 2 * (x*z - w*y);
+			const float gy = 2 * (w*x + y*z);
+			const float gz = w*w - x*x - y*y + z*z;
+
+			p_yaw[i] = 2*x*y - 2*w*z;
+			yaw_den[i] = 2*w*w + 2*x*x - 1;
+			p_pitch[i] = gx / sqrtf( gy*gy + gz*gz );
+			p_roll[i] = gy / sqrtf( gx*gx + gz*gz );
+		}
+
+		// Second pass: the angles, as MPU6050::dmpGetYawPitchRoll()
+
+		for ( UInt32 i = 0; i < count; i++ )
+		{
+			p_yaw[i] = atan2f( p_yaw[i], yaw_den[i] ) * to_degrees;
+			p_pitch[i] = atanf( p_pitch[i] ) * to_degrees;
+			p_roll[i] = atanf( p_roll[i] ) * to_degrees;
+		}
+	}
+
+} }
@@ -0,0 +1,70 @@
+// External component headers
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/msg/CapsResponse.hpp"
+
+// Module header
+#include "../LinkConfig.hpp"
+
+namespace robocom {
+namespace client
+{
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+
+	LinkConfig::LinkConfig () throw ()
+		: m_codec( MessageIO::CODEC_PLAIN )
+		, m_is_flow_control( false )
+		, m_is_reliable( false )
+		, m_max_data_size( Message::MAX_DATA_SIZE )
+		, m_max_blob_size( 0 )
+	{ }
+
+
+	LinkConfig
+	LinkConfig::choose (
+		const CapsResponse& caps,
+		UInt8 local_features,
+		bool is_reliable_wanted
+	) throw ()
+	{
+		USE_CONTRACT_CHECK( caps.validate() == STATUS_OK );
+
+		const UInt8 features = caps.getFeatures() & local_features;
+		LinkConfig config;
+
+		if ( features & CapsResponse::FEATURE_COBS ) {
+			config.m_codec = MessageIO::CODEC_COBS;
+		}
+
+		config.m_is_flow_control =
+			0 != ( features & CapsResponse::FEATURE_CREDIT );
+		config.m_is_reliable = is_reliable_wanted
+			&& 0 != ( features & CapsResponse::FEATURE_RELIABLE );
+
+		if ( caps.getMaxDataSize() < config.m_max_data_size ) {
+			config.m_max_data_size = caps.getMaxDataSize();
+		}
+
+		// Any client can send blobs, only the server has to support them
+		if ( caps.getFeatures() & CapsResponse::FEATURE_BLOB ) {
+			config.m_max_blob_size = caps.getMaxBlobSize();
+		}
+
+		return config;
+	}
+
+
+	void
+	LinkConfig::apply (MessageIO& io) const
+	{
+		io.setFlowControl( m_is_flow_control );
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		if ( m_is_reliable != io.isReliable() ) {
+			io.setReliable( m_is_reliable );
+		}
+#endif
+	}
+
+} }
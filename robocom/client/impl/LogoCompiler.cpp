@@ -0,0 +1,223 @@
+// System headers
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+// External component headers
+#include "robocom/shared/LogoInterpreter.hpp"
+#include "robocom/shared/msg/LogoProgramRequest.hpp"
+
+// Module header
+#include "../LogoCompiler.hpp"
+
+namespace robocom {
+namespace client
+{
+	using namespace std;
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+
+	namespace
+	{
+		// Splits the source into words, with brackets as separate words
+		vector<string> __tokenize (const string& source)
+		{
+			vector<string> tokens;
+			string token;
+
+			for ( string::size_type i = 0; i <= source.size(); ++i )
+			{
+				const char c = i < source.size() ? source[i] : ' ';
+
+				if ( isspace( static_cast<unsigned char>( c ) ) || '[' == c || ']' == c )
+				{
+					if ( ! token.empty() ) {
+						tokens.push_back( token );
+						token.clear();
+					}
+					if ( '[' == c || ']' == c ) {
+						tokens.push_back( string( 1, c ) );
+					}
+				}
+				else {
+					token += static_cast<char>( toupper( static_cast<unsigned char>( c ) ) );
+				}
+			}
+
+			return tokens;
+		}
+
+
+		unsigned long __parseNumber (
+			const vector<string>& tokens,
+			vector<string>::size_type& i,
+			unsigned long max_value
+		) throw (invalid_argument)
+		{
+			const string command = tokens[i];
+
+			if ( ++i == tokens.size() ) {
+				throw invalid_argument( command + " needs a number" );
+			}
+
+			const string& token = tokens[i];
+			char* p_end = 0;
+			const unsigned long value = strtoul( token.c_str(), &p_end, 10 );
+
+			if ( token.empty() || ! isdigit( static_cast<unsigned char>( token[0] ) )
+				 || *p_end != '\0' || value > max_value )
+			{
+				ostringstream os;
+				os << command << " needs a number from 0 to " << max_value
+				   << ", got " << token;
+				throw invalid_argument( os.str() );
+			}
+
+			return value;
+		}
+
+
+		void __emit (vector<UInt8>& code, UInt8 opcode, UInt16 operand)
+		{
+			UInt8 bytes[2];
+			hton_UInt16( bytes, operand );
+
+			code.push_back( opcode );
+			code.push_back( bytes[0] );
+			code.push_back( bytes[1] );
+		}
+	}
+
+
+	LogoCompiler::LogoCompiler () throw ()
+		: m_code( )
+	{ }
+
+
+	void
+	LogoCompiler::clear () throw ()
+	{
+		m_code.clear();
+	}
+
+
+	void
+	LogoCompiler::compile (const string& source) throw (invalid_argument)
+	{
+		const vector<string> tokens = __tokenize( source );
+		vector<UInt8> code( m_code );
+		unsigned depth = 0;
+
+		// For each open REPEAT, whether its body does anything and
+		// whether it runs at all, as LogoInterpreter::verify() checks
+		vector<bool> has_action;
+		vector<bool> is_run;
+
+		for ( vector<string>::size_type i = 0; i < tokens.size(); ++i )
+		{
+			const string& command = tokens[i];
+
+			if ( "FORWARD" == command || "FD" == command ) {
+				__emit( code, LogoInterpreter::OP_FORWARD, __parseNumber( tokens, i, 0xFFFF ) );
+			}
+			else if ( "BACK" == command || "BK" == command ) {
+				__emit( code, LogoInterpreter::OP_BACK, __parseNumber( tokens, i, 0xFFFF ) );
+			}
+			else if ( "RIGHT" == command || "RT" == command ) {
+				__emit( code, LogoInterpreter::OP_RIGHT, __parseNumber( tokens, i, 0xFFFF ) );
+			}
+			else if ( "LEFT" == command || "LT" == command ) {
+				__emit( code, LogoInterpreter::OP_LEFT, __parseNumber( tokens, i, 0xFFFF ) );
+			}
+			else if ( "WAIT" == command ) {
+				__emit( code, LogoInterpreter::OP_WAIT, __parseNumber( tokens, i, 0xFFFF ) );
+			}
+			else if ( "PENUP" == command || "PU" == command ) {
+				code.push_back( LogoInterpreter::OP_PEN_UP );
+			}
+			else if ( "PENDOWN" == command || "PD" == command ) {
+				code.push_back( LogoInterpreter::OP_PEN_DOWN );
+			}
+			else if ( "REPEAT" == command )
+			{
+				const UInt8 count = __parseNumber( tokens, i, 0xFF );
+
+				if ( ++i == tokens.size() || "[" != tokens[i] ) {
+					throw invalid_argument( "REPEAT needs a [" );
+				}
+
+				if ( ++depth > LogoInterpreter::MAX_LOOP_DEPTH ) {
+					throw invalid_argument( "REPEAT nested too deep" );
+				}
+
+				has_action.push_back( false );
+				is_run.push_back( 0 != count );
+				code.push_back( LogoInterpreter::OP_REPEAT );
+				code.push_back( count );
+				continue;
+			}
+			else if ( "]" == command )
+			{
+				if ( 0 == depth ) {
+					throw invalid_argument( "] without REPEAT" );
+				}
+
+				if ( ! has_action.back() ) {
+					throw invalid_argument( "REPEAT with nothing to do" );
+				}
+
+				const bool is_action = is_run.back();
+				has_action.pop_back();
+				is_run.pop_back();
+				--depth;
+				code.push_back( LogoInterpreter::OP_END );
+
+				if ( ! is_action ) {
+					continue;
+				}
+			}
+			else {
+				throw invalid_argument( "unknown command " + command );
+			}
+
+			if ( ! has_action.empty() ) {
+				has_action.back() = true;
+			}
+		}
+
+		if ( 0 != depth ) {
+			throw invalid_argument( "REPEAT without ]" );
+		}
+
+		if ( code.size() > LogoInterpreter::MAX_PROGRAM_SIZE ) {
+			throw invalid_argument( "program too long" );
+		}
+
+		m_code.swap( code );
+	}
+
+
+	vector<Message>
+	LogoCompiler::makeUploadRequests (UInt16 task_id) const
+	{
+		vector<Message> requests;
+
+		for ( size_t offset = 0; offset < m_code.size();
+			  offset += LogoProgramRequest::MAX_CODE_SIZE )
+		{
+			const size_t size = min<size_t>(
+				m_code.size() - offset, LogoProgramRequest::MAX_CODE_SIZE );
+
+			requests.push_back(
+				LogoProgramRequest(
+					task_id, offset, &m_code[offset], size
+				).asMessage()
+			);
+		}
+
+		return requests;
+	}
+
+} }
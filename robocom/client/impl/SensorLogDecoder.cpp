@@ -0,0 +1,130 @@
+// External component headers
+#include "robocom/shared/SensorLog.hpp"
+
+// Component headers
+#include "../GyroDecoder.hpp"
+
+// Module header
+#include "../SensorLogDecoder.hpp"
+
+namespace robocom {
+namespace client
+{
+	using namespace std;
+	using namespace robocom::shared;
+
+
+	SensorLogDecoder::SensorLogDecoder () throw ()
+		: m_millis( )
+		, m_w( )
+		, m_x( )
+		, m_y( )
+		, m_z( )
+		, m_yaw_angle( )
+		, m_yaw( )
+		, m_pitch( )
+		, m_roll( )
+		, m_overflow_count( 0 )
+		, m_channels( 0 )
+	{ }
+
+
+	void
+	SensorLogDecoder::clear () throw ()
+	{
+		m_millis.clear();
+		m_w.clear();
+		m_x.clear();
+		m_y.clear();
+		m_z.clear();
+		m_yaw_angle.clear();
+		m_encoder_totals[0].clear();
+		m_encoder_totals[1].clear();
+		m_yaw.clear();
+		m_pitch.clear();
+		m_roll.clear();
+		m_overflow_count = 0;
+		m_channels = 0;
+	}
+
+
+	bool
+	SensorLogDecoder::add (const UInt8* p_blob, UInt16 size)
+	{
+		SensorLog::Header header;
+		if ( ! SensorLog::parseHeader( p_blob, size, header ) ) {
+			return false;
+		}
+
+		const UInt8 record_size = SensorLog::getRecordSize( header.channels );
+		const UInt8* p_record = p_blob + SensorLog::HEADER_SIZE;
+
+		for ( UInt8 i = 0; i < header.record_count; i++, p_record += record_size )
+		{
+			SensorLog::Sample sample;
+			SensorLog::unpackRecord( p_record, header.channels, sample );
+
+			m_millis.push_back(
+				header.start_millis
+				+ ( header.first_index + i ) * header.period_millis
+			);
+
+			if ( header.channels & SensorLog::CHANNEL_QUATERNION )
+			{
+				m_w.push_back( sample.quaternion[0] );
+				m_x.push_back( sample.quaternion[1] );
+				m_y.push_back( sample.quaternion[2] );
+				m_z.push_back( sample.quaternion[3] );
+			}
+
+			if ( header.channels & SensorLog::CHANNEL_YAW ) {
+				m_yaw_angle.push_back( sample.yaw );
+			}
+
+			if ( header.channels & SensorLog::CHANNEL_ENCODERS )
+			{
+				for ( int e = 0; e < 2; e++ )
+				{
+					vector<SInt32>& totals = m_encoder_totals[e];
+					if ( totals.empty() ) {
+						totals.push_back( sample.encoder_ticks[e] );
+					}
+					else
+					{
+						// The difference of the low 16 bits is the
+						// movement since the previous sample
+						const UInt16 last = static_cast<UInt16>( totals.back() );
+						totals.push_back(
+							totals.back()
+							+ static_cast<SInt16>( sample.encoder_ticks[e] - last )
+						);
+					}
+				}
+			}
+		}
+
+		m_channels = header.channels;
+		m_overflow_count = header.overflow_count;
+		return true;
+	}
+
+
+	void
+	SensorLogDecoder::decode ()
+	{
+		const UInt32 count = m_w.size();
+
+		m_yaw.resize( count );
+		m_pitch.resize( count );
+		m_roll.resize( count );
+
+		if ( count > 0 )
+		{
+			GyroDecoder::decode(
+				& m_w[0], & m_x[0], & m_y[0], & m_z[0], count,
+				& m_yaw[0], & m_pitch[0], & m_roll[0]
+			);
+		}
+	}
+
+} }
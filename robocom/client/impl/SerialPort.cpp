@@ -9,6 +9,7 @@
 
 // External component headers
 #include "common/ErrorReporting.hpp"
+#include "robocom/shared/MessageIO.hxx"
 
 // Component headers
 #include "../Handle.hpp"
@@ -250,6 +251,37 @@ namespace client
 	}
 
 
+	bool
+	SerialPort::awaitAvailable (UInt32 timeout_millis) throw (system_error)
+	{
+		if ( m_peeked_byte >= 0 || available() > 0 ) {
+			return true;
+		}
+
+		const SysHandleType fd = m_handle.getNative();
+
+		::fd_set rdset;
+		::timeval timeout;
+		int result;
+
+		do
+		{
+			FD_ZERO( & rdset );
+			FD_SET( fd, & rdset );
+			timeout.tv_sec = timeout_millis / 1000;
+			timeout.tv_usec = ( timeout_millis % 1000 ) * 1000;
+			result = ::select( fd + 1, & rdset, NULL, NULL, & timeout );
+		}
+		while ( result < 0 && errno == EINTR );
+
+		if ( result < 0 ) {
+			THROW_SYSTEM_ERROR( "Error blocking for input on " + m_port_name );
+		}
+
+		return result > 0;
+	}
+
+
 	int
 	SerialPort::peek () throw (system_error)
 	{
@@ -496,3 +528,6 @@ namespace client
 	}
 
 } }
+
+
+template class robocom::shared::BasicMessageIO<robocom::client::SerialPort>;
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <unittest++/UnitTest++.h>
+
+#include "robocom/shared/msg/GyroQuaternionNotice.hpp"
+#include "robocom/client/GyroDecoder.hpp"
+
+using namespace robocom::shared::msg;
+using namespace robocom::client;
+
+SUITE(GyroDecoderTester)
+{
+	GyroQuaternionNotice __rotation (
+		double angle, double ax, double ay, double az, UInt32 micros)
+	{
+		const double one = GyroQuaternionNotice::QUATERNION_ONE;
+		const double s = std::sin( angle / 2 );
+
+		return GyroQuaternionNotice(
+			1, micros / 1000,
+			static_cast<SInt16>( std::cos( angle / 2 ) * one ),
+			static_cast<SInt16>( ax * s * one ),
+			static_cast<SInt16>( ay * s * one ),
+			static_cast<SInt16>( az * s * one ),
+			micros
+		);
+	}
+
+	TEST(Empty)
+	{
+		GyroDecoder d;
+		d.decode();
+		CHECK_EQUAL( 0u, d.getSize() );
+		CHECK_EQUAL( 0u, d.getYawDegrees().size() );
+	}
+
+	TEST(Yaw)
+	{
+		GyroDecoder d;
+
+		for ( int deg = -170; deg <= 170; deg += 10 ) {
+			d.add( __rotation( deg * M_PI / 180, 0, 0, 1, deg + 1000 ) );
+		}
+
+		d.decode();
+		CHECK_EQUAL( 35u, d.getSize() );
+
+		for ( UInt32 i = 0; i < d.getSize(); i++ )
+		{
+			const int deg = -170 + 10 * i;
+
+			// Rotation about Z by angle a is reported as yaw -a
+			CHECK_CLOSE( -deg, d.getYawDegrees()[i], 0.05f );
+			CHECK_CLOSE( 0.0f, d.getPitchDegrees()[i], 0.05f );
+			CHECK_CLOSE( 0.0f, d.getRollDegrees()[i], 0.05f );
+			CHECK_EQUAL( (UInt32) (deg + 1000), d.getMeasurementMicros()[i] );
+		}
+	}
+
+	TEST(PitchRoll)
+	{
+		GyroDecoder d;
+		d.add( __rotation( 20 * M_PI / 180, 0, 1, 0, 0 ) );
+		d.add( __rotation( 20 * M_PI / 180, 1, 0, 0, 0 ) );
+		d.decode();
+
+		CHECK_CLOSE( -20.0f, d.getPitchDegrees()[0], 0.05f );
+		CHECK_CLOSE( 0.0f, d.getRollDegrees()[0], 0.05f );
+		CHECK_CLOSE( 0.0f, d.getPitchDegrees()[1], 0.05f );
+		CHECK_CLOSE( 20.0f, d.getRollDegrees()[1], 0.05f );
+	}
+
+	TEST(Clear)
+	{
+		GyroDecoder d;
+		d.add( __rotation( 1.0, 0, 0, 1, 0 ) );
+		d.decode();
+		d.clear();
+		CHECK_EQUAL( 0u, d.getSize() );
+		CHECK_EQUAL( 0u, d.getYawDegrees().size() );
+	}
+}
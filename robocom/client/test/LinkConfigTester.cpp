@@ -0,0 +1,71 @@
+#include <unittest++/UnitTest++.h>
+
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hpp"
+#include "robocom/shared/msg/CapsResponse.hpp"
+#include "robocom/client/LinkConfig.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+using namespace robocom::client;
+
+SUITE(LinkConfigTester)
+{
+	CapsResponse __caps (UInt8 features, UInt8 max_data_size)
+	{
+		return CapsResponse(
+			1, CapsResponse::PROTOCOL_VERSION, features,
+			max_data_size, 32, 4, 4, 50, 64
+		);
+	}
+
+	TEST(Default)
+	{
+		const LinkConfig config;
+		CHECK_EQUAL( (int) MessageIO::CODEC_PLAIN, (int) config.getCodec() );
+		CHECK( ! config.isFlowControl() );
+		CHECK( ! config.isReliable() );
+		CHECK_EQUAL( (int) Message::MAX_DATA_SIZE, (int) config.getMaxDataSize() );
+		CHECK_EQUAL( 0, (int) config.getMaxBlobSize() );
+	}
+
+	TEST(ChoosesCommonFeatures)
+	{
+		const UInt8 all = CapsResponse::FEATURE_CREDIT
+			| CapsResponse::FEATURE_COBS
+			| CapsResponse::FEATURE_RELIABLE;
+
+		const LinkConfig config =
+			LinkConfig::choose( __caps( all, 12 ), all, true );
+		CHECK_EQUAL( (int) MessageIO::CODEC_COBS, (int) config.getCodec() );
+		CHECK( config.isFlowControl() );
+		CHECK( config.isReliable() );
+		CHECK_EQUAL( 12, (int) config.getMaxDataSize() );
+		CHECK_EQUAL( 0, (int) config.getMaxBlobSize() );
+
+		// The reliable frames only when asked for
+		CHECK( ! LinkConfig::choose( __caps( all, 16 ), all, false ).isReliable() );
+	}
+
+	TEST(FeaturesMissingOnOneSide)
+	{
+		const LinkConfig old_server = LinkConfig::choose(
+			__caps( CapsResponse::FEATURE_CREDIT, 16 ),
+			CapsResponse::FEATURE_CREDIT | CapsResponse::FEATURE_COBS,
+			true
+		);
+		CHECK_EQUAL( (int) MessageIO::CODEC_PLAIN, (int) old_server.getCodec() );
+		CHECK( old_server.isFlowControl() );
+		CHECK( ! old_server.isReliable() );
+
+		const LinkConfig old_client = LinkConfig::choose(
+			__caps( 0xFF, 16 ),
+			CapsResponse::FEATURE_COBS,
+			true
+		);
+		CHECK_EQUAL( (int) MessageIO::CODEC_COBS, (int) old_client.getCodec() );
+		CHECK( ! old_client.isFlowControl() );
+		CHECK( ! old_client.isReliable() );
+		CHECK_EQUAL( 64, (int) old_client.getMaxBlobSize() );
+	}
+}
@@ -0,0 +1,131 @@
+#include <stdexcept>
+#include <unittest++/UnitTest++.h>
+
+#include "robocom/shared/LogoInterpreter.hpp"
+#include "robocom/shared/msg/LogoProgramRequest.hpp"
+#include "robocom/client/LogoCompiler.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+using namespace robocom::client;
+
+SUITE(LogoCompilerTester)
+{
+	TEST(Square)
+	{
+		LogoCompiler compiler;
+		compiler.compile( "pd repeat 4 [fd 20 RT 90] PENUP wait 1000" );
+
+		const UInt8 expected[] = {
+			LogoInterpreter::OP_PEN_DOWN,
+			LogoInterpreter::OP_REPEAT, 4,
+			LogoInterpreter::OP_FORWARD, 20, 0,
+			LogoInterpreter::OP_RIGHT, 90, 0,
+			LogoInterpreter::OP_END,
+			LogoInterpreter::OP_PEN_UP,
+			LogoInterpreter::OP_WAIT, 0xE8, 0x03
+		};
+
+		CHECK_EQUAL( sizeof(expected), compiler.getCode().size() );
+		CHECK_ARRAY_EQUAL( expected, &compiler.getCode()[0], sizeof(expected) );
+	}
+
+	TEST(RunsOnInterpreter)
+	{
+		LogoCompiler compiler;
+		compiler.compile( "REPEAT 3 [ REPEAT 2 [ BK 5 LT 10 ] ]" );
+
+		LogoInterpreter interpreter;
+		interpreter.write( 0, &compiler.getCode()[0], compiler.getCode().size() );
+		CHECK( interpreter.start() );
+
+		LogoInterpreter::Action action;
+		int moves = 0;
+		int turns = 0;
+		while ( interpreter.next( action ) )
+		{
+			if ( LogoInterpreter::ACTION_MOVE == action.type ) {
+				CHECK_EQUAL( 1, action.direction );
+				CHECK_EQUAL( 5, action.amount );
+				++moves;
+			}
+			else if ( LogoInterpreter::ACTION_TURN == action.type ) {
+				CHECK_EQUAL( 1, action.direction );
+				CHECK_EQUAL( 10, action.amount );
+				++turns;
+			}
+		}
+
+		CHECK_EQUAL( 6, moves );
+		CHECK_EQUAL( 6, turns );
+	}
+
+	TEST(Errors)
+	{
+		LogoCompiler compiler;
+		compiler.compile( "FD 1" );
+
+		CHECK_THROW( compiler.compile( "JUMP 3" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "FD" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "FD -1" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "FD 65536" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "REPEAT 256 [ FD 1 ]" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "REPEAT 2 FD 1" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "REPEAT 2 [ FD 1" ), std::invalid_argument );
+		CHECK_THROW( compiler.compile( "FD 1 ]" ), std::invalid_argument );
+		CHECK_THROW(
+			compiler.compile( "REPEAT 2 [ REPEAT 2 [ REPEAT 2 [ REPEAT 2 [ REPEAT 2 [ FD 1 ] ] ] ] ]" ),
+			std::invalid_argument );
+
+		// Loops that would keep the robot busy without doing anything
+		CHECK_THROW( compiler.compile( "REPEAT 2 [ ]" ), std::invalid_argument );
+		CHECK_THROW(
+			compiler.compile( "REPEAT 255 [ REPEAT 255 [ REPEAT 20 [ ] ] ] PU" ),
+			std::invalid_argument );
+		CHECK_THROW(
+			compiler.compile( "REPEAT 255 [ REPEAT 0 [ FD 1 ] ]" ),
+			std::invalid_argument );
+
+		// 43 moves of 3 bytes do not fit in 128 bytes
+		std::string too_long;
+		for ( int i = 0; i < 43; ++i ) {
+			too_long += "FD 1 ";
+		}
+		CHECK_THROW( compiler.compile( too_long ), std::invalid_argument );
+
+		// Failed compilations leave the program intact
+		CHECK_EQUAL( 3u, compiler.getCode().size() );
+	}
+
+	TEST(UploadRequests)
+	{
+		LogoCompiler compiler;
+		compiler.compile( "FD 1 FD 2 FD 3 FD 4 FD 5 FD 6" );
+
+		const std::vector<Message> requests = compiler.makeUploadRequests( 7 );
+		CHECK_EQUAL( 2u, requests.size() );
+
+		LogoInterpreter interpreter;
+		for ( size_t i = 0; i < requests.size(); ++i )
+		{
+			const LogoProgramRequest req( requests[i] );
+			CHECK_EQUAL( STATUS_OK, req.validate() );
+			CHECK_EQUAL( 7, req.getTaskId() );
+			CHECK( req.asMessage().isImmediate() );
+
+			UInt8 code[LogoProgramRequest::MAX_CODE_SIZE];
+			req.getCode( code );
+			CHECK( interpreter.write( req.getOffset(), code, req.getCodeSize() ) );
+		}
+
+		CHECK_EQUAL( 18, interpreter.getSize() );
+		CHECK( interpreter.start() );
+
+		LogoInterpreter::Action action;
+		for ( UInt16 distance = 1; distance <= 6; ++distance ) {
+			CHECK( interpreter.next( action ) );
+			CHECK_EQUAL( distance, action.amount );
+		}
+		CHECK( ! interpreter.next( action ) );
+	}
+}
@@ -0,0 +1,111 @@
+#include <unittest++/UnitTest++.h>
+
+#include "robocom/shared/SensorLog.hpp"
+#include "robocom/client/SensorLogDecoder.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::client;
+
+SUITE(SensorLogDecoderTester)
+{
+	SensorLog::Sample __sample (UInt16 left, UInt16 right)
+	{
+		SensorLog::Sample sample;
+		sample.quaternion[0] = 16384;
+		sample.quaternion[1] = 0;
+		sample.quaternion[2] = 0;
+		sample.quaternion[3] = 0;
+		sample.yaw = 100;
+		sample.encoder_ticks[0] = left;
+		sample.encoder_ticks[1] = right;
+		return sample;
+	}
+
+	TEST(Empty)
+	{
+		SensorLogDecoder d;
+		d.decode();
+		CHECK_EQUAL( 0u, d.getSize() );
+		CHECK_EQUAL( 0u, d.getYawDegrees().size() );
+	}
+
+	TEST(Malformed)
+	{
+		SensorLog log;
+		log.start( SensorLog::CHANNEL_ALL, 10, 0 );
+		log.append( __sample( 0, 0 ) );
+
+		UInt8 blob[64];
+		const UInt16 size = log.fetch( blob, sizeof( blob ) );
+
+		SensorLogDecoder d;
+		CHECK( ! d.add( blob, size - 1 ) );
+		CHECK_EQUAL( 0u, d.getSize() );
+	}
+
+	TEST(TimesAndChannels)
+	{
+		SensorLog log;
+		log.start( SensorLog::CHANNEL_ALL, 20, 1000 );
+
+		SensorLogDecoder d;
+		UInt8 blob[64];
+		for ( int i = 0; i < 6; i++ )
+		{
+			log.append( __sample( i, 0 ) );
+			if ( 2 == i || 5 == i ) {
+				CHECK( d.add( blob, log.fetch( blob, sizeof( blob ) ) ) );
+			}
+		}
+
+		d.decode();
+		CHECK_EQUAL( 6u, d.getSize() );
+		CHECK_EQUAL( (int) SensorLog::CHANNEL_ALL, (int) d.getChannels() );
+		for ( UInt32 i = 0; i < d.getSize(); i++ )
+		{
+			CHECK_EQUAL( 1000 + 20 * i, d.getSampleMillis()[i] );
+			CHECK_EQUAL( 100, d.getYawAngles()[i] );
+			CHECK_EQUAL( (SInt32) i, d.getEncoderTotals( 0 )[i] );
+			CHECK_CLOSE( 0.0f, d.getYawDegrees()[i], 0.05f );
+			CHECK_CLOSE( 0.0f, d.getPitchDegrees()[i], 0.05f );
+		}
+	}
+
+	TEST(EncoderTotalsAreUnwrapped)
+	{
+		SensorLog log;
+		log.start( SensorLog::CHANNEL_ENCODERS, 10, 0 );
+		log.append( __sample( 0xFFF0, 0x0010 ) );
+		log.append( __sample( 0x0010, 0xFFF0 ) );
+		log.append( __sample( 0x8000, 0x8000 ) );
+
+		UInt8 blob[64];
+		SensorLogDecoder d;
+		CHECK( d.add( blob, log.fetch( blob, sizeof( blob ) ) ) );
+
+		CHECK_EQUAL( 3u, d.getSize() );
+		CHECK_EQUAL( 0u, d.getYawAngles().size() );
+		CHECK_EQUAL( 0xFFF0 + 0x20, d.getEncoderTotals( 0 )[1] );
+		CHECK_EQUAL( 0xFFF0 + 0x20 + 0x7FF0, d.getEncoderTotals( 0 )[2] );
+		CHECK_EQUAL( -0x10, d.getEncoderTotals( 1 )[1] );
+	}
+
+	TEST(OverflowLeavesGap)
+	{
+		SensorLog log;
+		log.start( SensorLog::CHANNEL_YAW, 10, 0 );
+
+		const int slots = SensorLog::CAPACITY / 2;
+		for ( int i = 0; i < slots + 5; i++ ) {
+			log.append( __sample( 0, 0 ) );
+		}
+
+		UInt8 blob[SensorLog::HEADER_SIZE + 8];
+		SensorLogDecoder d;
+		CHECK( d.add( blob, log.fetch( blob, sizeof( blob ) ) ) );
+
+		CHECK_EQUAL( 4u, d.getSize() );
+		CHECK_EQUAL( 5, (int) d.getOverflowCount() );
+		CHECK_EQUAL( 50u, d.getSampleMillis()[0] );
+	}
+}
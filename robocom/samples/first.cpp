@@ -36,7 +36,9 @@ void setDrive (UInt8 dir1, UInt8 sig1, UInt8 dir2, UInt8 sig2)
 void subscribe (UInt8 encoder)
 {
 	printf( "%d: Subscribe %d\n", task_id, encoder );
-	EncoderReadingRequest req( task_id++, encoder, true );
+	EncoderReadingRequest req(
+		task_id++, encoder, true, EncoderReadingRequest::FORMAT_READING,
+		0, 1, 0 );
 	io.write( req.asMessage() );
 }
 
@@ -44,7 +46,9 @@ void subscribe (UInt8 encoder)
 void unsubcribe (UInt8 encoder)
 {
 	printf( "%d: Unsubscribe %d\n", task_id, encoder );
-	EncoderReadingRequest req( task_id++, encoder, false );
+	EncoderReadingRequest req(
+		task_id++, encoder, false, EncoderReadingRequest::FORMAT_READING,
+		0, 1, 0 );
 	io.write( req.asMessage() );
 }
 
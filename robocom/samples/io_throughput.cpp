@@ -0,0 +1,181 @@
+/*
+ * Compares the time MessageIO and BasicMessageIO<BufferStream> take to
+ * encode and decode messages.
+ *
+ * Both write the frames of a batch of messages into a buffer in
+ * memory and read them back from it. MessageIO reaches the buffer
+ * through the virtual functions of StreamIO, byte by byte; the
+ * BasicMessageIO is bound to the BufferStream at compile time, so the
+ * stream access is inlined into the parsing. The times are per message,
+ * averaged over all the rounds.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "robocom/shared/BufferStream.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hxx"
+#include "robocom/shared/StreamIO.hpp"
+#include "robocom/shared/msg/GyroQuaternionNotice.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+#include "robocom/shared/msg/SimpleMessage.hxx"
+
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+
+
+enum
+{
+	BATCH_SIZE = 32,
+	ROUND_COUNT = 20000,
+	BUFFER_SIZE = 4096
+};
+
+
+/**
+ * StreamIO over a BufferStream, the way MessageIO sees any stream
+ */
+class VirtualBufferStream
+	: public StreamIO
+{
+public:
+
+	explicit VirtualBufferStream (BufferStream& stream)
+		: m_stream( stream )
+	{ }
+
+	virtual int available ()
+	{
+		return m_stream.available();
+	}
+
+	virtual int peek ()
+	{
+		return m_stream.peek();
+	}
+
+	virtual int read ()
+	{
+		return m_stream.read();
+	}
+
+	virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+	{
+		return m_stream.readBytes( p_buffer, size );
+	}
+
+	virtual UInt32 write (UInt8 b)
+	{
+		return m_stream.write( b );
+	}
+
+	virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+	{
+		return m_stream.write( p_buffer, size );
+	}
+
+private:
+
+	BufferStream& m_stream;
+};
+
+
+double getNanos ()
+{
+	::timespec ts;
+	::clock_gettime( CLOCK_MONOTONIC, & ts );
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+/**
+ * A mix of short and long, immediate and timed messages
+ */
+void makeBatch (Message* p_batch)
+{
+	for ( UInt16 i = 0; i < BATCH_SIZE; i++ )
+	{
+		switch ( i % 3 )
+		{
+		case 0:
+			p_batch[i] = NoopRequest( i ).asMessage();
+			break;
+		case 1:
+			p_batch[i] = SetWheelDriveRequest( i, 1000u + i, 1, 200, 0, 100 ).asMessage();
+			break;
+		default:
+			p_batch[i] = GyroQuaternionNotice( i, 1000u + i, -1, 2, -3, 4, i ).asMessage();
+			break;
+		}
+	}
+}
+
+
+/**
+ * Writes and reads back the batch for all rounds, timing both
+ */
+template <class IO>
+void run (const char* binding, UInt8 codec, IO& io)
+{
+	Message batch[BATCH_SIZE];
+	makeBatch( batch );
+	io.setCodec( codec );
+
+	double encode_nanos = 0;
+	double decode_nanos = 0;
+	UInt32 checksum = 0;
+	Message msg;
+
+	for ( int round = 0; round < ROUND_COUNT; round++ )
+	{
+		const double start = getNanos();
+		for ( int i = 0; i < BATCH_SIZE; i++ ) {
+			io.write( batch[i] );
+		}
+
+		const double written = getNanos();
+		while ( io.read( msg ) ) {
+			checksum += msg.getTaskId();
+		}
+
+		const double end = getNanos();
+		encode_nanos += written - start;
+		decode_nanos += end - written;
+	}
+
+	const UInt32 expected = ROUND_COUNT * ( BATCH_SIZE * ( BATCH_SIZE - 1 ) / 2 );
+	printf(
+		"%-6s %-8s %10.1f %10.1f %s\n",
+		MessageIO::CODEC_COBS == codec ? "cobs" : "plain",
+		binding,
+		encode_nanos / ( ROUND_COUNT * BATCH_SIZE ),
+		decode_nanos / ( ROUND_COUNT * BATCH_SIZE ),
+		expected == checksum ? "ok" : "LOST"
+	);
+}
+
+
+int main ()
+{
+	static UInt8 buffer[BUFFER_SIZE];
+
+	printf(
+		"%-6s %-8s %10s %10s %s\n",
+		"codec", "binding", "encode_ns", "decode_ns", "check"
+	);
+
+	for ( UInt8 codec = 0; codec < MessageIO::CODEC_COUNT; codec++ )
+	{
+		BufferStream stream( buffer, sizeof( buffer ) );
+
+		VirtualBufferStream virtual_stream( stream );
+		MessageIO virtual_io( virtual_stream );
+		run( "virtual", codec, virtual_io );
+
+		BasicMessageIO<BufferStream> static_io( stream );
+		run( "static", codec, static_io );
+	}
+
+	return EXIT_SUCCESS;
+}
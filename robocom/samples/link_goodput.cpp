@@ -0,0 +1,295 @@
+/*
+ * Compares the goodput of the frame codecs over a simulated link
+ * which flips random bits.
+ *
+ * The goodput is the share of the bytes on the wire which carried
+ * the payload of messages that arrived intact. Without the reliable
+ * mode, corrupted frames that still parse count as garbage; with it,
+ * the messages are retransmitted until all of them arrive, and the
+ * wire bytes include the retransmissions and acknowledgements.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <deque>
+#include <vector>
+
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hpp"
+#include "robocom/shared/StreamIO.hpp"
+#include "robocom/shared/msg/MessageTypes.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+
+
+/**
+ * One end of the simulated link
+ */
+class EndStream
+	: public StreamIO
+{
+public:
+
+	virtual int available ()
+	{
+		return static_cast<int>( m_in.size() );
+	}
+
+	virtual int peek ()
+	{
+		return m_in.empty() ? -1 : m_in.front();
+	}
+
+	virtual int read ()
+	{
+		if ( m_in.empty() ) {
+			return -1;
+		}
+
+		const int b = m_in.front();
+		m_in.pop_front();
+		return b;
+	}
+
+	virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+	{
+		UInt32 n = 0;
+		for ( ; n < size && ! m_in.empty(); n++ ) {
+			p_buffer[n] = static_cast<char>( read() );
+		}
+		return n;
+	}
+
+	virtual UInt32 write (UInt8 b)
+	{
+		m_out.push_back( b );
+		return 1;
+	}
+
+	virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+	{
+		m_out.insert( m_out.end(), p_buffer, p_buffer + size );
+		return size;
+	}
+
+	std::deque<UInt8> m_in;
+	std::vector<UInt8> m_out;
+};
+
+
+/**
+ * Moves the bytes between the ends, flipping each bit with the given
+ * probability
+ */
+class NoisyLink
+{
+public:
+
+	NoisyLink (double bit_error_rate)
+		: m_bit_error_rate( bit_error_rate )
+		, m_wire_bytes( 0 )
+		, m_seed( 12345 )
+	{ }
+
+	void deliver (EndStream& from, EndStream& to)
+	{
+		for ( size_t i = 0; i < from.m_out.size(); i++ )
+		{
+			UInt8 b = from.m_out[i];
+			for ( int bit = 0; bit < 8; bit++ )
+			{
+				if ( _random() < m_bit_error_rate ) {
+					b ^= 1u << bit;
+				}
+			}
+			to.m_in.push_back( b );
+		}
+
+		m_wire_bytes += from.m_out.size();
+		from.m_out.clear();
+	}
+
+	UInt32 getWireBytes () const
+	{
+		return m_wire_bytes;
+	}
+
+private:
+
+	double _random ()
+	{
+		m_seed = m_seed * 1103515245u + 12345u;
+		return ( m_seed >> 8 ) / 16777216.0;
+	}
+
+	double m_bit_error_rate;
+	UInt32 m_wire_bytes;
+	UInt32 m_seed;
+};
+
+
+enum
+{
+	MESSAGE_COUNT = 20000,
+	PAYLOAD_SIZE = 8
+};
+
+
+Message makeMessage (UInt16 index)
+{
+	Message msg;
+	msg.clear();
+	msg.setMessageType( CommonMessageTypes::MSGID_ECHO );
+	msg.setImmediate();
+	msg.setTaskId( index );
+	msg.setDataSize( PAYLOAD_SIZE );
+	for ( unsigned i = 0; i < PAYLOAD_SIZE; i++ ) {
+		msg.setUInt8( i, static_cast<UInt8>( index * 7 + i ) );
+	}
+	return msg;
+}
+
+
+bool isIntact (const Message& msg)
+{
+	const Message expected = makeMessage( msg.getTaskId() );
+	if ( msg.getMessageType() != expected.getMessageType() ||
+		 ! msg.isImmediate() ||
+		 msg.getDataSize() != PAYLOAD_SIZE )
+	{
+		return false;
+	}
+
+	for ( unsigned i = 0; i < PAYLOAD_SIZE; i++ )
+	{
+		if ( msg.getUInt8( i ) != expected.getUInt8( i ) ) {
+			return false;
+		}
+	}
+	return msg.getTaskId() < MESSAGE_COUNT;
+}
+
+
+/**
+ * Sends the messages once and counts what arrived
+ */
+void runUnreliable (UInt8 codec, double bit_error_rate)
+{
+	EndStream a;
+	EndStream b;
+	MessageIO io_a( a );
+	MessageIO io_b( b );
+	NoisyLink link( bit_error_rate );
+	io_a.setCodec( codec );
+	io_b.setCodec( codec );
+
+	UInt32 intact_count = 0;
+	UInt32 garbage_count = 0;
+	Message msg;
+
+	for ( UInt16 i = 0; i < MESSAGE_COUNT; i++ )
+	{
+		io_a.write( makeMessage( i ) );
+		link.deliver( a, b );
+
+		while ( io_b.read( msg ) )
+		{
+			if ( isIntact( msg ) ) {
+				intact_count++;
+			}
+			else {
+				garbage_count++;
+			}
+		}
+	}
+
+	printf(
+		"%-6s %-10s %8.0e %8.3f %8u %8u\n",
+		MessageIO::CODEC_COBS == codec ? "cobs" : "plain",
+		"once",
+		bit_error_rate,
+		intact_count * PAYLOAD_SIZE / (double) link.getWireBytes(),
+		intact_count,
+		garbage_count
+	);
+}
+
+
+#if defined(ROBOCOM_RELIABLE_IO)
+/**
+ * Streams the messages in the reliable mode until all of them arrived
+ */
+void runReliable (UInt8 codec, double bit_error_rate)
+{
+	EndStream a;
+	EndStream b;
+	MessageIO io_a( a );
+	MessageIO io_b( b );
+	NoisyLink link( bit_error_rate );
+	io_a.setCodec( codec );
+	io_b.setCodec( codec );
+	io_a.setReliable( true );
+
+	UInt32 next_to_send = 0;
+	UInt32 intact_count = 0;
+	UInt32 garbage_count = 0;
+	Message msg;
+
+	for ( UInt32 millis = 0; intact_count < MESSAGE_COUNT && millis < 10000000; millis++ )
+	{
+		while ( next_to_send < MESSAGE_COUNT && io_a.tryWrite( makeMessage( next_to_send ) ) ) {
+			next_to_send++;
+		}
+		io_a.poll( millis );
+		link.deliver( a, b );
+
+		while ( io_b.read( msg ) )
+		{
+			if ( isIntact( msg ) ) {
+				intact_count++;
+			}
+			else {
+				garbage_count++;
+			}
+		}
+		io_b.poll( millis );
+		link.deliver( b, a );
+
+		while ( io_a.read( msg ) ) { }
+	}
+
+	printf(
+		"%-6s %-10s %8.0e %8.3f %8u %8u\n",
+		MessageIO::CODEC_COBS == codec ? "cobs" : "plain",
+		"reliable",
+		bit_error_rate,
+		intact_count * PAYLOAD_SIZE / (double) link.getWireBytes(),
+		intact_count,
+		garbage_count
+	);
+}
+#endif
+
+
+int main ()
+{
+	const double BIT_ERROR_RATES[] = { 0, 1e-5, 1e-4, 1e-3, 3e-3 };
+
+	printf(
+		"%-6s %-10s %8s %8s %8s %8s\n",
+		"codec", "mode", "ber", "goodput", "intact", "garbage"
+	);
+
+	for ( size_t i = 0; i < sizeof( BIT_ERROR_RATES ) / sizeof( double ); i++ )
+	{
+		runUnreliable( MessageIO::CODEC_PLAIN, BIT_ERROR_RATES[i] );
+		runUnreliable( MessageIO::CODEC_COBS, BIT_ERROR_RATES[i] );
+#if defined(ROBOCOM_RELIABLE_IO)
+		runReliable( MessageIO::CODEC_PLAIN, BIT_ERROR_RATES[i] );
+		runReliable( MessageIO::CODEC_COBS, BIT_ERROR_RATES[i] );
+#endif
+	}
+
+	return EXIT_SUCCESS;
+}
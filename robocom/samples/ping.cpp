@@ -0,0 +1,520 @@
+/*
+ * robocom-ping: measures the round trip time to the server over a serial
+ * port with timestamped EchoRequest messages.
+ *
+ * The server writes an echo back as soon as it reads it, so the round
+ * trip covers the serial link, the USB-serial adapter and the read loop
+ * of the server, but no queueing. Each probe carries the time it was
+ * sent, in microseconds since the start, in its first four data bytes
+ * and a pattern in the rest. The round trip time is taken from the
+ * timestamp of the reply. Replies are matched by task ID, and those with
+ * a damaged payload are counted as corrupt. Probes without a reply
+ * within the timeout are lost; replies which come later are late.
+ *
+ * Usage: robocom-ping [options] PORT
+ *   -b BAUD     baud rate of the port (default 57600)
+ *   -c COUNT    number of probes (default 100)
+ *   -r RATE     probes per second (default 10)
+ *   -s SIZE     data bytes per probe, 4 to 16 (default 8)
+ *   -t MILLIS   time to wait for a reply (default 1000)
+ *   -d MILLIS   time to wait after opening the port, for boards which
+ *               reset on open (default 0)
+ *   -z          switch to the COBS codec if the server has it
+ *   -q          print only the summary
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "robocom/client/LinkConfig.hpp"
+#include "robocom/client/SerialPort.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hpp"
+#include "robocom/shared/msg/CapsResponse.hpp"
+#include "robocom/shared/msg/CodecRequest.hpp"
+#include "robocom/shared/msg/HelloRequest.hpp"
+#include "robocom/shared/msg/MessageTypes.hpp"
+
+using namespace robocom::client;
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+
+
+enum
+{
+	/// Task IDs of the handshake; the probes use 1 up to the count
+	HELLO_TASK_ID = 0xfff0,
+	CODEC_TASK_ID = 0xfff1,
+
+	MAX_PROBE_COUNT = 0xff00,
+	TIMESTAMP_SIZE = 4,
+	HISTOGRAM_WIDTH = 40
+};
+
+
+double getMicros ()
+{
+	::timespec ts;
+	::clock_gettime( CLOCK_MONOTONIC, & ts );
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+
+struct Options
+{
+	Options ()
+		: p_port_name( NULL )
+		, baud_rate( BAUD_RATE_57600 )
+		, count( 100 )
+		, rate( 10 )
+		, size( 8 )
+		, timeout_millis( 1000 )
+		, delay_millis( 0 )
+		, is_cobs( false )
+		, is_quiet( false )
+	{ }
+
+	const char* p_port_name;
+	BaudRate baud_rate;
+	unsigned count;
+	unsigned rate;
+	unsigned size;
+	unsigned timeout_millis;
+	unsigned delay_millis;
+	bool is_cobs;
+	bool is_quiet;
+};
+
+
+bool parseBaudRate (const char* p_text, BaudRate& baud_rate)
+{
+	static const struct
+	{
+		unsigned value;
+		BaudRate baud_rate;
+	}
+	RATES[] = {
+		{ 1200, BAUD_RATE_1200 },
+		{ 2400, BAUD_RATE_2400 },
+		{ 4800, BAUD_RATE_4800 },
+		{ 9600, BAUD_RATE_9600 },
+		{ 19200, BAUD_RATE_19200 },
+		{ 38400, BAUD_RATE_38400 },
+		{ 57600, BAUD_RATE_57600 },
+		{ 115200, BAUD_RATE_115200 }
+	};
+
+	const unsigned value = atoi( p_text );
+	for ( size_t i = 0; i < sizeof( RATES ) / sizeof( RATES[0] ); i++ )
+	{
+		if ( RATES[i].value == value )
+		{
+			baud_rate = RATES[i].baud_rate;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool parseOptions (int argc, char** argv, Options& options)
+{
+	int c;
+	while ( ( c = ::getopt( argc, argv, "b:c:r:s:t:d:zq" ) ) != -1 )
+	{
+		switch ( c )
+		{
+		case 'b':
+			if ( ! parseBaudRate( optarg, options.baud_rate ) )
+			{
+				fprintf( stderr, "Unsupported baud rate %s\n", optarg );
+				return false;
+			}
+			break;
+		case 'c':
+			options.count = atoi( optarg );
+			break;
+		case 'r':
+			options.rate = atoi( optarg );
+			break;
+		case 's':
+			options.size = atoi( optarg );
+			break;
+		case 't':
+			options.timeout_millis = atoi( optarg );
+			break;
+		case 'd':
+			options.delay_millis = atoi( optarg );
+			break;
+		case 'z':
+			options.is_cobs = true;
+			break;
+		case 'q':
+			options.is_quiet = true;
+			break;
+		default:
+			return false;
+		}
+	}
+
+	if ( optind + 1 != argc )
+	{
+		fprintf( stderr, "Expected the name of the serial port\n" );
+		return false;
+	}
+	options.p_port_name = argv[optind];
+
+	if ( options.count < 1 || options.count > MAX_PROBE_COUNT ||
+		 options.rate < 1 || options.timeout_millis < 1 ||
+		 options.size < TIMESTAMP_SIZE || options.size > Message::MAX_DATA_SIZE )
+	{
+		fprintf( stderr, "An option is out of range\n" );
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Sends the probes and collects the round trip times
+ */
+class Pinger
+{
+public:
+
+	Pinger (SerialPort& port, const Options& options)
+		: m_port( port )
+		, m_io( port )
+		, m_options( options )
+		, m_start_micros( 0 )
+		, m_sent_micros( options.count + 1, -1 )
+		, m_sent_count( 0 )
+		, m_late_count( 0 )
+		, m_corrupt_count( 0 )
+	{ }
+
+	/**
+	 * Switches to the COBS codec if the server supports it
+	 *
+	 * @return false if the server did not answer the handshake
+	 */
+	bool negotiate ()
+	{
+		Message msg;
+
+		m_io.write( HelloRequest( HELLO_TASK_ID, CapsResponse::PROTOCOL_VERSION,
+			MessageIO::getFeatures() ).asMessage() );
+		if ( ! _awaitTask( HELLO_TASK_ID, msg ) ) {
+			return false;
+		}
+
+		const LinkConfig config = LinkConfig::choose( CapsResponse( msg ) );
+		if ( config.getCodec() != m_io.getCodec() )
+		{
+			m_io.write( CodecRequest( CODEC_TASK_ID, config.getCodec() ).asMessage() );
+			if ( ! _awaitTask( CODEC_TASK_ID, msg ) ) {
+				return false;
+			}
+			m_io.setCodec( CodecResponse( msg ).getCodec() );
+		}
+		return true;
+	}
+
+	/**
+	 * Sends all probes and waits for the replies of the last ones
+	 */
+	void run ()
+	{
+		const double period_micros = 1e6 / m_options.rate;
+		const double timeout_micros = m_options.timeout_millis * 1e3;
+		const double start_micros = getMicros();
+		m_start_micros = start_micros;
+		const double end_micros = start_micros
+			+ ( m_options.count - 1 ) * period_micros + timeout_micros;
+		Message msg;
+
+		while ( getMicros() < end_micros && ! _isComplete() )
+		{
+			const double due_micros = start_micros + m_sent_count * period_micros;
+			if ( m_sent_count < m_options.count && getMicros() >= due_micros )
+			{
+				_sendProbe();
+				continue;
+			}
+
+			const double wait_micros =
+				( m_sent_count < m_options.count ? due_micros : end_micros )
+				- getMicros();
+			if ( wait_micros > 0 &&
+				 ! m_port.awaitAvailable( static_cast<UInt32>( ceil( wait_micros / 1e3 ) ) ) )
+			{
+				continue;
+			}
+
+			bool has_message = false;
+			while ( m_io.read( msg ) )
+			{
+				has_message = true;
+				_onReply( msg );
+			}
+
+			// The plain codec leaves a partial frame in the port, which
+			// keeps awaitAvailable() from blocking until the rest arrives
+			if ( ! has_message ) {
+				::usleep( 50 );
+			}
+		}
+	}
+
+	/**
+	 * Prints the statistics of the run
+	 */
+	void printSummary () const
+	{
+		std::vector<double> rtts( m_rtt_micros );
+		std::sort( rtts.begin(), rtts.end() );
+
+		const unsigned lost_count = m_sent_count - rtts.size();
+		printf( "--- %s ping statistics ---\n", m_options.p_port_name );
+		printf(
+			"%u probes sent, %u received, %.1f%% loss, %u late, %u corrupt\n",
+			m_sent_count,
+			static_cast<unsigned>( rtts.size() ),
+			100.0 * lost_count / m_sent_count,
+			m_late_count,
+			m_corrupt_count
+		);
+
+		if ( rtts.empty() ) {
+			return;
+		}
+
+		printf(
+			"rtt min/median/p99/max = %.3f/%.3f/%.3f/%.3f ms\n",
+			rtts.front() / 1e3,
+			_percentile( rtts, 0.5 ) / 1e3,
+			_percentile( rtts, 0.99 ) / 1e3,
+			rtts.back() / 1e3
+		);
+
+		_printHistogram( rtts );
+	}
+
+	/**
+	 * Returns whether any probe got a reply
+	 */
+	bool hasReplies () const
+	{
+		return ! m_rtt_micros.empty();
+	}
+
+private:
+
+	bool _isComplete () const
+	{
+		return m_sent_count == m_options.count
+			&& m_rtt_micros.size() + m_corrupt_count == m_sent_count;
+	}
+
+	void _sendProbe ()
+	{
+		const UInt16 task_id = ++m_sent_count;
+
+		Message msg;
+		msg.clear();
+		msg.setMessageType( CommonMessageTypes::MSGID_ECHO );
+		msg.setImmediate();
+		msg.setTaskId( task_id );
+		msg.setDataSize( m_options.size );
+		for ( unsigned i = TIMESTAMP_SIZE; i < m_options.size; i++ ) {
+			msg.setUInt8( i, _patternByte( task_id, i ) );
+		}
+
+		m_sent_micros[task_id] = getMicros();
+		msg.setUInt32( 0, _toTimestamp( m_sent_micros[task_id] ) );
+		m_io.write( msg );
+	}
+
+	void _onReply (const Message& msg)
+	{
+		if ( CommonMessageTypes::MSGID_ECHO != msg.getMessageType() ) {
+			return;
+		}
+
+		const double now_micros = getMicros();
+		const UInt16 task_id = msg.getTaskId();
+		if ( task_id < 1 || task_id > m_sent_count || m_sent_micros[task_id] < 0 ) {
+			return;
+		}
+
+		const UInt32 timestamp = _toTimestamp( m_sent_micros[task_id] );
+		m_sent_micros[task_id] = -1;
+
+		if ( ! _isIntact( msg, timestamp ) )
+		{
+			m_corrupt_count++;
+			return;
+		}
+
+		const double rtt_micros = now_micros - m_start_micros - msg.getUInt32( 0 );
+		if ( rtt_micros > m_options.timeout_millis * 1e3 )
+		{
+			m_late_count++;
+			return;
+		}
+
+		m_rtt_micros.push_back( rtt_micros );
+		if ( ! m_options.is_quiet )
+		{
+			printf( "%u bytes from %s: seq=%u rtt=%.3f ms\n",
+				msg.getDataSize(), m_options.p_port_name, task_id,
+				rtt_micros / 1e3 );
+		}
+	}
+
+	bool _isIntact (const Message& msg, UInt32 timestamp) const
+	{
+		if ( msg.getDataSize() != m_options.size ||
+			 msg.getUInt32( 0 ) != timestamp )
+		{
+			return false;
+		}
+
+		for ( unsigned i = TIMESTAMP_SIZE; i < m_options.size; i++ )
+		{
+			if ( msg.getUInt8( i ) != _patternByte( msg.getTaskId(), i ) ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	UInt32 _toTimestamp (double micros) const
+	{
+		return static_cast<UInt32>( micros - m_start_micros );
+	}
+
+	static UInt8 _patternByte (UInt16 task_id, unsigned index)
+	{
+		return static_cast<UInt8>( task_id * 31 + index * 7 );
+	}
+
+	static double _percentile (const std::vector<double>& sorted, double p)
+	{
+		return sorted[static_cast<size_t>( p * ( sorted.size() - 1 ) + 0.5 )];
+	}
+
+	/**
+	 * Prints the count of round trip times in buckets which double
+	 * in width
+	 */
+	static void _printHistogram (const std::vector<double>& sorted)
+	{
+		const int first = static_cast<int>( floor( log2( std::max( 1.0, sorted.front() ) ) ) );
+		const int last = static_cast<int>( floor( log2( std::max( 1.0, sorted.back() ) ) ) );
+
+		std::vector<unsigned> counts( last - first + 1, 0 );
+		for ( size_t i = 0; i < sorted.size(); i++ )
+		{
+			const int bucket = static_cast<int>( floor( log2( std::max( 1.0, sorted[i] ) ) ) );
+			counts[bucket - first]++;
+		}
+
+		const unsigned max_count = *std::max_element( counts.begin(), counts.end() );
+		printf( "\n%9s   %9s  %-*s %s\n", "from_us", "to_us",
+			static_cast<int>( HISTOGRAM_WIDTH ), "", "count" );
+		for ( size_t i = 0; i < counts.size(); i++ )
+		{
+			const unsigned width = counts[i] * HISTOGRAM_WIDTH / max_count;
+			printf(
+				"%9.0f - %9.0f |%s%*s %u\n",
+				ldexp( 1.0, first + i ),
+				ldexp( 1.0, first + i + 1 ),
+				std::string( width, '#' ).c_str(),
+				static_cast<int>( HISTOGRAM_WIDTH - width ), "",
+				counts[i]
+			);
+		}
+	}
+
+	/**
+	 * Reads until the answer with the given task ID arrives
+	 */
+	bool _awaitTask (UInt16 task_id, Message& msg)
+	{
+		for ( ;; )
+		{
+			while ( m_io.read( msg ) )
+			{
+				if ( msg.getTaskId() == task_id ) {
+					return true;
+				}
+			}
+
+			// Let the rest of a partial plain frame arrive
+			::usleep( 50 );
+			if ( ! m_port.awaitAvailable( m_options.timeout_millis ) ) {
+				return false;
+			}
+		}
+	}
+
+	SerialPort& m_port;
+	MessageIO m_io;
+	const Options& m_options;
+	double m_start_micros;
+	std::vector<double> m_sent_micros;
+	std::vector<double> m_rtt_micros;
+	unsigned m_sent_count;
+	unsigned m_late_count;
+	unsigned m_corrupt_count;
+};
+
+
+int main (int argc, char** argv)
+{
+	Options options;
+	if ( ! parseOptions( argc, argv, options ) )
+	{
+		fprintf( stderr,
+			"Usage: %s [-b baud] [-c count] [-r rate] [-s size] "
+			"[-t timeout_ms] [-d delay_ms] [-z] [-q] port\n", argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		SerialPort port( options.p_port_name, options.baud_rate );
+		if ( options.delay_millis > 0 ) {
+			::usleep( options.delay_millis * 1000 );
+		}
+
+		Pinger pinger( port, options );
+		if ( options.is_cobs && ! pinger.negotiate() )
+		{
+			fprintf( stderr, "No answer to the HelloRequest from %s\n",
+				options.p_port_name );
+			return EXIT_FAILURE;
+		}
+
+		printf( "PING %s: %u data bytes, %u probes/s\n",
+			options.p_port_name, options.size, options.rate );
+		pinger.run();
+		pinger.printSummary();
+
+		return pinger.hasReplies() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch ( const std::system_error& e )
+	{
+		fprintf( stderr, "%s\n", e.what() );
+		return EXIT_FAILURE;
+	}
+}
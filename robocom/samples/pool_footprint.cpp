@@ -0,0 +1,110 @@
+/*
+ * Compares the memory footprint and the capacity of MessagePool and
+ * CompactMessagePool.
+ *
+ * The host sizes differ from the ones on arduino, where pointers take
+ * two bytes and nothing is padded, so the arduino sizes are computed
+ * from the layout of the classes. The capacity is the number of
+ * messages of one kind that a pool can hold.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "robocom/shared/CompactMessagePool.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessagePool.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+#include "robocom/shared/msg/SimpleMessage.hxx"
+
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+
+
+enum
+{
+	// The bytes of a node besides the Message: the next pointer, and
+	// the enqueue millis when profiling
+	AVR_NODE_OVERHEAD = 2
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		+ 2
+#endif
+		,
+
+	// The bytes of a compact slot: the offset, the next index, and the
+	// enqueue millis when profiling
+	AVR_SLOT_OVERHEAD = 3
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		+ 2
+#endif
+};
+
+
+/**
+ * MessagePool holds the same number of messages of any kind
+ */
+int countMessagePool ()
+{
+	MessagePool pool;
+	int count = 0;
+	while ( 0 != pool.alloc() ) {
+		count++;
+	}
+	return count;
+}
+
+
+int countCompactMessagePool (const Message& msg)
+{
+	CompactMessagePool pool;
+	int count = 0;
+	while ( CompactMessagePool::NIL != pool.alloc( msg ) ) {
+		count++;
+	}
+	return count;
+}
+
+
+void printCapacity (const char* p_name, const Message& msg)
+{
+	printf(
+		"%-24s %6u %8d %8d\n",
+		p_name,
+		msg.getSerializedSize(),
+		countMessagePool(),
+		countCompactMessagePool( msg )
+	);
+}
+
+
+int main ()
+{
+	const unsigned avr_pool_size =
+		MessagePool::SLOT_COUNT * ( AVR_NODE_OVERHEAD + sizeof( Message ) ) + 4;
+	const unsigned avr_compact_size =
+		CompactMessagePool::ARENA_SIZE
+		+ CompactMessagePool::SLOT_COUNT * AVR_SLOT_OVERHEAD + 7;
+
+	printf( "%-24s %8s %8s\n", "pool", "host", "arduino" );
+	printf( "%-24s %8u %8u\n", "MessagePool", (unsigned) sizeof( MessagePool ), avr_pool_size );
+	printf( "%-24s %8u %8u\n", "CompactMessagePool", (unsigned) sizeof( CompactMessagePool ), avr_compact_size );
+	printf( "\n" );
+
+	Message max_immediate;
+	max_immediate.clear();
+	max_immediate.setImmediate();
+	max_immediate.setDataSize( Message::MAX_DATA_SIZE );
+
+	Message max_timed;
+	max_timed.clear();
+	max_timed.setMillis( 1000 );
+	max_timed.setDataSize( max_timed.getMaxDataSize() );
+
+	printf( "%-24s %6s %8s %8s\n", "message", "bytes", "pool", "compact" );
+	printCapacity( "reset", ResetRequest( 1 ).asMessage() );
+	printCapacity( "wheel drive", SetWheelDriveRequest( 1, 0, 100, 0, 100 ).asMessage() );
+	printCapacity( "timed wheel drive", SetWheelDriveRequest( 1, 1000u, 0, 100, 0, 100 ).asMessage() );
+	printCapacity( "largest immediate", max_immediate );
+	printCapacity( "largest timed", max_timed );
+
+	return EXIT_SUCCESS;
+}
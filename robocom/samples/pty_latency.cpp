@@ -0,0 +1,604 @@
+/*
+ * Measures the latency and throughput of the whole link between
+ * a client SerialPort and the host server over a pseudo-terminal pair.
+ *
+ * The server runs in a thread on the master side of the pty; the client
+ * opens the slave side as a serial port, so the termios setup of
+ * SerialPort is the real one. After the handshake (HelloRequest, codec
+ * switch, ResetRequest) the client sends SetWheelDriveRequest commands,
+ * each followed by a FlushRequest, and the server answers each with
+ * a WheelDriveChangedNotice. The server queues the commands, so a flush
+ * may overtake its command; the client then flushes again, as real
+ * clients do. The latency is the time from writing a command to reading
+ * its notice.
+ *
+ * Options:
+ *   --count N       number of commands to send (default 2000)
+ *   --window N      commands in flight at most (default 1)
+ *   --rate N        commands per second, 0 for as fast as possible
+ *                   (default 0)
+ *   --plain         keep the plain codec instead of switching to COBS
+ *   --max-p99-us N  fail if the 99th percentile latency is higher
+ *   --min-fps N     fail if fewer frames per second were exchanged
+ *
+ * The exit status is non-zero if a threshold was missed or the server
+ * stopped answering, so the sample can gate performance regressions.
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "robocom/client/LinkConfig.hpp"
+#include "robocom/client/SerialPort.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hpp"
+#include "robocom/shared/Server.hpp"
+#include "robocom/shared/StreamIO.hpp"
+#include "robocom/shared/msg/CapsResponse.hpp"
+#include "robocom/shared/msg/CodecRequest.hpp"
+#include "robocom/shared/msg/FlushResponse.hpp"
+#include "robocom/shared/msg/HelloRequest.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+#include "robocom/shared/msg/SimpleMessage.hxx"
+#include "robocom/shared/msg/WheelDriveChangedNotice.hpp"
+
+using namespace robocom::client;
+using namespace robocom::shared;
+using namespace robocom::shared::msg;
+
+
+enum
+{
+	/// Longest wait for any answer of the server
+	REPLY_TIMEOUT_MILLIS = 2000,
+
+	/// Task IDs of the handshake; the commands use 1 up to the count
+	HELLO_TASK_ID = 0xfff0,
+	CODEC_TASK_ID = 0xfff1,
+	RESET_TASK_ID = 0xfff2,
+	FLUSH_TASK_ID = 0xfff3,
+
+	MAX_COMMAND_COUNT = 0xff00
+};
+
+
+double getMicros ()
+{
+	::timespec ts;
+	::clock_gettime( CLOCK_MONOTONIC, & ts );
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+
+/**
+ * StreamIO over the master side of the pty
+ */
+class FdStream
+	: public StreamIO
+{
+public:
+
+	explicit FdStream (int fd)
+		: m_fd( fd )
+		, m_peeked_byte( -1 )
+	{ }
+
+	virtual int available ()
+	{
+		int count = 0;
+		::ioctl( m_fd, FIONREAD, & count );
+		return count + ( m_peeked_byte >= 0 ? 1 : 0 );
+	}
+
+	virtual int peek ()
+	{
+		if ( m_peeked_byte < 0 ) {
+			m_peeked_byte = read();
+		}
+		return m_peeked_byte;
+	}
+
+	virtual int read ()
+	{
+		char c;
+		return 1 == readBytes( & c, 1 ) ? static_cast<UInt8>( c ) : -1;
+	}
+
+	virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+	{
+		UInt32 n = 0;
+		if ( size > 0 && m_peeked_byte >= 0 )
+		{
+			p_buffer[n++] = static_cast<char>( m_peeked_byte );
+			m_peeked_byte = -1;
+		}
+
+		int count = 0;
+		::ioctl( m_fd, FIONREAD, & count );
+		if ( count > 0 && n < size )
+		{
+			const ssize_t result = ::read(
+				m_fd, p_buffer + n, std::min<UInt32>( size - n, count )
+			);
+			if ( result > 0 ) {
+				n += result;
+			}
+		}
+		return n;
+	}
+
+	virtual UInt32 write (UInt8 b)
+	{
+		return write( & b, 1 );
+	}
+
+	virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+	{
+		UInt32 n = 0;
+		while ( n < size )
+		{
+			const ssize_t result = ::write( m_fd, p_buffer + n, size - n );
+			if ( result < 0 ) {
+				break;
+			}
+			n += result;
+		}
+		return n;
+	}
+
+	/**
+	 * Blocks until some data are available or the given time passed
+	 */
+	void await (UInt32 timeout_millis)
+	{
+		if ( m_peeked_byte >= 0 ) {
+			return;
+		}
+
+		::fd_set rdset;
+		FD_ZERO( & rdset );
+		FD_SET( m_fd, & rdset );
+		::timeval timeout;
+		timeout.tv_sec = 0;
+		timeout.tv_usec = timeout_millis * 1000;
+		::select( m_fd + 1, & rdset, NULL, NULL, & timeout );
+	}
+
+private:
+
+	int m_fd;
+	int m_peeked_byte;
+};
+
+
+/**
+ * Server which answers every SetWheelDriveRequest with a notice
+ */
+class HarnessServer
+	: public Server
+{
+public:
+
+	explicit HarnessServer (FdStream& stream)
+		: Server( stream )
+		, m_stream( stream )
+		, m_is_stopped( false )
+	{ }
+
+	/**
+	 * Runs the loop until stop() is called
+	 */
+	void run ()
+	{
+		setup();
+		while ( ! m_is_stopped ) {
+			loop();
+		}
+	}
+
+	void stop ()
+	{
+		m_is_stopped = true;
+	}
+
+	// The process CPU time of the default clock also counts the client
+	virtual UInt32 getMillis () const throw ()
+	{
+		return static_cast<UInt32>( ::getMicros() / 1000 );
+	}
+
+	virtual UInt32 getMicros () const throw ()
+	{
+		return static_cast<UInt32>( ::getMicros() );
+	}
+
+protected:
+
+	virtual bool handleMessage (const Message& msg)
+	{
+		if ( SetWheelDriveRequest::MSGID != msg.getMessageType() ) {
+			return false;
+		}
+
+		const SetWheelDriveRequest req( msg );
+		addResponse(
+			WheelDriveChangedNotice(
+				req.getTaskId(),
+				getMillis(),
+				req.getMotor1Direction(),
+				req.getMotor1Signal(),
+				req.getMotor2Direction(),
+				req.getMotor2Signal()
+			).asMessage()
+		);
+		return true;
+	}
+
+	// Sleeps until the client writes, so that the client gets the CPU
+	virtual void handleIdle ()
+	{
+		m_stream.await( 1 );
+	}
+
+private:
+
+	FdStream& m_stream;
+	std::atomic<bool> m_is_stopped;
+};
+
+
+struct Options
+{
+	Options ()
+		: count( 2000 )
+		, window( 1 )
+		, rate( 0 )
+		, is_plain( false )
+		, max_p99_micros( 0 )
+		, min_fps( 0 )
+	{ }
+
+	unsigned count;
+	unsigned window;
+	unsigned rate;
+	bool is_plain;
+	double max_p99_micros;
+	double min_fps;
+};
+
+
+bool parseOptions (int argc, char** argv, Options& options)
+{
+	for ( int i = 1; i < argc; i++ )
+	{
+		const bool has_value = i + 1 < argc;
+		if ( 0 == strcmp( argv[i], "--plain" ) ) {
+			options.is_plain = true;
+		}
+		else if ( has_value && 0 == strcmp( argv[i], "--count" ) ) {
+			options.count = atoi( argv[++i] );
+		}
+		else if ( has_value && 0 == strcmp( argv[i], "--window" ) ) {
+			options.window = atoi( argv[++i] );
+		}
+		else if ( has_value && 0 == strcmp( argv[i], "--rate" ) ) {
+			options.rate = atoi( argv[++i] );
+		}
+		else if ( has_value && 0 == strcmp( argv[i], "--max-p99-us" ) ) {
+			options.max_p99_micros = atof( argv[++i] );
+		}
+		else if ( has_value && 0 == strcmp( argv[i], "--min-fps" ) ) {
+			options.min_fps = atof( argv[++i] );
+		}
+		else
+		{
+			fprintf( stderr, "Unknown option %s\n", argv[i] );
+			return false;
+		}
+	}
+
+	if ( options.count < 1 || options.count > MAX_COMMAND_COUNT ||
+		 options.window < 1 )
+	{
+		fprintf( stderr, "The count or the window is out of range\n" );
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * The client side of the harness
+ */
+class Client
+{
+public:
+
+	Client (SerialPort& port)
+		: m_port( port )
+		, m_io( port )
+		, m_frame_count( 0 )
+		, m_elapsed_micros( 0 )
+		, m_pending_flush_count( 0 )
+	{ }
+
+	/**
+	 * Negotiates the link options and resets the server
+	 *
+	 * @return false if the server did not answer
+	 */
+	bool connect (bool is_plain)
+	{
+		Message msg;
+
+		_write( HelloRequest( HELLO_TASK_ID, CapsResponse::PROTOCOL_VERSION,
+			MessageIO::getFeatures() ).asMessage() );
+		if ( ! _awaitTask( HELLO_TASK_ID, msg ) ) {
+			return false;
+		}
+
+		LinkConfig config = LinkConfig::choose( CapsResponse( msg ) );
+		if ( ! is_plain && config.getCodec() != m_io.getCodec() )
+		{
+			_write( CodecRequest( CODEC_TASK_ID, config.getCodec() ).asMessage() );
+			if ( ! _awaitTask( CODEC_TASK_ID, msg ) ) {
+				return false;
+			}
+			m_io.setCodec( CodecResponse( msg ).getCodec() );
+		}
+		config.apply( m_io );
+
+		_write( ResetRequest( RESET_TASK_ID ).asMessage() );
+		return _awaitTask( RESET_TASK_ID, msg );
+	}
+
+	/**
+	 * Sends the commands and collects the latency of each
+	 *
+	 * @return false if the server stopped answering
+	 */
+	bool run (const Options& options, std::vector<double>& latencies)
+	{
+		std::vector<double> sent_micros( options.count + 1 );
+		latencies.clear();
+
+		const double period_micros = options.rate > 0 ? 1e6 / options.rate : 0;
+		const double start_micros = getMicros();
+		unsigned sent_count = 0;
+		Message msg;
+
+		while ( latencies.size() < options.count )
+		{
+			// Send as far as the window, the pacing and the credits allow
+			while ( sent_count < options.count &&
+					sent_count - latencies.size() < options.window &&
+					getMicros() >= start_micros + sent_count * period_micros )
+			{
+				const UInt16 task_id = sent_count + 1;
+				sent_micros[task_id] = getMicros();
+				if ( ! m_io.tryWrite( SetWheelDriveRequest(
+						task_id, 0, task_id & 0xff, 1, task_id >> 8 ).asMessage() ) )
+				{
+					break;
+				}
+				m_frame_count++;
+				sent_count++;
+				_flush();
+			}
+
+			// Wait for the next answer, or the next command to be due
+			UInt32 timeout_millis = REPLY_TIMEOUT_MILLIS;
+			if ( sent_count < options.count &&
+				 sent_count - latencies.size() < options.window )
+			{
+				const double due_micros = start_micros + sent_count * period_micros;
+				timeout_millis = std::max( 0.0, due_micros - getMicros() ) / 1000;
+			}
+
+			if ( ! m_port.awaitAvailable( timeout_millis ) )
+			{
+				if ( REPLY_TIMEOUT_MILLIS == timeout_millis ) {
+					return false;
+				}
+				continue;
+			}
+
+			bool has_message = false;
+			while ( m_io.read( msg ) )
+			{
+				has_message = true;
+				m_frame_count++;
+				if ( WheelDriveChangedNotice::MSGID == msg.getMessageType() &&
+					 msg.getTaskId() >= 1 && msg.getTaskId() <= sent_count )
+				{
+					latencies.push_back( getMicros() - sent_micros[msg.getTaskId()] );
+				}
+				else if ( FlushResponse::MSGID == msg.getMessageType() &&
+						  FLUSH_TASK_ID == msg.getTaskId() )
+				{
+					m_pending_flush_count--;
+				}
+			}
+
+			// The plain codec leaves a partial frame in the port, which
+			// keeps awaitAvailable() from blocking until the rest arrives
+			if ( ! has_message ) {
+				::usleep( 50 );
+			}
+
+			// Flush again for the notices the last flush did not find
+			if ( 0 == m_pending_flush_count && latencies.size() < sent_count ) {
+				_flush();
+			}
+		}
+
+		m_elapsed_micros = getMicros() - start_micros;
+		return true;
+	}
+
+	/**
+	 * Returns the number of frames written and read during run()
+	 */
+	UInt32 getFrameCount () const
+	{
+		return m_frame_count;
+	}
+
+	/**
+	 * Returns the duration of run()
+	 */
+	double getElapsedMicros () const
+	{
+		return m_elapsed_micros;
+	}
+
+private:
+
+	void _write (const Message& msg)
+	{
+		m_io.write( msg );
+		m_frame_count++;
+	}
+
+	void _flush ()
+	{
+		_write( FlushRequest( FLUSH_TASK_ID ).asMessage() );
+		m_pending_flush_count++;
+	}
+
+	/**
+	 * Reads until the answer with the given task ID arrives
+	 */
+	bool _awaitTask (UInt16 task_id, Message& msg)
+	{
+		for ( ;; )
+		{
+			while ( m_io.read( msg ) )
+			{
+				if ( msg.getTaskId() == task_id ) {
+					return true;
+				}
+			}
+
+			// Let the rest of a partial plain frame arrive
+			::usleep( 50 );
+			if ( ! m_port.awaitAvailable( REPLY_TIMEOUT_MILLIS ) ) {
+				return false;
+			}
+		}
+	}
+
+	SerialPort& m_port;
+	MessageIO m_io;
+	UInt32 m_frame_count;
+	double m_elapsed_micros;
+	unsigned m_pending_flush_count;
+};
+
+
+double percentile (const std::vector<double>& sorted, double p)
+{
+	const size_t index = static_cast<size_t>( p * ( sorted.size() - 1 ) + 0.5 );
+	return sorted[index];
+}
+
+
+int main (int argc, char** argv)
+{
+	Options options;
+	if ( ! parseOptions( argc, argv, options ) ) {
+		return EXIT_FAILURE;
+	}
+
+	const int master_fd = ::posix_openpt( O_RDWR | O_NOCTTY );
+	if ( master_fd < 0 || ::grantpt( master_fd ) < 0 || ::unlockpt( master_fd ) < 0 )
+	{
+		perror( "Error opening the pseudo-terminal" );
+		return EXIT_FAILURE;
+	}
+
+	FdStream stream( master_fd );
+	HarnessServer server( stream );
+	std::vector<double> latencies;
+	UInt32 frame_count = 0;
+	double elapsed_micros = 0;
+	bool is_ok = false;
+
+	try
+	{
+		SerialPort port( ::ptsname( master_fd ), BAUD_RATE_115200 );
+		std::thread server_thread( & HarnessServer::run, & server );
+
+		try
+		{
+			Client client( port );
+			is_ok = client.connect( options.is_plain ) && client.run( options, latencies );
+			frame_count = client.getFrameCount();
+			elapsed_micros = client.getElapsedMicros();
+		}
+		catch ( const std::system_error& e ) {
+			fprintf( stderr, "%s\n", e.what() );
+		}
+
+		server.stop();
+		server_thread.join();
+	}
+	catch ( const std::system_error& e ) {
+		fprintf( stderr, "%s\n", e.what() );
+	}
+	::close( master_fd );
+
+	if ( ! is_ok )
+	{
+		fprintf( stderr, "The server stopped answering after %u notices\n",
+			static_cast<unsigned>( latencies.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	std::sort( latencies.begin(), latencies.end() );
+	const double fps = frame_count * 1e6 / elapsed_micros;
+	const double p99_micros = percentile( latencies, 0.99 );
+
+	printf(
+		"%-6s %6s %6s %8s %8s %8s %8s %10s %10s\n",
+		"codec", "window", "rate", "p50_us", "p90_us", "p99_us", "max_us",
+		"cmds/s", "frames/s"
+	);
+	printf(
+		"%-6s %6u %6u %8.0f %8.0f %8.0f %8.0f %10.0f %10.0f\n",
+		options.is_plain ? "plain" : "cobs",
+		options.window,
+		options.rate,
+		percentile( latencies, 0.5 ),
+		percentile( latencies, 0.9 ),
+		p99_micros,
+		latencies.back(),
+		latencies.size() * 1e6 / elapsed_micros,
+		fps
+	);
+
+	if ( options.max_p99_micros > 0 && p99_micros > options.max_p99_micros )
+	{
+		fprintf( stderr, "p99 latency %.0f us is above %.0f us\n",
+			p99_micros, options.max_p99_micros );
+		is_ok = false;
+	}
+	if ( options.min_fps > 0 && fps < options.min_fps )
+	{
+		fprintf( stderr, "%.0f frames/s is below %.0f\n", fps, options.min_fps );
+		is_ok = false;
+	}
+
+	return is_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
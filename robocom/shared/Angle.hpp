@@ -0,0 +1,115 @@
+#ifndef ROBOCOM_SHARED_ANGLE_HPP
+#define ROBOCOM_SHARED_ANGLE_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class implements fixed-point angle arithmetic
+	 *
+	 * Arduino has no FPU and the soft-float atan2() costs thousands of
+	 * cycles. The functions of this class work on integers only and
+	 * represent angles in binary units where HALF_TURN (32768) equals
+	 * pi radians. One unit is thus about 0.0055 degrees.
+	 *
+	 * Angles are held in signed 32-bit integers, so that angles beyond
+	 * one full turn and differences of angles can be represented without
+	 * overflow.
+	 */
+	class Angle
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		enum
+		{
+			/// The angle of pi/2 radians
+			QUARTER_TURN = 16384,
+
+			/// The angle of pi radians
+			HALF_TURN = 32768,
+
+			/// The angle of 2*pi radians
+			FULL_TURN = 65536
+		};
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Computes the arc tangent of y/x
+		 *
+		 * The arguments can be in any scale, as long as both use the
+		 * same one. The maximum error against the floating point atan2()
+		 * is about two units.
+		 *
+		 * @param y the y coordinate
+		 * @param x the x coordinate
+		 *
+		 * @return the angle in the range (-HALF_TURN, HALF_TURN], or 0
+		 *   if both coordinates are 0
+		 */
+		static SInt32 atan2 (SInt32 y, SInt32 x) throw ();
+
+		/**
+		 * Computes the yaw from a quaternion produced by the MPU6050 DMP
+		 *
+		 * The result matches the yaw computed by
+		 * MPU6050::dmpGetYawPitchRoll() from the same quaternion.
+		 *
+		 * @param w the w component; 16384 represents 1.0
+		 * @param x the x component; 16384 represents 1.0
+		 * @param y the y component; 16384 represents 1.0
+		 * @param z the z component; 16384 represents 1.0
+		 *
+		 * @return the yaw in the range (-HALF_TURN, HALF_TURN]
+		 */
+		static SInt32 yawFromQuaternion (
+			SInt16 w,
+			SInt16 x,
+			SInt16 y,
+			SInt16 z
+		) throw ();
+
+		/**
+		 * Converts an angle in whole degrees to binary units
+		 */
+		static SInt32 fromDegrees (SInt32 degrees) throw ()
+		{
+			return degrees * ( FULL_TURN / 8 ) / 45;
+		}
+
+		/**
+		 * Converts an angle in binary units to degrees
+		 */
+		static float toDegrees (SInt32 angle) throw ()
+		{
+			return angle * ( 180.0f / HALF_TURN );
+		}
+
+		/**
+		 * Converts an angle in binary units to radians
+		 */
+		static float toRadians (SInt32 angle) throw ()
+		{
+			return angle * ( 3.14159265f / HALF_TURN );
+		}
+
+		///@}
+
+	private:
+
+		static SInt32 _atanUnit (UInt16 t) throw ();
+	};
+
+} }
+
+#endif
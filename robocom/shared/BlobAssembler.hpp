@@ -0,0 +1,134 @@
+#ifndef ROBOCOM_SHARED_BLOB_ASSEMBLER_HPP
+#define ROBOCOM_SHARED_BLOB_ASSEMBLER_HPP
+
+#include "shared_base.hpp"
+
+// Component includes
+#include "msg/msg_fwds.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class reassembles a blob from its fragments
+	 * (see msg::BlobFragment)
+	 *
+	 * The blob is collected in a buffer given by the owner, so that its
+	 * size stays fixed on arduino. The fragments must come in order;
+	 * a fragment that does not continue the blob, or does not fit in
+	 * the buffer, drops it, and the fragments of the same task that
+	 * follow are ignored until a fragment at offset 0 starts a new blob.
+	 */
+	class BlobAssembler
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an assembler which collects the blobs in the given
+		 * buffer
+		 *
+		 * @param p_buffer the buffer, which must outlive this object
+		 * @param capacity the size of the buffer
+		 */
+		BlobAssembler (UInt8* p_buffer, UInt16 capacity) throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the size of the largest blob that can be assembled
+		 */
+		UInt16 getCapacity () const throw ()
+		{
+			return m_capacity;
+		}
+
+		/**
+		 * Returns the task ID of the last blob
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_task_id;
+		}
+
+		/**
+		 * Returns the number of bytes of the last blob collected
+		 * so far
+		 */
+		UInt16 getSize () const throw ()
+		{
+			return m_size;
+		}
+
+		/**
+		 * Returns the bytes of the last blob
+		 */
+		const UInt8* getData () const throw ()
+		{
+			return m_p_buffer;
+		}
+
+		/**
+		 * Returns STATUS_OK, or the reason why the last blob was
+		 * dropped
+		 */
+		msg::MessageStatus getStatus () const throw ()
+		{
+			return m_status;
+		}
+
+		/**
+		 * Returns whether the final fragment of the last blob arrived
+		 */
+		bool isComplete () const throw ()
+		{
+			return m_is_complete;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards the last blob
+		 */
+		void clear () throw ();
+
+		/**
+		 * Adds the given fragment to the blob
+		 *
+		 * @return true if the blob ended with this fragment, because
+		 *   it was complete (see isComplete()) or because it was dropped
+		 *   (see getStatus())
+		 */
+		bool add (const msg::BlobFragment& fragment) throw ();
+
+		///@}
+
+	private:
+
+		BlobAssembler (const BlobAssembler&);
+		void operator= (const BlobAssembler&);
+
+		bool _drop (msg::MessageStatus status) throw ();
+
+		UInt8* m_p_buffer;
+		UInt16 m_capacity;
+		UInt16 m_task_id;
+		UInt16 m_size;
+		msg::MessageStatus m_status;
+		bool m_is_complete;
+	};
+
+} }
+
+#endif // ROBOCOM_SHARED_BLOB_ASSEMBLER_HPP
@@ -0,0 +1,166 @@
+#ifndef ROBOCOM_SHARED_BUFFER_STREAM_HPP
+#define ROBOCOM_SHARED_BUFFER_STREAM_HPP
+
+#if defined(AVR)
+#include <string.h>
+#else
+#include <cstring>
+#endif
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class implements a stream over a buffer in memory
+	 *
+	 * The bytes written to the stream are read back from it in the same
+	 * order, so a BasicMessageIO over it reads the frames it wrote. The
+	 * functions are the ones of StreamIO, but not virtual, so that
+	 * a BasicMessageIO<BufferStream> can inline them.
+	 *
+	 * The buffer is used from the start again whenever everything
+	 * written has been read. Writes which do not fit are cut short.
+	 */
+	class BufferStream
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a new instance
+		 *
+		 * @param p_buffer the buffer for the bytes; it must outlive
+		 *  this object
+		 * @param capacity the size of the buffer
+		 */
+		BufferStream (UInt8* p_buffer, UInt32 capacity) throw ()
+			: m_p_buffer( p_buffer )
+			, m_capacity( capacity )
+			, m_read( 0 )
+			, m_write( 0 )
+		{ }
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Returns the number of bytes written and not read yet
+		 */
+		int available () const throw ()
+		{
+			return static_cast<int>( m_write - m_read );
+		}
+
+		/**
+		 * Returns the next byte without consuming it, or -1 if there
+		 * is none
+		 */
+		int peek () const throw ()
+		{
+			return m_read < m_write ? m_p_buffer[m_read] : -1;
+		}
+
+		/**
+		 * Consumes and returns the next byte, or -1 if there is none
+		 */
+		int read () throw ()
+		{
+			if ( m_read == m_write ) {
+				return -1;
+			}
+
+			const int b = m_p_buffer[m_read++];
+			_rewindIfEmpty();
+			return b;
+		}
+
+		/**
+		 * Consumes up to the given number of bytes
+		 *
+		 * @return the number of bytes placed in the buffer
+		 */
+		UInt32 readBytes (char* p_buffer, UInt32 size) throw ()
+		{
+			if ( size > m_write - m_read ) {
+				size = m_write - m_read;
+			}
+
+			::memcpy( p_buffer, m_p_buffer + m_read, size );
+			m_read += size;
+			_rewindIfEmpty();
+			return size;
+		}
+
+		/**
+		 * Appends one byte
+		 *
+		 * @return the number of bytes written, zero if the buffer is full
+		 */
+		UInt32 write (UInt8 b) throw ()
+		{
+			if ( m_write == m_capacity ) {
+				return 0;
+			}
+
+			m_p_buffer[m_write++] = b;
+			return 1;
+		}
+
+		/**
+		 * Appends as many of the given bytes as fit
+		 *
+		 * @return the number of bytes written
+		 */
+		UInt32 write (const UInt8* p_buffer, UInt32 size) throw ()
+		{
+			if ( size > m_capacity - m_write ) {
+				size = m_capacity - m_write;
+			}
+
+			::memcpy( m_p_buffer + m_write, p_buffer, size );
+			m_write += size;
+			return size;
+		}
+
+		/**
+		 * Discards the bytes which were not read yet
+		 */
+		void clear () throw ()
+		{
+			m_read = 0;
+			m_write = 0;
+		}
+
+		///@}
+
+	private:
+
+		BufferStream (const BufferStream&);
+		void operator= (const BufferStream&);
+
+		void _rewindIfEmpty () throw ()
+		{
+			if ( m_read == m_write )
+			{
+				m_read = 0;
+				m_write = 0;
+			}
+		}
+
+		UInt8* m_p_buffer;
+		UInt32 m_capacity;
+		UInt32 m_read;
+		UInt32 m_write;
+	};
+
+} }
+
+#endif // ROBOCOM_SHARED_BUFFER_STREAM_HPP
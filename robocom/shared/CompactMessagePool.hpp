@@ -0,0 +1,244 @@
+#ifndef ROBOCOM_SHARED_COMPACT_MESSAGE_POOL_HPP
+#define ROBOCOM_SHARED_COMPACT_MESSAGE_POOL_HPP
+
+#include "shared_base.hpp"
+
+#include "Message.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class implements a pool of messages stored in their
+	 * serialized form
+	 *
+	 * MessagePool reserves the full size of a Message for every slot,
+	 * although most messages carry only a few bytes of payload. This
+	 * pool keeps the messages in a byte arena instead, each one taking
+	 * only the size of its serialized form plus one byte. The slots are
+	 * identified by one byte indices, which also link them into lists,
+	 * so a slot costs three bytes besides the message itself.
+	 *
+	 * Released messages leave holes in the arena. When a new message
+	 * does not fit at the end of the arena but the holes would make
+	 * room for it, the stored messages are moved down to close the
+	 * holes. The indices of the slots do not change when that happens.
+	 *
+	 * With about the same RAM as MessagePool, this pool holds twice as
+	 * many messages as long as they average no more than 7 bytes in the
+	 * serialized form, which is the case of immediate messages with up
+	 * to 3 bytes of payload. Larger messages are limited by the arena;
+	 * getFreeBytes() tells how much of it is left.
+	 */
+	class CompactMessagePool
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		enum
+		{
+			/**
+			 * The maximum number of messages that one pool can
+			 * accomodate
+			 */
+			SLOT_COUNT = 64,
+
+			/**
+			 * The size of the arena which stores the messages
+			 */
+			ARENA_SIZE = 512,
+
+			/**
+			 * The index which does not refer to any slot, ending
+			 * the lists
+			 */
+			NIL = 0xFF
+		};
+
+		///@}
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a new pool of messages
+		 */
+		CompactMessagePool () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the number of free slots
+		 */
+		UInt8 getFree () const throw ()
+		{
+			return m_free_count;
+		}
+
+		/**
+		 * Returns the minimum number of free slots since creation of
+		 * this object.
+		 */
+		UInt8 getMinFree () const throw ()
+		{
+			return m_min_free_count;
+		}
+
+		/**
+		 * Returns the number of arena bytes not taken by the stored
+		 * messages
+		 */
+		UInt16 getFreeBytes () const throw ()
+		{
+			return ARENA_SIZE - m_used_size;
+		}
+
+		/**
+		 * Returns the slot that follows the given one in its list
+		 */
+		UInt8 getNext (UInt8 index) const throw ()
+		{
+			return m_next[index];
+		}
+
+		/**
+		 * Returns whether the message in the given slot is marked for
+		 * immediate execution
+		 */
+		bool isImmediate (UInt8 index) const throw ()
+		{
+			return 0 != ( _getEntry( index )[2] & Message::IMMEDIATE_BIT );
+		}
+
+		/**
+		 * Returns the execution millis of the message in the given slot
+		 */
+		UInt32 getMillis (UInt8 index) const throw ()
+		{
+			return isImmediate( index ) ? 0 : ntoh_UInt32( _getEntry( index ) + 5 );
+		}
+
+		/**
+		 * Returns the task ID of the message in the given slot
+		 */
+		UInt16 getTaskId (UInt8 index) const throw ()
+		{
+			return ntoh_UInt16( _getEntry( index ) + 3 );
+		}
+
+		/**
+		 * Compares the message in the given slot to another one, like
+		 * Message::comparePriority() does
+		 */
+		int comparePriority (UInt8 index, const Message& other) const throw ();
+
+		/**
+		 * Copies the message in the given slot
+		 *
+		 * @param index the slot
+		 * @param msg on output stores the message
+		 */
+		void load (UInt8 index, Message& msg) const throw ();
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Returns the lower 16 bits of the millis at which the message
+		 * in the given slot was added to a queue
+		 */
+		UInt16 getEnqueueMillis (UInt8 index) const throw ()
+		{
+			return m_enqueue_millis[index];
+		}
+#endif
+
+		///@}
+
+
+		/// @name Mutators
+		///@{
+
+		/**
+		 * Sets the slot that follows the given one in its list
+		 */
+		void setNext (UInt8 index, UInt8 next) throw ()
+		{
+			m_next[index] = next;
+		}
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Sets the millis at which the message in the given slot was
+		 * added to a queue
+		 */
+		void setEnqueueMillis (UInt8 index, UInt32 millis) throw ()
+		{
+			m_enqueue_millis[index] = static_cast<UInt16>( millis );
+		}
+#endif
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Allocates a slot and stores a copy of the given message in it
+		 *
+		 * @param msg the message to store
+		 *
+		 * @return the index of the slot, or NIL if there is no free
+		 *   slot or not enough free arena bytes left
+		 */
+		UInt8 alloc (const Message& msg) throw ();
+
+		/**
+		 * Releases one slot
+		 *
+		 * @param index the slot to release
+		 */
+		void free (UInt8 index) throw ();
+
+		///@}
+
+	private:
+
+		/**
+		 * Returns the entry of the given slot in the arena
+		 *
+		 * An entry holds the index of its slot, or NIL for a hole,
+		 * followed by the serialized message, which starts with its
+		 * size.
+		 */
+		const UInt8* _getEntry (UInt8 index) const throw ()
+		{
+			return m_arena + m_offsets[index];
+		}
+
+		void _compact () throw ();
+
+		UInt8 m_arena[ARENA_SIZE];
+		UInt16 m_offsets[SLOT_COUNT];
+		UInt8 m_next[SLOT_COUNT];
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		UInt16 m_enqueue_millis[SLOT_COUNT];
+#endif
+		UInt16 m_end;
+		UInt16 m_used_size;
+		UInt8 m_free;
+		UInt8 m_free_count;
+		UInt8 m_min_free_count;
+	};
+
+} }
+
+#endif
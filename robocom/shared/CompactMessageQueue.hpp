@@ -0,0 +1,170 @@
+#ifndef ROBOCOM_SHARED_COMPACT_MESSAGE_QUEUE_HPP
+#define ROBOCOM_SHARED_COMPACT_MESSAGE_QUEUE_HPP
+
+#include "shared_base.hpp"
+
+#include "MessageQueue.hpp"
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+#include "QueueProfile.hpp"
+#endif
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class implements a queue of messages kept in
+	 * a CompactMessagePool
+	 *
+	 * It behaves like MessageQueue, which it can replace when the
+	 * messages are allocated from a CompactMessagePool instead of
+	 * a MessagePool.
+	 */
+	class CompactMessageQueue
+	{
+	public:
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a new Message queue that will use the specified
+		 * pool for message allocation
+		 */
+		CompactMessageQueue (CompactMessagePool& pool) throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the number of messages in this object
+		 */
+		UInt8 getSize () const throw ()
+		{
+			return m_size;
+		}
+
+		/**
+		 * Returns the maximum size of this object since its creation
+		 */
+		UInt8 getMaxSize () const throw ()
+		{
+			return m_max_size;
+		}
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Returns the residency time and depth statistics of this queue
+		 *
+		 * Only available when built with ROBOCOM_QUEUE_PROFILE defined.
+		 */
+		QueueProfile& getProfile () throw ()
+		{
+			return m_profile;
+		}
+
+		/**
+		 * Returns the residency time and depth statistics of this queue
+		 */
+		const QueueProfile& getProfile () const throw ()
+		{
+			return m_profile;
+		}
+#endif
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all messages from this queue
+		 */
+		void clear () throw ();
+
+		/**
+		 * Adds the given message to this queue
+		 *
+		 * @param msg the message to add
+		 * @param current_millis the current millis value, used to measure
+		 *   how long the message stays in the queue
+		 *
+		 * @return true if the message was added, false if there is no more
+		 *   free space in the message pool and the message was not added
+		 */
+		bool push (const Message& msg, UInt32 current_millis = 0) throw ();
+
+		/**
+		 * Gets the message from the head of this queue and removes it
+		 *
+		 * Messages marked for immediate execution are retrieved before the
+		 * others, then messages not marked for immediate execution are
+		 * prioritized by their millis value.
+		 *
+		 * @param msg on output stores the retrieved message
+		 * @param current_millis the current millis value
+		 *
+		 * @return true if the message was retrieved, false if the message
+		 *   was not removed because the queue was empty
+		 */
+		bool pop (Message& msg, UInt32 current_millis) throw ();
+
+		/**
+		 * Passes the message at the head of this queue to the visitor
+		 * and removes it
+		 *
+		 * The message has to be deserialized from the arena anyway, so
+		 * unlike MessageQueue::popAndVisit() this saves no copy; it is
+		 * there so that the two queues can be used the same way.
+		 *
+		 * @param visitor the object to handle the message
+		 * @param current_millis the current millis value
+		 *
+		 * @return true if a message was visited, false if the queue was
+		 *   empty or its head message is not due yet
+		 */
+		bool popAndVisit (MessageQueue::Visitor& visitor, UInt32 current_millis);
+
+		/**
+		 * Discards all messages of the given task from this queue
+		 *
+		 * @param task_id the ID of the task whose messages to discard
+		 *
+		 * @return the number of discarded messages
+		 */
+		UInt8 remove (UInt16 task_id) throw ();
+
+		/**
+		 * Records the current size of this queue in the depth histogram
+		 * of its profile
+		 *
+		 * Does nothing unless built with ROBOCOM_QUEUE_PROFILE defined.
+		 */
+		void sampleDepth () throw ()
+		{
+#if defined(ROBOCOM_QUEUE_PROFILE)
+			m_profile.recordDepth( m_size );
+#endif
+		}
+
+		///@}
+
+	private:
+
+		CompactMessagePool* m_p_pool;
+		UInt8 m_head;
+		UInt8 m_size;
+		UInt8 m_max_size;
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		QueueProfile m_profile;
+#endif
+	};
+
+} }
+
+#endif
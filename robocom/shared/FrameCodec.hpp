@@ -0,0 +1,107 @@
+#ifndef ROBOCOM_SHARED_FRAME_CODEC_HPP
+#define ROBOCOM_SHARED_FRAME_CODEC_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class implements the encodings used by MessageIO for the
+	 * frames on the wire
+	 *
+	 * COBS (Consistent Overhead Byte Stuffing) removes all zero bytes
+	 * from a frame, so that a zero byte can delimit the frames: a reader
+	 * which lost track after an error starts over at the next zero.
+	 * Each run of up to 254 non-zero bytes is preceded by a code byte
+	 * giving the distance to the next zero, which costs one byte for
+	 * the short frames of this protocol.
+	 *
+	 * The CRC-16 is the CCITT variant (polynomial 0x1021, initial value
+	 * 0xFFFF), computed with a table of 16 entries, one for each value
+	 * of a half byte. The CRC-8 uses the polynomial 0x07.
+	 */
+	class FrameCodec
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		enum
+		{
+			/// The initial value of the CRC-16
+			CRC16_INIT = 0xFFFF,
+
+			/// The maximum size of a frame that can be encoded
+			MAX_DECODED_SIZE = 254
+		};
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Returns the size of the COBS encoding of the given number
+		 * of bytes, without the delimiter
+		 */
+		static UInt8 getEncodedSize (UInt8 size) throw ()
+		{
+			return size + 1;
+		}
+
+		/**
+		 * Encodes the given bytes with COBS
+		 *
+		 * @param p_src the bytes to encode
+		 * @param size the number of bytes to encode
+		 * @param p_dst the buffer for getEncodedSize( size ) bytes
+		 *
+		 * @return the number of bytes written to p_dst
+		 *
+		 * @pre size <= MAX_DECODED_SIZE
+		 */
+		static UInt8 encodeCobs (
+			const UInt8* p_src,
+			UInt8 size,
+			UInt8* p_dst
+		) throw ();
+
+		/**
+		 * Decodes the given COBS encoded bytes in place
+		 *
+		 * @param p_buffer the bytes to decode, without the delimiter
+		 * @param size the number of bytes to decode
+		 *
+		 * @return the number of decoded bytes, or zero if the data
+		 *   is not a valid encoding
+		 */
+		static UInt8 decodeCobs (UInt8* p_buffer, UInt8 size) throw ();
+
+		/**
+		 * Updates the CRC-16 with the given bytes
+		 */
+		static UInt16 updateCrc16 (
+			UInt16 crc,
+			const UInt8* p_buffer,
+			UInt8 size
+		) throw ();
+
+		/**
+		 * Updates the CRC-8 with the given bytes
+		 */
+		static UInt8 updateCrc8 (
+			UInt8 crc,
+			const UInt8* p_buffer,
+			UInt8 size
+		) throw ();
+
+		///@}
+	};
+
+} }
+
+#endif // ROBOCOM_SHARED_FRAME_CODEC_HPP
@@ -0,0 +1,199 @@
+#ifndef ROBOCOM_SHARED_LOGO_INTERPRETER_HPP
+#define ROBOCOM_SHARED_LOGO_INTERPRETER_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class executes LOGO programs compiled into a compact bytecode
+	 *
+	 * A program is a sequence of instructions, each made of a one-byte
+	 * opcode followed by its operands. Multi-byte operands are stored
+	 * in the same byte order as message data. The motion instructions
+	 * take the same parameters as the LOGO requests:
+	 * - OP_FORWARD, OP_BACK: the distance in encoder ticks, UInt16
+	 * - OP_RIGHT, OP_LEFT: the angle in degrees, UInt16
+	 * - OP_PEN_UP, OP_PEN_DOWN: no operands
+	 * - OP_WAIT: the delay in millis, UInt16
+	 * - OP_REPEAT: the repeat count, UInt8; the instructions up to the
+	 *   matching OP_END are executed that many times
+	 * - OP_END: no operands
+	 *
+	 * The interpreter does not move the robot itself. Each call to next()
+	 * runs the control flow up to the next motion instruction and returns
+	 * it as an Action for the caller to carry out. This keeps the
+	 * interpreter independent of the hardware.
+	 *
+	 * The robot measures a turn by the change of its yaw, which cannot
+	 * tell a turn by 360 degrees from no turn at all. Turns are therefore
+	 * returned in steps of at most MAX_TURN_STEP degrees.
+	 *
+	 * The program is kept in a fixed buffer, so that it can be uploaded
+	 * in chunks that fit into messages.
+	 */
+	class LogoInterpreter
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		/// Instruction opcodes
+		enum Opcode
+		{
+			OP_FORWARD = 1,
+			OP_BACK,
+			OP_RIGHT,
+			OP_LEFT,
+			OP_PEN_UP,
+			OP_PEN_DOWN,
+			OP_WAIT,
+			OP_REPEAT,
+			OP_END
+		};
+
+		enum
+		{
+			/// The maximum size of a program in bytes
+			MAX_PROGRAM_SIZE = 128,
+
+			/// The maximum nesting of REPEAT blocks
+			MAX_LOOP_DEPTH = 4,
+
+			/// The largest turn returned as a single action, in degrees,
+			/// the same as for msg::LogoTurnRequest
+			MAX_TURN_STEP = 180
+		};
+
+		/// The kinds of actions produced by the program
+		enum ActionType
+		{
+			/// Move by the given distance; direction 0 is forward
+			ACTION_MOVE,
+
+			/// Turn by the given angle; direction 0 is right
+			ACTION_TURN,
+
+			/// Move the pen; direction 0 is up
+			ACTION_PEN,
+
+			/// Do nothing for the given number of millis
+			ACTION_WAIT
+		};
+
+		///@}
+
+
+		/**
+		 * A single step of the program for the caller to carry out
+		 */
+		class Action
+		{
+		public:
+			UInt8 type;
+			UInt8 direction;
+			UInt16 amount;
+		};
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an interpreter with an empty program
+		 */
+		LogoInterpreter () throw ();
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards the program
+		 */
+		void clear () throw ();
+
+		/**
+		 * Stores a chunk of the program
+		 *
+		 * The program size grows to cover the chunk.
+		 *
+		 * @param offset the position of the chunk in the program
+		 * @param p_code the bytes of the chunk
+		 * @param size the number of bytes in the chunk
+		 *
+		 * @return false if the chunk does not fit in the program buffer
+		 */
+		bool write (UInt16 offset, const UInt8* p_code, UInt16 size) throw ();
+
+		/**
+		 * Returns the size of the program in bytes
+		 */
+		UInt16 getSize () const throw ()
+		{
+			return m_size;
+		}
+
+		/**
+		 * Checks that the program is well formed
+		 *
+		 * All opcodes must be known, all operands must be present, REPEAT
+		 * and END instructions must be balanced and not nested deeper than
+		 * MAX_LOOP_DEPTH. The body of every loop must contain an action,
+		 * not counting loops that repeat zero times, so that next() always
+		 * returns after a bounded number of steps.
+		 *
+		 * @return true if the program is well formed
+		 */
+		bool verify () const throw ();
+
+		/**
+		 * Prepares to run the program from the beginning
+		 *
+		 * @return false if the program is not well formed
+		 */
+		bool start () throw ();
+
+		/**
+		 * Runs the program up to the next action
+		 *
+		 * @param action receives the next action
+		 *
+		 * @return true if there is an action, false if the program ended
+		 *
+		 * @pre start() returned true
+		 */
+		bool next (Action& action) throw ();
+
+		///@}
+
+	private:
+
+		void _nextTurnStep (Action& action) throw ();
+
+		static UInt8 _getInstructionSize (UInt8 opcode) throw ();
+
+		UInt16 _skipBlock (UInt16 pc) const throw ();
+
+		UInt8 m_code[MAX_PROGRAM_SIZE];
+		UInt16 m_size;
+		UInt16 m_pc;
+
+		// The REPEAT blocks being executed, innermost last
+		UInt16 m_loop_start[MAX_LOOP_DEPTH];
+		UInt8 m_loop_remaining[MAX_LOOP_DEPTH];
+		UInt8 m_loop_depth;
+
+		// The part of the current turn not returned yet
+		UInt16 m_turn_remaining;
+		UInt8 m_turn_direction;
+	};
+
+} }
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef ROBOCOM_SHARED_LOOP_PROFILE_HPP
+#define ROBOCOM_SHARED_LOOP_PROFILE_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class accumulates the time spent in the phases of the
+	 * server loop
+	 *
+	 * For each phase it keeps the number of measurements, their sum and
+	 * maximum, and a histogram of their base 2 logarithms: bucket 0
+	 * counts the durations below 2 micros, bucket N the durations from
+	 * 2^N up to 2^(N+1) - 1 micros, and the last bucket also counts all
+	 * the longer durations. The histogram counts stop at MAX_BUCKET_VALUE.
+	 *
+	 * The server only keeps a profile when it is built with
+	 * ROBOCOM_LOOP_PROFILE defined. On arduino the profile takes about
+	 * 220 bytes of RAM.
+	 */
+	class LoopProfile
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		/// The measured phases of the server loop
+		enum Phase
+		{
+			/// Reading the next message from the stream
+			PHASE_READ,
+
+			/// Taking the next due message from the input queue
+			PHASE_POP,
+
+			/// Handling a message from the input queue
+			PHASE_DISPATCH,
+
+			/// Updating the state and running the due tasks
+			PHASE_STATE_UPDATE,
+
+			/// Writing the output queue to the stream on a FlushRequest
+			PHASE_FLUSH,
+
+			PHASE_COUNT
+		};
+
+		enum
+		{
+			/// The number of histogram buckets
+			BUCKET_COUNT = 16,
+
+			/// The maximum value of a histogram bucket
+			MAX_BUCKET_VALUE = 0xFFFF
+		};
+
+		///@}
+
+
+		/// @name Nested types
+		///@{
+
+		/**
+		 * Statistics of a single phase
+		 */
+		struct PhaseStats
+		{
+			/// Number of measurements
+			UInt32 count;
+
+			/// Sum of the measured durations in micros
+			UInt32 sum_micros;
+
+			/// The longest measured duration in micros
+			UInt32 max_micros;
+
+			/// Histogram of the measured durations
+			UInt16 buckets[BUCKET_COUNT];
+		};
+
+		///@}
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a new instance with no measurements
+		 */
+		LoopProfile () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the statistics of the given phase
+		 *
+		 * @pre phase < PHASE_COUNT
+		 */
+		const PhaseStats& getPhase (UInt8 phase) const throw ();
+
+		/**
+		 * Returns the histogram bucket of the given duration
+		 */
+		static UInt8 getBucket (UInt32 micros) throw ();
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all measurements
+		 */
+		void clear () throw ();
+
+		/**
+		 * Adds a measurement of the given phase
+		 *
+		 * @param phase the measured phase
+		 * @param start_micros the micros at the start of the phase
+		 * @param end_micros the micros at the end of the phase
+		 *
+		 * @pre phase < PHASE_COUNT
+		 *
+		 * @return end_micros, so that the end of one phase can become
+		 *  the start of the next one
+		 */
+		UInt32 record (
+			UInt8 phase,
+			UInt32 start_micros,
+			UInt32 end_micros
+		) throw ();
+
+		///@}
+
+	private:
+
+		PhaseStats m_phases[PHASE_COUNT];
+	};
+
+} }
+
+#endif
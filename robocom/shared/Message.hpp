@@ -7,6 +7,12 @@ namespace robocom {
 namespace shared
 {
 
+	namespace msg {
+	namespace schema
+	{
+		template <int TIMING> struct Payload;
+	} }
+
 	/**
 	 * This class implements the base message layout for the communication
 	 * protocol with arduino
@@ -77,7 +83,9 @@ namespace shared
 	 */
 	class Message
 	{
-		friend class MessageIO;
+		friend class CompactMessagePool;
+		template <class STREAM> friend class BasicMessageIO;
+		template <int TIMING> friend struct msg::schema::Payload;
 
 	public:
 
@@ -98,7 +106,12 @@ namespace shared
 			/**
 			 * Maximum value of the message type identifier.
 			 */
-			MAX_MESSAGE_TYPE = 0x7F
+			MAX_MESSAGE_TYPE = 0x7F,
+
+			/**
+			 * Maximum size of a serialized message
+			 */
+			MAX_SERIALIZED_SIZE = 4 + MAX_DATA_SIZE
 		};
 
 		///@}
@@ -125,6 +138,15 @@ namespace shared
 		 */
 		UInt8 getMaxDataSize () const throw ();
 
+		/**
+		 * Returns the size of this message on the wire, not counting
+		 * the framing added by the codec
+		 */
+		UInt8 getSerializedSize () const throw ()
+		{
+			return HEADER_SIZE + m_data_size + ( isImmediate() ? 0 : 4 );
+		}
+
   		/**
 		 * Returns the type of the message
 		 */
@@ -299,33 +321,30 @@ namespace shared
 		 */
 		int comparePriority (const Message& other) const throw ();
 
-		///@}
-
-	private:
-
-		/// @name Friend Access
-		///@{
-
 		/**
-		 * Reads this object from the given stream
+		 * Reads this object from the given buffer
+		 *
+		 * The buffer starts with the size byte, which must match the
+		 * given size. If this function returns false, this object is
+		 * in undetermined state.
 		 *
-		 * The stream must have enough bytes available for the whole message.
-		 * If this function throws an exception, this object is in undetermined
-		 * state.
+		 * @param p_buffer the buffer to read from
+		 * @param size the number of bytes in the buffer
 		 *
-		 * @param stream the stream to read from
+		 * @return true if the buffer holds a well-formed message
 		 */
-		void deserializeFrom (StreamIO& stream);
+		bool deserializeFrom (const UInt8* p_buffer, UInt8 size) throw ();
 
 		/**
-		 * Writes this object to the given stream
+		 * Writes this object to the given buffer
 		 *
-		 * If this function throws, the object could have been written only
-		 * partially.
+		 * @param p_buffer the buffer for getSerializedSize() bytes, at
+		 *   most MAX_SERIALIZED_SIZE
 		 *
-		 * @param stream the stream to write to
+		 * @return the number of bytes written, which is also the value
+		 *   of the first byte
 		 */
-		void serializeTo (StreamIO& stream) const;
+		UInt8 serializeTo (UInt8* p_buffer) const throw ();
 
 		///@}
 
@@ -0,0 +1,165 @@
+#ifndef ROBOCOM_SHARED_MESSAGE_DISPATCH_HXX
+#define ROBOCOM_SHARED_MESSAGE_DISPATCH_HXX
+
+#if defined(AVR)
+#include <avr/pgmspace.h>
+#endif
+
+#include "shared_base.hpp"
+
+// Component includes
+#include "Message.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class template routes messages to the typed handlers of
+	 * a TARGET class through a table indexed by the message type
+	 *
+	 * The target declares a member template with the route of each
+	 * message type, which does not route anything by default:
+	 *
+	 * @code
+	 * typedef MessageDispatch<MyServer> Dispatch;
+	 * template <int MSGID> struct Route : Dispatch::Unrouted { };
+	 * static const Dispatch::Handler ROUTES[Dispatch::TABLE_SIZE];
+	 * @endcode
+	 *
+	 * and specializes it for the types it handles, before it defines
+	 * the table:
+	 *
+	 * @code
+	 * template <> struct MyServer::Route<FooRequest::MSGID>
+	 *     : Dispatch::To<FooRequest, & MyServer::_processMessage> { };
+	 *
+	 * const MyServer::Dispatch::Handler MyServer::ROUTES[] PROGMEM =
+	 *     ROBOCOM_DISPATCH_TABLE( Route );
+	 * @endcode
+	 *
+	 * The table is built by the compiler and kept in the flash memory
+	 * on arduino. A new message type only needs its route; dispatch()
+	 * is a single indexed call.
+	 */
+	template <class TARGET>
+	class MessageDispatch
+	{
+	public:
+
+		/// @name Exported Types and Constants
+		///@{
+
+		/**
+		 * Function which handles a message for the target
+		 *
+		 * @return true if the message was handled
+		 */
+		typedef bool (*Handler) (TARGET& target, const Message& msg);
+
+		enum
+		{
+			/**
+			 * Number of entries of a routing table
+			 */
+			TABLE_SIZE = Message::MAX_MESSAGE_TYPE + 1
+		};
+
+		/**
+		 * Route of the message types the target does not handle
+		 */
+		struct Unrouted
+		{
+			static bool dispatch (TARGET& target, const Message& msg)
+			{
+				return false;
+			}
+		};
+
+		/**
+		 * Route of the message types the target accepts and drops
+		 */
+		struct Ignored
+		{
+			static bool dispatch (TARGET& target, const Message& msg)
+			{
+				return true;
+			}
+		};
+
+		/**
+		 * Route which passes the message as MSG to the given member
+		 * function of the target
+		 */
+		template <class MSG, void (TARGET::*PROCESS) (const MSG&)>
+		struct To
+		{
+			static bool dispatch (TARGET& target, const Message& msg)
+			{
+				(target.*PROCESS)( MSG( msg ) );
+				return true;
+			}
+		};
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Routes the message through the given table
+		 *
+		 * @param p_table the table of TABLE_SIZE handlers, in the flash
+		 *  memory on arduino
+		 * @param target the object which handles the message
+		 * @param msg the message to route
+		 *
+		 * @return true if the message was handled, false if the table
+		 *  has no route for its type
+		 */
+		static bool dispatch (
+			const Handler* p_table,
+			TARGET& target,
+			const Message& msg
+		)
+		{
+#if defined(AVR)
+			const Handler p_handler = reinterpret_cast<Handler>(
+				pgm_read_word( & p_table[msg.getMessageType()] )
+			);
+#else
+			const Handler p_handler = p_table[msg.getMessageType()];
+#endif
+			return (*p_handler)( target, msg );
+		}
+
+		///@}
+	};
+
+} }
+
+
+// Initializer of a routing table with the dispatch function of ROUTE<i>
+// at index i, for all message types
+#define ROBOCOM_DISPATCH_ROUTE_4(ROUTE, n) \
+	& ROUTE<(n)>::dispatch, & ROUTE<(n) + 1>::dispatch, \
+	& ROUTE<(n) + 2>::dispatch, & ROUTE<(n) + 3>::dispatch
+#define ROBOCOM_DISPATCH_ROUTE_16(ROUTE, n) \
+	ROBOCOM_DISPATCH_ROUTE_4(ROUTE, (n)), \
+	ROBOCOM_DISPATCH_ROUTE_4(ROUTE, (n) + 4), \
+	ROBOCOM_DISPATCH_ROUTE_4(ROUTE, (n) + 8), \
+	ROBOCOM_DISPATCH_ROUTE_4(ROUTE, (n) + 12)
+#define ROBOCOM_DISPATCH_ROUTE_64(ROUTE, n) \
+	ROBOCOM_DISPATCH_ROUTE_16(ROUTE, (n)), \
+	ROBOCOM_DISPATCH_ROUTE_16(ROUTE, (n) + 16), \
+	ROBOCOM_DISPATCH_ROUTE_16(ROUTE, (n) + 32), \
+	ROBOCOM_DISPATCH_ROUTE_16(ROUTE, (n) + 48)
+#define ROBOCOM_DISPATCH_TABLE(ROUTE) \
+	{ \
+		ROBOCOM_DISPATCH_ROUTE_64(ROUTE, 0), \
+		ROBOCOM_DISPATCH_ROUTE_64(ROUTE, 64) \
+	}
+
+#endif
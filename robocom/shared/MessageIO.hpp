@@ -3,21 +3,78 @@
 
 #include "shared_base.hpp"
 
+// Component includes
+#include "Message.hpp"
+
 namespace robocom {
 namespace shared
 {
 
 	/**
-	 * This class implements reading and writing of Messages
-	 * over the arduino Stream interface.
+	 * This class template implements reading and writing of Messages
+	 * over a stream with the interface of the arduino Stream.
+	 *
+	 * The STREAM is bound at compile time: it needs the available(),
+	 * peek(), read(), readBytes() and write() functions of StreamIO,
+	 * but does not have to derive from it. With a stream whose
+	 * functions are not virtual, like BufferStream, the byte by byte
+	 * parsing inlines the stream access. MessageIO is the instance for
+	 * StreamIO, which works with any stream through its virtual
+	 * functions; the other instances need to include MessageIO.hxx.
 	 *
 	 * Each message starts with the start byte ('>') and ends with the
 	 * end byte ('<'). Between the start byte and the end byte come the
 	 * message data. The first byte of the message data is the size of that
 	 * data (includes the size byte, but does not include the start and
 	 * end bytes).
+	 *
+	 * On the client side, the IO can also keep the client from overflowing
+	 * the input queue of the server (see setFlowControl()). It then counts
+	 * the written messages that use a credit, takes the credit limit from
+	 * the CreditNotice and FlushResponse messages it reads, and tryWrite()
+	 * holds back the messages for which there is no credit left.
+	 *
+	 * With ROBOCOM_RELIABLE_IO, the IO can also deliver the messages
+	 * reliably over a link that corrupts or drops bytes (see
+	 * setReliable()). The reliable frames start with their own start
+	 * byte and carry a trailer after the message data:
+	 *
+	 * - data frame: '}' message seq ack sack crc '<'
+	 * - control frame: ']' kind ack sack crc '<'
+	 *
+	 * The seq is the 8-bit sequence number of the frame in its direction
+	 * and the ack is the sequence number of the next frame expected from
+	 * the other side, so every frame acknowledges all frames before it.
+	 * Bit i of the sack is set when the frame ack + 1 + i has already
+	 * arrived out of order. The crc is a CRC-8 of everything from the
+	 * start byte to the sack. Frames with a bad crc are dropped.
+	 *
+	 * Up to WINDOW_SIZE frames can wait for an acknowledgement in each
+	 * direction. A frame is sent again when it was not acknowledged
+	 * within RETRANSMIT_MILLIS, or at once when the sack shows that
+	 * a later frame got through; the link keeps the order of the bytes,
+	 * so that means the frame was lost. The receiver keeps the frames
+	 * that arrive after a lost one and delivers them in order once
+	 * the retransmission arrived.
+	 *
+	 * The plain frames are dropped in the reliable mode, as they cannot
+	 * be told apart from noise.
+	 *
+	 * The frames above use the plain codec, which is the default. With
+	 * the COBS codec (see setCodec()), each frame is the start byte and
+	 * the data of the frame as above, without the end byte, followed by
+	 * the CRC-16 of those bytes (most significant byte first), all
+	 * encoded with COBS and followed by a zero byte. Any frame which
+	 * does not decode or has a bad CRC is dropped, and the reader starts
+	 * over after the zero byte. Both sides must use the same codec; the
+	 * client asks the server to switch with a CodecRequest right after
+	 * connecting.
+	 *
+	 * The client learns which of these the server supports from the
+	 * CapsResponse to a HelloRequest.
 	 */
-	class MessageIO
+	template <class STREAM>
+	class BasicMessageIO
 	{
 	public:
 
@@ -28,9 +85,41 @@ namespace shared
 		enum MagicConstants
 		{
 			MC_MESSAGE_START = '>',
-			MC_MESSAGE_END = '<'
+			MC_MESSAGE_END = '<',
+			MC_RELIABLE_START = '}',
+			MC_CONTROL_START = ']'
+		};
+
+		/// The frame encodings on the wire
+		enum Codec
+		{
+			/// The frames start and end with the marker bytes
+			CODEC_PLAIN,
+
+			/// The frames are COBS encoded with a CRC-16
+			CODEC_COBS,
+
+			CODEC_COUNT
 		};
 
+#if defined(ROBOCOM_RELIABLE_IO)
+		enum
+		{
+			/**
+			 * Maximum number of frames waiting for an acknowledgement
+			 * in one direction; must divide 256 so that the slots
+			 * follow the 8-bit sequence numbers across the wrap
+			 */
+			WINDOW_SIZE = 4,
+
+			/**
+			 * Time after which a frame which was not acknowledged is
+			 * sent again
+			 */
+			RETRANSMIT_MILLIS = 50
+		};
+#endif
+
 		///@}
 
 
@@ -43,7 +132,7 @@ namespace shared
 		 *
 		 * @param stream the reference to the Stream instance to use
 		 */
-		MessageIO (StreamIO& stream) throw ();
+		BasicMessageIO (STREAM& stream) throw ();
 
 		///@}
 
@@ -57,6 +146,9 @@ namespace shared
 		 * If this function throws, the message could have been read
 		 * only partially and will be in an undefined state.
 		 *
+		 * The acknowledgements and the frames which cannot be delivered
+		 * yet are consumed without returning.
+		 *
 		 * @param msg on output stores the message that has been read from
 		 *  the stream
 		 *
@@ -76,10 +168,162 @@ namespace shared
 		 * If this function throws an exception, the message might have not
 		 * been completely written.
 		 *
+		 * In the reliable mode, the message is kept until the other side
+		 * acknowledged it. The other side drops plain frames in that
+		 * mode, so there is no way to send a message while the window
+		 * is full; see tryWrite().
+		 *
 		 * @param msg the message to write
+		 *
+		 * @pre canWrite()
 		 */
 		void write (const Message& msg);
 
+		/**
+		 * Returns whether a message can be written without waiting
+		 * for acknowledgements
+		 *
+		 * This is always true outside of the reliable mode.
+		 */
+		bool canWrite () const throw ();
+
+		/**
+		 * Sends the retransmissions and acknowledgements which are due
+		 *
+		 * This should be called regularly, both when the link is busy
+		 * and when it is idle. It has no effect outside of the reliable
+		 * mode.
+		 *
+		 * @param current_millis the current time in millis, which is also
+		 *   used for the frames written until the next call
+		 */
+		void poll (UInt32 current_millis);
+
+		/**
+		 * Switches to the given frame encoding for both reading and
+		 * writing
+		 *
+		 * A partially read frame is dropped.
+		 *
+		 * @pre codec < CODEC_COUNT
+		 */
+		void setCodec (UInt8 codec) throw ();
+
+		/**
+		 * Returns the frame encoding in use
+		 */
+		UInt8 getCodec () const throw ()
+		{
+			return m_codec;
+		}
+
+		/**
+		 * Returns the number of frames dropped so far because their
+		 * CRC or end byte was wrong
+		 */
+		UInt16 getCorruptFrameCount () const throw ()
+		{
+			return m_corrupt_count;
+		}
+
+		/**
+		 * Returns the bit mask of the msg::CapsResponse::Feature values
+		 * of the link that this build supports
+		 */
+		static UInt8 getFeatures () throw ();
+
+		///@}
+
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		/// @name Reliable delivery
+		///@{
+
+		/**
+		 * Starts or stops the reliable mode
+		 *
+		 * Starting the reliable mode synchronizes the sequence numbers
+		 * with the other side, which switches to the reliable mode as
+		 * well. The messages written before the other side answered
+		 * are held in the window. The client should start the reliable
+		 * mode again whenever the server may have restarted.
+		 *
+		 * @param is_enabled whether to use the reliable frames
+		 */
+		void setReliable (bool is_enabled);
+
+		/**
+		 * Returns whether the reliable mode is started, possibly still
+		 * waiting for the other side
+		 */
+		bool isReliable () const throw ()
+		{
+			return LS_PLAIN != m_link_state;
+		}
+
+		/**
+		 * Returns the number of frames sent again so far
+		 */
+		UInt16 getRetransmitCount () const throw ()
+		{
+			return m_retransmit_count;
+		}
+
+		///@}
+#endif
+
+
+		/// @name Flow control
+		///@{
+
+		/**
+		 * Enables or disables the credit-based flow control
+		 *
+		 * The credits are only known after the server has answered
+		 * a ResetRequest written through this object; until then
+		 * getCredits() returns zero. The server only answers it for
+		 * a client which listed FEATURE_CREDIT in its HelloRequest (see
+		 * msg::CreditNotice). The flow control is disabled by default.
+		 */
+		void setFlowControl (bool is_enabled) throw ();
+
+		/**
+		 * Returns whether the credit-based flow control is enabled
+		 */
+		bool isFlowControl () const throw ()
+		{
+			return m_is_flow_control;
+		}
+
+		/**
+		 * Returns the number of messages using a credit that can be
+		 * written before the server grants more credits
+		 */
+		UInt16 getCredits () const throw ();
+
+		/**
+		 * Writes the given message unless it needs a credit and there
+		 * is none left
+		 *
+		 * The caller should keep reading messages, which may bring
+		 * new credits, and retry later.
+		 *
+		 * @param msg the message to write
+		 *
+		 * @return true if the message was written, false if it was
+		 *   held back
+		 */
+		bool tryWrite (const Message& msg);
+
+		/**
+		 * Returns whether the given message uses a credit
+		 *
+		 * All messages use credits, except the framework messages
+		 * which the server handles on arrival instead of putting them
+		 * to its input queue.
+		 */
+		static bool usesCredit (const Message& msg) throw ();
+
 		///@}
 
 	private:
@@ -102,14 +346,116 @@ namespace shared
 			IOS_HAVE_DATA
 		};
 
-		bool _readMessageStart ();
-		bool _waitForDataAvailable ();
-		bool _readData (Message& msg);
+		enum
+		{
+			// Size of the seq, ack, sack and crc after the message data
+			// of a reliable frame
+			DATA_TRAILER_SIZE = 4,
+
+			// Size of the kind, ack, sack and crc of a control frame
+			CONTROL_SIZE = 4,
+
+			// The start byte, message and trailer of the largest frame
+			MAX_FRAME_SIZE = 1 + Message::MAX_SERIALIZED_SIZE + DATA_TRAILER_SIZE,
+
+			// The largest frame with the CRC-16 and the COBS overhead
+			MAX_ENCODED_SIZE = MAX_FRAME_SIZE + 2 + 1
+		};
 
-		StreamIO& m_stream;
+#if defined(ROBOCOM_RELIABLE_IO)
+		enum LinkState
+		{
+			// Only the plain frames are written
+			LS_PLAIN,
+
+			// The IO sent a sync and waits for the other side to answer
+			LS_SYNCING,
+
+			// Both sides agreed on the sequence numbers
+			LS_RELIABLE
+		};
+
+		enum ControlKind
+		{
+			CK_ACK,
+			CK_SYNC,
+			CK_SYNC_ACK
+		};
+
+		struct SentFrame
+		{
+			Message msg;
+			UInt16 sent_millis;
+			bool is_sacked;
+			bool is_fast_retransmitted;
+		};
+#endif
+
+		bool _readFrame ();
+		bool _readPlainFrame ();
+		bool _readCobsFrame ();
+		bool _isFrameStart (int b) throw ();
+		bool _parseFrame (Message& msg);
+		void _writeMessage (const Message& msg);
+		void _writeFrame (UInt8* p_frame, UInt8 size);
+		void _updateCredits (const Message& msg) throw ();
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		bool _parseReliableData (Message& msg);
+		bool _parseControl ();
+		bool _popReceived (Message& msg) throw ();
+		bool _onDataFrame (const Message& msg, UInt8 seq) throw ();
+		void _onAck (UInt8 ack, UInt8 sack);
+		void _writeReliable (const Message& msg);
+		void _sendDataFrame (UInt8 seq);
+		void _sendControlFrame (UInt8 kind);
+		UInt8 _getSack () const throw ();
+#endif
+
+		STREAM& m_stream;
 		IOState m_state;
+		bool m_is_flow_control;
+		bool m_is_synced;
+		UInt16 m_reset_task_id;
+		UInt16 m_sent_count;
+		UInt16 m_credit_limit;
+
+		// The frame being read: the bytes received so far (or expected,
+		// with the plain codec), and the size of the last complete
+		// frame, which is zero if it was dropped
+		UInt8 m_codec;
+		UInt8 m_frame[MAX_ENCODED_SIZE];
+		UInt8 m_rx_size;
+		UInt8 m_frame_size;
+		bool m_is_frame_overflow;
+		UInt16 m_corrupt_count;
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		UInt8 m_link_state;
+		bool m_is_ack_pending;
+		UInt16 m_current_millis;
+		UInt16 m_sync_millis;
+		UInt16 m_retransmit_count;
+
+		// Frames waiting for an acknowledgement, indexed by seq modulo
+		// WINDOW_SIZE
+		SentFrame m_sent[WINDOW_SIZE];
+		UInt8 m_send_base;
+		UInt8 m_send_next;
+
+		// Frames which arrived out of order, indexed the same way
+		Message m_received[WINDOW_SIZE];
+		UInt8 m_received_mask;
+		UInt8 m_receive_next;
+#endif
 	};
 
+
+	/**
+	 * The message IO over any StreamIO, instantiated in the library
+	 */
+	typedef BasicMessageIO<StreamIO> MessageIO;
+
 } }
 
 #endif // ROBOCOM_SHARED_MESSAGE_IO_HPP
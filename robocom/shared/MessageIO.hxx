@@ -0,0 +1,785 @@
+#ifndef ROBOCOM_SHARED_MESSAGE_IO_HXX
+#define ROBOCOM_SHARED_MESSAGE_IO_HXX
+
+#include "FrameCodec.hpp"
+#include "Message.hpp"
+#include "StreamIO.hpp"
+#include "msg/CapsResponse.hpp"
+#include "msg/CreditNotice.hpp"
+#include "msg/FlushResponse.hpp"
+
+#include "MessageIO.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	template <class STREAM>
+	BasicMessageIO<STREAM>::BasicMessageIO (STREAM& stream) throw ()
+		: m_stream( stream )
+		, m_state( IOS_NEED_MESSAGE_START )
+		, m_is_flow_control( false )
+		, m_is_synced( false )
+		, m_reset_task_id( 0 )
+		, m_sent_count( 0 )
+		, m_credit_limit( 0 )
+		, m_codec( CODEC_PLAIN )
+		, m_rx_size( 0 )
+		, m_frame_size( 0 )
+		, m_is_frame_overflow( false )
+		, m_corrupt_count( 0 )
+#if defined(ROBOCOM_RELIABLE_IO)
+		, m_link_state( LS_PLAIN )
+		, m_is_ack_pending( false )
+		, m_current_millis( 0 )
+		, m_sync_millis( 0 )
+		, m_retransmit_count( 0 )
+		, m_send_base( 0 )
+		, m_send_next( 0 )
+		, m_received_mask( 0 )
+		, m_receive_next( 0 )
+#endif
+	{ }
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::read (Message& msg)
+	{
+		bool has_message = false;
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		has_message = _popReceived( msg );
+#endif
+
+		// Frames which do not deliver a message are skipped
+		while ( ! has_message )
+		{
+			if ( ! _readFrame() ) {
+				return false;
+			}
+
+			has_message = _parseFrame( msg );
+		}
+
+		if ( m_is_flow_control ) {
+			_updateCredits( msg );
+		}
+
+		return true;
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::write (const Message& msg)
+	{
+		USE_CONTRACT_CHECK( canWrite() );
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		if ( LS_PLAIN != m_link_state ) {
+			_writeReliable( msg );
+		}
+		else {
+			_writeMessage( msg );
+		}
+#else
+		_writeMessage( msg );
+#endif
+
+		if ( ! m_is_flow_control ) {
+			return;
+		}
+
+		// The server restarts its count on a reset, and the credits
+		// are unknown until it answers
+		if ( msg.getMessageType() == msg::CommonMessageTypes::MSGID_RESET )
+		{
+			m_is_synced = false;
+			m_reset_task_id = msg.getTaskId();
+			m_sent_count = 0;
+			m_credit_limit = 0;
+		}
+		else if ( usesCredit( msg ) ) {
+			m_sent_count++;
+		}
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::canWrite () const throw ()
+	{
+#if defined(ROBOCOM_RELIABLE_IO)
+		if ( LS_PLAIN != m_link_state ) {
+			return static_cast<UInt8>( m_send_next - m_send_base ) < WINDOW_SIZE;
+		}
+#endif
+		return true;
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::poll (UInt32 current_millis)
+	{
+#if defined(ROBOCOM_RELIABLE_IO)
+		m_current_millis = current_millis;
+
+		if ( LS_SYNCING == m_link_state )
+		{
+			if ( static_cast<UInt16>( m_current_millis - m_sync_millis ) >= RETRANSMIT_MILLIS )
+			{
+				m_sync_millis = m_current_millis;
+				m_retransmit_count++;
+				_sendControlFrame( CK_SYNC );
+			}
+			return;
+		}
+
+		if ( LS_RELIABLE != m_link_state ) {
+			return;
+		}
+
+		for ( UInt8 seq = m_send_base; seq != m_send_next; seq++ )
+		{
+			const SentFrame& frame = m_sent[seq % WINDOW_SIZE];
+			if ( ! frame.is_sacked &&
+				 static_cast<UInt16>( m_current_millis - frame.sent_millis ) >= RETRANSMIT_MILLIS )
+			{
+				m_retransmit_count++;
+				_sendDataFrame( seq );
+			}
+		}
+
+		// Nothing was written to carry the acknowledgement
+		if ( m_is_ack_pending ) {
+			_sendControlFrame( CK_ACK );
+		}
+#else
+		(void) current_millis;
+#endif
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::setCodec (UInt8 codec) throw ()
+	{
+		USE_CONTRACT_CHECK( codec < CODEC_COUNT );
+
+		m_codec = codec;
+		m_state = IOS_NEED_MESSAGE_START;
+		m_rx_size = 0;
+		m_is_frame_overflow = false;
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::setFlowControl (bool is_enabled) throw ()
+	{
+		m_is_flow_control = is_enabled;
+	}
+
+
+	template <class STREAM>
+	UInt16
+	BasicMessageIO<STREAM>::getCredits () const throw ()
+	{
+		if ( ! m_is_synced ) {
+			return 0;
+		}
+
+		const SInt16 credits = static_cast<SInt16>( m_credit_limit - m_sent_count );
+		return credits > 0 ? credits : 0;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::tryWrite (const Message& msg)
+	{
+		if ( ! canWrite() ) {
+			return false;
+		}
+
+		if ( m_is_flow_control && usesCredit( msg ) && 0 == getCredits() ) {
+			return false;
+		}
+
+		write( msg );
+		return true;
+	}
+
+
+	template <class STREAM>
+	UInt8
+	BasicMessageIO<STREAM>::getFeatures () throw ()
+	{
+		UInt8 features = msg::CapsResponse::FEATURE_CREDIT
+			| msg::CapsResponse::FEATURE_COBS;
+#if defined(ROBOCOM_RELIABLE_IO)
+		features |= msg::CapsResponse::FEATURE_RELIABLE;
+#endif
+		return features;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::usesCredit (const Message& msg) throw ()
+	{
+		const UInt8 type = msg.getMessageType();
+		return type >= msg::CommonMessageTypes::LAST
+			&& type < msg::CommonMessageTypes::FIRST_RESERVED;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_readFrame ()
+	{
+		if ( CODEC_COBS == m_codec ) {
+			return _readCobsFrame();
+		}
+
+		return _readPlainFrame();
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_readPlainFrame ()
+	{
+		if ( IOS_NEED_MESSAGE_START == m_state )
+		{
+			for ( ; ; )
+			{
+				if ( 0 == m_stream.available() ) {
+					return false;
+				}
+
+				const int b = m_stream.read();
+				if ( _isFrameStart( b ) )
+				{
+					m_frame[0] = b;
+					m_state = IOS_NEED_DATA;
+					break;
+				}
+			}
+		}
+
+		if ( IOS_NEED_DATA == m_state )
+		{
+			if ( 0 == m_stream.available() ) {
+				return false;
+			}
+
+			if ( MC_CONTROL_START == m_frame[0] ) {
+				m_rx_size = 1 + CONTROL_SIZE;
+			}
+			else
+			{
+				// The first byte is the message size. Make sure that the
+				// message size falls within a valid range. If it doesn't,
+				// reset the state and look for the next message start marker.
+				const int message_size = m_stream.peek();
+				if ( message_size > Message::HEADER_SIZE + Message::MAX_DATA_SIZE
+						||
+					 message_size < Message::HEADER_SIZE )
+				{
+					m_state = IOS_NEED_MESSAGE_START;
+					m_frame_size = 0;
+					m_corrupt_count++;
+					return true;
+				}
+
+				m_rx_size = 1 + message_size;
+				if ( MC_RELIABLE_START == m_frame[0] ) {
+					m_rx_size += DATA_TRAILER_SIZE;
+				}
+			}
+
+			// The frame size does not include the end marker byte, so
+			// we need at least one byte more than the rest of the frame
+			if ( m_stream.available() <= m_rx_size - 1 ) {
+				return false;
+			}
+
+			m_state = IOS_HAVE_DATA;
+		}
+
+		// IOS_HAVE_DATA == m_state
+		m_state = IOS_NEED_MESSAGE_START;
+		m_stream.readBytes( (char*) m_frame + 1, m_rx_size - 1 );
+
+		if ( MC_MESSAGE_END == m_stream.read() ) {
+			m_frame_size = m_rx_size;
+		}
+		else
+		{
+			m_frame_size = 0;
+			m_corrupt_count++;
+		}
+
+		return true;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_readCobsFrame ()
+	{
+		while ( m_stream.available() > 0 )
+		{
+			const UInt8 b = m_stream.read();
+			if ( 0 != b )
+			{
+				// An overlong frame is dropped at its delimiter
+				if ( m_rx_size < MAX_ENCODED_SIZE ) {
+					m_frame[m_rx_size++] = b;
+				}
+				else {
+					m_is_frame_overflow = true;
+				}
+				continue;
+			}
+
+			const UInt8 encoded_size = m_rx_size;
+			const bool is_overflow = m_is_frame_overflow;
+			m_rx_size = 0;
+			m_is_frame_overflow = false;
+
+			if ( 0 == encoded_size ) {
+				continue;
+			}
+
+			// The start byte, at least one data byte and the CRC-16;
+			// the CRC-16 of the data followed by their CRC-16 is zero
+			const UInt8 size = is_overflow ?
+				0 : FrameCodec::decodeCobs( m_frame, encoded_size );
+
+			if ( size < 1 + 1 + 2 ||
+				 FrameCodec::updateCrc16( FrameCodec::CRC16_INIT, m_frame, size ) != 0 )
+			{
+				m_frame_size = 0;
+				m_corrupt_count++;
+				return true;
+			}
+
+			m_frame_size = size - 2;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_isFrameStart (int b) throw ()
+	{
+#if defined(ROBOCOM_RELIABLE_IO)
+		return MC_MESSAGE_START == b
+			|| MC_RELIABLE_START == b
+			|| MC_CONTROL_START == b;
+#else
+		return MC_MESSAGE_START == b;
+#endif
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_parseFrame (Message& msg)
+	{
+		if ( 0 == m_frame_size ) {
+			return false;
+		}
+
+		switch ( m_frame[0] )
+		{
+		case MC_MESSAGE_START:
+#if defined(ROBOCOM_RELIABLE_IO)
+			// Plain frames cannot be checked, so noise could pass for one
+			if ( LS_PLAIN != m_link_state ) {
+				return false;
+			}
+#endif
+			return msg.deserializeFrom( m_frame + 1, m_frame_size - 1 );
+#if defined(ROBOCOM_RELIABLE_IO)
+		case MC_RELIABLE_START:
+			return _parseReliableData( msg );
+		case MC_CONTROL_START:
+			return _parseControl();
+#endif
+		default:
+			return false;
+		}
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_writeMessage (const Message& msg)
+	{
+		UInt8 frame[MAX_FRAME_SIZE + 2];
+		frame[0] = MC_MESSAGE_START;
+		const UInt8 size = 1 + msg.serializeTo( frame + 1 );
+
+		_writeFrame( frame, size );
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_writeFrame (UInt8* p_frame, UInt8 size)
+	{
+		if ( CODEC_PLAIN == m_codec )
+		{
+			m_stream.write( p_frame, size );
+			m_stream.write( static_cast<UInt8>( MC_MESSAGE_END ) );
+			return;
+		}
+
+		// The buffer has room for the CRC-16
+		const UInt16 crc = FrameCodec::updateCrc16(
+			FrameCodec::CRC16_INIT,
+			p_frame,
+			size
+		);
+		p_frame[size++] = crc >> 8;
+		p_frame[size++] = crc & 0xFF;
+
+		UInt8 encoded[MAX_ENCODED_SIZE];
+		const UInt8 encoded_size = FrameCodec::encodeCobs( p_frame, size, encoded );
+
+		m_stream.write( encoded, encoded_size );
+		m_stream.write( static_cast<UInt8>( 0 ) );
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_updateCredits (const Message& msg) throw ()
+	{
+		UInt16 credit_limit = 0;
+
+		if ( msg.getMessageType() == msg::CreditNotice::MSGID )
+		{
+			const msg::CreditNotice notice( msg );
+			if ( notice.validate() != msg::STATUS_OK ) {
+				return;
+			}
+
+			// Notices sent before the server got the reset are stale
+			if ( ! m_is_synced )
+			{
+				if ( notice.getTaskId() != m_reset_task_id ) {
+					return;
+				}
+
+				m_is_synced = true;
+				m_credit_limit = notice.getCreditLimit();
+				return;
+			}
+
+			credit_limit = notice.getCreditLimit();
+		}
+		else if ( msg.getMessageType() == msg::FlushResponse::MSGID )
+		{
+			const msg::FlushResponse response( msg );
+			if ( ! m_is_synced ||
+				 response.validate() != msg::STATUS_OK ||
+				 ! response.hasCreditLimit() )
+			{
+				return;
+			}
+
+			credit_limit = response.getCreditLimit();
+		}
+		else {
+			return;
+		}
+
+		// The limit never goes back, an older value may only arrive late
+		if ( static_cast<SInt16>( credit_limit - m_credit_limit ) > 0 ) {
+			m_credit_limit = credit_limit;
+		}
+	}
+
+
+#if defined(ROBOCOM_RELIABLE_IO)
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::setReliable (bool is_enabled)
+	{
+		m_send_base = 0;
+		m_send_next = 0;
+		m_received_mask = 0;
+		m_receive_next = 0;
+		m_is_ack_pending = false;
+
+		if ( ! is_enabled )
+		{
+			m_link_state = LS_PLAIN;
+			return;
+		}
+
+		m_link_state = LS_SYNCING;
+		m_sync_millis = m_current_millis;
+		_sendControlFrame( CK_SYNC );
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_parseReliableData (Message& msg)
+	{
+		// The message size byte follows the start byte
+		const UInt8 message_size = m_frame[1];
+		if ( m_frame_size != 1 + message_size + DATA_TRAILER_SIZE ) {
+			return false;
+		}
+
+		const UInt8* p_trailer = m_frame + 1 + message_size;
+		const UInt8 seq = p_trailer[0];
+		const UInt8 ack = p_trailer[1];
+		const UInt8 sack = p_trailer[2];
+		const UInt8 crc = p_trailer[3];
+
+		if ( crc != FrameCodec::updateCrc8( 0, m_frame, m_frame_size - 1 ) ||
+			 ! msg.deserializeFrom( m_frame + 1, message_size ) )
+		{
+			m_corrupt_count++;
+			return false;
+		}
+
+		// The other side restarted its sequence numbers without
+		// synchronizing with this side
+		if ( LS_RELIABLE != m_link_state ) {
+			return false;
+		}
+
+		_onAck( ack, sack );
+		return _onDataFrame( msg, seq );
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_parseControl ()
+	{
+		if ( m_frame_size != 1 + CONTROL_SIZE ) {
+			return false;
+		}
+
+		const UInt8 kind = m_frame[1];
+		const UInt8 ack = m_frame[2];
+		const UInt8 sack = m_frame[3];
+		const UInt8 crc = m_frame[4];
+
+		if ( crc != FrameCodec::updateCrc8( 0, m_frame, m_frame_size - 1 ) )
+		{
+			m_corrupt_count++;
+			return false;
+		}
+
+		switch ( kind )
+		{
+		case CK_SYNC:
+			// The other side starts over, whatever was in flight
+			// belonged to its previous session
+			m_link_state = LS_RELIABLE;
+			m_send_base = 0;
+			m_send_next = 0;
+			m_received_mask = 0;
+			m_receive_next = 0;
+			_sendControlFrame( CK_SYNC_ACK );
+			break;
+		case CK_SYNC_ACK:
+			if ( LS_SYNCING == m_link_state )
+			{
+				m_link_state = LS_RELIABLE;
+				for ( UInt8 seq = m_send_base; seq != m_send_next; seq++ ) {
+					_sendDataFrame( seq );
+				}
+			}
+			break;
+		case CK_ACK:
+			if ( LS_RELIABLE == m_link_state ) {
+				_onAck( ack, sack );
+			}
+			break;
+		default:
+			break;
+		}
+
+		// Control frames never carry a message
+		return false;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_popReceived (Message& msg) throw ()
+	{
+		const UInt8 bit = 1u << ( m_receive_next % WINDOW_SIZE );
+		if ( 0 == ( m_received_mask & bit ) ) {
+			return false;
+		}
+
+		msg = m_received[m_receive_next % WINDOW_SIZE];
+		m_received_mask &= ~bit;
+		m_receive_next++;
+		m_is_ack_pending = true;
+		return true;
+	}
+
+
+	template <class STREAM>
+	bool
+	BasicMessageIO<STREAM>::_onDataFrame (const Message& msg, UInt8 seq) throw ()
+	{
+		// Duplicates are acknowledged too, the acknowledgement of
+		// the original might have been lost
+		m_is_ack_pending = true;
+
+		const UInt8 offset = seq - m_receive_next;
+		if ( 0 == offset )
+		{
+			m_receive_next++;
+			return true;
+		}
+
+		// Frames after a lost one are kept until it arrives, older
+		// frames are duplicates
+		if ( offset < WINDOW_SIZE )
+		{
+			m_received[seq % WINDOW_SIZE] = msg;
+			m_received_mask |= 1u << ( seq % WINDOW_SIZE );
+		}
+
+		return false;
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_onAck (UInt8 ack, UInt8 sack)
+	{
+		const UInt8 outstanding = m_send_next - m_send_base;
+		const UInt8 acked = ack - m_send_base;
+
+		// Not an acknowledgement of anything sent by this side
+		if ( acked > outstanding ) {
+			return;
+		}
+
+		m_send_base = ack;
+		const UInt8 remaining = outstanding - acked;
+
+		// The link keeps the order of the frames, so the frames before
+		// the last one selectively acknowledged were lost
+		UInt8 lost_count = 0;
+		for ( UInt8 i = 0; i + 1 < remaining && i < WINDOW_SIZE - 1; i++ )
+		{
+			if ( sack & ( 1u << i ) )
+			{
+				m_sent[( ack + 1 + i ) % WINDOW_SIZE].is_sacked = true;
+				lost_count = i + 1;
+			}
+		}
+
+		for ( UInt8 i = 0; i < lost_count; i++ )
+		{
+			const UInt8 seq = ack + i;
+			SentFrame& frame = m_sent[seq % WINDOW_SIZE];
+			if ( ! frame.is_sacked && ! frame.is_fast_retransmitted )
+			{
+				frame.is_fast_retransmitted = true;
+				m_retransmit_count++;
+				_sendDataFrame( seq );
+			}
+		}
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_writeReliable (const Message& msg)
+	{
+		const UInt8 seq = m_send_next++;
+
+		SentFrame& frame = m_sent[seq % WINDOW_SIZE];
+		frame.msg = msg;
+		frame.sent_millis = m_current_millis;
+		frame.is_sacked = false;
+		frame.is_fast_retransmitted = false;
+
+		// Held back until the other side answered the sync
+		if ( LS_RELIABLE == m_link_state ) {
+			_sendDataFrame( seq );
+		}
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_sendDataFrame (UInt8 seq)
+	{
+		SentFrame& sent = m_sent[seq % WINDOW_SIZE];
+		sent.sent_millis = m_current_millis;
+
+		UInt8 frame[MAX_FRAME_SIZE + 2];
+		frame[0] = MC_RELIABLE_START;
+		UInt8 size = 1 + sent.msg.serializeTo( frame + 1 );
+		frame[size++] = seq;
+		frame[size++] = m_receive_next;
+		frame[size++] = _getSack();
+		frame[size] = FrameCodec::updateCrc8( 0, frame, size );
+		size++;
+
+		_writeFrame( frame, size );
+		m_is_ack_pending = false;
+	}
+
+
+	template <class STREAM>
+	void
+	BasicMessageIO<STREAM>::_sendControlFrame (UInt8 kind)
+	{
+		UInt8 frame[1 + CONTROL_SIZE + 2];
+		frame[0] = MC_CONTROL_START;
+		frame[1] = kind;
+		frame[2] = m_receive_next;
+		frame[3] = _getSack();
+		frame[4] = FrameCodec::updateCrc8( 0, frame, 4 );
+
+		_writeFrame( frame, 1 + CONTROL_SIZE );
+		m_is_ack_pending = false;
+	}
+
+
+	template <class STREAM>
+	UInt8
+	BasicMessageIO<STREAM>::_getSack () const throw ()
+	{
+		UInt8 sack = 0;
+		for ( UInt8 i = 0; i < WINDOW_SIZE - 1; i++ )
+		{
+			const UInt8 bit = 1u << ( ( m_receive_next + 1 + i ) % WINDOW_SIZE );
+			if ( m_received_mask & bit ) {
+				sack |= 1u << i;
+			}
+		}
+		return sack;
+	}
+
+#endif
+
+} }
+
+#endif // ROBOCOM_SHARED_MESSAGE_IO_HXX
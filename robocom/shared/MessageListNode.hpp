@@ -38,6 +38,25 @@ namespace shared
 			return m_msg;
 		}
 
+		/**
+		 * Returns the stored message for modification in place
+		 */
+		Message& getMessage () throw ()
+		{
+			return m_msg;
+		}
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Returns the lower 16 bits of the millis at which the message
+		 * was added to a queue
+		 */
+		UInt16 getEnqueueMillis () const throw ()
+		{
+			return m_enqueue_millis;
+		}
+#endif
+
 		///@}
 
 
@@ -60,12 +79,28 @@ namespace shared
 			m_msg = msg;
 		}
 
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Sets the millis at which the message was added to a queue
+		 *
+		 * Only the lower 16 bits are kept, which is enough for messages
+		 * that stay in the queue for less than a minute.
+		 */
+		void setEnqueueMillis (UInt32 millis) throw ()
+		{
+			m_enqueue_millis = static_cast<UInt16>( millis );
+		}
+#endif
+
 		///@}
 
 	private:
 
 		MessageListNode* m_p_next;
 		Message m_msg;
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		UInt16 m_enqueue_millis;
+#endif
 	};
 
 } }
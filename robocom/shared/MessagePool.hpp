@@ -28,9 +28,13 @@ namespace shared
 		{
 			/**
 			 * The maximum number of messages that one pool can
-			 * accomodate
+			 * accomodate; the firmware has 2 KB of RAM in all
 			 */
+#if defined(AVR)
+			SLOT_COUNT = 16
+#else
 			SLOT_COUNT = 32
+#endif
 		};
 
 		///@}
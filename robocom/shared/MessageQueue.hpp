@@ -3,6 +3,10 @@
 
 #include "shared_base.hpp"
 
+#if defined(ROBOCOM_QUEUE_PROFILE)
+#include "QueueProfile.hpp"
+#endif
+
 namespace robocom {
 namespace shared
 {
@@ -17,6 +21,35 @@ namespace shared
 	{
 	public:
 
+		/// @name Nested types
+		///@{
+
+		/**
+		 * The interface of the objects which popAndVisit() passes
+		 * the messages to
+		 */
+		class Visitor
+		{
+		public:
+
+			/**
+			 * Destroys this object
+			 */
+			virtual ~Visitor () throw ()
+			{ }
+
+			/**
+			 * Handles a message popped from the queue
+			 *
+			 * The message stays valid until the function returns. The
+			 * queue may be modified in the meantime.
+			 */
+			virtual void visit (const Message& msg) = 0;
+		};
+
+		///@}
+
+
 		/// @name Lifetime management
 		///@{
 
@@ -48,6 +81,26 @@ namespace shared
 			return m_max_size;
 		}
 
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Returns the residency time and depth statistics of this queue
+		 *
+		 * Only available when built with ROBOCOM_QUEUE_PROFILE defined.
+		 */
+		QueueProfile& getProfile () throw ()
+		{
+			return m_profile;
+		}
+
+		/**
+		 * Returns the residency time and depth statistics of this queue
+		 */
+		const QueueProfile& getProfile () const throw ()
+		{
+			return m_profile;
+		}
+#endif
+
 		///@}
 
 
@@ -55,19 +108,45 @@ namespace shared
 		///@{
 
 		/**
-		 * Discards all messages from this queue
+		 * Discards all messages from this queue, and the reserved one
 		 */
 		void clear () throw ();
 
 		/**
 		 * Adds the given message to this queue
 		 *
+		 * If the message is the one returned by reserve(), it is linked
+		 * in place.
+		 *
 		 * @param msg the message to add
+		 * @param current_millis the current millis value, used to measure
+		 *   how long the message stays in the queue
 		 *
 		 * @return true if the message was added, false if there is no more
 		 *   free space in the message pool and the message was not added
 		 */
-		bool push (const Message& msg) throw ();
+		bool push (const Message& msg, UInt32 current_millis = 0) throw ();
+
+		/**
+		 * Allocates a message from the pool without adding it to
+		 * this queue
+		 *
+		 * The caller builds the message in place and then passes it
+		 * to push(), which links it into this queue without copying
+		 * it, or drops it with cancel(). Only one message can be
+		 * reserved at a time; reserving again returns the same one.
+		 *
+		 * @return the reserved message, or NULL if there is no more
+		 *   free space in the message pool
+		 */
+		Message* reserve () throw ();
+
+		/**
+		 * Returns the reserved message to the pool
+		 *
+		 * Does nothing if no message is reserved.
+		 */
+		void cancel () throw ();
 
 		/**
 		 * Gets the message from the head of this queue and removes it
@@ -84,14 +163,58 @@ namespace shared
 		 */
 		bool pop (Message& msg, UInt32 current_millis) throw ();
 
+		/**
+		 * Passes the message at the head of this queue to the visitor
+		 * and removes it
+		 *
+		 * Works like pop(), except that the message is handled where
+		 * it is stored instead of being copied out. Its slot returns
+		 * to the pool only after the visitor is done.
+		 *
+		 * @param visitor the object to handle the message
+		 * @param current_millis the current millis value
+		 *
+		 * @return true if a message was visited, false if the queue was
+		 *   empty or its head message is not due yet
+		 */
+		bool popAndVisit (Visitor& visitor, UInt32 current_millis);
+
+		/**
+		 * Discards all messages of the given task from this queue
+		 *
+		 * @param task_id the ID of the task whose messages to discard
+		 *
+		 * @return the number of discarded messages
+		 */
+		UInt8 remove (UInt16 task_id) throw ();
+
+		/**
+		 * Records the current size of this queue in the depth histogram
+		 * of its profile
+		 *
+		 * Does nothing unless built with ROBOCOM_QUEUE_PROFILE defined.
+		 */
+		void sampleDepth () throw ()
+		{
+#if defined(ROBOCOM_QUEUE_PROFILE)
+			m_profile.recordDepth( m_size );
+#endif
+		}
+
 		///@}
 
 	private:
 
+		MessageListNode* _unlinkHead (UInt32 current_millis) throw ();
+
 		MessagePool* m_p_pool;
 		MessageListNode* m_p_head;
+		MessageListNode* m_p_reserved;
 		UInt8 m_size;
 		UInt8 m_max_size;
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		QueueProfile m_profile;
+#endif
 	};
 
 } }
@@ -0,0 +1,155 @@
+#ifndef ROBOCOM_SHARED_MPU_FIFO_READER_HXX
+#define ROBOCOM_SHARED_MPU_FIFO_READER_HXX
+
+#include "shared_base.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class template decides when the FIFO of an MPU6050 is read
+	 * over I2C, and drains it
+	 *
+	 * The MPU class provides the I2C transactions used here, with the
+	 * signatures of the MPU6050 library:
+	 *
+	 * @code
+	 * uint8_t getIntStatus ();
+	 * uint16_t getFIFOCount ();
+	 * void getFIFOBytes (uint8_t* data, uint8_t length);
+	 * void resetFIFO ();
+	 * @endcode
+	 *
+	 * No transaction is done unless the data ready flag is set, which
+	 * the interrupt of the MPU6050 does, or MAX_POLL_INTERVAL_MILLIS
+	 * passed since the last poll. The logic does not depend on the
+	 * hardware, so the host tests run it against a mock MPU.
+	 */
+	template <class MPU>
+	class MpuFifoReader
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		enum
+		{
+			/// The data ready bit of INT_STATUS
+			INT_STATUS_DATA_READY = 0x02,
+
+			/// The FIFO overflow bit of INT_STATUS
+			INT_STATUS_FIFO_OFLOW = 0x10,
+
+			/// The size of the FIFO of the MPU6050
+			FIFO_SIZE = 1024,
+
+			/// The FIFO is polled at least this often even without
+			/// an interrupt, in case an edge was missed
+			MAX_POLL_INTERVAL_MILLIS = 100
+		};
+
+		///@}
+
+		/// @name Construction
+		///@{
+
+		/**
+		 * Constructor
+		 *
+		 * @param mpu the MPU6050 whose FIFO is read
+		 */
+		explicit MpuFifoReader (MPU& mpu) throw ()
+			: m_mpu( mpu )
+			, m_last_poll_millis( 0 )
+			, m_packet_size( 0 )
+		{ }
+
+		///@}
+
+		/// @name Modifiers
+		///@{
+
+		/**
+		 * Sets the size of the packets the DMP writes to the FIFO
+		 */
+		void setPacketSize (UInt16 packet_size) throw ()
+		{
+			m_packet_size = packet_size;
+		}
+
+		/**
+		 * Reads the newest complete packet from the FIFO, if it is time
+		 * to check it
+		 *
+		 * The data ready flag is cleared before the MPU is queried, so
+		 * that a packet arriving meanwhile is not missed. It is set
+		 * again when the DMP is still writing a packet, so that the next
+		 * call checks once more instead of spinning on the FIFO count
+		 * here. All complete packets are read in one burst; the older
+		 * ones are stale by now. An overflowed FIFO is reset.
+		 *
+		 * @param current_millis the current time in millis
+		 * @param is_data_ready the data ready flag set by the interrupt
+		 * @param p_packet receives the packet, must hold the packet size
+		 * @return true if a packet was read
+		 */
+		bool read (
+			UInt32 current_millis,
+			volatile bool& is_data_ready,
+			UInt8* p_packet ) throw ()
+		{
+			if ( ! is_data_ready
+			     && current_millis - m_last_poll_millis
+			     < MAX_POLL_INTERVAL_MILLIS )
+			{
+				return false;
+			}
+
+			is_data_ready = false;
+			m_last_poll_millis = current_millis;
+
+			// Reading INT_STATUS also clears the interrupt on the MPU6050
+			const UInt8 int_status = m_mpu.getIntStatus();
+			UInt16 fifo_count = m_mpu.getFIFOCount();
+
+			if ( 0 != (int_status & INT_STATUS_FIFO_OFLOW)
+			     || fifo_count >= FIFO_SIZE )
+			{
+				m_mpu.resetFIFO();
+				return false;
+			}
+
+			if ( 0 == m_packet_size || fifo_count < m_packet_size ) {
+				if ( 0 != (int_status & INT_STATUS_DATA_READY) ) {
+					is_data_ready = true;
+				}
+				return false;
+			}
+
+			while ( fifo_count >= m_packet_size ) {
+				m_mpu.getFIFOBytes( p_packet, (UInt8)m_packet_size );
+				fifo_count -= m_packet_size;
+			}
+
+			return true;
+		}
+
+		///@}
+
+	private:
+
+		MpuFifoReader (const MpuFifoReader&);
+		MpuFifoReader& operator= (const MpuFifoReader&);
+
+		MPU& m_mpu;
+		UInt32 m_last_poll_millis;
+		UInt16 m_packet_size;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef ROBOCOM_SHARED_QUEUE_PROFILE_HPP
+#define ROBOCOM_SHARED_QUEUE_PROFILE_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class accumulates statistics of a MessageQueue
+	 *
+	 * It keeps two histograms of base 2 logarithms:
+	 * - the residency time, which is how long a message waited in the
+	 *   queue after it was due (or after it was queued, if that was
+	 *   later), in millis
+	 * - the depth of the queue, sampled once per server loop
+	 *
+	 * Bucket 0 counts the values below 2, bucket N the values from 2^N
+	 * up to 2^(N+1) - 1, and the last bucket also counts all the larger
+	 * values. The histogram counts stop at MAX_BUCKET_VALUE.
+	 *
+	 * Queues only keep a profile when built with ROBOCOM_QUEUE_PROFILE
+	 * defined.
+	 */
+	class QueueProfile
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		/// The histograms of the profile
+		enum Histogram
+		{
+			HISTOGRAM_RESIDENCY,
+			HISTOGRAM_DEPTH,
+			HISTOGRAM_COUNT
+		};
+
+		enum
+		{
+			/// The number of buckets of the residency time histogram
+			RESIDENCY_BUCKET_COUNT = 12,
+
+			/// The number of buckets of the depth histogram
+			DEPTH_BUCKET_COUNT = 6,
+
+			/// The maximum value of a histogram bucket
+			MAX_BUCKET_VALUE = 0xFFFF,
+
+			/// The maximum residency time that can be recorded
+			MAX_RESIDENCY_MILLIS = 0xFFFF
+		};
+
+		///@}
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates a new instance with no measurements
+		 */
+		QueueProfile () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns the number of buckets of the given histogram
+		 *
+		 * @pre histogram < HISTOGRAM_COUNT
+		 */
+		static UInt8 getBucketCount (UInt8 histogram) throw ();
+
+		/**
+		 * Returns the value of a histogram bucket
+		 *
+		 * @pre histogram < HISTOGRAM_COUNT
+		 * @pre bucket < getBucketCount( histogram )
+		 */
+		UInt16 getBucket (UInt8 histogram, UInt8 bucket) const throw ();
+
+		/**
+		 * Returns a pointer to the buckets of the given histogram
+		 *
+		 * @pre histogram < HISTOGRAM_COUNT
+		 */
+		const UInt16* getBuckets (UInt8 histogram) const throw ();
+
+		/**
+		 * Returns the longest residency time in millis
+		 */
+		UInt16 getMaxResidencyMillis () const throw ()
+		{
+			return m_max_residency_millis;
+		}
+
+		/**
+		 * Returns the number of messages dropped because there was no
+		 * free slot in the pool
+		 */
+		UInt16 getDropCount () const throw ()
+		{
+			return m_drop_count;
+		}
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all measurements
+		 */
+		void clear () throw ();
+
+		/**
+		 * Records the residency time of a message leaving the queue
+		 *
+		 * Times above MAX_RESIDENCY_MILLIS are recorded as
+		 * MAX_RESIDENCY_MILLIS.
+		 */
+		void recordResidency (UInt32 millis) throw ();
+
+		/**
+		 * Records a sample of the queue depth
+		 */
+		void recordDepth (UInt8 depth) throw ();
+
+		/**
+		 * Records a message that could not be queued
+		 */
+		void recordDrop () throw ();
+
+		///@}
+
+	private:
+
+		static void _record (
+			UInt16* p_buckets,
+			UInt8 bucket_count,
+			UInt32 value
+		) throw ();
+
+		UInt16 m_residency[RESIDENCY_BUCKET_COUNT];
+		UInt16 m_depth[DEPTH_BUCKET_COUNT];
+		UInt16 m_max_residency_millis;
+		UInt16 m_drop_count;
+	};
+
+} }
+
+#endif
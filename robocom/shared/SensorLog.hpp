@@ -0,0 +1,316 @@
+#ifndef ROBOCOM_SHARED_SENSOR_LOG_HPP
+#define ROBOCOM_SHARED_SENSOR_LOG_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class keeps the sensor samples taken at a fixed rate in
+	 * a ring buffer, until the client fetches them
+	 *
+	 * Each sample is stored as a record holding the selected channels,
+	 * in the order of the Channel values, with the same byte order as
+	 * the messages. The records carry no timestamp: sample number n was
+	 * taken at getStartMillis() + n * getPeriodMillis(). When the buffer
+	 * is full, a new sample overwrites the oldest one, which is counted
+	 * as an overflow. Samples whose time passed before they could be
+	 * taken are skipped by skipMissed() and counted as missed, which
+	 * leaves a gap in the numbering. The buffer remembers one gap;
+	 * fetch() stops at it, so each blob holds consecutive samples.
+	 *
+	 * fetch() moves the oldest records into a blob, which starts with
+	 * a header:
+	 * - the start millis (UInt32)
+	 * - the number of the first sample (UInt32)
+	 * - the period in millis (UInt16)
+	 * - the overflow count (UInt16)
+	 * - the channels (UInt8)
+	 * - the number of records (UInt8)
+	 *
+	 * parseHeader() and unpackRecord() read the blob on the client.
+	 */
+	class SensorLog
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		/// The sensor data that can be logged
+		enum Channel
+		{
+			/// The raw DMP quaternion w, x, y, z of the gyro (4 x SInt16)
+			CHANNEL_QUATERNION = 0x01,
+
+			/// The yaw of the gyro in Angle units, modulo a full turn
+			/// (SInt16)
+			CHANNEL_YAW = 0x02,
+
+			/// The tick totals of both encoders, modulo 2^16 (2 x UInt16)
+			CHANNEL_ENCODERS = 0x04,
+
+			CHANNEL_ALL = 0x07
+		};
+
+		enum
+		{
+			/// The size of the ring buffer in bytes
+			CAPACITY = 64,
+
+			/// The size of a record with all channels
+			MAX_RECORD_SIZE = 14,
+
+			/// The size of the header of a fetched blob
+			HEADER_SIZE = 14
+		};
+
+		///@}
+
+
+		/// @name Nested types
+		///@{
+
+		/**
+		 * The values of all channels of one sample
+		 */
+		struct Sample
+		{
+			SInt16 quaternion[4];
+			SInt16 yaw;
+			UInt16 encoder_ticks[2];
+		};
+
+		/**
+		 * The header of a fetched blob
+		 */
+		struct Header
+		{
+			UInt32 start_millis;
+			UInt32 first_index;
+			UInt16 period_millis;
+			UInt16 overflow_count;
+			UInt8 channels;
+			UInt8 record_count;
+		};
+
+		///@}
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an empty log which is not running
+		 */
+		SensorLog () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns whether samples are being taken
+		 */
+		bool isRunning () const throw ()
+		{
+			return m_is_running;
+		}
+
+		/**
+		 * Returns the logged channels
+		 */
+		UInt8 getChannels () const throw ()
+		{
+			return m_channels;
+		}
+
+		/**
+		 * Returns the time between two samples
+		 */
+		UInt16 getPeriodMillis () const throw ()
+		{
+			return m_period_millis;
+		}
+
+		/**
+		 * Returns the time of the first sample
+		 */
+		UInt32 getStartMillis () const throw ()
+		{
+			return m_start_millis;
+		}
+
+		/**
+		 * Returns the number of records in the buffer
+		 */
+		UInt8 getRecordCount () const throw ()
+		{
+			return m_record_count;
+		}
+
+		/**
+		 * Returns the number of samples overwritten before they were
+		 * fetched, modulo 2^16
+		 */
+		UInt16 getOverflowCount () const throw ()
+		{
+			return m_overflow_count;
+		}
+
+		/**
+		 * Returns the number of samples skipped because their time
+		 * passed before they were taken, modulo 2^16
+		 */
+		UInt16 getMissedCount () const throw ()
+		{
+			return m_missed_count;
+		}
+
+		/**
+		 * Returns the number of the next sample
+		 */
+		UInt32 getNextIndex () const throw ()
+		{
+			return m_next_index;
+		}
+
+		/**
+		 * Returns the time at which the next sample is due
+		 */
+		UInt32 getDueMillis () const throw ()
+		{
+			return m_start_millis + m_next_index * m_period_millis;
+		}
+
+		/**
+		 * Returns the size of a record with the given channels
+		 */
+		static UInt8 getRecordSize (UInt8 channels) throw ();
+
+		///@}
+
+
+		/// @name Methods
+		///@{
+
+		/**
+		 * Discards all records and starts taking samples
+		 *
+		 * @param channels the bit mask of the channels to log
+		 * @param period_millis the time between two samples
+		 * @param start_millis the time of the first sample
+		 *
+		 * @pre channels != 0 && ( channels & ~CHANNEL_ALL ) == 0
+		 * @pre period_millis != 0
+		 */
+		void start (
+			UInt8 channels,
+			UInt16 period_millis,
+			UInt32 start_millis
+		) throw ();
+
+		/**
+		 * Stops taking samples; the records can still be fetched
+		 */
+		void stop () throw ()
+		{
+			m_is_running = false;
+		}
+
+		/**
+		 * Skips the samples that were due before the given time,
+		 * except the newest one
+		 *
+		 * A sample taken late is stored by append() as the newest one
+		 * that was due, so that its time stays on the grid of the
+		 * period. The samples before it are counted as missed. If the
+		 * buffer already holds a gap, the records before that older gap
+		 * are dropped and counted as overflows.
+		 *
+		 * @param current_millis the time the sample is taken
+		 *
+		 * @return the number of skipped samples
+		 *
+		 * @pre isRunning()
+		 */
+		UInt32 skipMissed (UInt32 current_millis) throw ();
+
+		/**
+		 * Stores a sample, overwriting the oldest one if the buffer
+		 * is full
+		 *
+		 * @pre isRunning()
+		 */
+		void append (const Sample& sample) throw ();
+
+		/**
+		 * Moves the oldest records into a blob
+		 *
+		 * The blob ends at a gap in the numbering; the records after it
+		 * come with the next call.
+		 *
+		 * @param p_buffer receives the blob
+		 * @param max_size the size of the buffer
+		 *
+		 * @return the size of the blob
+		 *
+		 * @pre max_size >= HEADER_SIZE
+		 */
+		UInt16 fetch (UInt8* p_buffer, UInt16 max_size) throw ();
+
+		/**
+		 * Reads the header of a fetched blob
+		 *
+		 * @return false if the blob is too short for its records
+		 */
+		static bool parseHeader (
+			const UInt8* p_blob,
+			UInt16 size,
+			Header& header
+		) throw ();
+
+		/**
+		 * Reads a record of a fetched blob
+		 *
+		 * The channels that were not logged are left unchanged.
+		 *
+		 * @param p_record the record
+		 * @param channels the logged channels
+		 * @param sample receives the values
+		 */
+		static void unpackRecord (
+			const UInt8* p_record,
+			UInt8 channels,
+			Sample& sample
+		) throw ();
+
+		///@}
+
+	private:
+
+		void _dropOldest () throw ();
+
+		UInt8 m_buffer[CAPACITY];
+		UInt32 m_start_millis;
+		UInt32 m_next_index;
+		UInt32 m_gap_size;
+		UInt16 m_period_millis;
+		UInt16 m_overflow_count;
+		UInt16 m_missed_count;
+		UInt8 m_channels;
+		UInt8 m_record_size;
+		UInt8 m_slot_count;
+		UInt8 m_first_slot;
+		UInt8 m_record_count;
+		UInt8 m_gap_record_count;
+		bool m_is_running;
+	};
+
+} }
+
+#endif // ROBOCOM_SHARED_SENSOR_LOG_HPP
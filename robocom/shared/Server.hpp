@@ -5,10 +5,16 @@
 
 // Component includes
 #include "msg/msg_fwds.hpp"
+#include "BlobAssembler.hpp"
+#include "MessageDispatch.hxx"
 #include "MessageIO.hpp"
 #include "MessagePool.hpp"
 #include "MessageQueue.hpp"
 
+#if defined(ROBOCOM_LOOP_PROFILE)
+#include "LoopProfile.hpp"
+#endif
+
 
 namespace robocom {
 namespace shared
@@ -25,6 +31,119 @@ namespace shared
 	{
 	public:
 
+		/// @name Exported Constants
+		///@{
+
+		enum
+		{
+			/**
+			 * Maximum number of tasks whose messages can be repeated
+			 * at the same time (see msg::RepeatRequest)
+			 */
+			MAX_REPEATED_TASKS = 4,
+
+			/**
+			 * Maximum number of periodic tasks (see addTask())
+			 */
+			MAX_TASKS = 4,
+
+			/**
+			 * Value returned by addTask() when there is no free slot
+			 */
+			NO_TASK = 0xFF,
+
+			/**
+			 * Number of pool slots kept out of the credits granted to
+			 * the client, for the output messages and repeated tasks
+			 * (see msg::CreditNotice)
+			 */
+			CREDIT_RESERVE_SLOTS = 8,
+
+			/**
+			 * The credit limit is only advertised on its own when it
+			 * grew by at least this much, so that the notices do not
+			 * take over the output
+			 */
+			CREDIT_NOTICE_STEP = 4,
+
+			/**
+			 * Size of the buffer for the blobs sent by the client
+			 * (see msg::BlobFragment); the firmware takes no blobs, so
+			 * it keeps the RAM and rejects all but empty ones
+			 */
+#if defined(AVR)
+			MAX_BLOB_SIZE = 0
+#else
+			MAX_BLOB_SIZE = 64
+#endif
+		};
+
+		///@}
+
+
+		/// @name Nested types
+		///@{
+
+		/**
+		 * Interface of tasks run by the scheduler of the server
+		 *
+		 * Tasks are cooperative: run() should do a bounded amount of work
+		 * and return, so that the server can get back to the communication
+		 * with the client.
+		 */
+		class Task
+		{
+		public:
+
+			/**
+			 * Destroys this object
+			 */
+			virtual ~Task () throw ()
+			{ }
+
+			/**
+			 * Returns whether an event has happened that the task should
+			 * handle before its period elapses
+			 *
+			 * The function is called on every loop, so it should be cheap,
+			 * like checking a flag set by an interrupt handler.
+			 *
+			 * The default implementation returns false.
+			 */
+			virtual bool isReady () throw ()
+			{
+				return false;
+			}
+
+			/**
+			 * Performs the work of the task
+			 */
+			virtual void run () throw () = 0;
+		};
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+		/**
+		 * Run-time accounting of a task
+		 */
+		struct TaskStats
+		{
+			/// Number of runs of the task
+			UInt32 run_count;
+
+			/// Total time spent in the task in microseconds
+			UInt32 total_micros;
+
+			/// Longest run of the task in microseconds
+			UInt32 max_micros;
+
+			/// Number of runs that started after the deadline
+			UInt32 late_count;
+		};
+#endif
+
+		///@}
+
+
 		/// @name Lifetime management
 		///@{
 
@@ -50,14 +169,17 @@ namespace shared
 		/**
 		 * Returns the number of milliseconds since an unspecified time
 		 * during execution of the current process.
+		 *
+		 * The function is virtual so that tests can run the server
+		 * on a virtual clock.
 		 */
-		UInt32 getMillis () const throw ();
+		virtual UInt32 getMillis () const throw ();
 
 		/**
 		 * Returns the number of microseconds since an unspecified time
 		 * during execution of the current process.
 		 */
-		UInt32 getMicros () const throw ();
+		virtual UInt32 getMicros () const throw ();
 
 		/**
 		 * Sets up the server environment
@@ -81,6 +203,110 @@ namespace shared
 		 */
 		void loop ();
 
+		/**
+		 * Registers a task to be run by this server
+		 *
+		 * The task runs once every period, and also whenever its
+		 * isReady() function returns true. A task with the period of zero
+		 * runs only on events. A run that starts later than the deadline
+		 * after the time the task became due is counted as late. When
+		 * several tasks are due, the one with the earliest deadline runs
+		 * first.
+		 *
+		 * @param task the task to run; it must outlive this object
+		 * @param period_micros the period of the task in microseconds
+		 * @param deadline_micros the time after the task became due by
+		 *  which it should have started
+		 *
+		 * @return the index of the task, or NO_TASK if there is no more
+		 *  space for tasks
+		 */
+		UInt8 addTask (
+			Task& task,
+			UInt32 period_micros,
+			UInt32 deadline_micros
+		) throw ();
+
+		/**
+		 * Returns the number of registered tasks
+		 */
+		UInt8 getTaskCount () const throw ()
+		{
+			return m_task_count;
+		}
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+		/**
+		 * Returns the run-time accounting of a task
+		 *
+		 * Only available when built with ROBOCOM_LOOP_PROFILE defined.
+		 *
+		 * @param index the index of the task returned by addTask()
+		 *
+		 * @pre index < getTaskCount()
+		 */
+		const TaskStats& getTaskStats (UInt8 index) const throw ();
+
+		/**
+		 * Resets the run-time accounting of all tasks
+		 */
+		void clearTaskStats () throw ();
+#endif
+
+		/**
+		 * Returns the number of messages which no handler took, because
+		 * handleMessage() returned false for them; wraps around
+		 */
+		UInt16 getUnhandledCount () const throw ()
+		{
+			return m_unhandled_count;
+		}
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+		/**
+		 * Returns the time spent in the phases of loop()
+		 *
+		 * Only available when built with ROBOCOM_LOOP_PROFILE defined.
+		 * Clients get the same data with a LoopStatsRequest.
+		 */
+		const LoopProfile& getLoopProfile () const throw ()
+		{
+			return m_loop_profile;
+		}
+
+		/**
+		 * Discards the measurements of the phases of loop()
+		 */
+		void clearLoopProfile () throw ()
+		{
+			m_loop_profile.clear();
+		}
+#endif
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		/**
+		 * Returns the statistics of the input queue
+		 *
+		 * Only available when built with ROBOCOM_QUEUE_PROFILE defined.
+		 * Clients get the same data with a QueueStatsRequest.
+		 */
+		const QueueProfile& getInputQueueProfile () const throw ()
+		{
+			return m_input_queue.getProfile();
+		}
+
+		/**
+		 * Returns the statistics of the output queue
+		 *
+		 * Only available when built with ROBOCOM_QUEUE_PROFILE defined.
+		 * Clients get the same data with a QueueStatsRequest.
+		 */
+		const QueueProfile& getOutputQueueProfile () const throw ()
+		{
+			return m_output_queue.getProfile();
+		}
+#endif
+
 		///@}
 
 	protected:
@@ -102,6 +328,25 @@ namespace shared
 		 */
 		void addResponse (const Message& msg) throw ();
 
+		/**
+		 * Sends the given blob to the client
+		 *
+		 * The fragments go out right away, as far as the IO can take
+		 * them, and the rest waits in the output queue for the next
+		 * flush. Blobs larger than the free slots of the pool do not fit.
+		 *
+		 * @param task_id the ID of the task for the transfer
+		 * @param p_data the bytes of the blob
+		 * @param size the size of the blob
+		 *
+		 * @pre size <= msg::BlobFragment::MAX_BLOB_SIZE
+		 */
+		void writeBlob (
+			UInt16 task_id,
+			const UInt8* p_data,
+			UInt16 size
+		) throw ();
+
 		/**
 		 * Method called by the framework when the client requests the reset
 		 * of the robot state
@@ -123,9 +368,31 @@ namespace shared
 		 * of the system, and may cause responses to be generated and added
 		 * to this server.
 		 *
+		 * The default implementation does not handle any message.
+		 *
+		 * @return true if the message was handled, false if its type
+		 *  is unknown (see getUnhandledCount())
+		 */
+		virtual bool handleMessage (const Message& msg);
+
+		/**
+		 * Method called by the framework when a blob from the client
+		 * arrived
+		 *
+		 * The data is only valid during the call; the framework confirms
+		 * the blob to the client once this function returns.
+		 *
 		 * The default implementation does not do anything.
+		 *
+		 * @param task_id the ID of the task of the transfer
+		 * @param p_data the bytes of the blob
+		 * @param size the size of the blob
 		 */
-		virtual void handleMessage (const Message& msg);
+		virtual void handleBlob (
+			UInt16 task_id,
+			const UInt8* p_data,
+			UInt16 size
+		);
 
 		/**
 		 * Method called by the framework periodically
@@ -133,25 +400,150 @@ namespace shared
 		 * Derived classes should gather any new measurements and add any
 		 * generated responses this server.
 		 *
+		 * Periodic work is better done in tasks (see addTask()), which run
+		 * only when they are due.
+		 *
 		 * The default implementation does not do anything.
 		 */
 		virtual void handleStateUpdate ();
 
+		/**
+		 * Method called by the framework when a loop found no message
+		 * to process and no task to run
+		 *
+		 * The default implementation puts arduino into the idle sleep
+		 * mode, from which it wakes up on the next interrupt (at the latest
+		 * on the next tick of the millis timer). It does nothing on
+		 * other platforms.
+		 */
+		virtual void handleIdle ();
+
 		///@}
 
 	private:
 
+		/**
+		 * Dispatches the messages popped from the input queue
+		 */
+		class DispatchVisitor
+			: public MessageQueue::Visitor
+		{
+		public:
+
+			explicit DispatchVisitor (Server& server) throw ()
+				: m_server( server )
+			{ }
+
+			virtual void visit (const Message& msg);
+
+		private:
+
+			Server& m_server;
+		};
+
+		/**
+		 * Writes the messages popped from the output queue
+		 */
+		class WriteVisitor
+			: public MessageQueue::Visitor
+		{
+		public:
+
+			explicit WriteVisitor (MessageIO& io) throw ()
+				: m_io( io )
+			{ }
+
+			virtual void visit (const Message& msg);
+
+		private:
+
+			MessageIO& m_io;
+		};
+
+		typedef MessageDispatch<Server> Dispatch;
+
+		/**
+		 * Routes of the framework messages, specialized in the
+		 * implementation; the others go to the input queue
+		 */
+		template <int MSGID> struct Route
+			: Dispatch::Unrouted
+		{ };
+
+		static const Dispatch::Handler ROUTES[Dispatch::TABLE_SIZE];
+
 		Server (const Server&);
 		void operator= (const Server&);
 
 		void _onNewMessage (const Message& msg);
+		void _handleEcho (const msg::EchoRequest& req);
 		void _handleReset (const msg::ResetRequest& req);
 		void _handleFlush (const msg::FlushRequest& req);
-		
+		void _continueFlush ();
+		void _write (const Message& msg);
+		void _handleRepeat (const msg::RepeatRequest& req);
+		void _handleLoopStats (const msg::LoopStatsRequest& req);
+		void _handleQueueStats (const msg::QueueStatsRequest& req);
+		void _handleCodec (const msg::CodecRequest& req);
+		void _handleHello (const msg::HelloRequest& req);
+		void _handleBlobFragment (const msg::BlobFragment& fragment);
+		void _repeatMessage (const Message& msg);
+		bool _runTasks ();
+		bool _isTaskDue (UInt8 index, UInt32 current_micros) throw ();
+		UInt16 _getCreditLimit () const throw ();
+		void _advertiseCredits ();
+
 		MessagePool m_pool;
 		MessageQueue m_input_queue;
 		MessageQueue m_output_queue;
 		MessageIO m_io;
+
+		struct RepeatedTask
+		{
+			UInt16 task_id;
+			UInt32 period_millis;
+		};
+
+		RepeatedTask m_repeated_tasks[MAX_REPEATED_TASKS];
+		UInt16 m_unhandled_count;
+
+		struct TaskSlot
+		{
+			Task* p_task;
+			UInt32 period_micros;
+			UInt32 deadline_micros;
+			UInt32 due_micros;
+			bool is_ready;
+#if defined(ROBOCOM_LOOP_PROFILE)
+			TaskStats stats;
+#endif
+		};
+
+		TaskSlot m_tasks[MAX_TASKS];
+		UInt8 m_task_count;
+
+		// Counters of the credit-based flow control, both wrap around.
+		// Credits are only advertised to a client which listed
+		// FEATURE_CREDIT in its HelloRequest, from its next reset on.
+		UInt16 m_received_count;
+		UInt16 m_advertised_credit_limit;
+		bool m_is_credit_synced;
+		bool m_is_credit_wanted;
+
+		// The blob being sent by the client
+#if ! defined(AVR)
+		UInt8 m_blob_buffer[MAX_BLOB_SIZE];
+#endif
+		BlobAssembler m_blob_assembler;
+
+		// Flush waiting for the IO to take the rest of the output
+		bool m_is_flush_pending;
+		UInt16 m_flush_task_id;
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+		LoopProfile m_loop_profile;
+#endif
+
 #if ! defined(AVR)
 		SInt64 m_base_seconds;
 #endif
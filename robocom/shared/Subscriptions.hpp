@@ -0,0 +1,180 @@
+#ifndef ROBOCOM_SHARED_SUBSCRIPTIONS_HPP
+#define ROBOCOM_SHARED_SUBSCRIPTIONS_HPP
+
+#include "shared_base.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	/**
+	 * This class keeps the clients subscribed to the readings of one
+	 * sensor
+	 *
+	 * Each subscriber limits how much of the sensor output it receives:
+	 * - the minimum interval between two reports, in millis,
+	 * - the decimation factor; only every n-th reading is considered,
+	 * - the change threshold; a reading is reported only if its value
+	 *   moved by more than the threshold since the last report to the
+	 *   subscriber.
+	 *
+	 * The sensor offers every new reading to the subscriptions, which
+	 * answer which of the subscribers should get it. The meaning of the
+	 * value and of the format is up to the sensor.
+	 */
+	class Subscriptions
+	{
+	public:
+
+		/// @name Exported Constants
+		///@{
+
+		/// The number of subscribers a single sensor can have
+		enum { MAX_SUBSCRIBERS = 2 };
+
+		///@}
+
+
+		/// @name Nested types
+		///@{
+
+		/**
+		 * A single subscription
+		 */
+		struct Subscriber
+		{
+			UInt16 task_id;
+			UInt8 format;
+			UInt8 decimation;
+			UInt16 change_threshold;
+			UInt32 min_interval_millis;
+
+			UInt32 last_report_millis;
+			SInt32 last_value;
+			UInt8 skipped;
+			bool has_reported;
+		};
+
+		///@}
+
+
+		/// @name Lifetime management
+		///@{
+
+		/**
+		 * Creates an empty list of subscriptions
+		 */
+		Subscriptions () throw ();
+
+		///@}
+
+
+		/// @name Accessors
+		///@{
+
+		/**
+		 * Returns whether there are no subscribers
+		 */
+		bool isEmpty () const throw ()
+		{
+			return 0 == m_count;
+		}
+
+		/**
+		 * Returns whether any subscriber wants the reports in the given
+		 * format
+		 */
+		bool hasFormat (UInt8 format) const throw ();
+
+		/**
+		 * Returns the number of subscribers
+		 */
+		UInt8 getCount () const throw ()
+		{
+			return m_count;
+		}
+
+		/**
+		 * Returns the subscriber at the given position
+		 *
+		 * @pre i < getCount()
+		 */
+		const Subscriber& get (UInt8 i) const throw ()
+		{
+			return m_subscribers[i];
+		}
+
+		///@}
+
+
+		/// @name Modifiers
+		///@{
+
+		/**
+		 * Adds a subscriber, or changes the subscription with the same
+		 * task ID
+		 *
+		 * @param task_id the task ID of the reports
+		 * @param format the sensor specific format of the reports
+		 * @param min_interval_millis the minimum number of millis between
+		 *   two reports
+		 * @param decimation report only every n-th reading; both 0 and 1
+		 *   mean every reading
+		 * @param change_threshold the change of the value required for
+		 *   a report; 0 reports any reading
+		 * @return false if there is no room for another subscriber
+		 */
+		bool subscribe (
+			UInt16 task_id,
+			UInt8 format,
+			UInt32 min_interval_millis,
+			UInt8 decimation,
+			UInt16 change_threshold
+		) throw ();
+
+		/**
+		 * Removes the subscription with the given task ID
+		 *
+		 * @return false if there is no such subscription
+		 */
+		bool unsubscribe (UInt16 task_id) throw ();
+
+		/**
+		 * Removes all subscriptions
+		 */
+		void clear () throw ()
+		{
+			m_count = 0;
+		}
+
+		/**
+		 * Offers a new reading to the subscribers
+		 *
+		 * The subscribers that get the reading are marked as reported.
+		 *
+		 * @param value the value of the reading compared with the change
+		 *   threshold
+		 * @param current_millis the time of the reading
+		 * @param modulus if not zero, the values wrap around at this
+		 *   modulus, as angles do; the change is measured the shorter
+		 *   way around
+		 * @return the bit mask of the subscribers that should get
+		 *   a report; bit i stands for get(i)
+		 */
+		UInt8 offer (
+			SInt32 value,
+			UInt32 current_millis,
+			SInt32 modulus
+		) throw ();
+
+		///@}
+
+	private:
+
+		Subscriber m_subscribers[MAX_SUBSCRIBERS];
+		UInt8 m_count;
+	};
+
+} }
+
+#endif
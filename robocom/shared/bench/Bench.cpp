@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace robocom {
+namespace shared {
+namespace bench
+{
+
+	namespace
+	{
+
+		// The head of the list of the registered benchmarks
+		Benchmark* s_p_first = 0;
+
+
+		bool
+		isNameLess (const Benchmark* p_a, const Benchmark* p_b)
+		{
+			return ::strcmp( p_a->getName(), p_b->getName() ) < 0;
+		}
+
+
+		double
+		runOnce (Benchmark::Function p_function, UInt32 iteration_count)
+		{
+			State state( iteration_count );
+			(*p_function)( state );
+			return state.getElapsedNanos();
+		}
+
+	}
+
+
+	double
+	State::getNanos () throw ()
+	{
+		::timespec ts;
+		::clock_gettime( CLOCK_MONOTONIC, & ts );
+		return ts.tv_sec * 1e9 + ts.tv_nsec;
+	}
+
+
+	Benchmark::Benchmark (const char* p_name, Function p_function) throw ()
+		: m_p_name( p_name )
+		, m_p_function( p_function )
+		, m_p_next( s_p_first )
+	{
+		s_p_first = this;
+	}
+
+
+	int
+	Benchmark::run (const char* p_filter)
+	{
+		// The order of registration depends on the linker, the order
+		// of the names does not
+		std::vector<const Benchmark*> benchmarks;
+		for ( const Benchmark* p = s_p_first; 0 != p; p = p->m_p_next )
+		{
+			if ( 0 == p_filter || 0 != ::strstr( p->m_p_name, p_filter ) ) {
+				benchmarks.push_back( p );
+			}
+		}
+		std::sort( benchmarks.begin(), benchmarks.end(), isNameLess );
+
+		for ( size_t i = 0; i < benchmarks.size(); i++ ) {
+			benchmarks[i]->_run();
+		}
+
+		return static_cast<int>( benchmarks.size() );
+	}
+
+
+	void
+	Benchmark::_run () const
+	{
+		const double MIN_SAMPLE_NANOS = MIN_SAMPLE_MILLIS * 1e6;
+
+		// Also warms up the caches
+		UInt32 iteration_count = 1;
+		while ( runOnce( m_p_function, iteration_count ) < MIN_SAMPLE_NANOS &&
+				iteration_count < 0x80000000u / 10 )
+		{
+			iteration_count *= 10;
+		}
+
+		double samples[SAMPLE_COUNT];
+		for ( int i = 0; i < SAMPLE_COUNT; i++ ) {
+			samples[i] = runOnce( m_p_function, iteration_count ) / iteration_count;
+		}
+		std::sort( samples, samples + SAMPLE_COUNT );
+
+		::printf(
+			"{\"name\": \"%s\", \"iterations\": %u, \"samples\": %d, "
+			"\"median_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f}\n",
+			m_p_name,
+			iteration_count,
+			static_cast<int>( SAMPLE_COUNT ),
+			samples[SAMPLE_COUNT / 2],
+			samples[0],
+			samples[SAMPLE_COUNT - 1]
+		);
+		::fflush( stdout );
+	}
+
+} } }
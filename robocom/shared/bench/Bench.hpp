@@ -0,0 +1,182 @@
+#ifndef ROBOCOM_SHARED_BENCH_BENCH_HPP
+#define ROBOCOM_SHARED_BENCH_BENCH_HPP
+
+#include "robocom/shared/shared_base.hpp"
+
+namespace robocom {
+namespace shared {
+namespace bench
+{
+
+	/**
+	 * This class gives a benchmark the number of iterations to run and
+	 * times them
+	 *
+	 * The benchmark does its setup, then runs its operation while
+	 * next() returns true. Only the iterations are timed:
+	 *
+	 * @code
+	 * BENCH(Message_SetUInt16)
+	 * {
+	 *     Message msg;
+	 *     msg.setDataSize( 2 );
+	 *     while ( state.next() ) {
+	 *         msg.setUInt16( 0, 0x1234 );
+	 *     }
+	 *     keep( msg );
+	 * }
+	 * @endcode
+	 */
+	class State
+	{
+	public:
+
+		/**
+		 * Creates a state for the given number of iterations
+		 */
+		explicit State (UInt32 iteration_count) throw ()
+			: m_iteration_count( iteration_count )
+			, m_remaining( iteration_count + 1 )
+			, m_start_nanos( 0 )
+			, m_elapsed_nanos( 0 )
+		{ }
+
+		/**
+		 * Starts the clock on the first call and stops it once all
+		 * iterations ran
+		 *
+		 * @return true if the benchmark should run one more iteration
+		 */
+		bool next () throw ()
+		{
+			if ( m_remaining == m_iteration_count + 1 ) {
+				m_start_nanos = getNanos();
+			}
+
+			if ( 0 == --m_remaining )
+			{
+				m_elapsed_nanos = getNanos() - m_start_nanos;
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Returns the number of iterations to run
+		 */
+		UInt32 getIterationCount () const throw ()
+		{
+			return m_iteration_count;
+		}
+
+		/**
+		 * Returns the time taken by the iterations, once they all ran
+		 */
+		double getElapsedNanos () const throw ()
+		{
+			return m_elapsed_nanos;
+		}
+
+		/**
+		 * Returns the time of a monotonic clock in nanoseconds
+		 */
+		static double getNanos () throw ();
+
+	private:
+
+		UInt32 m_iteration_count;
+		UInt32 m_remaining;
+		double m_start_nanos;
+		double m_elapsed_nanos;
+	};
+
+
+	/**
+	 * This class represents one benchmark of the suite
+	 *
+	 * The instances created by BENCH() register themselves, and run()
+	 * runs them all in the order of registration.
+	 */
+	class Benchmark
+	{
+	public:
+
+		typedef void (*Function) (State& state);
+
+		/**
+		 * Registers a benchmark
+		 *
+		 * @param p_name the name of the benchmark, reported with the
+		 *  results
+		 * @param p_function the function running the benchmark
+		 */
+		Benchmark (const char* p_name, Function p_function) throw ();
+
+		/**
+		 * Runs the benchmarks whose name contains the filter and prints
+		 * one line of JSON with the results of each to the standard
+		 * output
+		 *
+		 * The number of iterations is raised until a run takes at least
+		 * MIN_SAMPLE_MILLIS, then SAMPLE_COUNT runs are measured with
+		 * it. The median, fastest and slowest run are reported in
+		 * nanoseconds per iteration.
+		 *
+		 * @param p_filter the part of the name to select, or NULL to
+		 *  run all benchmarks
+		 *
+		 * @return the number of benchmarks run
+		 */
+		static int run (const char* p_filter);
+
+		/**
+		 * Returns the name of this benchmark
+		 */
+		const char* getName () const throw ()
+		{
+			return m_p_name;
+		}
+
+		enum
+		{
+			MIN_SAMPLE_MILLIS = 10,
+			SAMPLE_COUNT = 7
+		};
+
+	private:
+
+		Benchmark (const Benchmark&);
+		void operator= (const Benchmark&);
+
+		void _run () const;
+
+		const char* m_p_name;
+		Function m_p_function;
+		Benchmark* m_p_next;
+	};
+
+
+	/**
+	 * Keeps the compiler from optimizing away the computation of the
+	 * value
+	 */
+	template <class T>
+	inline void
+	keep (const T& value) throw ()
+	{
+		asm volatile ( "" : : "r,m" ( value ) : "memory" );
+	}
+
+} } }
+
+
+/**
+ * Defines a benchmark with the given name; the body gets the State as
+ * the state parameter
+ */
+#define BENCH(NAME) \
+	static void bench##NAME (robocom::shared::bench::State& state); \
+	static robocom::shared::bench::Benchmark s_bench##NAME( #NAME, & bench##NAME ); \
+	static void bench##NAME (robocom::shared::bench::State& state)
+
+#endif // ROBOCOM_SHARED_BENCH_BENCH_HPP
@@ -0,0 +1,188 @@
+#include "robocom/shared/Message.hpp"
+
+#include "Bench.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::bench;
+
+
+namespace
+{
+
+	Message
+	makeMessage (bool is_immediate, UInt8 data_size)
+	{
+		Message msg;
+		msg.clear();
+		msg.setMessageType( 5 );
+		msg.setTaskId( 0x1234 );
+		if ( is_immediate ) {
+			msg.setImmediate();
+		}
+		else {
+			msg.setMillis( 0x00012345 );
+		}
+		msg.setDataSize( data_size );
+
+		for ( UInt8 i = 0; i < data_size; i++ ) {
+			msg.setUInt8( i, i * 17 );
+		}
+		return msg;
+	}
+
+
+	void
+	benchSerialize (State& state, const Message& msg)
+	{
+		UInt8 buffer[Message::MAX_SERIALIZED_SIZE];
+		while ( state.next() )
+		{
+			keep( msg.serializeTo( buffer ) );
+			keep( buffer );
+		}
+	}
+
+
+	void
+	benchDeserialize (State& state, const Message& original)
+	{
+		UInt8 buffer[Message::MAX_SERIALIZED_SIZE];
+		const UInt8 size = original.getSerializedSize();
+		original.serializeTo( buffer );
+
+		Message msg;
+		while ( state.next() )
+		{
+			keep( msg.deserializeFrom( buffer, size ) );
+			keep( msg );
+		}
+	}
+
+}
+
+
+BENCH(Message_GetUInt8)
+{
+	const Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	unsigned offset = 0;
+	while ( state.next() )
+	{
+		keep( msg.getUInt8( offset ) );
+		offset = ( offset + 1 ) % Message::MAX_DATA_SIZE;
+	}
+}
+
+
+BENCH(Message_GetUInt16)
+{
+	const Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	unsigned offset = 0;
+	while ( state.next() )
+	{
+		keep( msg.getUInt16( offset ) );
+		offset = ( offset + 2 ) % Message::MAX_DATA_SIZE;
+	}
+}
+
+
+BENCH(Message_GetUInt32)
+{
+	const Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	unsigned offset = 0;
+	while ( state.next() )
+	{
+		keep( msg.getUInt32( offset ) );
+		offset = ( offset + 4 ) % Message::MAX_DATA_SIZE;
+	}
+}
+
+
+BENCH(Message_GetHeader)
+{
+	const Message msg = makeMessage( false, 4 );
+	while ( state.next() )
+	{
+		keep( msg.getMessageType() );
+		keep( msg.isImmediate() );
+		keep( msg.getTaskId() );
+		keep( msg.getMillis() );
+	}
+}
+
+
+BENCH(Message_SetUInt8)
+{
+	Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	UInt32 i = 0;
+	while ( state.next() )
+	{
+		msg.setUInt8( i % Message::MAX_DATA_SIZE, i );
+		i++;
+	}
+	keep( msg );
+}
+
+
+BENCH(Message_SetUInt16)
+{
+	Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	UInt32 i = 0;
+	while ( state.next() )
+	{
+		msg.setUInt16( ( i * 2 ) % Message::MAX_DATA_SIZE, i );
+		i++;
+	}
+	keep( msg );
+}
+
+
+BENCH(Message_SetUInt32)
+{
+	Message msg = makeMessage( true, Message::MAX_DATA_SIZE );
+	UInt32 i = 0;
+	while ( state.next() )
+	{
+		msg.setUInt32( ( i * 4 ) % Message::MAX_DATA_SIZE, i );
+		i++;
+	}
+	keep( msg );
+}
+
+
+BENCH(Message_SetHeader)
+{
+	Message msg = makeMessage( false, 4 );
+	UInt32 i = 0;
+	while ( state.next() )
+	{
+		msg.setMessageType( i & Message::MAX_MESSAGE_TYPE );
+		msg.setTaskId( i );
+		msg.setMillis( i );
+		i++;
+	}
+	keep( msg );
+}
+
+
+BENCH(Message_SerializeImmediateEmpty)
+{
+	benchSerialize( state, makeMessage( true, 0 ) );
+}
+
+
+BENCH(Message_SerializeTimedFull)
+{
+	benchSerialize( state, makeMessage( false, Message::MAX_DATA_SIZE - 4 ) );
+}
+
+
+BENCH(Message_DeserializeImmediateEmpty)
+{
+	benchDeserialize( state, makeMessage( true, 0 ) );
+}
+
+
+BENCH(Message_DeserializeTimedFull)
+{
+	benchDeserialize( state, makeMessage( false, Message::MAX_DATA_SIZE - 4 ) );
+}
@@ -0,0 +1,198 @@
+#include "robocom/shared/BufferStream.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessageIO.hxx"
+#include "robocom/shared/StreamIO.hpp"
+#include "robocom/shared/msg/GyroQuaternionNotice.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+#include "robocom/shared/msg/SimpleMessage.hxx"
+
+#include "Bench.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::bench;
+using namespace robocom::shared::msg;
+
+
+namespace
+{
+
+	enum
+	{
+		BATCH_SIZE = 8,
+		BATCH_BUFFER_SIZE = 256
+	};
+
+
+	/**
+	 * Stream which replays the same bytes over and over, and drops
+	 * everything written to it
+	 *
+	 * The replayed bytes are whole frames, so a reader always finds
+	 * the next frame without the stream ever running dry.
+	 */
+	class ReplayStream
+		: public StreamIO
+	{
+	public:
+
+		ReplayStream (const UInt8* p_data, UInt32 size)
+			: m_p_data( p_data )
+			, m_size( size )
+			, m_position( 0 )
+			, m_written_count( 0 )
+		{ }
+
+		virtual int available ()
+		{
+			return static_cast<int>( m_size - m_position );
+		}
+
+		virtual int peek ()
+		{
+			return m_p_data[m_position];
+		}
+
+		virtual int read ()
+		{
+			const int b = m_p_data[m_position++];
+			if ( m_position == m_size ) {
+				m_position = 0;
+			}
+			return b;
+		}
+
+		virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+		{
+			// The frames do not cross the end of the data
+			for ( UInt32 i = 0; i < size; i++ ) {
+				p_buffer[i] = static_cast<char>( read() );
+			}
+			return size;
+		}
+
+		virtual UInt32 write (UInt8 b)
+		{
+			m_written_count++;
+			return 1;
+		}
+
+		virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+		{
+			m_written_count += size;
+			return size;
+		}
+
+		UInt32 getWrittenCount () const
+		{
+			return m_written_count;
+		}
+
+	private:
+
+		const UInt8* m_p_data;
+		UInt32 m_size;
+		UInt32 m_position;
+		UInt32 m_written_count;
+	};
+
+
+	/**
+	 * A mix of short and long, immediate and timed messages
+	 */
+	Message
+	makeMessage (UInt16 index)
+	{
+		switch ( index % 3 )
+		{
+		case 0:
+			return NoopRequest( index ).asMessage();
+		case 1:
+			return SetWheelDriveRequest( index, 1000u + index, 1, 200, 0, 100 ).asMessage();
+		default:
+			return GyroQuaternionNotice( index, 1000u + index, -1, 2, -3, 4, index ).asMessage();
+		}
+	}
+
+
+	/**
+	 * Encodes the batch of messages with the given codec
+	 *
+	 * @return the size of the frames
+	 */
+	UInt32
+	encodeBatch (UInt8 codec, UInt8* p_buffer)
+	{
+		BufferStream stream( p_buffer, BATCH_BUFFER_SIZE );
+		BasicMessageIO<BufferStream> io( stream );
+		io.setCodec( codec );
+
+		for ( UInt16 i = 0; i < BATCH_SIZE; i++ ) {
+			io.write( makeMessage( i ) );
+		}
+		return stream.available();
+	}
+
+
+	void
+	benchWrite (State& state, UInt8 codec)
+	{
+		Message batch[BATCH_SIZE];
+		for ( UInt16 i = 0; i < BATCH_SIZE; i++ ) {
+			batch[i] = makeMessage( i );
+		}
+
+		ReplayStream stream( 0, 0 );
+		MessageIO io( stream );
+		io.setCodec( codec );
+
+		UInt32 i = 0;
+		while ( state.next() ) {
+			io.write( batch[i++ % BATCH_SIZE] );
+		}
+		keep( stream.getWrittenCount() );
+	}
+
+
+	void
+	benchRead (State& state, UInt8 codec)
+	{
+		UInt8 frames[BATCH_BUFFER_SIZE];
+		const UInt32 size = encodeBatch( codec, frames );
+
+		ReplayStream stream( frames, size );
+		MessageIO io( stream );
+		io.setCodec( codec );
+
+		Message msg;
+		while ( state.next() )
+		{
+			keep( io.read( msg ) );
+			keep( msg );
+		}
+	}
+
+}
+
+
+BENCH(MessageIO_WritePlain)
+{
+	benchWrite( state, MessageIO::CODEC_PLAIN );
+}
+
+
+BENCH(MessageIO_WriteCobs)
+{
+	benchWrite( state, MessageIO::CODEC_COBS );
+}
+
+
+BENCH(MessageIO_ReadPlain)
+{
+	benchRead( state, MessageIO::CODEC_PLAIN );
+}
+
+
+BENCH(MessageIO_ReadCobs)
+{
+	benchRead( state, MessageIO::CODEC_COBS );
+}
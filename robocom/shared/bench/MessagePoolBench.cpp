@@ -0,0 +1,52 @@
+#include "robocom/shared/CompactMessagePool.hpp"
+#include "robocom/shared/MessageListNode.hpp"
+#include "robocom/shared/MessagePool.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+
+#include "Bench.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::bench;
+using namespace robocom::shared::msg;
+
+
+BENCH(MessagePool_AllocFree)
+{
+	MessagePool pool;
+	while ( state.next() )
+	{
+		MessageListNode* const p_node = pool.alloc();
+		keep( p_node );
+		pool.free( p_node );
+	}
+}
+
+
+BENCH(MessagePool_AllocAllFreeAll)
+{
+	MessagePool pool;
+	MessageListNode* nodes[MessagePool::SLOT_COUNT];
+	while ( state.next() )
+	{
+		for ( int i = 0; i < MessagePool::SLOT_COUNT; i++ ) {
+			nodes[i] = pool.alloc();
+		}
+		keep( nodes );
+		for ( int i = 0; i < MessagePool::SLOT_COUNT; i++ ) {
+			pool.free( nodes[i] );
+		}
+	}
+}
+
+
+BENCH(CompactMessagePool_AllocFree)
+{
+	CompactMessagePool pool;
+	const Message msg = SetWheelDriveRequest( 1, 1000u, 1, 100, 1, 100 ).asMessage();
+	while ( state.next() )
+	{
+		const UInt8 index = pool.alloc( msg );
+		keep( index );
+		pool.free( index );
+	}
+}
@@ -0,0 +1,114 @@
+#include "robocom/shared/CompactMessagePool.hpp"
+#include "robocom/shared/CompactMessageQueue.hpp"
+#include "robocom/shared/Message.hpp"
+#include "robocom/shared/MessagePool.hpp"
+#include "robocom/shared/MessageQueue.hpp"
+#include "robocom/shared/msg/SetWheelDriveRequest.hpp"
+
+#include "Bench.hpp"
+
+using namespace robocom::shared;
+using namespace robocom::shared::bench;
+using namespace robocom::shared::msg;
+
+
+namespace
+{
+
+	/**
+	 * Pushes one message and pops one with the given number of timed
+	 * messages waiting in the queue
+	 *
+	 * The pushed message is due after all the waiting ones, so a push
+	 * walks the whole queue, unless it is immediate. The pop takes
+	 * the head.
+	 */
+	template <class QUEUE>
+	void
+	benchPushPop (State& state, QUEUE& queue, int fill, bool is_immediate)
+	{
+		UInt32 millis = 1;
+		for ( int i = 0; i < fill; i++ ) {
+			queue.push( SetWheelDriveRequest( i, millis++, 1, 100, 1, 100 ).asMessage() );
+		}
+
+		Message msg = SetWheelDriveRequest( 0, 1, 100, 1, 100 ).asMessage();
+		Message popped;
+		while ( state.next() )
+		{
+			if ( ! is_immediate ) {
+				msg.setMillis( millis++ );
+			}
+			queue.push( msg );
+			keep( queue.pop( popped, 0xFFFFFFFFu ) );
+		}
+		keep( popped );
+	}
+
+
+	void
+	benchMessageQueue (State& state, int fill, bool is_immediate)
+	{
+		MessagePool pool;
+		MessageQueue queue( pool );
+		benchPushPop( state, queue, fill, is_immediate );
+	}
+
+
+	void
+	benchCompactMessageQueue (State& state, int fill, bool is_immediate)
+	{
+		CompactMessagePool pool;
+		CompactMessageQueue queue( pool );
+		benchPushPop( state, queue, fill, is_immediate );
+	}
+
+}
+
+
+BENCH(MessageQueue_PushPopTimed_Fill0)
+{
+	benchMessageQueue( state, 0, false );
+}
+
+
+BENCH(MessageQueue_PushPopTimed_Fill8)
+{
+	benchMessageQueue( state, 8, false );
+}
+
+
+BENCH(MessageQueue_PushPopTimed_Fill16)
+{
+	benchMessageQueue( state, 16, false );
+}
+
+
+BENCH(MessageQueue_PushPopTimed_Fill30)
+{
+	benchMessageQueue( state, MessagePool::SLOT_COUNT - 2, false );
+}
+
+
+BENCH(MessageQueue_PushPopImmediate_Fill30)
+{
+	benchMessageQueue( state, MessagePool::SLOT_COUNT - 2, true );
+}
+
+
+BENCH(CompactMessageQueue_PushPopTimed_Fill0)
+{
+	benchCompactMessageQueue( state, 0, false );
+}
+
+
+BENCH(CompactMessageQueue_PushPopTimed_Fill16)
+{
+	benchCompactMessageQueue( state, 16, false );
+}
+
+
+BENCH(CompactMessageQueue_PushPopTimed_Fill30)
+{
+	benchCompactMessageQueue( state, MessagePool::SLOT_COUNT - 2, false );
+}
@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Bench.hpp"
+
+using namespace robocom::shared::bench;
+
+
+/**
+ * Runs the benchmarks whose name contains the first argument, or all
+ * of them, and prints the results as JSON lines
+ *
+ * The first line describes the build, as the results are only
+ * comparable between runs of the same configuration.
+ */
+int main (int argc, char* argv[])
+{
+	const char* p_filter = argc > 1 ? argv[1] : 0;
+
+	printf(
+		"{\"suite\": \"RoboComBench\", \"compiler\": \"%s\", \"optimized\": %s, "
+		"\"queue_profile\": %s, \"reliable_io\": %s}\n",
+		__VERSION__,
+#if defined(__OPTIMIZE__)
+		"true",
+#else
+		"false",
+#endif
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		"true",
+#else
+		"false",
+#endif
+#if defined(ROBOCOM_RELIABLE_IO)
+		"true"
+#else
+		"false"
+#endif
+	);
+
+	if ( 0 == Benchmark::run( p_filter ) )
+	{
+		fprintf( stderr, "no benchmark matches %s\n", p_filter );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include "../Angle.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace common;
+
+
+	namespace
+	{
+		// Coefficients of the odd polynomial approximating atan(t) on
+		// [0, 1] (Abramowitz & Stegun 4.4.49, error below 1e-5 radians),
+		// in Q15 fixed point
+		const SInt32 ATAN_C1 = 32764;	//  0.9998660
+		const SInt32 ATAN_C3 = -10823;	// -0.3302995
+		const SInt32 ATAN_C5 = 5903;	//  0.1801410
+		const SInt32 ATAN_C7 = -2790;	// -0.0851330
+		const SInt32 ATAN_C9 = 683;		//  0.0208351
+
+		// 65536 / pi; converts Q15 radians to binary angle units
+		// with a shift by 16
+		const SInt32 RADIANS_TO_UNITS = 20861;
+	}
+
+
+	SInt32
+	Angle::atan2 (SInt32 y, SInt32 x) throw ()
+	{
+		if ( 0 == x && 0 == y ) {
+			return 0;
+		}
+
+		UInt32 ax = x < 0 ? 0u - static_cast<UInt32>( x ) : x;
+		UInt32 ay = y < 0 ? 0u - static_cast<UInt32>( y ) : y;
+
+		// Drop the low bits so that the ratio of the smaller to the
+		// larger coordinate can be computed in Q15 without overflow
+		while ( ( ax | ay ) > 0xFFFFu )
+		{
+			ax >>= 1;
+			ay >>= 1;
+		}
+
+		// Angle in the first quadrant, reduced to the first octant
+		// where the polynomial is accurate
+		SInt32 angle;
+		if ( ay <= ax ) {
+			angle = _atanUnit( ( ay << 15 ) / ax );
+		}
+		else {
+			angle = QUARTER_TURN - _atanUnit( ( ax << 15 ) / ay );
+		}
+
+		if ( x < 0 ) {
+			angle = HALF_TURN - angle;
+		}
+
+		if ( y < 0 ) {
+			angle = -angle;
+		}
+
+		return angle;
+	}
+
+
+	SInt32
+	Angle::yawFromQuaternion (
+		SInt16 w,
+		SInt16 x,
+		SInt16 y,
+		SInt16 z
+	) throw ()
+	{
+		// The yaw is atan2(2xy - 2wz, 2ww + 2xx - 1), which is the same
+		// angle as atan2(xy - wz, ww + xx - 1/2). The products are in Q28;
+		// they are divided by 4 so that the sums cannot overflow.
+
+		const SInt32 num =
+			( static_cast<SInt32>( x ) * y >> 2 ) -
+			( static_cast<SInt32>( w ) * z >> 2 );
+
+		const SInt32 den =
+			( static_cast<SInt32>( w ) * w >> 2 ) +
+			( static_cast<SInt32>( x ) * x >> 2 ) -
+			( static_cast<SInt32>( 1 ) << 25 );
+
+		return atan2( num, den );
+	}
+
+
+	SInt32
+	Angle::_atanUnit (UInt16 t) throw ()
+	{
+		// t is tan(angle) in Q15 in the range [0, 1]; evaluate
+		// the polynomial with Horner's method in Q15
+
+		const SInt32 t2 = static_cast<SInt32>( t ) * t >> 15;
+
+		SInt32 acc = ATAN_C9;
+		acc = ATAN_C7 + ( acc * t2 >> 15 );
+		acc = ATAN_C5 + ( acc * t2 >> 15 );
+		acc = ATAN_C3 + ( acc * t2 >> 15 );
+		acc = ATAN_C1 + ( acc * t2 >> 15 );
+
+		const SInt32 radians = acc * t >> 15;
+
+		return ( radians * RADIANS_TO_UNITS + 0x8000 ) >> 16;
+	}
+
+} }
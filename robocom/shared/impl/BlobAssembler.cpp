@@ -0,0 +1,82 @@
+#include "../msg/BlobFragment.hpp"
+
+#include "../BlobAssembler.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared::msg;
+
+
+	BlobAssembler::BlobAssembler (UInt8* p_buffer, UInt16 capacity) throw ()
+		: m_p_buffer( p_buffer )
+		, m_capacity( capacity )
+		, m_task_id( 0 )
+		, m_size( 0 )
+		, m_status( STATUS_OK )
+		, m_is_complete( false )
+	{
+	}
+
+
+	void
+	BlobAssembler::clear () throw ()
+	{
+		m_task_id = 0;
+		m_size = 0;
+		m_status = STATUS_OK;
+		m_is_complete = false;
+	}
+
+
+	bool
+	BlobAssembler::add (const BlobFragment& fragment) throw ()
+	{
+		const MessageStatus status = fragment.validate();
+		if ( STATUS_OK != status ) {
+			m_task_id = fragment.getTaskId();
+			return _drop( status );
+		}
+
+		if ( 0 == fragment.getOffset() )
+		{
+			clear();
+			m_task_id = fragment.getTaskId();
+		}
+		else if ( fragment.getTaskId() == m_task_id && STATUS_OK != m_status ) {
+			// the rest of a blob already dropped
+			return false;
+		}
+		else if (
+			fragment.getTaskId() != m_task_id ||
+			fragment.getOffset() != m_size ||
+			m_is_complete
+		)
+		{
+			m_task_id = fragment.getTaskId();
+			return _drop( STATUS_E_BLOB_OFFSET );
+		}
+
+		if ( fragment.getSize() > m_capacity - m_size ) {
+			return _drop( STATUS_E_BLOB_SIZE );
+		}
+
+		fragment.getData( m_p_buffer + m_size );
+		m_size += fragment.getSize();
+		m_is_complete = fragment.isFinal();
+
+		return m_is_complete;
+	}
+
+
+	bool
+	BlobAssembler::_drop (MessageStatus status) throw ()
+	{
+		m_size = 0;
+		m_status = status;
+		m_is_complete = false;
+		return true;
+	}
+
+} }
@@ -0,0 +1,143 @@
+#if defined(AVR)
+#include <string.h>
+#else
+#include <cstring>
+#endif
+
+#include "../CompactMessagePool.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	CompactMessagePool::CompactMessagePool () throw ()
+		: m_end( 0 )
+		, m_used_size( 0 )
+		, m_free( 0 )
+		, m_free_count( SLOT_COUNT )
+		, m_min_free_count( SLOT_COUNT )
+	{
+		for ( int i = 1; i < SLOT_COUNT; i++ ) {
+			m_next[i-1] = i;
+		}
+		m_next[SLOT_COUNT-1] = NIL;
+	}
+
+
+	int
+	CompactMessagePool::comparePriority (
+		UInt8 index,
+		const Message& other
+	) const throw ()
+	{
+		if ( isImmediate( index ) ) {
+			return other.isImmediate() ? 0 : -1;
+		}
+		else if ( other.isImmediate() ) {
+			return 1;
+		}
+
+		const UInt32 millis = getMillis( index );
+		if ( millis < other.getMillis() ) {
+			return -1;
+		}
+		else if ( millis > other.getMillis() ) {
+			return 1;
+		}
+
+		return 0;
+	}
+
+
+	void
+	CompactMessagePool::load (UInt8 index, Message& msg) const throw ()
+	{
+		const UInt8* const p_entry = _getEntry( index );
+		msg.deserializeFrom( p_entry + 1, p_entry[1] );
+	}
+
+
+	UInt8
+	CompactMessagePool::alloc (const Message& msg) throw ()
+	{
+		const UInt8 entry_size = 1 + msg.getSerializedSize();
+
+		// No more free slots or bytes... have to ignore
+		if ( NIL == m_free || m_used_size + entry_size > ARENA_SIZE ) {
+			return NIL;
+		}
+
+		if ( m_end + entry_size > ARENA_SIZE ) {
+			_compact();
+		}
+
+		if ( -- m_free_count < m_min_free_count ) {
+			m_min_free_count = m_free_count;
+		}
+
+		const UInt8 index = m_free;
+		m_free = m_next[index];
+		m_next[index] = NIL;
+
+		m_offsets[index] = m_end;
+		m_arena[m_end] = index;
+		msg.serializeTo( m_arena + m_end + 1 );
+		m_end += entry_size;
+		m_used_size += entry_size;
+
+		return index;
+	}
+
+
+	void
+	CompactMessagePool::free (UInt8 index) throw ()
+	{
+		UInt8* const p_entry = m_arena + m_offsets[index];
+		const UInt8 entry_size = 1 + p_entry[1];
+
+		// The last entry gives its bytes back right away, the others
+		// become holes until the next compaction
+		if ( m_offsets[index] + entry_size == m_end ) {
+			m_end -= entry_size;
+		}
+		else {
+			p_entry[0] = NIL;
+		}
+		m_used_size -= entry_size;
+
+		if ( 0 == m_used_size ) {
+			m_end = 0;
+		}
+
+		m_next[index] = m_free;
+		m_free = index;
+		m_free_count++;
+	}
+
+
+	void
+	CompactMessagePool::_compact () throw ()
+	{
+		UInt16 dst = 0;
+		UInt16 src = 0;
+		while ( src < m_end )
+		{
+			const UInt8 entry_size = 1 + m_arena[src + 1];
+			const UInt8 index = m_arena[src];
+
+			if ( NIL != index )
+			{
+				if ( dst != src ) {
+					::memmove( m_arena + dst, m_arena + src, entry_size );
+					m_offsets[index] = dst;
+				}
+				dst += entry_size;
+			}
+
+			src += entry_size;
+		}
+
+		m_end = dst;
+	}
+
+} }
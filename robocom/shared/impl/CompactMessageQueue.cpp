@@ -0,0 +1,169 @@
+#include "../CompactMessagePool.hpp"
+
+#include "../CompactMessageQueue.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	CompactMessageQueue::CompactMessageQueue (CompactMessagePool& pool) throw ()
+		: m_p_pool( & pool )
+		, m_head( CompactMessagePool::NIL )
+		, m_size( 0 )
+		, m_max_size( 0 )
+	{ }
+
+
+	void
+	CompactMessageQueue::clear () throw ()
+	{
+		while ( CompactMessagePool::NIL != m_head )
+		{
+			const UInt8 index = m_head;
+			m_head = m_p_pool->getNext( index );
+			m_p_pool->free( index );
+		}
+
+		m_size = 0;
+	}
+
+
+	bool
+	CompactMessageQueue::push (const Message& msg, UInt32 current_millis) throw ()
+	{
+		// Allocate a slot for the new mesage
+		const UInt8 index = m_p_pool->alloc( msg );
+
+		// No more free slots... have to ignore the message
+		if ( CompactMessagePool::NIL == index )
+		{
+#if defined(ROBOCOM_QUEUE_PROFILE)
+			m_profile.recordDrop();
+#endif
+			return false;
+		}
+
+		// Link the new command at the right position according
+		// to their ordering
+		UInt8 i1 = CompactMessagePool::NIL;
+		UInt8 i2 = m_head;
+		while ( CompactMessagePool::NIL != i2 &&
+				m_p_pool->comparePriority( i2, msg ) <= 0 )
+		{
+			i1 = i2;
+			i2 = m_p_pool->getNext( i2 );
+		}
+
+		if ( CompactMessagePool::NIL == i1 ) {
+			m_head = index;
+		}
+		else {
+			m_p_pool->setNext( i1, index );
+		}
+
+		m_p_pool->setNext( index, i2 );
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		m_p_pool->setEnqueueMillis( index, current_millis );
+#endif
+
+		if ( ++ m_size > m_max_size ) {
+			m_max_size = m_size;
+		}
+
+		return true;
+	}
+
+
+	bool
+	CompactMessageQueue::pop (Message& msg, UInt32 current_millis) throw ()
+	{
+		// No commands in the queue...
+		if ( CompactMessagePool::NIL == m_head ) {
+			return false;
+		}
+
+		// Check if the time has come for the head command to execute
+		if ( ! m_p_pool->isImmediate( m_head ) &&
+			 m_p_pool->getMillis( m_head ) > current_millis )
+		{
+			return false;
+		}
+
+		// Unlink the command from the queue
+		const UInt8 index = m_head;
+		m_head = m_p_pool->getNext( index );
+		m_size--;
+
+		// Copy the command to the user supplied memory
+		m_p_pool->load( index, msg );
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		// Count the time since the message was queued, or since it
+		// was due if it was queued ahead of time
+		UInt32 residency_millis = static_cast<UInt16>(
+			current_millis - m_p_pool->getEnqueueMillis( index )
+		);
+		if ( ! msg.isImmediate() && current_millis - msg.getMillis() < residency_millis ) {
+			residency_millis = current_millis - msg.getMillis();
+		}
+		m_profile.recordResidency( residency_millis );
+#endif
+
+		// Return the slot back to the pool
+		m_p_pool->free( index );
+
+		return true;
+	}
+
+
+	bool
+	CompactMessageQueue::popAndVisit (
+		MessageQueue::Visitor& visitor,
+		UInt32 current_millis
+	)
+	{
+		Message msg;
+		if ( ! pop( msg, current_millis ) ) {
+			return false;
+		}
+
+		visitor.visit( msg );
+		return true;
+	}
+
+
+	UInt8
+	CompactMessageQueue::remove (UInt16 task_id) throw ()
+	{
+		UInt8 removed = 0;
+
+		UInt8 i1 = CompactMessagePool::NIL;
+		UInt8 i2 = m_head;
+		while ( CompactMessagePool::NIL != i2 )
+		{
+			const UInt8 next = m_p_pool->getNext( i2 );
+
+			if ( m_p_pool->getTaskId( i2 ) == task_id )
+			{
+				if ( CompactMessagePool::NIL == i1 ) {
+					m_head = next;
+				}
+				else {
+					m_p_pool->setNext( i1, next );
+				}
+
+				m_p_pool->free( i2 );
+				m_size--;
+				removed++;
+			}
+			else {
+				i1 = i2;
+			}
+
+			i2 = next;
+		}
+
+		return removed;
+	}
+
+} }
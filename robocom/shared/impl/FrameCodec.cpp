@@ -0,0 +1,135 @@
+#if defined(AVR)
+#include <avr/pgmspace.h>
+#endif
+
+#include "../FrameCodec.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	namespace
+	{
+
+		// CRC-16 of each half byte value, for the polynomial 0x1021
+		const UInt16 CRC16_TABLE[16]
+#if defined(AVR)
+			PROGMEM
+#endif
+			= {
+				0x0000, 0x1021, 0x2042, 0x3063,
+				0x4084, 0x50A5, 0x60C6, 0x70E7,
+				0x8108, 0x9129, 0xA14A, 0xB16B,
+				0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+			};
+
+		inline UInt16
+		getCrc16Entry (UInt8 index) throw ()
+		{
+#if defined(AVR)
+			return pgm_read_word( & CRC16_TABLE[index] );
+#else
+			return CRC16_TABLE[index];
+#endif
+		}
+
+	}
+
+
+	UInt8
+	FrameCodec::encodeCobs (
+		const UInt8* p_src,
+		UInt8 size,
+		UInt8* p_dst
+	) throw ()
+	{
+		USE_CONTRACT_CHECK( size <= MAX_DECODED_SIZE );
+
+		UInt8 code_index = 0;
+		UInt8 code = 1;
+		UInt8 out = 1;
+
+		for ( UInt8 i = 0; i < size; i++ )
+		{
+			if ( 0 == p_src[i] )
+			{
+				p_dst[code_index] = code;
+				code_index = out++;
+				code = 1;
+			}
+			else
+			{
+				p_dst[out++] = p_src[i];
+				code++;
+			}
+		}
+
+		p_dst[code_index] = code;
+		return out;
+	}
+
+
+	UInt8
+	FrameCodec::decodeCobs (UInt8* p_buffer, UInt8 size) throw ()
+	{
+		// The output never overtakes the input, so the decoding
+		// can be done in place
+		UInt8 in = 0;
+		UInt8 out = 0;
+
+		while ( in < size )
+		{
+			const UInt8 code = p_buffer[in++];
+			if ( 0 == code || code - 1 > size - in ) {
+				return 0;
+			}
+
+			for ( UInt8 i = 1; i < code; i++ ) {
+				p_buffer[out++] = p_buffer[in++];
+			}
+
+			// Every block but the last one ends with a zero
+			if ( in < size && code < 0xFF ) {
+				p_buffer[out++] = 0;
+			}
+		}
+
+		return out;
+	}
+
+
+	UInt16
+	FrameCodec::updateCrc16 (
+		UInt16 crc,
+		const UInt8* p_buffer,
+		UInt8 size
+	) throw ()
+	{
+		for ( UInt8 i = 0; i < size; i++ )
+		{
+			const UInt8 b = p_buffer[i];
+			crc = ( crc << 4 ) ^ getCrc16Entry( ( crc >> 12 ) ^ ( b >> 4 ) );
+			crc = ( crc << 4 ) ^ getCrc16Entry( ( crc >> 12 ) ^ ( b & 0x0F ) );
+		}
+		return crc;
+	}
+
+
+	UInt8
+	FrameCodec::updateCrc8 (
+		UInt8 crc,
+		const UInt8* p_buffer,
+		UInt8 size
+	) throw ()
+	{
+		for ( UInt8 i = 0; i < size; i++ )
+		{
+			crc ^= p_buffer[i];
+			for ( int bit = 0; bit < 8; bit++ ) {
+				crc = ( crc & 0x80 ) ? ( crc << 1 ) ^ 0x07 : crc << 1;
+			}
+		}
+		return crc;
+	}
+
+} }
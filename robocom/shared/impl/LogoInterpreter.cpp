@@ -0,0 +1,260 @@
+#include "../LogoInterpreter.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace common;
+
+
+	LogoInterpreter::LogoInterpreter () throw ()
+		: m_size( 0 )
+		, m_pc( 0 )
+		, m_loop_depth( 0 )
+		, m_turn_remaining( 0 )
+		, m_turn_direction( 0 )
+	{
+	}
+
+
+	void
+	LogoInterpreter::clear () throw ()
+	{
+		m_size = 0;
+		m_pc = 0;
+		m_loop_depth = 0;
+		m_turn_remaining = 0;
+	}
+
+
+	bool
+	LogoInterpreter::write (
+		UInt16 offset,
+		const UInt8* p_code,
+		UInt16 size
+	) throw ()
+	{
+		if ( offset > MAX_PROGRAM_SIZE || size > MAX_PROGRAM_SIZE - offset ) {
+			return false;
+		}
+
+		for ( UInt16 i = 0; i < size; ++i ) {
+			m_code[offset + i] = p_code[i];
+		}
+
+		if ( offset + size > m_size ) {
+			m_size = offset + size;
+		}
+
+		return true;
+	}
+
+
+	bool
+	LogoInterpreter::verify () const throw ()
+	{
+		UInt8 depth = 0;
+		UInt16 pc = 0;
+
+		// For each open loop, whether its body does anything and whether
+		// it runs at all. A loop without an action in its body would
+		// keep next() busy without returning.
+		bool has_action[MAX_LOOP_DEPTH];
+		bool is_run[MAX_LOOP_DEPTH];
+
+		while ( pc < m_size )
+		{
+			const UInt8 opcode = m_code[pc];
+			const UInt8 instruction_size = _getInstructionSize( opcode );
+
+			if ( 0 == instruction_size || instruction_size > m_size - pc ) {
+				return false;
+			}
+
+			if ( OP_REPEAT == opcode )
+			{
+				if ( MAX_LOOP_DEPTH == depth ) {
+					return false;
+				}
+
+				has_action[depth] = false;
+				is_run[depth] = 0 != m_code[pc + 1];
+				++depth;
+			}
+			else if ( OP_END == opcode )
+			{
+				if ( 0 == depth || ! has_action[--depth] ) {
+					return false;
+				}
+
+				// A skipped loop is no action of the enclosing one
+				if ( 0 != depth && is_run[depth] ) {
+					has_action[depth - 1] = true;
+				}
+			}
+			else if ( 0 != depth ) {
+				has_action[depth - 1] = true;
+			}
+
+			pc += instruction_size;
+		}
+
+		return 0 == depth;
+	}
+
+
+	bool
+	LogoInterpreter::start () throw ()
+	{
+		m_pc = 0;
+		m_loop_depth = 0;
+		m_turn_remaining = 0;
+
+		return verify();
+	}
+
+
+	bool
+	LogoInterpreter::next (Action& action) throw ()
+	{
+		if ( 0 != m_turn_remaining )
+		{
+			_nextTurnStep( action );
+			return true;
+		}
+
+		while ( m_pc < m_size )
+		{
+			const UInt8 opcode = m_code[m_pc];
+
+			switch ( opcode )
+			{
+			case OP_FORWARD:
+			case OP_BACK:
+				action.type = ACTION_MOVE;
+				action.direction = OP_FORWARD == opcode ? 0 : 1;
+				action.amount = ntoh_UInt16( m_code + m_pc + 1 );
+				m_pc += 3;
+				return true;
+
+			case OP_RIGHT:
+			case OP_LEFT:
+				m_turn_direction = OP_RIGHT == opcode ? 0 : 1;
+				m_turn_remaining = ntoh_UInt16( m_code + m_pc + 1 );
+				m_pc += 3;
+
+				// A turn by zero degrees is still one action
+				_nextTurnStep( action );
+				return true;
+
+			case OP_PEN_UP:
+			case OP_PEN_DOWN:
+				action.type = ACTION_PEN;
+				action.direction = OP_PEN_UP == opcode ? 0 : 1;
+				action.amount = 0;
+				m_pc += 1;
+				return true;
+
+			case OP_WAIT:
+				action.type = ACTION_WAIT;
+				action.direction = 0;
+				action.amount = ntoh_UInt16( m_code + m_pc + 1 );
+				m_pc += 3;
+				return true;
+
+			case OP_REPEAT:
+			{
+				const UInt8 count = m_code[m_pc + 1];
+				m_pc += 2;
+
+				if ( 0 == count ) {
+					m_pc = _skipBlock( m_pc );
+				}
+				else {
+					m_loop_start[m_loop_depth] = m_pc;
+					m_loop_remaining[m_loop_depth] = count;
+					++m_loop_depth;
+				}
+				break;
+			}
+
+			case OP_END:
+				if ( 0 != --m_loop_remaining[m_loop_depth - 1] ) {
+					m_pc = m_loop_start[m_loop_depth - 1];
+				}
+				else {
+					--m_loop_depth;
+					m_pc += 1;
+				}
+				break;
+
+			default:
+				// Can't happen with a verified program
+				NCR_UNEXPECTED( "invalid LOGO opcode" );
+				m_pc = m_size;
+				break;
+			}
+		}
+
+		return false;
+	}
+
+
+	void
+	LogoInterpreter::_nextTurnStep (Action& action) throw ()
+	{
+		action.type = ACTION_TURN;
+		action.direction = m_turn_direction;
+		action.amount = m_turn_remaining < MAX_TURN_STEP
+			? m_turn_remaining : static_cast<UInt16>( MAX_TURN_STEP );
+		m_turn_remaining -= action.amount;
+	}
+
+
+	UInt8
+	LogoInterpreter::_getInstructionSize (UInt8 opcode) throw ()
+	{
+		switch ( opcode )
+		{
+		case OP_FORWARD:
+		case OP_BACK:
+		case OP_RIGHT:
+		case OP_LEFT:
+		case OP_WAIT:
+			return 3;
+		case OP_REPEAT:
+			return 2;
+		case OP_PEN_UP:
+		case OP_PEN_DOWN:
+		case OP_END:
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+
+	UInt16
+	LogoInterpreter::_skipBlock (UInt16 pc) const throw ()
+	{
+		// Finds the END matching a REPEAT whose body starts at pc
+		// and returns the position after it
+		UInt8 depth = 1;
+
+		while ( pc < m_size )
+		{
+			const UInt8 opcode = m_code[pc];
+			pc += _getInstructionSize( opcode );
+
+			if ( OP_REPEAT == opcode ) {
+				++depth;
+			}
+			else if ( OP_END == opcode && 0 == --depth ) {
+				break;
+			}
+		}
+
+		return pc;
+	}
+
+} }
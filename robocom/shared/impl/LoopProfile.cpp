@@ -0,0 +1,74 @@
+#if defined(AVR)
+#include <string.h>
+#else
+#include <cstring>
+#endif
+
+#include "../LoopProfile.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	LoopProfile::LoopProfile () throw ()
+	{
+		clear();
+	}
+
+
+	const LoopProfile::PhaseStats&
+	LoopProfile::getPhase (UInt8 phase) const throw ()
+	{
+		USE_CONTRACT_CHECK( phase < PHASE_COUNT );
+		return m_phases[phase];
+	}
+
+
+	UInt8
+	LoopProfile::getBucket (UInt32 micros) throw ()
+	{
+		UInt8 bucket = 0;
+		while ( micros > 1 && bucket < BUCKET_COUNT - 1 )
+		{
+			micros >>= 1;
+			bucket++;
+		}
+
+		return bucket;
+	}
+
+
+	void
+	LoopProfile::clear () throw ()
+	{
+		::memset( m_phases, 0, sizeof( m_phases ) );
+	}
+
+
+	UInt32
+	LoopProfile::record (
+		UInt8 phase,
+		UInt32 start_micros,
+		UInt32 end_micros
+	) throw ()
+	{
+		USE_CONTRACT_CHECK( phase < PHASE_COUNT );
+
+		PhaseStats& stats = m_phases[phase];
+		const UInt32 micros = end_micros - start_micros;
+
+		stats.count++;
+		stats.sum_micros += micros;
+		if ( micros > stats.max_micros ) {
+			stats.max_micros = micros;
+		}
+
+		UInt16& bucket = stats.buckets[ getBucket( micros ) ];
+		if ( bucket < MAX_BUCKET_VALUE ) {
+			bucket++;
+		}
+
+		return end_micros;
+	}
+
+} }
@@ -1,4 +1,8 @@
-#include "../StreamIO.hpp"
+#if defined(AVR)
+#include <string.h>
+#else
+#include <cstring>
+#endif
 
 #include "../Message.hpp"
 
@@ -232,40 +236,50 @@ namespace shared
 	}
 
 
-	void
-	Message::deserializeFrom (StreamIO& stream)
+	bool
+	Message::deserializeFrom (const UInt8* p_buffer, UInt8 size) throw ()
 	{
-		// The caller (MessageIO) has verified that the data size
-		// is in the valid range, and that there are enough data in the
-		// output buffer to read the whole message.
-
-		const UInt8 data_size = stream.read() - HEADER_SIZE;
-		m_message_type = stream.read();
-		stream.readBytes( (char*) m_task_id, sizeof(m_task_id) );
-
-		if ( data_size > 0 ) {
-			stream.readBytes( (char*) m_data, data_size );
+		if ( size < HEADER_SIZE || size > HEADER_SIZE + MAX_DATA_SIZE ||
+			 p_buffer[0] != size )
+		{
+			return false;
 		}
 
+		const UInt8 data_size = size - HEADER_SIZE;
+		m_message_type = p_buffer[1];
+		m_task_id[0] = p_buffer[2];
+		m_task_id[1] = p_buffer[3];
+		::memcpy( m_data, p_buffer + HEADER_SIZE, data_size );
+
 		m_data_size = data_size;
-		if ( ! isImmediate() ) {
+		if ( ! isImmediate() )
+		{
+			// The millis must fit
+			if ( data_size < 4u ) {
+				return false;
+			}
 			m_data_size -= 4u;
 		}
+
+		return true;
 	}
 
 
-	void
-	Message::serializeTo (StreamIO& stream) const
+	UInt8
+	Message::serializeTo (UInt8* p_buffer) const throw ()
 	{
 		UInt8 data_size = m_data_size;
 		if ( ! isImmediate() ) {
 			data_size += 4u;
 		}
 
-		stream.write( data_size + HEADER_SIZE );
-		stream.write( m_message_type );
-		stream.write( m_task_id, sizeof(m_task_id) );
-		stream.write( m_data, data_size );
+		p_buffer[0] = data_size + HEADER_SIZE;
+		p_buffer[1] = m_message_type;
+		p_buffer[2] = m_task_id[0];
+		p_buffer[3] = m_task_id[1];
+		::memcpy( p_buffer + HEADER_SIZE, m_data, data_size );
+
+		return data_size + HEADER_SIZE;
 	}
 
 } }
@@ -9,6 +9,7 @@ namespace shared
 	MessageQueue::MessageQueue (MessagePool& pool) throw ()
 		: m_p_pool( & pool )
 		, m_p_head( 0 )
+		, m_p_reserved( 0 )
 		, m_size( 0 )
 		, m_max_size( 0 )
 	{ }
@@ -25,17 +26,51 @@ namespace shared
 		}
 
 		m_size = 0;
+		cancel();
+	}
+
+
+	Message*
+	MessageQueue::reserve () throw ()
+	{
+		if ( 0 == m_p_reserved ) {
+			m_p_reserved = m_p_pool->alloc();
+		}
+
+		return 0 == m_p_reserved ? 0 : & m_p_reserved->getMessage();
+	}
+
+
+	void
+	MessageQueue::cancel () throw ()
+	{
+		if ( 0 != m_p_reserved )
+		{
+			m_p_pool->free( m_p_reserved );
+			m_p_reserved = 0;
+		}
 	}
 
 
 	bool
-	MessageQueue::push (const Message& msg) throw ()
+	MessageQueue::push (const Message& msg, UInt32 current_millis) throw ()
 	{
-		// Allocate a slot for the new mesage
-		MessageListNode* p_node = m_p_pool->alloc();
+		// Take the reserved slot if the message was built in it,
+		// otherwise allocate a slot for the new mesage
+		const bool is_reserved =
+			0 != m_p_reserved && & m_p_reserved->getMessage() == & msg;
+		MessageListNode* p_node =
+			is_reserved ? m_p_reserved : m_p_pool->alloc();
+		if ( is_reserved ) {
+			m_p_reserved = 0;
+		}
 
 		// No more free slots... have to ignore the message
-		if ( 0 == p_node ) {
+		if ( 0 == p_node )
+		{
+#if defined(ROBOCOM_QUEUE_PROFILE)
+			m_profile.recordDrop();
+#endif
 			return false;
 		}
 		// Link the new command at the right position according
@@ -58,7 +93,12 @@ namespace shared
 		}
 
 		p_node->setNext( p2 );
-		p_node->setMessage( msg );
+		if ( ! is_reserved ) {
+			p_node->setMessage( msg );
+		}
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		p_node->setEnqueueMillis( current_millis );
+#endif
 
 		if ( ++ m_size > m_max_size ) {
 			m_max_size = m_size;
@@ -70,31 +110,107 @@ namespace shared
 
 	bool
 	MessageQueue::pop (Message& msg, UInt32 current_millis) throw ()
+	{
+		MessageListNode* const p_node = _unlinkHead( current_millis );
+		if ( 0 == p_node ) {
+			return false;
+		}
+
+		// Copy the command to the user supplied memory
+		msg = p_node->getMessage();
+
+		// Return the list node back to the pool
+		m_p_pool->free( p_node );
+
+		return true;
+	}
+
+
+	bool
+	MessageQueue::popAndVisit (Visitor& visitor, UInt32 current_millis)
+	{
+		MessageListNode* const p_node = _unlinkHead( current_millis );
+		if ( 0 == p_node ) {
+			return false;
+		}
+
+		// The node is no longer linked, so the visitor may change
+		// the queue while it looks at the message
+		visitor.visit( p_node->getMessage() );
+
+		m_p_pool->free( p_node );
+
+		return true;
+	}
+
+
+	UInt8
+	MessageQueue::remove (UInt16 task_id) throw ()
+	{
+		UInt8 removed = 0;
+
+		MessageListNode* p1 = 0;
+		MessageListNode* p2 = m_p_head;
+		while ( p2 != 0 )
+		{
+			MessageListNode* const p_next = p2->getNext();
+
+			if ( p2->getMessage().getTaskId() == task_id )
+			{
+				if ( 0 == p1 ) {
+					m_p_head = p_next;
+				}
+				else {
+					p1->setNext( p_next );
+				}
+
+				m_p_pool->free( p2 );
+				m_size--;
+				removed++;
+			}
+			else {
+				p1 = p2;
+			}
+
+			p2 = p_next;
+		}
+
+		return removed;
+	}
+
+
+	MessageListNode*
+	MessageQueue::_unlinkHead (UInt32 current_millis) throw ()
 	{
 		// No commands in the queue...
 		if ( 0 == m_p_head ) {
-			return false;
+			return 0;
 		}
 
 		// Check if the time has come for the head command to execute
 		const Message& head = m_p_head->getMessage();
 		if ( ! head.isImmediate() && head.getMillis() > current_millis ) {
-			return false;
+			return 0;
 		}
 
 		// Unlink the command from the queue
-  		MessageListNode* const p_node = m_p_head;
+		MessageListNode* const p_node = m_p_head;
 		m_p_head = m_p_head->getNext();
 		m_size--;
 
-		// Copy the command to the user supplied memory
-		msg = p_node->getMessage();
-
-		// Return the list node back to the pool
-		m_p_pool->free( p_node );
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		// Count the time since the message was queued, or since it
+		// was due if it was queued ahead of time
+		UInt32 residency_millis = static_cast<UInt16>(
+			current_millis - p_node->getEnqueueMillis()
+		);
+		if ( ! head.isImmediate() && current_millis - head.getMillis() < residency_millis ) {
+			residency_millis = current_millis - head.getMillis();
+		}
+		m_profile.recordResidency( residency_millis );
+#endif
 
-		return true;
+		return p_node;
 	}
 
-
 } }
@@ -0,0 +1,109 @@
+#if defined(AVR)
+#include <string.h>
+#else
+#include <cstring>
+#endif
+
+#include "../QueueProfile.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	QueueProfile::QueueProfile () throw ()
+	{
+		clear();
+	}
+
+
+	UInt8
+	QueueProfile::getBucketCount (UInt8 histogram) throw ()
+	{
+		USE_CONTRACT_CHECK( histogram < HISTOGRAM_COUNT );
+
+		return HISTOGRAM_RESIDENCY == histogram
+			? RESIDENCY_BUCKET_COUNT
+			: DEPTH_BUCKET_COUNT;
+	}
+
+
+	UInt16
+	QueueProfile::getBucket (UInt8 histogram, UInt8 bucket) const throw ()
+	{
+		USE_CONTRACT_CHECK( bucket < getBucketCount( histogram ) );
+		return getBuckets( histogram )[bucket];
+	}
+
+
+	const UInt16*
+	QueueProfile::getBuckets (UInt8 histogram) const throw ()
+	{
+		USE_CONTRACT_CHECK( histogram < HISTOGRAM_COUNT );
+
+		return HISTOGRAM_RESIDENCY == histogram
+			? m_residency
+			: m_depth;
+	}
+
+
+	void
+	QueueProfile::clear () throw ()
+	{
+		::memset( m_residency, 0, sizeof( m_residency ) );
+		::memset( m_depth, 0, sizeof( m_depth ) );
+		m_max_residency_millis = 0;
+		m_drop_count = 0;
+	}
+
+
+	void
+	QueueProfile::recordResidency (UInt32 millis) throw ()
+	{
+		if ( millis > MAX_RESIDENCY_MILLIS ) {
+			millis = MAX_RESIDENCY_MILLIS;
+		}
+
+		if ( millis > m_max_residency_millis ) {
+			m_max_residency_millis = millis;
+		}
+
+		_record( m_residency, RESIDENCY_BUCKET_COUNT, millis );
+	}
+
+
+	void
+	QueueProfile::recordDepth (UInt8 depth) throw ()
+	{
+		_record( m_depth, DEPTH_BUCKET_COUNT, depth );
+	}
+
+
+	void
+	QueueProfile::recordDrop () throw ()
+	{
+		if ( m_drop_count < MAX_BUCKET_VALUE ) {
+			m_drop_count++;
+		}
+	}
+
+
+	void
+	QueueProfile::_record (
+		UInt16* p_buckets,
+		UInt8 bucket_count,
+		UInt32 value
+	) throw ()
+	{
+		UInt8 bucket = 0;
+		while ( value > 1 && bucket < bucket_count - 1 )
+		{
+			value >>= 1;
+			bucket++;
+		}
+
+		if ( p_buckets[bucket] < MAX_BUCKET_VALUE ) {
+			p_buckets[bucket]++;
+		}
+	}
+
+} }
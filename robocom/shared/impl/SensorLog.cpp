@@ -0,0 +1,252 @@
+#include "../SensorLog.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	SensorLog::SensorLog () throw ()
+		: m_start_millis( 0 )
+		, m_next_index( 0 )
+		, m_gap_size( 0 )
+		, m_period_millis( 0 )
+		, m_overflow_count( 0 )
+		, m_missed_count( 0 )
+		, m_channels( 0 )
+		, m_record_size( 0 )
+		, m_slot_count( 0 )
+		, m_first_slot( 0 )
+		, m_record_count( 0 )
+		, m_gap_record_count( 0 )
+		, m_is_running( false )
+	{
+	}
+
+
+	UInt8
+	SensorLog::getRecordSize (UInt8 channels) throw ()
+	{
+		UInt8 size = 0;
+		if ( channels & CHANNEL_QUATERNION ) {
+			size += 8;
+		}
+		if ( channels & CHANNEL_YAW ) {
+			size += 2;
+		}
+		if ( channels & CHANNEL_ENCODERS ) {
+			size += 4;
+		}
+		return size;
+	}
+
+
+	void
+	SensorLog::start (
+		UInt8 channels,
+		UInt16 period_millis,
+		UInt32 start_millis
+	) throw ()
+	{
+		USE_CONTRACT_CHECK( 0 != channels && 0 == ( channels & ~CHANNEL_ALL ) );
+		USE_CONTRACT_CHECK( 0 != period_millis );
+
+		m_start_millis = start_millis;
+		m_next_index = 0;
+		m_gap_size = 0;
+		m_period_millis = period_millis;
+		m_overflow_count = 0;
+		m_missed_count = 0;
+		m_channels = channels;
+		m_record_size = getRecordSize( channels );
+		m_slot_count = CAPACITY / m_record_size;
+		m_first_slot = 0;
+		m_record_count = 0;
+		m_gap_record_count = 0;
+		m_is_running = true;
+	}
+
+
+	UInt32
+	SensorLog::skipMissed (UInt32 current_millis) throw ()
+	{
+		USE_CONTRACT_CHECK( m_is_running );
+
+		const SInt32 late_millis =
+			static_cast<SInt32>( current_millis - getDueMillis() );
+		if ( late_millis < m_period_millis ) {
+			return 0;
+		}
+
+		const UInt32 count = static_cast<UInt32>( late_millis ) / m_period_millis;
+
+		if ( 0 != m_gap_size && m_gap_record_count != m_record_count )
+		{
+			// Only one gap is remembered; the records before the older
+			// one are given up
+			while ( 0 != m_gap_size ) {
+				_dropOldest();
+			}
+		}
+
+		// A gap right after the previous one, or before the first
+		// record, just moves the numbering on
+		if ( 0 != m_record_count )
+		{
+			m_gap_size += count;
+			m_gap_record_count = m_record_count;
+		}
+
+		m_next_index += count;
+		m_missed_count += count;
+		return count;
+	}
+
+
+	void
+	SensorLog::append (const Sample& sample) throw ()
+	{
+		USE_CONTRACT_CHECK( m_is_running );
+
+		UInt8 slot = m_first_slot + m_record_count;
+		if ( slot >= m_slot_count ) {
+			slot -= m_slot_count;
+		}
+
+		// The oldest record makes room for the new one
+		if ( m_record_count == m_slot_count ) {
+			_dropOldest();
+		}
+		m_record_count++;
+
+		UInt8* p = m_buffer + slot * m_record_size;
+		if ( m_channels & CHANNEL_QUATERNION )
+		{
+			for ( int i = 0; i < 4; i++, p += 2 ) {
+				hton_UInt16( p, sample.quaternion[i] );
+			}
+		}
+		if ( m_channels & CHANNEL_YAW )
+		{
+			hton_UInt16( p, sample.yaw );
+			p += 2;
+		}
+		if ( m_channels & CHANNEL_ENCODERS )
+		{
+			hton_UInt16( p, sample.encoder_ticks[0] );
+			hton_UInt16( p + 2, sample.encoder_ticks[1] );
+		}
+
+		m_next_index++;
+	}
+
+
+	UInt16
+	SensorLog::fetch (UInt8* p_buffer, UInt16 max_size) throw ()
+	{
+		USE_CONTRACT_CHECK( max_size >= HEADER_SIZE );
+
+		// The records before a gap go first
+		const UInt8 available =
+			0 != m_gap_size ? m_gap_record_count : m_record_count;
+
+		UInt8 count = 0;
+		if ( m_record_size > 0 )
+		{
+			const UInt16 fit = ( max_size - HEADER_SIZE ) / m_record_size;
+			count = fit < available ? fit : available;
+		}
+
+		hton_UInt32( p_buffer, m_start_millis );
+		hton_UInt32( p_buffer + 4, m_next_index - m_gap_size - m_record_count );
+		hton_UInt16( p_buffer + 8, m_period_millis );
+		hton_UInt16( p_buffer + 10, m_overflow_count );
+		p_buffer[12] = m_channels;
+		p_buffer[13] = count;
+
+		UInt8* p = p_buffer + HEADER_SIZE;
+		for ( UInt8 i = 0; i < count; i++ )
+		{
+			const UInt8* p_record = m_buffer + m_first_slot * m_record_size;
+			for ( UInt8 j = 0; j < m_record_size; j++ ) {
+				*p++ = p_record[j];
+			}
+
+			if ( ++m_first_slot == m_slot_count ) {
+				m_first_slot = 0;
+			}
+		}
+		m_record_count -= count;
+
+		if ( 0 != m_gap_size && 0 == ( m_gap_record_count -= count ) ) {
+			m_gap_size = 0;
+		}
+
+		return HEADER_SIZE + count * m_record_size;
+	}
+
+
+	bool
+	SensorLog::parseHeader (
+		const UInt8* p_blob,
+		UInt16 size,
+		Header& header
+	) throw ()
+	{
+		if ( size < HEADER_SIZE ) {
+			return false;
+		}
+
+		header.start_millis = ntoh_UInt32( p_blob );
+		header.first_index = ntoh_UInt32( p_blob + 4 );
+		header.period_millis = ntoh_UInt16( p_blob + 8 );
+		header.overflow_count = ntoh_UInt16( p_blob + 10 );
+		header.channels = p_blob[12];
+		header.record_count = p_blob[13];
+
+		return size >= HEADER_SIZE
+			+ header.record_count * getRecordSize( header.channels );
+	}
+
+
+	void
+	SensorLog::unpackRecord (
+		const UInt8* p_record,
+		UInt8 channels,
+		Sample& sample
+	) throw ()
+	{
+		if ( channels & CHANNEL_QUATERNION )
+		{
+			for ( int i = 0; i < 4; i++, p_record += 2 ) {
+				sample.quaternion[i] = ntoh_UInt16( p_record );
+			}
+		}
+		if ( channels & CHANNEL_YAW )
+		{
+			sample.yaw = ntoh_UInt16( p_record );
+			p_record += 2;
+		}
+		if ( channels & CHANNEL_ENCODERS )
+		{
+			sample.encoder_ticks[0] = ntoh_UInt16( p_record );
+			sample.encoder_ticks[1] = ntoh_UInt16( p_record + 2 );
+		}
+	}
+
+
+	void
+	SensorLog::_dropOldest () throw ()
+	{
+		m_overflow_count++;
+		m_record_count--;
+		if ( ++m_first_slot == m_slot_count ) {
+			m_first_slot = 0;
+		}
+
+		// Once the records before the gap are gone, the gap is part
+		// of the numbering of the oldest record
+		if ( 0 != m_gap_size && 0 == --m_gap_record_count ) {
+			m_gap_size = 0;
+		}
+	}
+
+} }
@@ -1,17 +1,46 @@
 #if defined(AVR)
 #include <Arduino.h>
+#include <avr/sleep.h>
+#include <string.h>
 #else
 #include <time.h>
 #include <cstring>
 #endif
 
 // Component includes
+#include "../msg/BlobFragment.hpp"
+#include "../msg/BlobStatusNotice.hpp"
+#include "../msg/CapsResponse.hpp"
+#include "../msg/CodecRequest.hpp"
+#include "../msg/CreditNotice.hpp"
 #include "../msg/FlushResponse.hpp"
+#include "../msg/HelloRequest.hpp"
+#include "../msg/LoopHistogramResponse.hpp"
+#include "../msg/LoopStatsRequest.hpp"
+#include "../msg/LoopStatsResponse.hpp"
+#include "../msg/QueueHistogramResponse.hpp"
+#include "../msg/QueueStatsRequest.hpp"
+#include "../msg/QueueStatsResponse.hpp"
+#include "../msg/RepeatRequest.hpp"
 #include "../msg/SimpleMessage.hxx"
 
 // Module include
 #include "../Server.hpp"
 
+
+// Measures the time between the previous mark and now as the given
+// phase of the loop. Compiles to nothing without ROBOCOM_LOOP_PROFILE.
+#if defined(ROBOCOM_LOOP_PROFILE)
+#define LOOP_PROFILE_START(var) UInt32 var = getMicros()
+#define LOOP_PROFILE_RESTART(var) var = getMicros()
+#define LOOP_PROFILE_MARK(var, phase) \
+	var = m_loop_profile.record( LoopProfile::phase, var, getMicros() )
+#else
+#define LOOP_PROFILE_START(var)
+#define LOOP_PROFILE_RESTART(var)
+#define LOOP_PROFILE_MARK(var, phase)
+#endif
+
 namespace robocom {
 namespace shared
 {
@@ -20,15 +49,60 @@ namespace shared
 	using namespace robocom::shared::msg;
 
 
+	template <> struct Server::Route<NoopRequest::MSGID>
+		: Dispatch::Ignored { };
+	template <> struct Server::Route<EchoRequest::MSGID>
+		: Dispatch::To<EchoRequest, & Server::_handleEcho> { };
+	template <> struct Server::Route<ResetRequest::MSGID>
+		: Dispatch::To<ResetRequest, & Server::_handleReset> { };
+	template <> struct Server::Route<FlushRequest::MSGID>
+		: Dispatch::To<FlushRequest, & Server::_handleFlush> { };
+	template <> struct Server::Route<RepeatRequest::MSGID>
+		: Dispatch::To<RepeatRequest, & Server::_handleRepeat> { };
+	template <> struct Server::Route<LoopStatsRequest::MSGID>
+		: Dispatch::To<LoopStatsRequest, & Server::_handleLoopStats> { };
+	template <> struct Server::Route<QueueStatsRequest::MSGID>
+		: Dispatch::To<QueueStatsRequest, & Server::_handleQueueStats> { };
+	template <> struct Server::Route<CodecRequest::MSGID>
+		: Dispatch::To<CodecRequest, & Server::_handleCodec> { };
+	template <> struct Server::Route<HelloRequest::MSGID>
+		: Dispatch::To<HelloRequest, & Server::_handleHello> { };
+	template <> struct Server::Route<BlobFragment::MSGID>
+		: Dispatch::To<BlobFragment, & Server::_handleBlobFragment> { };
+
+	// The messages of the other types go to the input queue
+	const Server::Dispatch::Handler Server::ROUTES[]
+#if defined(AVR)
+		PROGMEM
+#endif
+		= ROBOCOM_DISPATCH_TABLE( Route );
+
+
 	Server::Server (StreamIO& stream) throw ()
 		: m_pool( )
 		, m_input_queue( m_pool )
 		, m_output_queue( m_pool )
 		, m_io( stream )
+		, m_unhandled_count( 0 )
+		, m_task_count( 0 )
+		, m_received_count( 0 )
+		, m_advertised_credit_limit( 0 )
+		, m_is_credit_synced( false )
+		, m_is_credit_wanted( false )
+#if defined(AVR)
+		, m_blob_assembler( 0, MAX_BLOB_SIZE )
+#else
+		, m_blob_assembler( m_blob_buffer, MAX_BLOB_SIZE )
+#endif
+		, m_is_flush_pending( false )
+		, m_flush_task_id( 0 )
 #if ! defined(AVR)
 		, m_base_seconds( 0 )
 #endif
 	{
+		::memset( m_repeated_tasks, 0, sizeof( m_repeated_tasks ) );
+		::memset( m_tasks, 0, sizeof( m_tasks ) );
+
 #if ! defined(AVR)
 		::timespec ts;
 		::bzero( & ts, sizeof( ts ) );
@@ -96,27 +170,141 @@ namespace shared
 	Server::loop ()
 	{
 		Message msg;
+		bool is_busy = true;
+
+		m_input_queue.sampleDepth();
+		m_output_queue.sampleDepth();
+
+		LOOP_PROFILE_START( phase_micros );
+
+		// Read straight into a slot of the input queue, so that the
+		// messages which get queued are not copied
+		Message* p_msg = m_input_queue.reserve();
+		if ( 0 == p_msg ) {
+			p_msg = & msg;
+		}
+
+		const bool has_new_message = m_io.read( *p_msg );
+		LOOP_PROFILE_MARK( phase_micros, PHASE_READ );
 
-		if ( m_io.read( msg ) ) {
-			_onNewMessage( msg );
+		if ( has_new_message )
+		{
+			_onNewMessage( *p_msg );
+			m_input_queue.cancel();
+			LOOP_PROFILE_RESTART( phase_micros );
 		}
-		else if ( m_input_queue.pop( msg, getMillis() ) ) {
-			handleMessage( msg );
+		else
+		{
+			m_input_queue.cancel();
+
+			// The message is dispatched where it is queued
+			DispatchVisitor visitor( *this );
+			const bool has_due_message =
+				m_input_queue.popAndVisit( visitor, getMillis() );
+
+			if ( has_due_message ) {
+				LOOP_PROFILE_MARK( phase_micros, PHASE_DISPATCH );
+			}
+			else
+			{
+				LOOP_PROFILE_MARK( phase_micros, PHASE_POP );
+				is_busy = false;
+			}
 		}
 
 		handleStateUpdate();
+
+		if ( _runTasks() ) {
+			is_busy = true;
+		}
+
+		LOOP_PROFILE_MARK( phase_micros, PHASE_STATE_UPDATE );
+
+		if ( m_is_flush_pending ) {
+			_continueFlush();
+		}
+
+		_advertiseCredits();
+		m_io.poll( getMillis() );
+
+		if ( ! is_busy ) {
+			handleIdle();
+		}
+	}
+
+
+	UInt8
+	Server::addTask (
+		Task& task,
+		UInt32 period_micros,
+		UInt32 deadline_micros
+	) throw ()
+	{
+		if ( m_task_count >= MAX_TASKS ) {
+			return NO_TASK;
+		}
+
+		TaskSlot& slot = m_tasks[m_task_count];
+		slot.p_task = & task;
+		slot.period_micros = period_micros;
+		slot.deadline_micros = deadline_micros;
+		slot.due_micros = getMicros() + period_micros;
+		slot.is_ready = false;
+#if defined(ROBOCOM_LOOP_PROFILE)
+		::memset( & slot.stats, 0, sizeof( slot.stats ) );
+#endif
+
+		return m_task_count++;
+	}
+
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+	const Server::TaskStats&
+	Server::getTaskStats (UInt8 index) const throw ()
+	{
+		USE_CONTRACT_CHECK( index < m_task_count );
+		return m_tasks[index].stats;
 	}
 
 
+	void
+	Server::clearTaskStats () throw ()
+	{
+		for ( UInt8 i = 0; i < m_task_count; i++ ) {
+			::memset( & m_tasks[i].stats, 0, sizeof( m_tasks[i].stats ) );
+		}
+	}
+#endif
+
+
 	void
 	Server::addResponse (const Message& msg) throw ()
 	{
-		if ( ! m_output_queue.push( msg ) ) {
+		if ( ! m_output_queue.push( msg, getMillis() ) ) {
 			NCR_UNEXPECTED( "failed to add a response: queue is full" );
 		}
 	}
 
 
+	void
+	Server::writeBlob (
+		UInt16 task_id,
+		const UInt8* p_data,
+		UInt16 size
+	) throw ()
+	{
+		UInt16 offset = 0;
+		do
+		{
+			const BlobFragment fragment =
+				BlobFragment::makeFragment( task_id, p_data, size, offset );
+			_write( fragment.asMessage() );
+			offset += fragment.getSize();
+		}
+		while ( offset < size );
+	}
+
+
 	void
 	Server::handleReset (const ResetRequest& req)
 	{
@@ -124,8 +312,19 @@ namespace shared
 	}
 
 
-	void
+	bool
 	Server::handleMessage (const Message& msg)
+	{
+		return false;
+	}
+
+
+	void
+	Server::handleBlob (
+		UInt16 task_id,
+		const UInt8* p_data,
+		UInt16 size
+	)
 	{
 		// empty in the base class
 	}
@@ -138,27 +337,51 @@ namespace shared
 	}
 
 
+	void
+	Server::handleIdle ()
+	{
+#if defined(AVR)
+		set_sleep_mode( SLEEP_MODE_IDLE );
+		sleep_mode();
+#endif
+	}
+
+
+	void
+	Server::DispatchVisitor::visit (const Message& msg)
+	{
+		if ( ! m_server.handleMessage( msg ) ) {
+			m_server.m_unhandled_count++;
+		}
+		m_server._repeatMessage( msg );
+	}
+
+
+	void
+	Server::WriteVisitor::visit (const Message& msg)
+	{
+		m_io.write( msg );
+	}
+
+
 	void
 	Server::_onNewMessage (const Message& msg)
 	{
-		switch ( msg.getMessageType() )
-		{
-		case NoopRequest::MSGID:
-			// do nothing message
-			break;
-		case EchoRequest::MSGID:
-			m_io.write( msg );
-			break;
-		case ResetRequest::MSGID:
-			_handleReset( ResetRequest( msg ) );
-			break;
-		case FlushRequest::MSGID:
-			_handleFlush( FlushRequest( msg ) );
-			break;
-		default:
-			m_input_queue.push( msg );
-			break;
+		if ( Dispatch::dispatch( ROUTES, *this, msg ) ) {
+			return;
+		}
+
+		if ( MessageIO::usesCredit( msg ) ) {
+			m_received_count++;
 		}
+		m_input_queue.push( msg, getMillis() );
+	}
+
+
+	void
+	Server::_handleEcho (const EchoRequest& req)
+	{
+		_write( req.asMessage() );
 	}
 
 
@@ -167,36 +390,514 @@ namespace shared
 	{
 		m_input_queue.clear();
 		m_output_queue.clear();
+		::memset( m_repeated_tasks, 0, sizeof( m_repeated_tasks ) );
 
 		handleReset( req );
+
+		m_received_count = 0;
+		m_advertised_credit_limit = 0;
+
+		// A reset has no response of its own, so only a client which
+		// asked for credits in its HelloRequest gets this notice. It
+		// restarts its count with the reset, and waits for the notice
+		// before it sends anything that uses a credit.
+		m_is_credit_synced = m_is_credit_wanted;
+		if ( m_is_credit_synced )
+		{
+			m_advertised_credit_limit = _getCreditLimit();
+			_write(
+				CreditNotice( req.getTaskId(), m_advertised_credit_limit ).asMessage()
+			);
+		}
 	}
 
 
 	void
 	Server::_handleFlush (const FlushRequest& req)
 	{
-		Message msg;
-		while ( m_output_queue.pop( msg, getMillis() ) )
-		{
-			m_io.write( msg );
+		// A newer flush takes over the one still pending
+		m_flush_task_id = req.getTaskId();
+		m_is_flush_pending = true;
 
+		_continueFlush();
+	}
+
+
+	void
+	Server::_continueFlush ()
+	{
+		LOOP_PROFILE_START( phase_micros );
+
+		// In the reliable mode the IO can only take a window of messages,
+		// the rest waits for the acknowledgements in the next loops
+		WriteVisitor visitor( m_io );
+		while ( m_io.canWrite() && m_output_queue.popAndVisit( visitor, getMillis() ) )
+		{
 			// Update the state after each written message so that we
 			// minimize the risk of missing any state changes
 			handleStateUpdate();
+			_runTasks();
 		}
 
-		m_io.write(
-			FlushResponse(
+		if ( m_io.canWrite() )
+		{
+			const UInt16 credit_limit = _getCreditLimit();
+			m_advertised_credit_limit = credit_limit;
+
+			m_io.write(
+				FlushResponse(
+					m_flush_task_id,
+					getMillis(),
+					m_pool.getMinFree(),
+					m_pool.getFree(),
+					m_input_queue.getMaxSize(),
+					m_input_queue.getSize(),
+					m_output_queue.getMaxSize(),
+					m_output_queue.getSize(),
+					credit_limit
+				).asMessage()
+			);
+
+			m_is_flush_pending = false;
+		}
+
+		LOOP_PROFILE_MARK( phase_micros, PHASE_FLUSH );
+	}
+
+
+	void
+	Server::_handleCodec (const CodecRequest& req)
+	{
+		// The client still reads the old encoding until it gets the
+		// response, so the response has to go out before the switch.
+		// When the reliable window is full the response waits in the
+		// output queue, and the server keeps the codec in use.
+		UInt8 codec = m_io.getCodec();
+		if ( req.validate() == STATUS_OK && m_io.canWrite() ) {
+			codec = req.getCodec();
+		}
+
+		_write( CodecResponse( req.getTaskId(), codec ).asMessage() );
+		m_io.setCodec( codec );
+	}
+
+
+	void
+	Server::_handleHello (const HelloRequest& req)
+	{
+		if ( req.validate() != STATUS_OK ) {
+			return;
+		}
+
+		// The client switches on most features itself, but the server
+		// sends the credits on its own, so only to a client that has
+		// them. They start with the next reset.
+		m_is_credit_wanted =
+			0 != ( req.getFeatures() & CapsResponse::FEATURE_CREDIT );
+
+		UInt8 features =
+			MessageIO::getFeatures() | CapsResponse::FEATURE_BLOB;
+#if defined(ROBOCOM_LOOP_PROFILE)
+		features |= CapsResponse::FEATURE_LOOP_STATS;
+#endif
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		features |= CapsResponse::FEATURE_QUEUE_STATS;
+#endif
+
+		_write(
+			CapsResponse(
 				req.getTaskId(),
-				getMillis(),
-				m_pool.getMinFree(),
-				m_pool.getFree(),
-				m_input_queue.getMaxSize(),
-				m_input_queue.getSize(),
-				m_output_queue.getMaxSize(),
-				m_output_queue.getSize()
+				CapsResponse::PROTOCOL_VERSION,
+				features,
+				Message::MAX_DATA_SIZE,
+				MessagePool::SLOT_COUNT,
+				MAX_REPEATED_TASKS,
+#if defined(ROBOCOM_RELIABLE_IO)
+				MessageIO::WINDOW_SIZE,
+				MessageIO::RETRANSMIT_MILLIS,
+#else
+				0,
+				0,
+#endif
+				MAX_BLOB_SIZE
+			).asMessage()
+		);
+	}
+
+
+	void
+	Server::_handleBlobFragment (const BlobFragment& fragment)
+	{
+		if ( ! m_blob_assembler.add( fragment ) ) {
+			return;
+		}
+
+		if ( m_blob_assembler.isComplete() )
+		{
+			handleBlob(
+				m_blob_assembler.getTaskId(),
+				m_blob_assembler.getData(),
+				m_blob_assembler.getSize()
+			);
+		}
+
+		_write(
+			BlobStatusNotice(
+				m_blob_assembler.getTaskId(),
+				m_blob_assembler.getStatus(),
+				m_blob_assembler.getSize()
 			).asMessage()
 		);
+
+		if ( m_blob_assembler.isComplete() ) {
+			m_blob_assembler.clear();
+		}
+	}
+
+
+	void
+	Server::_write (const Message& msg)
+	{
+		// The message waits for the next flush when the IO cannot take
+		// it now; it is dropped if the queue is full, like any response
+		if ( m_io.canWrite() ) {
+			m_io.write( msg );
+		}
+		else {
+			m_output_queue.push( msg, getMillis() );
+		}
+	}
+
+
+
+	UInt16
+	Server::_getCreditLimit () const throw ()
+	{
+		const UInt8 free_count = m_pool.getFree();
+		const UInt16 credit_limit = m_received_count +
+			( free_count > CREDIT_RESERVE_SLOTS ?
+			  free_count - CREDIT_RESERVE_SLOTS : 0 );
+
+		// Credits once granted cannot be taken back
+		if ( static_cast<SInt16>( credit_limit - m_advertised_credit_limit ) < 0 ) {
+			return m_advertised_credit_limit;
+		}
+
+		return credit_limit;
+	}
+
+
+	void
+	Server::_advertiseCredits ()
+	{
+		if ( ! m_is_credit_synced ) {
+			return;
+		}
+
+		const UInt16 credit_limit = _getCreditLimit();
+		const UInt16 growth = credit_limit - m_advertised_credit_limit;
+
+		// A client that used up all its credits is waiting for any
+		// growth, otherwise only bigger steps are worth a message
+		const bool is_client_blocked =
+			m_advertised_credit_limit == m_received_count;
+
+		if ( growth >= CREDIT_NOTICE_STEP ||
+			 ( growth > 0 && is_client_blocked ) )
+		{
+			m_advertised_credit_limit = credit_limit;
+			_write( CreditNotice( 0, credit_limit ).asMessage() );
+		}
+	}
+
+
+	void
+	Server::_handleRepeat (const RepeatRequest& req)
+	{
+		if ( req.validate() != STATUS_OK ) {
+			return;
+		}
+
+		const UInt16 task_id = req.getTaskId();
+		const UInt32 period_millis = req.getPeriodMillis();
+
+		RepeatedTask* p_free = 0;
+		for ( int i = 0; i < MAX_REPEATED_TASKS; i++ )
+		{
+			RepeatedTask& task = m_repeated_tasks[i];
+
+			if ( 0 == task.period_millis )
+			{
+				if ( 0 == p_free ) {
+					p_free = & task;
+				}
+			}
+			else if ( task.task_id == task_id )
+			{
+				task.period_millis = period_millis;
+
+				// Cancelling the task also drops the pending occurrence
+				if ( 0 == period_millis ) {
+					m_input_queue.remove( task_id );
+				}
+
+				return;
+			}
+		}
+
+		// Register a new task if there is a free slot, otherwise
+		// the messages of the task are executed only once
+		if ( 0 != period_millis && 0 != p_free )
+		{
+			p_free->task_id = task_id;
+			p_free->period_millis = period_millis;
+		}
+	}
+
+
+	void
+	Server::_repeatMessage (const Message& msg)
+	{
+		for ( int i = 0; i < MAX_REPEATED_TASKS; i++ )
+		{
+			RepeatedTask& task = m_repeated_tasks[i];
+
+			if ( 0 == task.period_millis || task.task_id != msg.getTaskId() ) {
+				continue;
+			}
+
+			// The execution millis take up 4 bytes of the payload, so
+			// messages with more data cannot be scheduled
+			if ( msg.getDataSize() > Message::MAX_DATA_SIZE - 4 ) {
+				return;
+			}
+
+			// Keep the phase of the schedule, unless the server fell
+			// behind by more than a period, in which case the missed
+			// occurrences are skipped
+			const UInt32 current_millis = getMillis();
+			UInt32 next_millis = msg.isImmediate()
+				? current_millis + task.period_millis
+				: msg.getMillis() + task.period_millis;
+			if ( static_cast<SInt32>( next_millis - current_millis ) <= 0 ) {
+				next_millis = current_millis + task.period_millis;
+			}
+
+			Message next = msg;
+			next.setMillis( next_millis );
+
+			// Stop the repetition if the message pool is exhausted
+			if ( ! m_input_queue.push( next, current_millis ) ) {
+				task.period_millis = 0;
+			}
+
+			return;
+		}
+	}
+
+
+
+	void
+	Server::_handleLoopStats (const LoopStatsRequest& req)
+	{
+#if defined(ROBOCOM_LOOP_PROFILE)
+		if ( req.validate() != STATUS_OK ) {
+			return;
+		}
+
+		const LoopProfile::PhaseStats& stats =
+			m_loop_profile.getPhase( req.getPhase() );
+
+		_write(
+			LoopStatsResponse(
+				req.getTaskId(),
+				req.getPhase(),
+				stats.count,
+				stats.sum_micros,
+				stats.max_micros
+			).asMessage()
+		);
+
+		for ( UInt8 first = 0;
+			  first < LoopProfile::BUCKET_COUNT;
+			  first += LoopHistogramResponse::MAX_BUCKET_COUNT )
+		{
+			UInt8 count = LoopProfile::BUCKET_COUNT - first;
+			if ( count > LoopHistogramResponse::MAX_BUCKET_COUNT ) {
+				count = LoopHistogramResponse::MAX_BUCKET_COUNT;
+			}
+
+			_write(
+				LoopHistogramResponse(
+					req.getTaskId(),
+					req.getPhase(),
+					first,
+					stats.buckets + first,
+					count
+				).asMessage()
+			);
+		}
+
+		if ( req.isReset() ) {
+			m_loop_profile.clear();
+		}
+#endif
+	}
+
+
+	void
+	Server::_handleQueueStats (const QueueStatsRequest& req)
+	{
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		if ( req.validate() != STATUS_OK ) {
+			return;
+		}
+
+		MessageQueue& queue =
+			QueueStatsRequest::QUEUE_INPUT == req.getQueue()
+				? m_input_queue
+				: m_output_queue;
+		QueueProfile& profile = queue.getProfile();
+
+		_write(
+			QueueStatsResponse(
+				req.getTaskId(),
+				req.getQueue(),
+				queue.getSize(),
+				queue.getMaxSize(),
+				profile.getDropCount(),
+				profile.getMaxResidencyMillis()
+			).asMessage()
+		);
+
+		for ( UInt8 histogram = 0;
+			  histogram < QueueProfile::HISTOGRAM_COUNT;
+			  histogram++ )
+		{
+			const UInt8 bucket_count = QueueProfile::getBucketCount( histogram );
+
+			for ( UInt8 first = 0;
+				  first < bucket_count;
+				  first += QueueHistogramResponse::MAX_BUCKET_COUNT )
+			{
+				UInt8 count = bucket_count - first;
+				if ( count > QueueHistogramResponse::MAX_BUCKET_COUNT ) {
+					count = QueueHistogramResponse::MAX_BUCKET_COUNT;
+				}
+
+				_write(
+					QueueHistogramResponse(
+						req.getTaskId(),
+						req.getQueue(),
+						histogram,
+						first,
+						profile.getBuckets( histogram ) + first,
+						count
+					).asMessage()
+				);
+			}
+		}
+
+		if ( req.isReset() ) {
+			profile.clear();
+		}
+#endif
+	}
+
+
+	bool
+	Server::_runTasks ()
+	{
+		// Each task runs at most once per call, so that an event task
+		// that stays ready does not starve the communication
+		UInt8 done_mask = 0;
+
+		for ( ;; )
+		{
+			const UInt32 current_micros = getMicros();
+
+			// Pick the due task with the earliest deadline
+			UInt8 next = NO_TASK;
+			SInt32 next_slack = 0;
+			for ( UInt8 i = 0; i < m_task_count; i++ )
+			{
+				if ( 0 != ( done_mask & ( 1 << i ) ) ||
+					 ! _isTaskDue( i, current_micros ) )
+				{
+					continue;
+				}
+
+				// Events are due from now, periodic runs from the due time
+				const TaskSlot& slot = m_tasks[i];
+				const UInt32 due_micros = slot.is_ready
+					? current_micros
+					: slot.due_micros;
+				const SInt32 slack = static_cast<SInt32>(
+					due_micros + slot.deadline_micros - current_micros
+				);
+
+				if ( NO_TASK == next || slack < next_slack )
+				{
+					next = i;
+					next_slack = slack;
+				}
+			}
+
+			if ( NO_TASK == next ) {
+				return 0 != done_mask;
+			}
+
+			TaskSlot& slot = m_tasks[next];
+			done_mask |= ( 1 << next );
+
+			if ( slot.is_ready )
+			{
+				// The period restarts after a run triggered by an event
+				slot.due_micros = current_micros + slot.period_micros;
+			}
+			else
+			{
+#if defined(ROBOCOM_LOOP_PROFILE)
+				if ( next_slack < 0 ) {
+					slot.stats.late_count++;
+				}
+#endif
+
+				// Keep the phase of the schedule, unless the task fell
+				// behind by more than a period, in which case the missed
+				// runs are skipped
+				slot.due_micros += slot.period_micros;
+				if ( static_cast<SInt32>( slot.due_micros - current_micros ) <= 0 ) {
+					slot.due_micros = current_micros + slot.period_micros;
+				}
+			}
+
+			slot.p_task->run();
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+			const UInt32 run_micros = getMicros() - current_micros;
+			slot.stats.run_count++;
+			slot.stats.total_micros += run_micros;
+			if ( run_micros > slot.stats.max_micros ) {
+				slot.stats.max_micros = run_micros;
+			}
+#endif
+		}
+	}
+
+
+	bool
+	Server::_isTaskDue (UInt8 index, UInt32 current_micros) throw ()
+	{
+		TaskSlot& slot = m_tasks[index];
+
+		slot.is_ready = slot.p_task->isReady();
+		if ( slot.is_ready ) {
+			return true;
+		}
+
+		return 0 != slot.period_micros &&
+			static_cast<SInt32>( current_micros - slot.due_micros ) >= 0;
 	}
 
 } }
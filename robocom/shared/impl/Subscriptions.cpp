@@ -0,0 +1,137 @@
+#include "../Subscriptions.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	Subscriptions::Subscriptions () throw ()
+		: m_count( 0 )
+	{
+	}
+
+
+	bool
+	Subscriptions::subscribe (
+		UInt16 task_id,
+		UInt8 format,
+		UInt32 min_interval_millis,
+		UInt8 decimation,
+		UInt16 change_threshold
+	) throw ()
+	{
+		UInt8 i = 0;
+		while ( i < m_count && m_subscribers[i].task_id != task_id ) {
+			++i;
+		}
+
+		if ( i == m_count )
+		{
+			if ( m_count == MAX_SUBSCRIBERS ) {
+				return false;
+			}
+
+			++m_count;
+		}
+
+		Subscriber& subscriber = m_subscribers[i];
+		subscriber.task_id = task_id;
+		subscriber.format = format;
+		subscriber.decimation = decimation;
+		subscriber.change_threshold = change_threshold;
+		subscriber.min_interval_millis = min_interval_millis;
+		subscriber.last_report_millis = 0;
+		subscriber.last_value = 0;
+		subscriber.skipped = 0;
+		subscriber.has_reported = false;
+
+		return true;
+	}
+
+
+	bool
+	Subscriptions::unsubscribe (UInt16 task_id) throw ()
+	{
+		for ( UInt8 i = 0; i < m_count; ++i )
+		{
+			if ( m_subscribers[i].task_id == task_id )
+			{
+				--m_count;
+				for ( ; i < m_count; ++i ) {
+					m_subscribers[i] = m_subscribers[i + 1];
+				}
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	bool
+	Subscriptions::hasFormat (UInt8 format) const throw ()
+	{
+		for ( UInt8 i = 0; i < m_count; ++i )
+		{
+			if ( m_subscribers[i].format == format ) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	UInt8
+	Subscriptions::offer (
+		SInt32 value,
+		UInt32 current_millis,
+		SInt32 modulus
+	) throw ()
+	{
+		UInt8 mask = 0;
+
+		for ( UInt8 i = 0; i < m_count; ++i )
+		{
+			Subscriber& subscriber = m_subscribers[i];
+
+			// Decimation counts every reading, reported or not
+			++subscriber.skipped;
+			if ( subscriber.skipped < subscriber.decimation ) {
+				continue;
+			}
+			subscriber.skipped = 0;
+
+			if ( subscriber.has_reported )
+			{
+				if ( current_millis - subscriber.last_report_millis
+					 	< subscriber.min_interval_millis )
+				{
+					continue;
+				}
+
+				SInt32 change = value - subscriber.last_value;
+				if ( change < 0 ) {
+					change = -change;
+				}
+				if ( 0 != modulus && change > modulus / 2 ) {
+					change = modulus - change;
+				}
+
+				if ( change <= subscriber.change_threshold
+					 	&&
+					 0 != subscriber.change_threshold )
+				{
+					continue;
+				}
+			}
+
+			subscriber.has_reported = true;
+			subscriber.last_report_millis = current_millis;
+			subscriber.last_value = value;
+			mask |= 1 << i;
+		}
+
+		return mask;
+	}
+
+} }
@@ -0,0 +1,163 @@
+#ifndef ROBOCOM_SHARED_MSG_BLOB_FRAGMENT_HPP
+#define ROBOCOM_SHARED_MSG_BLOB_FRAGMENT_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a fragment of a blob, a block of data that
+	 * does not fit into one message
+	 *
+	 * The fragments of a blob carry the task ID of the transfer and are
+	 * sent in order, without waiting in between: each starts where the
+	 * previous one ended, and the last one is marked as final. The length
+	 * of a fragment is the data size of the message minus the two bytes
+	 * of the offset field, whose highest bit is the final marker.
+	 *
+	 * A fragment at offset 0 starts a new blob. The receiver assembles
+	 * the blob with a BlobAssembler and the server confirms it, or
+	 * reports why it was dropped, with a BlobStatusNotice. Fragments
+	 * are handled on arrival, so they do not use credits.
+	 */
+	class BlobFragment
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_BLOB };
+
+		enum
+		{
+			/// The maximum number of blob bytes in a fragment
+			MAX_FRAGMENT_SIZE = Message::MAX_DATA_SIZE - 2,
+
+			/// The maximum size of a blob
+			MAX_BLOB_SIZE = 0x7FFF
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param offset the position of the fragment in the blob
+		 * @param p_data the bytes of the fragment
+		 * @param size the number of bytes in the fragment
+		 * @param is_final whether the fragment ends the blob
+		 *
+		 * @pre size <= MAX_FRAGMENT_SIZE
+		 * @pre offset + size <= MAX_BLOB_SIZE
+		 */
+		BlobFragment (
+			UInt16 task_id,
+			UInt16 offset,
+			const UInt8* p_data,
+			UInt8 size,
+			bool is_final
+		) throw ();
+
+		/**
+		 * Constructs a BlobFragment object from the given message
+		 */
+		explicit BlobFragment (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		BlobFragment& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the fragment of the given blob which starts at
+		 * the given offset
+		 *
+		 * The fragment takes up to MAX_FRAGMENT_SIZE bytes, and is final
+		 * if it reaches the end of the blob. An empty blob is sent as one
+		 * empty final fragment.
+		 *
+		 * @param p_blob the bytes of the blob
+		 * @param blob_size the size of the blob
+		 * @param offset the position of the fragment
+		 *
+		 * @pre blob_size <= MAX_BLOB_SIZE
+		 * @pre offset < blob_size || 0 == offset
+		 */
+		static BlobFragment makeFragment (
+			UInt16 task_id,
+			const UInt8* p_blob,
+			UInt16 blob_size,
+			UInt16 offset
+		) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if there is no offset field
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the position of the fragment in the blob
+		 */
+		UInt16 getOffset () const throw ();
+
+		/**
+		 * Returns whether the fragment ends the blob
+		 */
+		bool isFinal () const throw ();
+
+		/**
+		 * Returns the number of blob bytes in the fragment
+		 */
+		UInt8 getSize () const throw ();
+
+		/**
+		 * Copies the blob bytes of the fragment
+		 *
+		 * @param p_data receives getSize() bytes
+		 */
+		void getData (UInt8* p_data) const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_OFFSET = 0,
+			OFFSET_DATA = 2,
+
+			FINAL_BIT = 0x8000
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
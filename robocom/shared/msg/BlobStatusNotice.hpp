@@ -0,0 +1,108 @@
+#ifndef ROBOCOM_SHARED_MSG_BLOB_STATUS_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_BLOB_STATUS_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the notice about the end of a blob transfer
+	 * (see BlobFragment)
+	 *
+	 * The server sends it with the task ID of the transfer, once the
+	 * final fragment arrived or once the blob was dropped. A dropped
+	 * blob is reported only once, the fragments that follow it are
+	 * ignored; the client sends the whole blob again.
+	 */
+	class BlobStatusNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_BLOB_STATUS };
+
+		/**
+		 * Constructor
+		 *
+		 * @param status STATUS_OK if the blob arrived, otherwise the
+		 *  reason why it was dropped
+		 * @param size the number of bytes received
+		 */
+		BlobStatusNotice (
+			UInt16 task_id,
+			UInt8 status,
+			UInt16 size
+		) throw ();
+
+		/**
+		 * Constructs a BlobStatusNotice object from the given message
+		 */
+		explicit BlobStatusNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		BlobStatusNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns STATUS_OK if the blob arrived, otherwise the reason
+		 * why it was dropped
+		 */
+		UInt8 getStatus () const throw ();
+
+		/**
+		 * Returns the number of bytes received
+		 */
+		UInt16 getSize () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_STATUS = 0,
+			OFFSET_SIZE = 1,
+			DATA_SIZE = 3
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef ROBOCOM_SHARED_MSG_CAPS_RESPONSE_HPP
+#define ROBOCOM_SHARED_MSG_CAPS_RESPONSE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the response to a HelloRequest, which
+	 * advertises the protocol version, the optional features and the
+	 * limits of the server
+	 *
+	 * The client uses the features that both sides support. Each
+	 * feature is still switched on by the client, in the way described
+	 * with the feature, so a server never uses one the client did not
+	 * ask for.
+	 *
+	 * Later versions may add data after the fields below; the readers
+	 * ignore what they do not know.
+	 */
+	class CapsResponse
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_HELLO };
+
+		/// The protocol version implemented by this code
+		enum { PROTOCOL_VERSION = 1 };
+
+		/// The optional features of the protocol
+		enum Feature
+		{
+			/// Credits in CreditNotice and FlushResponse, see
+			/// MessageIO::setFlowControl()
+			FEATURE_CREDIT = 0x01,
+
+			/// The COBS codec, see CodecRequest
+			FEATURE_COBS = 0x02,
+
+			/// The reliable frames, see MessageIO::setReliable()
+			FEATURE_RELIABLE = 0x04,
+
+			/// Answers to LoopStatsRequest
+			FEATURE_LOOP_STATS = 0x08,
+
+			/// Answers to QueueStatsRequest
+			FEATURE_QUEUE_STATS = 0x10,
+
+			/// Blobs sent in fragments, see BlobFragment
+			FEATURE_BLOB = 0x20
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param version the protocol version of the server
+		 * @param features the bit mask of the Feature values supported
+		 *  by the server
+		 * @param max_data_size the largest message data size the server
+		 *  accepts
+		 * @param pool_size the number of message slots shared by the
+		 *  queues of the server
+		 * @param max_repeated_tasks the number of tasks that can be
+		 *  repeated at the same time
+		 * @param window_size the number of reliable frames in flight in
+		 *  each direction, zero without FEATURE_RELIABLE
+		 * @param retransmit_millis the time after which the server sends
+		 *  a reliable frame again, zero without FEATURE_RELIABLE
+		 * @param max_blob_size the size of the largest blob the server
+		 *  accepts, zero without FEATURE_BLOB
+		 */
+		CapsResponse (
+			UInt16 task_id,
+			UInt8 version,
+			UInt8 features,
+			UInt8 max_data_size,
+			UInt8 pool_size,
+			UInt8 max_repeated_tasks,
+			UInt8 window_size,
+			UInt8 retransmit_millis,
+			UInt16 max_blob_size
+		) throw ();
+
+		/**
+		 * Constructs a CapsResponse object from the given message
+		 */
+		explicit CapsResponse (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		CapsResponse& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is too small
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the protocol version of the server
+		 */
+		UInt8 getVersion () const throw ();
+
+		/**
+		 * Returns the bit mask of the features supported by the server
+		 */
+		UInt8 getFeatures () const throw ();
+
+		/**
+		 * Returns the largest message data size the server accepts
+		 */
+		UInt8 getMaxDataSize () const throw ();
+
+		/**
+		 * Returns the number of message slots shared by the queues
+		 * of the server
+		 */
+		UInt8 getPoolSize () const throw ();
+
+		/**
+		 * Returns the number of tasks that can be repeated at the same
+		 * time
+		 */
+		UInt8 getMaxRepeatedTasks () const throw ();
+
+		/**
+		 * Returns the number of reliable frames in flight in each
+		 * direction
+		 */
+		UInt8 getWindowSize () const throw ();
+
+		/**
+		 * Returns the time after which the server sends a reliable
+		 * frame again
+		 */
+		UInt8 getRetransmitMillis () const throw ();
+
+		/**
+		 * Returns the size of the largest blob the server accepts
+		 */
+		UInt16 getMaxBlobSize () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_VERSION = 0,
+			OFFSET_FEATURES = 1,
+			OFFSET_MAX_DATA_SIZE = 2,
+			OFFSET_POOL_SIZE = 3,
+			OFFSET_MAX_REPEATED_TASKS = 4,
+			OFFSET_WINDOW_SIZE = 5,
+			OFFSET_RETRANSMIT_MILLIS = 6,
+			OFFSET_MAX_BLOB_SIZE = 7,
+			DATA_SIZE = 9
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
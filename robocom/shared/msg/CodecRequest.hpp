@@ -0,0 +1,102 @@
+#ifndef ROBOCOM_SHARED_MSG_CODEC_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_CODEC_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request to switch the frame encoding
+	 * of the link (see MessageIO::Codec), and the response to it
+	 *
+	 * The server answers in the encoding in use when the request
+	 * arrived, and uses the encoding given in the response from then
+	 * on: the requested one if the server supports it and can answer
+	 * right away, otherwise the one it kept. A server whose reliable
+	 * window is full keeps its encoding, and the client may ask again
+	 * later. The client should switch only after reading the response,
+	 * and should not send anything else until then.
+	 */
+	class CodecRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_CODEC };
+
+		/**
+		 * Constructor
+		 *
+		 * @param codec the frame encoding to use
+		 */
+		CodecRequest (
+			UInt16 task_id,
+			UInt8 codec
+		) throw ();
+
+		/**
+		 * Constructs a CodecRequest object from the given message
+		 */
+		explicit CodecRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		CodecRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_CODEC if the codec is not known
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the frame encoding
+		 */
+		UInt8 getCodec () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_CODEC = 0,
+			DATA_SIZE = 1
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef ROBOCOM_SHARED_MSG_CREDIT_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_CREDIT_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the notice about the number of messages
+	 * the client may send without overflowing the server input queue
+	 *
+	 * The server counts the messages that go to its input queue (all
+	 * messages but the framework ones, which are handled right away, see
+	 * MessageIO::usesCredit()). The credit limit is the value of that
+	 * count up to which the client may send. Both counters wrap around
+	 * at 2^16 and restart from zero on a ResetRequest.
+	 *
+	 * The server only sends the notice to a client which listed
+	 * FEATURE_CREDIT in its HelloRequest (see CapsResponse), first in
+	 * response to the next ResetRequest, in which case the notice
+	 * carries the task ID of the request, and then without being asked,
+	 * as soon as it frees enough slots for the input queue. The
+	 * FlushResponse carries the limit for every client.
+	 */
+	class CreditNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_CREDIT };
+
+		/**
+		 * Constructor
+		 *
+		 * @param credit_limit the count of received messages up to which
+		 *  the client may send
+		 */
+		CreditNotice (
+			UInt16 task_id,
+			UInt16 credit_limit
+		) throw ();
+
+		/**
+		 * Constructs a CreditNotice object from the given message
+		 */
+		explicit CreditNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		CreditNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the count of received messages up to which the client
+		 * may send
+		 */
+		UInt16 getCreditLimit () const throw ()
+		{
+			return Layout::get<CreditLimitField>( m_msg );
+		}
+
+	private:
+
+		typedef schema::Field<UInt16> CreditLimitField;
+		typedef schema::Layout<MSGID, CreditLimitField, schema::TIMING_IMMEDIATE> Layout;
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -22,6 +22,21 @@ namespace msg
 	 *
 	 * Encoder readings will be reported until the client sends an unsubscribe
 	 * EncoderReadingRequest.
+	 *
+	 * The client chooses the format of the readings. Clients estimating
+	 * the wheel velocity should subscribe to batches of ticks, which are
+	 * reported in EncoderTicksNotice messages. The batches keep the timing
+	 * of every tick and take a fraction of the frames.
+	 *
+	 * Each subscriber can limit the rate of the reports with a minimum
+	 * interval between them, a decimation factor and a change threshold
+	 * in ticks. The limits only apply to FORMAT_READING; the batches of
+	 * FORMAT_TICKS are all reported, so that no tick is lost, and the
+	 * limits of such requests are ignored. Several clients can be subscribed to one encoder at the
+	 * same time; an unsubscribe request ends the subscription made with
+	 * the same task ID, or all of them for a legacy request (see
+	 * isLegacy()) with no such subscription. A subscribe request for which
+	 * there is no room is answered with a SubscriptionStatusNotice.
 	 */
 	class EncoderReadingRequest
 	{
@@ -30,6 +45,16 @@ namespace msg
 		/// The message type for instances of this class
 		enum { MSGID = RobocomMessageTypes::MSGID_ENCODER_READING };
 
+		/// Formats in which the encoder readings can be reported
+		enum Format
+		{
+			/// The latest tick in an EncoderReadingNotice
+			FORMAT_READING = 0,
+
+			/// Batches of consecutive ticks in an EncoderTicksNotice
+			FORMAT_TICKS = 1
+		};
+
 		/**
 		 * Constructor for a delayed-execution message
 		 *
@@ -38,12 +63,24 @@ namespace msg
 		 * @param encoder_id the ID of the target encoder; either 0 or 1
 		 * @param is_subscribe true for a request to subscribe to encoder
 		 *   readings, false to unsubscribe
+		 * @param format the format of the reported readings
+		 * @param min_interval_millis the minimum number of millis between
+		 *   two reports
+		 * @param decimation report only every n-th reading; both 0 and 1
+		 *   mean every reading
+		 * @param change_threshold the number of ticks since the last
+		 *   report that must be exceeded for another report; 0 reports
+		 *   every reading
 		 */
 		EncoderReadingRequest (
 			UInt16 task_id,
 			UInt32 current_millis,
 			UInt8 encoder_id,
-			bool is_subscribe
+			bool is_subscribe,
+			Format format,
+			UInt16 min_interval_millis,
+			UInt8 decimation,
+			UInt16 change_threshold
 		) throw ();
 
 		/**
@@ -53,11 +90,23 @@ namespace msg
 		 * @param encoder_id the ID of the target encoder; either 0 or 1
 		 * @param is_subscribe true for a request to subscribe to encoder
 		 *   readings, false to unsubscribe
+		 * @param format the format of the reported readings
+		 * @param min_interval_millis the minimum number of millis between
+		 *   two reports
+		 * @param decimation report only every n-th reading; both 0 and 1
+		 *   mean every reading
+		 * @param change_threshold the number of ticks since the last
+		 *   report that must be exceeded for another report; 0 reports
+		 *   every reading
 		 */
 		EncoderReadingRequest (
 			UInt16 task_id,
 			UInt8 encoder_id,
-			bool is_subscribe
+			bool is_subscribe,
+			Format format,
+			UInt16 min_interval_millis,
+			UInt8 decimation,
+			UInt16 change_threshold
 		) throw ();
 
 		/**
@@ -88,6 +137,7 @@ namespace msg
 		 *   STATUS_E_DATA_SIZE if the data size is wrong
 		 *   STATUS_E_ENCODER_ID if the encoder ID is neither 0 nor 1
 		 *   STATUS_E_IS_SUBSCRIBE if the subscribe flag is neither 0 nor 1
+		 *   STATUS_E_ENCODER_FORMAT if the format is not one of Format values
 		 */
 		MessageStatus validate () const throw ();
 
@@ -115,13 +165,59 @@ namespace msg
 		 */
 		bool getIsSubscribe () const throw ();
 
+		/**
+		 * Returns whether the request was sent by a client that predates
+		 * the format and the rate limits, and carries only the encoder ID and the subscribe flag
+		 */
+		bool isLegacy () const throw ();
+
+		/**
+		 * Returns the format in which the readings should be reported
+		 *
+		 * Requests sent by older clients do not carry the format and
+		 * are treated as FORMAT_READING.
+		 *
+		 * @return the format of the readings
+		 */
+		Format getFormat () const throw ();
+
+		/**
+		 * Returns the minimum number of millis between two reports
+		 *
+		 * @return the minimum interval; 0 for requests of older clients
+		 */
+		UInt16 getMinIntervalMillis () const throw ();
+
+		/**
+		 * Returns the decimation factor of the reports
+		 *
+		 * @return report every n-th reading; 1 for requests of older
+		 *   clients
+		 */
+		UInt8 getDecimation () const throw ();
+
+		/**
+		 * Returns the change in ticks required for a report
+		 *
+		 * @return the change threshold; 0 for requests of older clients
+		 */
+		UInt16 getChangeThreshold () const throw ();
+
 	private:
 
 		enum
 		{
 			OFFSET_ENCODER_ID = 0,
 			OFFSET_IS_SUBSCRIBE = 1,
-			DATA_SIZE = 2
+			OFFSET_FORMAT = 2,
+			OFFSET_MIN_INTERVAL_MILLIS = 3,
+			OFFSET_DECIMATION = 5,
+			OFFSET_CHANGE_THRESHOLD = 6,
+			DATA_SIZE = 8,
+
+			// Size of the requests sent before the format and the rate
+			// limits were introduced
+			LEGACY_DATA_SIZE = 2
 		};
 
 		Message m_msg;
@@ -0,0 +1,184 @@
+#ifndef ROBOCOM_SHARED_MSG_ENCODER_TICKS_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_ENCODER_TICKS_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a notice about a batch of consecutive encoder
+	 * ticks
+	 *
+	 * If the client subscribed to readings from the encoder in the
+	 * EncoderReadingRequest::FORMAT_TICKS format, the ticks are reported
+	 * in batches of up to MAX_TICK_COUNT instead of one EncoderReadingNotice
+	 * per tick.
+	 *
+	 * The notice carries the index and the micros of the last tick in the
+	 * batch, followed by the intervals between consecutive ticks of the
+	 * batch, oldest first. Every interval fits in 16 bits; a longer pause
+	 * between ticks always starts a new batch. Every batch is reported,
+	 * regardless of the rate limits of the subscription. Together with the
+	 * last tick of the previous notice, the client can recover the exact
+	 * time of every tick.
+	 *
+	 * The notices are immediate messages, which leaves the whole payload
+	 * for the ticks. They are sent out with the next flush, before any
+	 * timed message waiting in the output queue.
+	 */
+	class EncoderTicksNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_ENCODER_TICKS };
+
+		enum
+		{
+			/// The maximum number of ticks in one notice
+			MAX_TICK_COUNT = 4,
+
+			/// The longest interval between two ticks of one notice
+			MAX_INTERVAL_MICROS = 0xFFFF
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param task_id
+		 * @param encoder_id the ID of the target encoder; either 0 or 1
+		 * @param tick_index the index of the last tick in the batch
+		 * @param p_tick_micros micros of each tick in the batch, oldest
+		 *   first
+		 * @param tick_count the number of ticks in the batch
+		 *
+		 * @pre 0 < tick_count && tick_count <= MAX_TICK_COUNT
+		 * @pre intervals between consecutive ticks are not longer than
+		 *   MAX_INTERVAL_MICROS
+		 */
+		EncoderTicksNotice (
+			UInt16 task_id,
+			UInt8 encoder_id,
+			UInt32 tick_index,
+			const UInt32* p_tick_micros,
+			UInt8 tick_count
+		) throw ();
+
+		/**
+		 * Constructs a EncoderTicksNotice object from the given message
+		 */
+		explicit EncoderTicksNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		EncoderTicksNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not immediate
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_ENCODER_ID if the encoder ID is neither 0 nor 1
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the ID of the target encoder
+		 *
+		 * @return the ID of the target encoder; either 0 or 1
+		 */
+		UInt8 getEncoderId () const throw ();
+
+		/**
+		 * Returns the number of ticks in the batch
+		 *
+		 * @return the number of ticks; between 1 and MAX_TICK_COUNT
+		 */
+		UInt8 getTickCount () const throw ();
+
+		/**
+		 * Returns the index of the last tick in the batch
+		 *
+		 * The first tick of the batch has the index
+		 * getTickIndex() - getTickCount() + 1.
+		 *
+		 * @return the index of the last tick
+		 */
+		UInt32 getTickIndex () const throw ();
+
+		/**
+		 * Returns the micros of the last tick in the batch
+		 *
+		 * @return the micros of the last tick
+		 */
+		UInt32 getMeasurementMicros () const throw ();
+
+		/**
+		 * Returns the interval between the given tick and the one after it
+		 *
+		 * @param i the position of the tick in the batch, oldest first
+		 * @return the interval in micros
+		 *
+		 * @pre i + 1 < getTickCount()
+		 */
+		UInt16 getInterval (UInt8 i) const throw ();
+
+		/**
+		 * Returns the micros of the given tick
+		 *
+		 * @param i the position of the tick in the batch, oldest first
+		 * @return the micros of the tick
+		 *
+		 * @pre i < getTickCount()
+		 */
+		UInt32 getTickMicros (UInt8 i) const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_ENCODER_ID = 0,
+			OFFSET_TICK_INDEX = 1,
+			OFFSET_MICROS = 5,
+			OFFSET_INTERVALS = 9,
+
+			// Size of a notice with a single tick; each further tick
+			// adds one interval
+			MIN_DATA_SIZE = 9,
+			INTERVAL_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -33,7 +33,8 @@ namespace msg
 			UInt8 input_queue_max_size,
 			UInt8 input_queue_size,
 			UInt8 output_queue_max_size,
-			UInt8 output_queue_size
+			UInt8 output_queue_size,
+			UInt16 credit_limit
 		) throw ();
 
 		/**
@@ -130,6 +131,20 @@ namespace msg
 		 */
 		UInt8 getOutputQueueSize () const throw ();
 
+		/**
+		 * Returns whether this message carries the input credit limit
+		 *
+		 * Responses from servers that predate the flow control do not.
+		 */
+		bool hasCreditLimit () const throw ();
+
+		/**
+		 * Returns the input credit limit (see CreditNotice)
+		 *
+		 * @return the limit, or zero if the message does not carry it
+		 */
+		UInt16 getCreditLimit () const throw ();
+
 	private:
 
 		enum
@@ -140,7 +155,12 @@ namespace msg
 			OFFSET_INPUT_QUEUE_SIZE = 3,
 			OFFSET_OUTPUT_QUEUE_MAX_SIZE = 4,
 			OFFSET_OUTPUT_QUEUE_SIZE = 5,
-			DATA_SIZE = 6
+			OFFSET_CREDIT_LIMIT = 6,
+			DATA_SIZE = 8,
+
+			// Size of the responses sent before the credit limit
+			// was introduced
+			LEGACY_DATA_SIZE = 6
 		};
 
 		Message m_msg;
@@ -0,0 +1,154 @@
+#ifndef ROBOCOM_SHARED_MSG_GYRO_QUATERNION_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_GYRO_QUATERNION_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a notice about a raw gyro reading.
+	 *
+	 * If the client subscribed to readings from the gyro in the
+	 * GyroReadingRequest::FORMAT_QUATERNION format, an instance of this
+	 * class is added to the output queue for each reading instead of
+	 * a GyroReadingNotice.
+	 *
+	 * The notice carries the orientation quaternion exactly as produced
+	 * by the DMP of the MPU6050. Each component is a fixed-point number
+	 * where QUATERNION_ONE represents 1.0. Conversion to yaw, pitch and
+	 * roll is left to the client.
+	 */
+	class GyroQuaternionNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_GYRO_QUATERNION };
+
+		/// The value of a quaternion component equal to 1.0
+		enum { QUATERNION_ONE = 16384 };
+
+		/**
+		 * Constructor
+		 *
+		 * @param task_id
+		 * @param current_millis
+		 * @param w the w component of the quaternion
+		 * @param x the x component of the quaternion
+		 * @param y the y component of the quaternion
+		 * @param z the z component of the quaternion
+		 * @param measurement_us micros at the time of measurement
+		 */
+		GyroQuaternionNotice (
+			UInt16 task_id,
+			UInt32 current_millis,
+			SInt16 w,
+			SInt16 x,
+			SInt16 y,
+			SInt16 z,
+			UInt32 measurement_us
+		) throw ();
+
+		/**
+		 * Constructs a GyroQuaternionNotice object from the given message
+		 */
+		explicit GyroQuaternionNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		GyroQuaternionNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_IMMEDIATE if the message is marked as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the w component of the quaternion
+		 */
+		SInt16 getW () const throw ()
+		{
+			return Layout::get<WField>( m_msg );
+		}
+
+		/**
+		 * Returns the x component of the quaternion
+		 */
+		SInt16 getX () const throw ()
+		{
+			return Layout::get<XField>( m_msg );
+		}
+
+		/**
+		 * Returns the y component of the quaternion
+		 */
+		SInt16 getY () const throw ()
+		{
+			return Layout::get<YField>( m_msg );
+		}
+
+		/**
+		 * Returns the z component of the quaternion
+		 */
+		SInt16 getZ () const throw ()
+		{
+			return Layout::get<ZField>( m_msg );
+		}
+
+		/**
+		 * Returns the micros at the time of this measurement
+		 *
+		 * @return the micros at the time of this measurement
+		 */
+		UInt32 getMeasurementMicros () const throw ()
+		{
+			return Layout::get<MicrosField>( m_msg );
+		}
+
+	private:
+
+		typedef schema::Field<SInt16> WField;
+		typedef schema::Field<SInt16, WField> XField;
+		typedef schema::Field<SInt16, XField> YField;
+		typedef schema::Field<SInt16, YField> ZField;
+		typedef schema::Field<UInt32, ZField> MicrosField;
+		typedef schema::Layout<MSGID, MicrosField, schema::TIMING_DELAYED> Layout;
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
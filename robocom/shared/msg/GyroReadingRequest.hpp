@@ -22,6 +22,20 @@ namespace msg
 	 *
 	 * Gyro readings will be reported until the client sends an unsubscribe
 	 * GyroReadingRequest.
+	 *
+	 * The client chooses the format of the readings. Computing yaw, pitch
+	 * and roll takes a lot of soft-float arithmetic on arduino, so clients
+	 * able to do the math themselves should subscribe to the raw DMP
+	 * quaternion instead, which is reported in GyroQuaternionNotice
+	 * messages.
+	 *
+	 * Besides the minimum delay between readings, each subscriber can set
+	 * a decimation factor and a change threshold of the yaw. Several
+	 * clients can be subscribed to the gyro at the same time; an
+	 * unsubscribe request ends the subscription made with the same task ID,
+	 * or all of them for a legacy request (see isLegacy()) with no such
+	 * subscription. A subscribe request for which there is no room is
+	 * answered with a SubscriptionStatusNotice.
 	 */
 	class GyroReadingRequest
 	{
@@ -30,6 +44,16 @@ namespace msg
 		/// The message type for instances of this class
 		enum { MSGID = RobocomMessageTypes::MSGID_GYRO_READING };
 
+		/// Formats in which the gyro readings can be reported
+		enum Format
+		{
+			/// Yaw, pitch and roll in a GyroReadingNotice
+			FORMAT_YAW_PITCH_ROLL = 0,
+
+			/// The raw DMP quaternion in a GyroQuaternionNotice
+			FORMAT_QUATERNION = 1
+		};
+
 		/**
 		 * Constructor for a delayed-execution message
 		 *
@@ -38,12 +62,21 @@ namespace msg
 		 * @param min_delay_millis the minimum number of millis between gyro readings
 		 * @param is_subscribe true for a request to subscribe to encoder
 		 *   readings, false to unsubscribe
+		 * @param format the format of the reported readings
+		 * @param decimation report only every n-th reading; both 0 and 1
+		 *   mean every reading
+		 * @param change_threshold the change of the yaw since the last
+		 *   report, in robocom::shared::Angle units, that must be exceeded
+		 *   for another report; 0 reports every reading
 		 */
 		GyroReadingRequest (
 			UInt16 task_id,
 			UInt32 current_millis,
 			UInt32 min_delay_millis,
-			bool is_subscribe
+			bool is_subscribe,
+			Format format,
+			UInt8 decimation,
+			UInt16 change_threshold
 		) throw ();
 
 		/**
@@ -53,11 +86,20 @@ namespace msg
 		 * @param min_delay_millis the minimum number of millis between gyro readings
 		 * @param is_subscribe true for a request to subscribe to encoder
 		 *   readings, false to unsubscribe
+		 * @param format the format of the reported readings
+		 * @param decimation report only every n-th reading; both 0 and 1
+		 *   mean every reading
+		 * @param change_threshold the change of the yaw since the last
+		 *   report, in robocom::shared::Angle units, that must be exceeded
+		 *   for another report; 0 reports every reading
 		 */
 		GyroReadingRequest (
 			UInt16 task_id,
 			UInt32 min_delay_millis,
-			bool is_subscribe
+			bool is_subscribe,
+			Format format,
+			UInt8 decimation,
+			UInt16 change_threshold
 		) throw ();
 
 		/**
@@ -87,6 +129,7 @@ namespace msg
 		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
 		 *   STATUS_E_DATA_SIZE if the data size is wrong
 		 *   STATUS_E_IS_SUBSCRIBE if the subscribe flag is neither 0 nor 1
+		 *   STATUS_E_GYRO_FORMAT if the format is not one of Format values
 		 */
 		MessageStatus validate () const throw ();
 
@@ -114,13 +157,52 @@ namespace msg
 		 */
 		bool getIsSubscribe () const throw ();
 
+		/**
+		 * Returns whether the request was sent by a client that predates
+		 * the format and the rate limits, and carries only the subscribe flag and the minimum delay
+		 */
+		bool isLegacy () const throw ();
+
+		/**
+		 * Returns the format in which the readings should be reported
+		 *
+		 * Requests sent by older clients do not carry the format and
+		 * are treated as FORMAT_YAW_PITCH_ROLL.
+		 *
+		 * @return the format of the readings
+		 */
+		Format getFormat () const throw ();
+
+		/**
+		 * Returns the decimation factor of the reports
+		 *
+		 * @return report every n-th reading; 1 for requests of older
+		 *   clients
+		 */
+		UInt8 getDecimation () const throw ();
+
+		/**
+		 * Returns the change of the yaw required for a report
+		 *
+		 * @return the change threshold in robocom::shared::Angle units;
+		 *   0 for requests of older clients
+		 */
+		UInt16 getChangeThreshold () const throw ();
+
 	private:
 
 		enum
 		{
 			OFFSET_IS_SUBSCRIBE = 0,
 			OFFSET_MIN_DELAY_MILLIS = 1,
-			DATA_SIZE = 5
+			OFFSET_FORMAT = 5,
+			OFFSET_DECIMATION = 6,
+			OFFSET_CHANGE_THRESHOLD = 7,
+			DATA_SIZE = 9,
+
+			// Size of the requests sent before the format and the rate
+			// limits were introduced
+			LEGACY_DATA_SIZE = 5
 		};
 
 		Message m_msg;
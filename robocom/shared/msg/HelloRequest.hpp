@@ -0,0 +1,113 @@
+#ifndef ROBOCOM_SHARED_MSG_HELLO_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_HELLO_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the first message a client sends after
+	 * connecting, which asks the server for its capabilities
+	 *
+	 * The request carries the protocol version and the features of the
+	 * client (see CapsResponse), and the server answers with
+	 * a CapsResponse. Firmware that predates the handshake puts the
+	 * request to its input queue and never answers, so a client that
+	 * does not get the response in time should assume a server of
+	 * version zero, which only has the plain codec and no optional
+	 * features.
+	 *
+	 * Later versions may add data after the fields below; the readers
+	 * ignore what they do not know.
+	 */
+	class HelloRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_HELLO };
+
+		/**
+		 * Constructor
+		 *
+		 * @param version the protocol version of the client
+		 * @param features the bit mask of CapsResponse::Feature values
+		 *  supported by the client
+		 */
+		HelloRequest (
+			UInt16 task_id,
+			UInt8 version,
+			UInt8 features
+		) throw ();
+
+		/**
+		 * Constructs a HelloRequest object from the given message
+		 */
+		explicit HelloRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		HelloRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is too small
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the protocol version of the client
+		 */
+		UInt8 getVersion () const throw ();
+
+		/**
+		 * Returns the bit mask of the features supported by the client
+		 */
+		UInt8 getFeatures () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_VERSION = 0,
+			OFFSET_FEATURES = 1,
+			DATA_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -15,6 +15,15 @@ namespace msg
 	 * This class represents a noticed sent to the controlling computer
 	 * that a logo command finished execution and the turtle is ready
 	 * to accept the next logo command
+	 *
+	 * LOGO commands sent while another one is active wait in a queue on
+	 * the device and start as soon as the previous one completes. Each
+	 * of them gets its own notice, including the ones dropped by
+	 * a LogoCancelRequest (STATUS_E_LOGO_CANCELLED), the ones that
+	 * did not fit in the queue (STATUS_E_LOGO_QUEUE_FULL) and the ones
+	 * whose command could not start because it was still active
+	 * (STATUS_E_LOGO_ACTIVE). Commands with nothing to do, such as a turn
+	 * by zero degrees, complete at once with STATUS_OK.
 	 */
 	class LogoCompleteNotice
 	{
@@ -0,0 +1,146 @@
+#ifndef ROBOCOM_SHARED_MSG_LOGO_PROGRAM_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_LOGO_PROGRAM_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a chunk of a LOGO program being uploaded
+	 * to the robot
+	 *
+	 * The program is bytecode executed by robocom::shared::LogoInterpreter.
+	 * It does not fit into a single message, so it is sent in chunks, each
+	 * stating its position in the program. A chunk at offset 0 starts
+	 * a new program. Once all chunks are sent, the program is started with
+	 * a LogoRunRequest.
+	 *
+	 * Chunks are rejected with a LogoCompleteNotice carrying
+	 * STATUS_E_LOGO_ACTIVE while a LOGO command is active or queued, and
+	 * with STATUS_E_LOGO_PROGRAM if they do not fit in the program buffer.
+	 * Accepted chunks are not confirmed.
+	 */
+	class LogoProgramRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_LOGO_PROGRAM };
+
+		enum
+		{
+			/// The maximum chunk size of an immediate message
+			MAX_CODE_SIZE = Message::MAX_DATA_SIZE - 2,
+
+			/// The maximum chunk size of a delayed-execution message
+			MAX_DELAYED_CODE_SIZE = Message::MAX_DATA_SIZE - 4 - 2
+		};
+
+		/**
+		 * Constructor for a delayed-execution message
+		 *
+		 * @param offset the position of the chunk in the program
+		 * @param p_code the bytes of the chunk
+		 * @param code_size the number of bytes in the chunk
+		 *
+		 * @pre 0 < code_size && code_size <= MAX_DELAYED_CODE_SIZE
+		 */
+		LogoProgramRequest (
+			UInt16 task_id,
+			UInt32 current_millis,
+			UInt16 offset,
+			const UInt8* p_code,
+			UInt8 code_size
+		) throw ();
+
+		/**
+		 * Constructor for an immediate-execution message
+		 *
+		 * @param offset the position of the chunk in the program
+		 * @param p_code the bytes of the chunk
+		 * @param code_size the number of bytes in the chunk
+		 *
+		 * @pre 0 < code_size && code_size <= MAX_CODE_SIZE
+		 */
+		LogoProgramRequest (
+			UInt16 task_id,
+			UInt16 offset,
+			const UInt8* p_code,
+			UInt8 code_size
+		) throw ();
+
+		/**
+		 * Constructs a LogoProgramRequest object from the given message
+		 */
+		explicit LogoProgramRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		LogoProgramRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the chunk is empty
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the position of the chunk in the program
+		 */
+		UInt16 getOffset () const throw ();
+
+		/**
+		 * Returns the number of bytes in the chunk
+		 */
+		UInt8 getCodeSize () const throw ();
+
+		/**
+		 * Copies the bytes of the chunk
+		 *
+		 * @param p_code receives getCodeSize() bytes
+		 */
+		void getCode (UInt8* p_code) const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_OFFSET = 0,
+			OFFSET_CODE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef ROBOCOM_SHARED_MSG_LOGO_RUN_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_LOGO_RUN_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request to run the LOGO program uploaded
+	 * with LogoProgramRequest messages
+	 *
+	 * The program runs as a single LOGO command: it is queued behind the
+	 * other LOGO commands, and a single LogoCompleteNotice is sent when
+	 * the whole program has finished. The notice carries
+	 * STATUS_E_LOGO_PROGRAM if the uploaded program does not have the
+	 * expected size or is not well formed.
+	 */
+	class LogoRunRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_LOGO_RUN };
+
+		/**
+		 * Constructor for a delayed-execution message
+		 *
+		 * @param program_size the size of the uploaded program in bytes
+		 */
+		LogoRunRequest (
+			UInt16 task_id,
+			UInt32 current_millis,
+			UInt16 program_size
+		) throw ();
+
+		/**
+		 * Constructor for an immediate-execution message
+		 *
+		 * @param program_size the size of the uploaded program in bytes
+		 */
+		LogoRunRequest (
+			UInt16 task_id,
+			UInt16 program_size
+		) throw ();
+
+		/**
+		 * Constructs a LogoRunRequest object from the given message
+		 */
+		explicit LogoRunRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		LogoRunRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the size of the program the client uploaded
+		 *
+		 * @return the size of the program in bytes
+		 */
+		UInt16 getProgramSize () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_PROGRAM_SIZE = 0,
+			DATA_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -14,6 +14,10 @@ namespace msg
 	/**
 	 * This class represents the request to rotate the robot in
 	 * place by the specified angle
+	 *
+	 * The robot measures the turn by the change of its yaw, so a single
+	 * request turns by at most MAX_ANGLE degrees; LOGO programs split
+	 * larger turns into steps.
 	 */
 	class LogoTurnRequest
 	{
@@ -22,6 +26,9 @@ namespace msg
 		/// The message type for instances of this class
 		enum { MSGID = RobocomMessageTypes::MSGID_LOGO_TURN };
 
+		/// The largest angle of a turn, in degrees
+		enum { MAX_ANGLE = 180 };
+
 		/**
 		 * Constructor for a delayed-execution message
 		 *
@@ -75,6 +82,7 @@ namespace msg
 		 *   STATUS_E_DATA_SIZE if the data size is wrong
 		 *   STATUS_E_DIRECTION if the rotation direction is invalid
 		 *     (must be 0 or 1)
+		 *   STATUS_E_ANGLE_RANGE if the angle is above MAX_ANGLE
 		 */
 		MessageStatus validate () const throw ();
 
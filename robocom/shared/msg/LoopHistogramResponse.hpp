@@ -0,0 +1,134 @@
+#ifndef ROBOCOM_SHARED_MSG_LOOP_HISTOGRAM_RESPONSE_HPP
+#define ROBOCOM_SHARED_MSG_LOOP_HISTOGRAM_RESPONSE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a part of the histogram of the time spent
+	 * in one phase of the server loop, sent in response to
+	 * a LoopStatsRequest
+	 *
+	 * Each message carries up to MAX_BUCKET_COUNT consecutive buckets
+	 * of the histogram, starting at the given first bucket.
+	 */
+	class LoopHistogramResponse
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_LOOP_HISTOGRAM };
+
+		enum
+		{
+			/// The maximum number of buckets in one message
+			MAX_BUCKET_COUNT = 7
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param phase the reported phase, see LoopProfile::Phase
+		 * @param first_bucket the index of the first bucket in the message
+		 * @param p_buckets the values of the buckets
+		 * @param bucket_count the number of buckets in the message
+		 *
+		 * @pre bucket_count <= MAX_BUCKET_COUNT
+		 */
+		LoopHistogramResponse (
+			UInt16 task_id,
+			UInt8 phase,
+			UInt8 first_bucket,
+			const UInt16* p_buckets,
+			UInt8 bucket_count
+		) throw ();
+
+		/**
+		 * Constructs a LoopHistogramResponse object from the given message
+		 */
+		explicit LoopHistogramResponse (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		LoopHistogramResponse& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_LOOP_PHASE if the phase or the buckets are out
+		 *    of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the reported phase
+		 */
+		UInt8 getPhase () const throw ();
+
+		/**
+		 * Returns the index of the first bucket in this message
+		 */
+		UInt8 getFirstBucket () const throw ();
+
+		/**
+		 * Returns the number of buckets in this message
+		 */
+		UInt8 getBucketCount () const throw ();
+
+		/**
+		 * Returns the value of a bucket
+		 *
+		 * @param i the index of the bucket within this message
+		 *
+		 * @pre i < getBucketCount()
+		 */
+		UInt16 getBucket (UInt8 i) const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_PHASE = 0,
+			OFFSET_FIRST_BUCKET = 1,
+			OFFSET_BUCKETS = 2,
+			MIN_DATA_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef ROBOCOM_SHARED_MSG_LOOP_STATS_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_LOOP_STATS_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request for the time spent in one phase
+	 * of the server loop (see LoopProfile)
+	 *
+	 * The server answers right away with a LoopStatsResponse followed by
+	 * LoopHistogramResponse messages covering all histogram buckets.
+	 * Servers built without ROBOCOM_LOOP_PROFILE ignore the request.
+	 */
+	class LoopStatsRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_LOOP_STATS };
+
+		/// Flags of the request
+		enum Flags
+		{
+			/// Discard the measurements of all phases after reporting
+			FLAG_RESET = 0x01
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param phase the phase to report, see LoopProfile::Phase
+		 * @param flags a combination of Flags values
+		 */
+		LoopStatsRequest (
+			UInt16 task_id,
+			UInt8 phase,
+			UInt8 flags
+		) throw ();
+
+		/**
+		 * Constructs a LoopStatsRequest object from the given message
+		 */
+		explicit LoopStatsRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		LoopStatsRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_LOOP_PHASE if the phase is out of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the phase to report
+		 */
+		UInt8 getPhase () const throw ();
+
+		/**
+		 * Returns whether the measurements should be discarded after
+		 * reporting
+		 */
+		bool isReset () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_PHASE = 0,
+			OFFSET_FLAGS = 1,
+			DATA_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef ROBOCOM_SHARED_MSG_LOOP_STATS_RESPONSE_HPP
+#define ROBOCOM_SHARED_MSG_LOOP_STATS_RESPONSE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the summary of the time spent in one phase
+	 * of the server loop, sent in response to a LoopStatsRequest
+	 *
+	 * The message is immediate, as the payload does not leave room for
+	 * the millis.
+	 */
+	class LoopStatsResponse
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_LOOP_STATS };
+
+		/**
+		 * Constructor
+		 *
+		 * @param phase the reported phase, see LoopProfile::Phase
+		 * @param count the number of measurements
+		 * @param sum_micros the sum of the measured durations
+		 * @param max_micros the longest measured duration
+		 */
+		LoopStatsResponse (
+			UInt16 task_id,
+			UInt8 phase,
+			UInt32 count,
+			UInt32 sum_micros,
+			UInt32 max_micros
+		) throw ();
+
+		/**
+		 * Constructs a LoopStatsResponse object from the given message
+		 */
+		explicit LoopStatsResponse (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		LoopStatsResponse& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_LOOP_PHASE if the phase is out of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the reported phase
+		 */
+		UInt8 getPhase () const throw ();
+
+		/**
+		 * Returns the number of measurements
+		 */
+		UInt32 getCount () const throw ();
+
+		/**
+		 * Returns the sum of the measured durations in micros
+		 */
+		UInt32 getSumMicros () const throw ();
+
+		/**
+		 * Returns the longest measured duration in micros
+		 */
+		UInt32 getMaxMicros () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_PHASE = 0,
+			OFFSET_COUNT = 1,
+			OFFSET_SUM_MICROS = 5,
+			OFFSET_MAX_MICROS = 9,
+			DATA_SIZE = 13
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
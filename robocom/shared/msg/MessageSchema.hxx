@@ -0,0 +1,338 @@
+#ifndef ROBOCOM_SHARED_MSG_MESSAGE_SCHEMA_HXX
+#define ROBOCOM_SHARED_MSG_MESSAGE_SCHEMA_HXX
+
+#include "msg_base.hpp"
+
+#include "../Message.hpp"
+
+#include "MessageStatus.hpp"
+
+/**
+ * This namespace holds the templates which describe the payload
+ * of a message
+ *
+ * A message class declares each field once, after the field it
+ * follows, and a layout which ends with the last field:
+ *
+ *   typedef schema::Field<UInt8> ServoIdField;
+ *   typedef schema::Field<UInt8, ServoIdField> AngleField;
+ *   typedef schema::Layout<MSGID, AngleField> Layout;
+ *
+ * The offsets and the data size are compile time constants, and
+ * Layout::get() and Layout::set() compile to plain loads and stores
+ * in the byte order of the messages. The wire layout is the same
+ * as that of the Message accessors with the same offsets.
+ *
+ * A layout also states whether its messages are immediate, delayed
+ * or either. For the first two, the position of the payload does not
+ * depend on the message either, so no run time check is left, and
+ * Layout::validate() checks that the message has the declared
+ * timing.
+ */
+namespace robocom {
+namespace shared {
+namespace msg {
+namespace schema
+{
+
+	/// Whether the messages of a layout carry the execution millis
+	enum Timing
+	{
+		/// The messages may be immediate or delayed
+		TIMING_ANY,
+
+		/// The messages are always immediate
+		TIMING_IMMEDIATE,
+
+		/// The messages always carry the millis
+		TIMING_DELAYED
+	};
+
+
+	/**
+	 * Fails to compile unless the condition is true
+	 */
+	template <bool CONDITION> struct Check;
+	template <> struct Check<true> { };
+
+
+	/**
+	 * Reads and writes the values of one type in the byte order of
+	 * the messages
+	 */
+	template <typename T> struct FieldType;
+
+	template <> struct FieldType<UInt8>
+	{
+		enum { SIZE = 1 };
+
+		static UInt8 read (const UInt8* p) throw ()
+		{
+			return p[0];
+		}
+
+		static void write (UInt8* p, UInt8 value) throw ()
+		{
+			p[0] = value;
+		}
+	};
+
+	template <> struct FieldType<bool>
+	{
+		enum { SIZE = 1 };
+
+		static bool read (const UInt8* p) throw ()
+		{
+			return 0 != p[0];
+		}
+
+		static void write (UInt8* p, bool value) throw ()
+		{
+			p[0] = value ? 1 : 0;
+		}
+	};
+
+	template <> struct FieldType<UInt16>
+	{
+		enum { SIZE = 2 };
+
+		static UInt16 read (const UInt8* p) throw ()
+		{
+			return ntoh_UInt16( p );
+		}
+
+		static void write (UInt8* p, UInt16 value) throw ()
+		{
+			hton_UInt16( p, value );
+		}
+	};
+
+	template <> struct FieldType<SInt16>
+	{
+		enum { SIZE = 2 };
+
+		static SInt16 read (const UInt8* p) throw ()
+		{
+			return static_cast<SInt16>( ntoh_UInt16( p ) );
+		}
+
+		static void write (UInt8* p, SInt16 value) throw ()
+		{
+			hton_UInt16( p, static_cast<UInt16>( value ) );
+		}
+	};
+
+	template <> struct FieldType<UInt32>
+	{
+		enum { SIZE = 4 };
+
+		static UInt32 read (const UInt8* p) throw ()
+		{
+			return ntoh_UInt32( p );
+		}
+
+		static void write (UInt8* p, UInt32 value) throw ()
+		{
+			hton_UInt32( p, value );
+		}
+	};
+
+	template <> struct FieldType<SInt32>
+	{
+		enum { SIZE = 4 };
+
+		static SInt32 read (const UInt8* p) throw ()
+		{
+			return static_cast<SInt32>( ntoh_UInt32( p ) );
+		}
+
+		static void write (UInt8* p, SInt32 value) throw ()
+		{
+			hton_UInt32( p, static_cast<UInt32>( value ) );
+		}
+	};
+
+
+	/**
+	 * The start of the payload, which the first field follows
+	 */
+	struct Start
+	{
+		enum { END = 0 };
+	};
+
+
+	/**
+	 * A field of the given type which follows the field PREVIOUS
+	 */
+	template <typename T, class PREVIOUS = Start>
+	struct Field
+	{
+		typedef T Type;
+
+		enum
+		{
+			OFFSET = PREVIOUS::END,
+			END = OFFSET + FieldType<T>::SIZE
+		};
+	};
+
+
+	/**
+	 * Locates the payload in a message of the given timing
+	 */
+	template <int TIMING> struct Payload;
+
+	template <> struct Payload<TIMING_ANY>
+	{
+		static const UInt8* get (const Message& msg) throw ()
+		{
+			return msg.m_data + ( msg.isImmediate() ? 0 : 4 );
+		}
+
+		static UInt8* get (Message& msg) throw ()
+		{
+			return msg.m_data + ( msg.isImmediate() ? 0 : 4 );
+		}
+	};
+
+	template <> struct Payload<TIMING_IMMEDIATE>
+	{
+		static const UInt8* get (const Message& msg) throw ()
+		{
+			return msg.m_data;
+		}
+
+		static UInt8* get (Message& msg) throw ()
+		{
+			return msg.m_data;
+		}
+	};
+
+	template <> struct Payload<TIMING_DELAYED>
+	{
+		static const UInt8* get (const Message& msg) throw ()
+		{
+			return msg.m_data + 4;
+		}
+
+		static UInt8* get (Message& msg) throw ()
+		{
+			return msg.m_data + 4;
+		}
+	};
+
+
+	/**
+	 * The layout of the messages of type ID whose payload ends with
+	 * the field LAST
+	 */
+	template <int ID, class LAST, int TIMING = TIMING_ANY>
+	struct Layout
+	{
+		enum
+		{
+			MSGID = ID,
+			DATA_SIZE = LAST::END,
+
+			// Delayed messages use 4 bytes of the payload for the millis
+			DATA_SIZE_CHECK = sizeof( Check<
+				DATA_SIZE <= ( TIMING_IMMEDIATE == TIMING
+					? Message::MAX_DATA_SIZE
+					: Message::MAX_DATA_SIZE - 4 )
+			> )
+		};
+
+		/**
+		 * Returns the value of a field
+		 */
+		template <class F>
+		static typename F::Type get (const Message& msg) throw ()
+		{
+			return FieldType<typename F::Type>::read(
+				Payload<TIMING>::get( msg ) + F::OFFSET
+			);
+		}
+
+		/**
+		 * Sets the value of a field
+		 */
+		template <class F>
+		static void set (Message& msg, typename F::Type value) throw ()
+		{
+			FieldType<typename F::Type>::write(
+				Payload<TIMING>::get( msg ) + F::OFFSET,
+				value
+			);
+		}
+
+		/**
+		 * Makes the message an immediate one of this layout, with all
+		 * fields zero
+		 */
+		static void initImmediate (Message& msg, UInt16 task_id) throw ()
+		{
+			(void) sizeof( Check<TIMING_DELAYED != TIMING> );
+
+			msg.clear();
+			msg.setMessageType( MSGID );
+			msg.setTaskId( task_id );
+			msg.setImmediate();
+			msg.setDataSize( DATA_SIZE );
+		}
+
+		/**
+		 * Makes the message a delayed one of this layout, with all
+		 * fields zero
+		 */
+		static void initDelayed (
+			Message& msg,
+			UInt16 task_id,
+			UInt32 millis
+		) throw ()
+		{
+			(void) sizeof( Check<TIMING_IMMEDIATE != TIMING> );
+
+			msg.clear();
+			msg.setMessageType( MSGID );
+			msg.setTaskId( task_id );
+			msg.setMillis( millis );
+			msg.setDataSize( DATA_SIZE );
+		}
+
+		/**
+		 * Checks the message type, the data size and the timing
+		 *
+		 * @return STATUS_OK if the message has this layout
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the layout is immediate and the
+		 *    message is not
+		 *   STATUS_E_IMMEDIATE if the layout is delayed and the message
+		 *    is immediate
+		 */
+		static MessageStatus validate (const Message& msg) throw ()
+		{
+			if ( msg.getMessageType() != MSGID ) {
+				return STATUS_E_MESSAGE_TYPE;
+			}
+
+			if ( msg.getDataSize() != DATA_SIZE ) {
+				return STATUS_E_DATA_SIZE;
+			}
+
+			if ( TIMING_IMMEDIATE == TIMING && ! msg.isImmediate() ) {
+				return STATUS_E_NOT_IMMEDIATE;
+			}
+
+			if ( TIMING_DELAYED == TIMING && msg.isImmediate() ) {
+				return STATUS_E_IMMEDIATE;
+			}
+
+			return STATUS_OK;
+		}
+	};
+
+} } } }
+
+#endif
@@ -26,7 +26,21 @@ namespace msg
 		STATUS_E_IS_SUBSCRIBE,
 		STATUS_E_ANGLE_RANGE,
 		STATUS_E_DIRECTION,
-		STATUS_E_LOGO_ACTIVE
+		STATUS_E_LOGO_ACTIVE,
+		STATUS_E_GYRO_FORMAT,
+		STATUS_E_ENCODER_FORMAT,
+		STATUS_E_LOGO_QUEUE_FULL,
+		STATUS_E_LOGO_CANCELLED,
+		STATUS_E_LOGO_PROGRAM,
+		STATUS_E_LOOP_PHASE,
+		STATUS_E_QUEUE_ID,
+		STATUS_E_CODEC,
+		STATUS_E_BLOB_OFFSET,
+		STATUS_E_BLOB_SIZE,
+		STATUS_E_LOG_COMMAND,
+		STATUS_E_LOG_CHANNELS,
+		STATUS_E_LOG_PERIOD,
+		STATUS_E_SUBSCRIBERS
 	};
 
 } } }
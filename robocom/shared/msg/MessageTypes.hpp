@@ -18,7 +18,26 @@ namespace msg
 			MSGID_ECHO,
 			MSGID_RESET,
 			MSGID_FLUSH,
-			LAST
+			LAST,
+
+			// Framework messages added after the application IDs had been
+			// assigned are numbered down from Message::MAX_MESSAGE_TYPE,
+			// so that the IDs of the application messages do not change
+			MSGID_REPEAT = 0x7F,
+			MSGID_LOOP_STATS = 0x7E,
+			MSGID_LOOP_HISTOGRAM = 0x7D,
+			MSGID_QUEUE_STATS = 0x7C,
+			MSGID_QUEUE_HISTOGRAM = 0x7B,
+			MSGID_CREDIT = 0x7A,
+			MSGID_CODEC = 0x79,
+			MSGID_HELLO = 0x78,
+			MSGID_BLOB = 0x77,
+			MSGID_BLOB_STATUS = 0x76,
+
+			// The lowest ID reserved for the framework messages numbered
+			// down from Message::MAX_MESSAGE_TYPE. Application IDs must
+			// stay below it.
+			FIRST_RESERVED = 0x70
 		};
 	};
 
@@ -38,6 +57,13 @@ namespace msg
 			MSGID_LOGO_MOVE,
 			MSGID_LOGO_PEN,
 			MSGID_LOGO_COMPLETE,
+			MSGID_GYRO_QUATERNION,
+			MSGID_ENCODER_TICKS,
+			MSGID_LOGO_CANCEL,
+			MSGID_LOGO_PROGRAM,
+			MSGID_LOGO_RUN,
+			MSGID_SENSOR_LOG,
+			MSGID_SUBSCRIPTION_STATUS,
 			LAST
 		};
 	};
@@ -0,0 +1,142 @@
+#ifndef ROBOCOM_SHARED_MSG_QUEUE_HISTOGRAM_RESPONSE_HPP
+#define ROBOCOM_SHARED_MSG_QUEUE_HISTOGRAM_RESPONSE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents a part of a histogram of one of the server
+	 * message queues, sent in response to a QueueStatsRequest
+	 *
+	 * Each message carries up to MAX_BUCKET_COUNT consecutive buckets
+	 * of the histogram, starting at the given first bucket.
+	 */
+	class QueueHistogramResponse
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_QUEUE_HISTOGRAM };
+
+		enum
+		{
+			/// The maximum number of buckets in one message
+			MAX_BUCKET_COUNT = 6
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param queue the reported queue, see QueueStatsRequest::Queue
+		 * @param histogram the reported histogram, see
+		 *  QueueProfile::Histogram
+		 * @param first_bucket the index of the first bucket in the message
+		 * @param p_buckets the values of the buckets
+		 * @param bucket_count the number of buckets in the message
+		 *
+		 * @pre bucket_count <= MAX_BUCKET_COUNT
+		 */
+		QueueHistogramResponse (
+			UInt16 task_id,
+			UInt8 queue,
+			UInt8 histogram,
+			UInt8 first_bucket,
+			const UInt16* p_buckets,
+			UInt8 bucket_count
+		) throw ();
+
+		/**
+		 * Constructs a QueueHistogramResponse object from the given message
+		 */
+		explicit QueueHistogramResponse (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		QueueHistogramResponse& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_QUEUE_ID if the queue, the histogram or the buckets
+		 *    are out of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the reported queue
+		 */
+		UInt8 getQueue () const throw ();
+
+		/**
+		 * Returns the reported histogram
+		 */
+		UInt8 getHistogram () const throw ();
+
+		/**
+		 * Returns the index of the first bucket in this message
+		 */
+		UInt8 getFirstBucket () const throw ();
+
+		/**
+		 * Returns the number of buckets in this message
+		 */
+		UInt8 getBucketCount () const throw ();
+
+		/**
+		 * Returns the value of a bucket
+		 *
+		 * @param i the index of the bucket within this message
+		 *
+		 * @pre i < getBucketCount()
+		 */
+		UInt16 getBucket (UInt8 i) const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_QUEUE = 0,
+			OFFSET_HISTOGRAM = 1,
+			OFFSET_FIRST_BUCKET = 2,
+			OFFSET_BUCKETS = 3,
+			MIN_DATA_SIZE = 3
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef ROBOCOM_SHARED_MSG_QUEUE_STATS_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_QUEUE_STATS_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request for the statistics of one of the
+	 * server message queues (see QueueProfile)
+	 *
+	 * The server answers right away with a QueueStatsResponse followed by
+	 * QueueHistogramResponse messages covering all buckets of both
+	 * histograms. Servers built without ROBOCOM_QUEUE_PROFILE ignore
+	 * the request.
+	 */
+	class QueueStatsRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_QUEUE_STATS };
+
+		/// The queues of the server
+		enum Queue
+		{
+			/// Messages waiting for their execution time
+			QUEUE_INPUT,
+
+			/// Responses waiting for a flush
+			QUEUE_OUTPUT,
+
+			QUEUE_COUNT
+		};
+
+		/// Flags of the request
+		enum Flags
+		{
+			/// Discard the statistics of the queue after reporting
+			FLAG_RESET = 0x01
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * @param queue the queue to report, see Queue
+		 * @param flags a combination of Flags values
+		 */
+		QueueStatsRequest (
+			UInt16 task_id,
+			UInt8 queue,
+			UInt8 flags
+		) throw ();
+
+		/**
+		 * Constructs a QueueStatsRequest object from the given message
+		 */
+		explicit QueueStatsRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		QueueStatsRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_QUEUE_ID if the queue is out of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the queue to report
+		 */
+		UInt8 getQueue () const throw ();
+
+		/**
+		 * Returns whether the statistics should be discarded after
+		 * reporting
+		 */
+		bool isReset () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_QUEUE = 0,
+			OFFSET_FLAGS = 1,
+			DATA_SIZE = 2
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
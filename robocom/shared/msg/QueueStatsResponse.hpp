@@ -0,0 +1,129 @@
+#ifndef ROBOCOM_SHARED_MSG_QUEUE_STATS_RESPONSE_HPP
+#define ROBOCOM_SHARED_MSG_QUEUE_STATS_RESPONSE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the summary of the statistics of one of the
+	 * server message queues, sent in response to a QueueStatsRequest
+	 */
+	class QueueStatsResponse
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_QUEUE_STATS };
+
+		/**
+		 * Constructor
+		 *
+		 * @param queue the reported queue, see QueueStatsRequest::Queue
+		 * @param size the current size of the queue
+		 * @param max_size the maximum size of the queue since its creation
+		 * @param drop_count the number of messages dropped because the
+		 *  pool was exhausted
+		 * @param max_residency_millis the longest time a message waited
+		 *  in the queue
+		 */
+		QueueStatsResponse (
+			UInt16 task_id,
+			UInt8 queue,
+			UInt8 size,
+			UInt8 max_size,
+			UInt16 drop_count,
+			UInt16 max_residency_millis
+		) throw ();
+
+		/**
+		 * Constructs a QueueStatsResponse object from the given message
+		 */
+		explicit QueueStatsResponse (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		QueueStatsResponse& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 *   STATUS_E_QUEUE_ID if the queue is out of range
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the reported queue
+		 */
+		UInt8 getQueue () const throw ();
+
+		/**
+		 * Returns the current size of the queue
+		 */
+		UInt8 getSize () const throw ();
+
+		/**
+		 * Returns the maximum size of the queue since its creation
+		 */
+		UInt8 getMaxSize () const throw ();
+
+		/**
+		 * Returns the number of messages dropped because the pool
+		 * was exhausted
+		 */
+		UInt16 getDropCount () const throw ();
+
+		/**
+		 * Returns the longest time a message waited in the queue
+		 */
+		UInt16 getMaxResidencyMillis () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_QUEUE = 0,
+			OFFSET_SIZE = 1,
+			OFFSET_MAX_SIZE = 2,
+			OFFSET_DROP_COUNT = 3,
+			OFFSET_MAX_RESIDENCY_MILLIS = 5,
+			DATA_SIZE = 7
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef ROBOCOM_SHARED_MSG_REPEAT_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_REPEAT_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request to execute the messages of a task
+	 * periodically
+	 *
+	 * The request applies to the messages with the same task ID as the
+	 * request itself. After such a message has been handled, the server
+	 * puts it back to the input queue to be executed again one period
+	 * after its previous execution time. This repeats until the task
+	 * is cancelled with a RepeatRequest with the period of zero, or until
+	 * the robot state is reset. Cancelling the task also discards the
+	 * occurrence of its messages that is waiting in the input queue.
+	 *
+	 * The request must be sent before the repeated message is executed,
+	 * and it is always executed immediately.
+	 */
+	class RepeatRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = CommonMessageTypes::MSGID_REPEAT };
+
+		/**
+		 * Constructor
+		 *
+		 * @param task_id the ID of the task whose messages should repeat
+		 * @param period_millis the period of repetition in milliseconds,
+		 *  or zero to stop the repetition
+		 */
+		RepeatRequest (
+			UInt16 task_id,
+			UInt32 period_millis
+		) throw ();
+
+		/**
+		 * Constructs a RepeatRequest object from the given message
+		 */
+		explicit RepeatRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		RepeatRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the period of repetition in milliseconds
+		 *
+		 * @return the period, or zero if the repetition should stop
+		 */
+		UInt32 getPeriodMillis () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_PERIOD_MILLIS = 0,
+			DATA_SIZE = 4
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef ROBOCOM_SHARED_MSG_SENSOR_LOG_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_SENSOR_LOG_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the state of the sensor log of the robot,
+	 * sent in response to a SensorLogRequest
+	 */
+	class SensorLogNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_SENSOR_LOG };
+
+		/**
+		 * Constructor
+		 *
+		 * @param status the result of the request
+		 * @param is_running whether samples are being taken
+		 * @param record_count the number of samples not fetched yet
+		 * @param overflow_count the number of samples overwritten before
+		 *   they were fetched, modulo 2^16
+		 * @param next_index the number of the next sample
+		 * @param missed_count the number of samples skipped because
+		 *   their time passed before they were taken, modulo 2^16
+		 */
+		SensorLogNotice (
+			UInt16 task_id,
+			UInt8 status,
+			bool is_running,
+			UInt8 record_count,
+			UInt16 overflow_count,
+			UInt32 next_index,
+			UInt16 missed_count
+		) throw ();
+
+		/**
+		 * Constructs a SensorLogNotice object from the given message
+		 */
+		explicit SensorLogNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		SensorLogNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the result of the request
+		 */
+		UInt8 getStatus () const throw ()
+		{
+			return Layout::get<StatusField>( m_msg );
+		}
+
+		/**
+		 * Returns whether samples are being taken
+		 */
+		bool isRunning () const throw ()
+		{
+			return Layout::get<IsRunningField>( m_msg );
+		}
+
+		/**
+		 * Returns the number of samples not fetched yet
+		 */
+		UInt8 getRecordCount () const throw ()
+		{
+			return Layout::get<RecordCountField>( m_msg );
+		}
+
+		/**
+		 * Returns the number of samples overwritten before they were
+		 * fetched, modulo 2^16
+		 */
+		UInt16 getOverflowCount () const throw ()
+		{
+			return Layout::get<OverflowCountField>( m_msg );
+		}
+
+		/**
+		 * Returns the number of the next sample
+		 */
+		UInt32 getNextIndex () const throw ()
+		{
+			return Layout::get<NextIndexField>( m_msg );
+		}
+
+		/**
+		 * Returns the number of samples skipped because their time
+		 * passed before they were taken, modulo 2^16
+		 */
+		UInt16 getMissedCount () const throw ()
+		{
+			return Layout::get<MissedCountField>( m_msg );
+		}
+
+	private:
+
+		typedef schema::Field<UInt8> StatusField;
+		typedef schema::Field<bool, StatusField> IsRunningField;
+		typedef schema::Field<UInt8, IsRunningField> RecordCountField;
+		typedef schema::Field<UInt16, RecordCountField> OverflowCountField;
+		typedef schema::Field<UInt32, OverflowCountField> NextIndexField;
+		typedef schema::Field<UInt16, NextIndexField> MissedCountField;
+		typedef schema::Layout<MSGID, MissedCountField, schema::TIMING_IMMEDIATE> Layout;
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
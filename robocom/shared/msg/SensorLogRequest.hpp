@@ -0,0 +1,160 @@
+#ifndef ROBOCOM_SHARED_MSG_SENSOR_LOG_REQUEST_HPP
+#define ROBOCOM_SHARED_MSG_SENSOR_LOG_REQUEST_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the request to control the sensor log of
+	 * the robot (see robocom::shared::SensorLog)
+	 *
+	 * COMMAND_START discards the logged samples and starts taking samples
+	 * of the given channels with the given period. COMMAND_STOP stops
+	 * taking them. COMMAND_FETCH makes the robot send the oldest samples
+	 * as a blob (see BlobFragment) of at most the given size, and remove
+	 * them from the log; the blob goes out while the loop waits, so the
+	 * fetches made while logging should be small.
+	 *
+	 * The robot answers each request with a SensorLogNotice, which comes
+	 * after the blob of a fetch.
+	 */
+	class SensorLogRequest
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_SENSOR_LOG };
+
+		/// The operations on the log
+		enum Command
+		{
+			COMMAND_START,
+			COMMAND_STOP,
+			COMMAND_FETCH,
+			COMMAND_COUNT
+		};
+
+		/**
+		 * Constructor for a delayed-execution message
+		 *
+		 * @param command the Command value
+		 * @param channels the SensorLog::Channel values to log, for
+		 *   COMMAND_START
+		 * @param period_millis the time between two samples, for
+		 *   COMMAND_START
+		 * @param fetch_size the maximum size of the blob, for
+		 *   COMMAND_FETCH
+		 */
+		SensorLogRequest (
+			UInt16 task_id,
+			UInt32 current_millis,
+			UInt8 command,
+			UInt8 channels,
+			UInt16 period_millis,
+			UInt16 fetch_size
+		) throw ();
+
+		/**
+		 * Constructor for an immediate-execution message
+		 *
+		 * @param command the Command value
+		 * @param channels the SensorLog::Channel values to log, for
+		 *   COMMAND_START
+		 * @param period_millis the time between two samples, for
+		 *   COMMAND_START
+		 * @param fetch_size the maximum size of the blob, for
+		 *   COMMAND_FETCH
+		 */
+		SensorLogRequest (
+			UInt16 task_id,
+			UInt8 command,
+			UInt8 channels,
+			UInt16 period_millis,
+			UInt16 fetch_size
+		) throw ();
+
+		/**
+		 * Constructs a SensorLogRequest object from the given message
+		 */
+		explicit SensorLogRequest (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		SensorLogRequest& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_LOG_COMMAND if the command is not known
+		 *   STATUS_E_LOG_CHANNELS if a start has no or unknown channels
+		 *   STATUS_E_LOG_PERIOD if a start has the period of zero
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the Command value
+		 */
+		UInt8 getCommand () const throw ();
+
+		/**
+		 * Returns the channels to log
+		 */
+		UInt8 getChannels () const throw ();
+
+		/**
+		 * Returns the time between two samples
+		 */
+		UInt16 getPeriodMillis () const throw ();
+
+		/**
+		 * Returns the maximum size of the blob of a fetch
+		 */
+		UInt16 getFetchSize () const throw ();
+
+	private:
+
+		enum
+		{
+			OFFSET_COMMAND = 0,
+			OFFSET_CHANNELS = 1,
+			OFFSET_PERIOD_MILLIS = 2,
+			OFFSET_FETCH_SIZE = 4,
+			DATA_SIZE = 6
+		};
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "MessageTypes.hpp"
 #include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
 
 namespace robocom {
 namespace shared {
@@ -83,7 +84,10 @@ namespace msg
 		 *
 		 * @return 0-based ID
 		 */
-		UInt8 getServoId () const throw ();
+		UInt8 getServoId () const throw ()
+		{
+			return Layout::get<ServoIdField>( m_msg );
+		}
 
 		/**
 		 * Returns the current angle of rotation
@@ -91,16 +95,16 @@ namespace msg
 		 * @return a value between 0 and 180 (inclusive) representing the
 		 *   rotation angle
 		 */
-		UInt8 getAngle () const throw ();
+		UInt8 getAngle () const throw ()
+		{
+			return Layout::get<AngleField>( m_msg );
+		}
 
 	private:
 
-		enum
-		{
-			OFFSET_SERVO_ID = 0,
-			OFFSET_ANGLE = 1,
-			DATA_SIZE = 2
-		};
+		typedef schema::Field<UInt8> ServoIdField;
+		typedef schema::Field<UInt8, ServoIdField> AngleField;
+		typedef schema::Layout<MSGID, AngleField> Layout;
 
 		Message m_msg;
 	};
@@ -41,6 +41,12 @@ namespace msg
 	 */
 	typedef SimpleMessage<CommonMessageTypes::MSGID_RESET> ResetRequest;
 
+	/**
+	 * This class represents the request to drop the LOGO commands waiting
+	 * for the active one to complete
+	 */
+	typedef SimpleMessage<RobocomMessageTypes::MSGID_LOGO_CANCEL> LogoCancelRequest;
+
 
 	template <int ID>
 	class SimpleMessage
@@ -0,0 +1,101 @@
+#ifndef ROBOCOM_SHARED_MSG_SUBSCRIPTION_STATUS_NOTICE_HPP
+#define ROBOCOM_SHARED_MSG_SUBSCRIPTION_STATUS_NOTICE_HPP
+
+#include "../Message.hpp"
+
+#include "MessageTypes.hpp"
+#include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	/**
+	 * This class represents the notice that a subscription to a sensor
+	 * (see EncoderReadingRequest and GyroReadingRequest) was refused
+	 *
+	 * The robot sends it with the task ID of the subscribe request
+	 * instead of any readings, for example with STATUS_E_SUBSCRIBERS when
+	 * the sensor already has as many subscribers as it can keep. Accepted
+	 * subscriptions are not confirmed, as clients that predate the notice
+	 * do not expect it.
+	 */
+	class SubscriptionStatusNotice
+	{
+	public:
+
+		/// The message type for instances of this class
+		enum { MSGID = RobocomMessageTypes::MSGID_SUBSCRIPTION_STATUS };
+
+		/**
+		 * Constructor
+		 *
+		 * @param status the reason why the subscription was refused
+		 */
+		SubscriptionStatusNotice (
+			UInt16 task_id,
+			UInt8 status
+		) throw ();
+
+		/**
+		 * Constructs a SubscriptionStatusNotice object from the given
+		 * message
+		 */
+		explicit SubscriptionStatusNotice (const Message& msg) throw ();
+
+		/**
+		 * Copies state from the given message into this object
+		 */
+		SubscriptionStatusNotice& operator= (const Message& msg) throw ();
+
+		/**
+		 * Returns the representation of this object state as a Message
+		 * instance
+		 */
+		const Message& asMessage () const throw ();
+
+		/**
+		 * Returns whether the data stored in this object is valid
+		 * and consistent
+		 *
+		 * Clients should not attempt to interpret the message if
+		 * this function returns an error value
+		 *
+		 * @return STATUS_OK if data is valid
+		 *   STATUS_E_MESSAGE_TYPE if the message type does not match
+		 *   STATUS_E_DATA_SIZE if the data size is wrong
+		 *   STATUS_E_NOT_IMMEDIATE if the message is not marked
+		 *    as immediate
+		 */
+		MessageStatus validate () const throw ();
+
+  		/**
+		 * Returns the ID of the task associated with this message, or
+		 * zero if there is no such task
+		 */
+		UInt16 getTaskId () const throw ()
+		{
+			return m_msg.getTaskId();
+		}
+
+		/**
+		 * Returns the reason why the subscription was refused
+		 */
+		UInt8 getStatus () const throw ()
+		{
+			return Layout::get<StatusField>( m_msg );
+		}
+
+	private:
+
+		typedef schema::Field<UInt8> StatusField;
+		typedef schema::Layout<MSGID, StatusField, schema::TIMING_IMMEDIATE> Layout;
+
+		Message m_msg;
+	};
+
+} } }
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "MessageTypes.hpp"
 #include "MessageStatus.hpp"
+#include "MessageSchema.hxx"
 
 namespace robocom {
 namespace shared {
@@ -82,7 +83,10 @@ namespace msg
 		 *
 		 * @return 0 for backward, 1 for forward
 		 */
-		UInt8 getMotor1Direction () const throw ();
+		UInt8 getMotor1Direction () const throw ()
+		{
+			return Layout::get<Motor1DirectionField>( m_msg );
+		}
 
 		/**
 		 * Returns the signal strength for the drive of the motor 1
@@ -93,14 +97,20 @@ namespace msg
 		 *
 		 * @return a value representing the signal strength
 		 */
-		UInt8 getMotor1Signal () const throw ();
+		UInt8 getMotor1Signal () const throw ()
+		{
+			return Layout::get<Motor1SignalField>( m_msg );
+		}
 
 		/**
 		 * Returns the direction in which the motor signal is applied
 		 *
 		 * @return 0 for backward, 1 for forward
 		 */
-		UInt8 getMotor2Direction () const throw ();
+		UInt8 getMotor2Direction () const throw ()
+		{
+			return Layout::get<Motor2DirectionField>( m_msg );
+		}
 
 		/**
 		 * Returns the signal strength for the drive of the motor 2
@@ -111,18 +121,18 @@ namespace msg
 		 *
 		 * @return a value representing the signal strength
 		 */
-		UInt8 getMotor2Signal () const throw ();
+		UInt8 getMotor2Signal () const throw ()
+		{
+			return Layout::get<Motor2SignalField>( m_msg );
+		}
 
 	private:
 
-		enum
-		{
-			OFFSET_MOTOR_1_DIRECTION = 0,
-			OFFSET_MOTOR_1_SIGNAL = 1,
-			OFFSET_MOTOR_2_DIRECTION = 2,
-			OFFSET_MOTOR_2_SIGNAL = 3,
-			DATA_SIZE = 4
-		};
+		typedef schema::Field<UInt8> Motor1DirectionField;
+		typedef schema::Field<UInt8, Motor1DirectionField> Motor1SignalField;
+		typedef schema::Field<UInt8, Motor1SignalField> Motor2DirectionField;
+		typedef schema::Field<UInt8, Motor2DirectionField> Motor2SignalField;
+		typedef schema::Layout<MSGID, Motor2SignalField, schema::TIMING_DELAYED> Layout;
 
 		Message m_msg;
 	};
@@ -0,0 +1,123 @@
+#include "../BlobFragment.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	BlobFragment::BlobFragment (
+		UInt16 task_id,
+		UInt16 offset,
+		const UInt8* p_data,
+		UInt8 size,
+		bool is_final
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		// Immediate first, a full fragment does not fit a delayed message
+		m_msg.setImmediate();
+		m_msg.setDataSize( OFFSET_DATA + size );
+		m_msg.setTaskId( task_id );
+		m_msg.setUInt16( OFFSET_OFFSET, is_final ? offset | FINAL_BIT : offset );
+
+		for ( UInt8 i = 0; i < size; ++i ) {
+			m_msg.setUInt8( OFFSET_DATA + i, p_data[i] );
+		}
+	}
+
+
+	BlobFragment::BlobFragment (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	BlobFragment&
+	BlobFragment::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	BlobFragment
+	BlobFragment::makeFragment (
+		UInt16 task_id,
+		const UInt8* p_blob,
+		UInt16 blob_size,
+		UInt16 offset
+	) throw ()
+	{
+		const UInt16 left = blob_size - offset;
+		const bool is_final = left <= MAX_FRAGMENT_SIZE;
+
+		return BlobFragment(
+			task_id,
+			offset,
+			p_blob + offset,
+			is_final ? left : MAX_FRAGMENT_SIZE,
+			is_final
+		);
+	}
+
+
+	const Message&
+	BlobFragment::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	BlobFragment::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() < OFFSET_DATA ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt16
+	BlobFragment::getOffset () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_OFFSET ) & ~FINAL_BIT;
+	}
+
+
+	bool
+	BlobFragment::isFinal () const throw ()
+	{
+		return 0 != ( m_msg.getUInt16( OFFSET_OFFSET ) & FINAL_BIT );
+	}
+
+
+	UInt8
+	BlobFragment::getSize () const throw ()
+	{
+		return m_msg.getDataSize() - OFFSET_DATA;
+	}
+
+
+	void
+	BlobFragment::getData (UInt8* p_data) const throw ()
+	{
+		for ( UInt8 i = 0; i < getSize(); ++i ) {
+			p_data[i] = m_msg.getUInt8( OFFSET_DATA + i );
+		}
+	}
+
+} } }
@@ -0,0 +1,80 @@
+#include "../BlobStatusNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	BlobStatusNotice::BlobStatusNotice (
+		UInt16 task_id,
+		UInt8 status,
+		UInt16 size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_STATUS, status );
+		m_msg.setUInt16( OFFSET_SIZE, size );
+	}
+
+
+	BlobStatusNotice::BlobStatusNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	BlobStatusNotice&
+	BlobStatusNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	BlobStatusNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	BlobStatusNotice::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	BlobStatusNotice::getStatus () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_STATUS );
+	}
+
+
+	UInt16
+	BlobStatusNotice::getSize () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_SIZE );
+	}
+
+} } }
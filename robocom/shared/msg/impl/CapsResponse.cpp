@@ -0,0 +1,134 @@
+#include "../CapsResponse.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	CapsResponse::CapsResponse (
+		UInt16 task_id,
+		UInt8 version,
+		UInt8 features,
+		UInt8 max_data_size,
+		UInt8 pool_size,
+		UInt8 max_repeated_tasks,
+		UInt8 window_size,
+		UInt8 retransmit_millis,
+		UInt16 max_blob_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_VERSION, version );
+		m_msg.setUInt8( OFFSET_FEATURES, features );
+		m_msg.setUInt8( OFFSET_MAX_DATA_SIZE, max_data_size );
+		m_msg.setUInt8( OFFSET_POOL_SIZE, pool_size );
+		m_msg.setUInt8( OFFSET_MAX_REPEATED_TASKS, max_repeated_tasks );
+		m_msg.setUInt8( OFFSET_WINDOW_SIZE, window_size );
+		m_msg.setUInt8( OFFSET_RETRANSMIT_MILLIS, retransmit_millis );
+		m_msg.setUInt16( OFFSET_MAX_BLOB_SIZE, max_blob_size );
+	}
+
+
+	CapsResponse::CapsResponse (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	CapsResponse&
+	CapsResponse::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	CapsResponse::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	CapsResponse::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() < DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	CapsResponse::getVersion () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_VERSION );
+	}
+
+
+	UInt8
+	CapsResponse::getFeatures () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_FEATURES );
+	}
+
+
+	UInt8
+	CapsResponse::getMaxDataSize () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_MAX_DATA_SIZE );
+	}
+
+
+	UInt8
+	CapsResponse::getPoolSize () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_POOL_SIZE );
+	}
+
+
+	UInt8
+	CapsResponse::getMaxRepeatedTasks () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_MAX_REPEATED_TASKS );
+	}
+
+
+	UInt8
+	CapsResponse::getWindowSize () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_WINDOW_SIZE );
+	}
+
+
+	UInt8
+	CapsResponse::getRetransmitMillis () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_RETRANSMIT_MILLIS );
+	}
+
+
+	UInt16
+	CapsResponse::getMaxBlobSize () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_MAX_BLOB_SIZE );
+	}
+
+} } }
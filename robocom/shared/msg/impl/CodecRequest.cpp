@@ -0,0 +1,78 @@
+
+#include "../../MessageIO.hpp"
+
+#include "../CodecRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	CodecRequest::CodecRequest (
+		UInt16 task_id,
+		UInt8 codec
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_CODEC, codec );
+	}
+
+
+	CodecRequest::CodecRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	CodecRequest&
+	CodecRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	CodecRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	CodecRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getCodec() >= MessageIO::CODEC_COUNT ) {
+			return STATUS_E_CODEC;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	CodecRequest::getCodec () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_CODEC );
+	}
+
+} } }
@@ -0,0 +1,49 @@
+
+#include "../CreditNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	CreditNotice::CreditNotice (
+		UInt16 task_id,
+		UInt16 credit_limit
+	) throw ()
+		: m_msg( )
+	{
+		Layout::initImmediate( m_msg, task_id );
+		Layout::set<CreditLimitField>( m_msg, credit_limit );
+	}
+
+
+	CreditNotice::CreditNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	CreditNotice&
+	CreditNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	CreditNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	CreditNotice::validate () const throw ()
+	{
+		return Layout::validate( m_msg );
+	}
+
+} } }
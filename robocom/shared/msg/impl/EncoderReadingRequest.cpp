@@ -9,7 +9,11 @@ namespace msg
 		UInt16 task_id,
 		UInt32 current_millis,
 		UInt8 encoder_id,
-		bool is_subscribe
+		bool is_subscribe,
+		Format format,
+		UInt16 min_interval_millis,
+		UInt8 decimation,
+		UInt16 change_threshold
 	) throw ()
 		: m_msg( )
 	{
@@ -20,13 +24,21 @@ namespace msg
 		m_msg.setMillis( current_millis );
 		m_msg.setUInt8( OFFSET_ENCODER_ID, encoder_id );
 		m_msg.setUInt8( OFFSET_IS_SUBSCRIBE, is_subscribe ? 1 : 0 );
+		m_msg.setUInt8( OFFSET_FORMAT, format );
+		m_msg.setUInt16( OFFSET_MIN_INTERVAL_MILLIS, min_interval_millis );
+		m_msg.setUInt8( OFFSET_DECIMATION, decimation );
+		m_msg.setUInt16( OFFSET_CHANGE_THRESHOLD, change_threshold );
 	}
 
 
 	EncoderReadingRequest::EncoderReadingRequest (
 		UInt16 task_id,
 		UInt8 encoder_id,
-		bool is_subscribe
+		bool is_subscribe,
+		Format format,
+		UInt16 min_interval_millis,
+		UInt8 decimation,
+		UInt16 change_threshold
 	) throw ()
 		: m_msg( )
 	{
@@ -37,6 +49,10 @@ namespace msg
 		m_msg.setImmediate();
 		m_msg.setUInt8( OFFSET_ENCODER_ID, encoder_id );
 		m_msg.setUInt8( OFFSET_IS_SUBSCRIBE, is_subscribe ? 1 : 0 );
+		m_msg.setUInt8( OFFSET_FORMAT, format );
+		m_msg.setUInt16( OFFSET_MIN_INTERVAL_MILLIS, min_interval_millis );
+		m_msg.setUInt8( OFFSET_DECIMATION, decimation );
+		m_msg.setUInt16( OFFSET_CHANGE_THRESHOLD, change_threshold );
 	}
 
 
@@ -70,7 +86,10 @@ namespace msg
 			return STATUS_E_MESSAGE_TYPE;
 		}
 
-		if ( m_msg.getDataSize() != DATA_SIZE ) {
+		if ( m_msg.getDataSize() != DATA_SIZE
+			 	&&
+			 m_msg.getDataSize() != LEGACY_DATA_SIZE )
+		{
 			return STATUS_E_DATA_SIZE;
 		}
 
@@ -83,6 +102,11 @@ namespace msg
 			return STATUS_E_IS_SUBSCRIBE;
 		}
 
+		const UInt8 format = getFormat();
+		if ( format != FORMAT_READING && format != FORMAT_TICKS ) {
+			return STATUS_E_ENCODER_FORMAT;
+		}
+
 		return STATUS_OK;
 	}
 
@@ -100,5 +124,56 @@ namespace msg
 		return 0 != m_msg.getUInt8( OFFSET_IS_SUBSCRIBE );
 	}
 
+
+	bool
+	EncoderReadingRequest::isLegacy () const throw ()
+	{
+		return m_msg.getDataSize() == LEGACY_DATA_SIZE;
+	}
+
+
+	EncoderReadingRequest::Format
+	EncoderReadingRequest::getFormat () const throw ()
+	{
+		if ( m_msg.getDataSize() <= OFFSET_FORMAT ) {
+			return FORMAT_READING;
+		}
+
+		return static_cast<Format>( m_msg.getUInt8( OFFSET_FORMAT ) );
+	}
+
+
+	UInt16
+	EncoderReadingRequest::getMinIntervalMillis () const throw ()
+	{
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return 0;
+		}
+
+		return m_msg.getUInt16( OFFSET_MIN_INTERVAL_MILLIS );
+	}
+
+
+	UInt8
+	EncoderReadingRequest::getDecimation () const throw ()
+	{
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return 1;
+		}
+
+		return m_msg.getUInt8( OFFSET_DECIMATION );
+	}
+
+
+	UInt16
+	EncoderReadingRequest::getChangeThreshold () const throw ()
+	{
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return 0;
+		}
+
+		return m_msg.getUInt16( OFFSET_CHANGE_THRESHOLD );
+	}
+
 } } }
 
@@ -0,0 +1,134 @@
+#include "../EncoderTicksNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	EncoderTicksNotice::EncoderTicksNotice (
+		UInt16 task_id,
+		UInt8 encoder_id,
+		UInt32 tick_index,
+		const UInt32* p_tick_micros,
+		UInt8 tick_count
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		// Immediate first, a full batch does not fit a delayed message
+		m_msg.setImmediate();
+		m_msg.setDataSize( MIN_DATA_SIZE + INTERVAL_SIZE * (tick_count - 1) );
+		m_msg.setTaskId( task_id );
+		m_msg.setUInt8( OFFSET_ENCODER_ID, encoder_id );
+		m_msg.setUInt32( OFFSET_TICK_INDEX, tick_index );
+		m_msg.setUInt32( OFFSET_MICROS, p_tick_micros[tick_count - 1] );
+
+		for ( UInt8 i = 0; i + 1 < tick_count; ++i )
+		{
+			m_msg.setUInt16(
+				OFFSET_INTERVALS + INTERVAL_SIZE * i,
+				static_cast<UInt16>( p_tick_micros[i + 1] - p_tick_micros[i] )
+			);
+		}
+	}
+
+
+	EncoderTicksNotice::EncoderTicksNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	EncoderTicksNotice&
+	EncoderTicksNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	EncoderTicksNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	EncoderTicksNotice::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		const UInt8 data_size = m_msg.getDataSize();
+		if ( data_size < MIN_DATA_SIZE
+			 	||
+			 (data_size - MIN_DATA_SIZE) % INTERVAL_SIZE != 0 )
+		{
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( getEncoderId() != 0 && getEncoderId() != 1 ) {
+			return STATUS_E_ENCODER_ID;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	EncoderTicksNotice::getEncoderId () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_ENCODER_ID );
+	}
+
+
+	UInt8
+	EncoderTicksNotice::getTickCount () const throw ()
+	{
+		return 1 + (m_msg.getDataSize() - MIN_DATA_SIZE) / INTERVAL_SIZE;
+	}
+
+
+	UInt32
+	EncoderTicksNotice::getTickIndex () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_TICK_INDEX );
+	}
+
+
+	UInt32
+	EncoderTicksNotice::getMeasurementMicros () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_MICROS );
+	}
+
+
+	UInt16
+	EncoderTicksNotice::getInterval (UInt8 i) const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_INTERVALS + INTERVAL_SIZE * i );
+	}
+
+
+	UInt32
+	EncoderTicksNotice::getTickMicros (UInt8 i) const throw ()
+	{
+		UInt32 tick_micros = getMeasurementMicros();
+
+		for ( UInt8 j = getTickCount() - 1; j > i; --j ) {
+			tick_micros -= getInterval( j - 1 );
+		}
+
+		return tick_micros;
+	}
+
+} } }
@@ -13,7 +13,8 @@ namespace msg
 		UInt8 input_queue_max_size,
 		UInt8 input_queue_size,
 		UInt8 output_queue_max_size,
-		UInt8 output_queue_size
+		UInt8 output_queue_size,
+		UInt16 credit_limit
 	) throw ()
 		: m_msg( )
 	{
@@ -28,6 +29,7 @@ namespace msg
 		m_msg.setUInt8( OFFSET_INPUT_QUEUE_SIZE, input_queue_size );
 		m_msg.setUInt8( OFFSET_OUTPUT_QUEUE_MAX_SIZE, output_queue_max_size );
 		m_msg.setUInt8( OFFSET_OUTPUT_QUEUE_SIZE, output_queue_size );
+		m_msg.setUInt16( OFFSET_CREDIT_LIMIT, credit_limit );
 	}
 
 
@@ -61,7 +63,10 @@ namespace msg
 			return STATUS_E_MESSAGE_TYPE;
 		}
 
-		if ( m_msg.getDataSize() != DATA_SIZE ) {
+		if ( m_msg.getDataSize() != DATA_SIZE
+			 	&&
+			 m_msg.getDataSize() != LEGACY_DATA_SIZE )
+		{
 			return STATUS_E_DATA_SIZE;
 		}
 
@@ -126,5 +131,23 @@ namespace msg
 		return m_msg.getUInt8( OFFSET_OUTPUT_QUEUE_SIZE );
 	}
 
+
+	bool
+	FlushResponse::hasCreditLimit () const throw ()
+	{
+		return m_msg.getDataSize() == DATA_SIZE;
+	}
+
+
+	UInt16
+	FlushResponse::getCreditLimit () const throw ()
+	{
+		if ( ! hasCreditLimit() ) {
+			return 0;
+		}
+
+		return m_msg.getUInt16( OFFSET_CREDIT_LIMIT );
+	}
+
 } } }
 
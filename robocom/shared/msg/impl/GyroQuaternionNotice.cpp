@@ -0,0 +1,58 @@
+
+#include "../GyroQuaternionNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	GyroQuaternionNotice::GyroQuaternionNotice (
+		UInt16 task_id,
+		UInt32 current_millis,
+		SInt16 w,
+		SInt16 x,
+		SInt16 y,
+		SInt16 z,
+		UInt32 measurement_us
+	) throw ()
+		: m_msg( )
+	{
+		Layout::initDelayed( m_msg, task_id, current_millis );
+		Layout::set<WField>( m_msg, w );
+		Layout::set<XField>( m_msg, x );
+		Layout::set<YField>( m_msg, y );
+		Layout::set<ZField>( m_msg, z );
+		Layout::set<MicrosField>( m_msg, measurement_us );
+	}
+
+
+	GyroQuaternionNotice::GyroQuaternionNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	GyroQuaternionNotice&
+	GyroQuaternionNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	GyroQuaternionNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	GyroQuaternionNotice::validate () const throw ()
+	{
+		return Layout::validate( m_msg );
+	}
+
+} } }
@@ -9,7 +9,10 @@ namespace msg
 		UInt16 task_id,
 		UInt32 current_millis,
 		UInt32 min_delay_millis,
-		bool is_subscribe
+		bool is_subscribe,
+		Format format,
+		UInt8 decimation,
+		UInt16 change_threshold
 	) throw ()
 		: m_msg( )
 	{
@@ -20,13 +23,19 @@ namespace msg
 		m_msg.setMillis( current_millis );
 		m_msg.setUInt8( OFFSET_IS_SUBSCRIBE, is_subscribe ? 1 : 0 );
 		m_msg.setUInt32( OFFSET_MIN_DELAY_MILLIS, min_delay_millis );
+		m_msg.setUInt8( OFFSET_FORMAT, format );
+		m_msg.setUInt8( OFFSET_DECIMATION, decimation );
+		m_msg.setUInt16( OFFSET_CHANGE_THRESHOLD, change_threshold );
 	}
 
 
 	GyroReadingRequest::GyroReadingRequest (
 		UInt16 task_id,
 		UInt32 min_delay_millis,
-		bool is_subscribe
+		bool is_subscribe,
+		Format format,
+		UInt8 decimation,
+		UInt16 change_threshold
 	) throw ()
 		: m_msg( )
 	{
@@ -37,6 +46,9 @@ namespace msg
 		m_msg.setImmediate();
 		m_msg.setUInt8( OFFSET_IS_SUBSCRIBE, is_subscribe ? 1 : 0 );
 		m_msg.setUInt32( OFFSET_MIN_DELAY_MILLIS, min_delay_millis );
+		m_msg.setUInt8( OFFSET_FORMAT, format );
+		m_msg.setUInt8( OFFSET_DECIMATION, decimation );
+		m_msg.setUInt16( OFFSET_CHANGE_THRESHOLD, change_threshold );
 	}
 
 
@@ -70,7 +82,10 @@ namespace msg
 			return STATUS_E_MESSAGE_TYPE;
 		}
 
-		if ( m_msg.getDataSize() != DATA_SIZE ) {
+		if ( m_msg.getDataSize() != DATA_SIZE
+			 	&&
+			 m_msg.getDataSize() != LEGACY_DATA_SIZE )
+		{
 			return STATUS_E_DATA_SIZE;
 		}
 
@@ -79,6 +94,11 @@ namespace msg
 			return STATUS_E_IS_SUBSCRIBE;
 		}
 
+		const UInt8 format = getFormat();
+		if ( format != FORMAT_YAW_PITCH_ROLL && format != FORMAT_QUATERNION ) {
+			return STATUS_E_GYRO_FORMAT;
+		}
+
 		return STATUS_OK;
 	}
 
@@ -96,5 +116,45 @@ namespace msg
 		return 0 != m_msg.getUInt8( OFFSET_IS_SUBSCRIBE );
 	}
 
+
+	bool
+	GyroReadingRequest::isLegacy () const throw ()
+	{
+		return m_msg.getDataSize() == LEGACY_DATA_SIZE;
+	}
+
+
+	GyroReadingRequest::Format
+	GyroReadingRequest::getFormat () const throw ()
+	{
+		if ( m_msg.getDataSize() <= OFFSET_FORMAT ) {
+			return FORMAT_YAW_PITCH_ROLL;
+		}
+
+		return static_cast<Format>( m_msg.getUInt8( OFFSET_FORMAT ) );
+	}
+
+
+	UInt8
+	GyroReadingRequest::getDecimation () const throw ()
+	{
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return 1;
+		}
+
+		return m_msg.getUInt8( OFFSET_DECIMATION );
+	}
+
+
+	UInt16
+	GyroReadingRequest::getChangeThreshold () const throw ()
+	{
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return 0;
+		}
+
+		return m_msg.getUInt16( OFFSET_CHANGE_THRESHOLD );
+	}
+
 } } }
 
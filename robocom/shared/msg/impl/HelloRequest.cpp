@@ -0,0 +1,80 @@
+#include "../HelloRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	HelloRequest::HelloRequest (
+		UInt16 task_id,
+		UInt8 version,
+		UInt8 features
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_VERSION, version );
+		m_msg.setUInt8( OFFSET_FEATURES, features );
+	}
+
+
+	HelloRequest::HelloRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	HelloRequest&
+	HelloRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	HelloRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	HelloRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() < DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	HelloRequest::getVersion () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_VERSION );
+	}
+
+
+	UInt8
+	HelloRequest::getFeatures () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_FEATURES );
+	}
+
+} } }
@@ -0,0 +1,112 @@
+#include "../LogoProgramRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	LogoProgramRequest::LogoProgramRequest (
+		UInt16 task_id,
+		UInt32 current_millis,
+		UInt16 offset,
+		const UInt8* p_code,
+		UInt8 code_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( OFFSET_CODE + code_size );
+		m_msg.setTaskId( task_id );
+		m_msg.setMillis( current_millis );
+		m_msg.setUInt16( OFFSET_OFFSET, offset );
+
+		for ( UInt8 i = 0; i < code_size; ++i ) {
+			m_msg.setUInt8( OFFSET_CODE + i, p_code[i] );
+		}
+	}
+
+
+	LogoProgramRequest::LogoProgramRequest (
+		UInt16 task_id,
+		UInt16 offset,
+		const UInt8* p_code,
+		UInt8 code_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		// Immediate first, a full chunk does not fit a delayed message
+		m_msg.setImmediate();
+		m_msg.setDataSize( OFFSET_CODE + code_size );
+		m_msg.setTaskId( task_id );
+		m_msg.setUInt16( OFFSET_OFFSET, offset );
+
+		for ( UInt8 i = 0; i < code_size; ++i ) {
+			m_msg.setUInt8( OFFSET_CODE + i, p_code[i] );
+		}
+	}
+
+
+	LogoProgramRequest::LogoProgramRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	LogoProgramRequest&
+	LogoProgramRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	LogoProgramRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	LogoProgramRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() <= OFFSET_CODE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt16
+	LogoProgramRequest::getOffset () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_OFFSET );
+	}
+
+
+	UInt8
+	LogoProgramRequest::getCodeSize () const throw ()
+	{
+		return m_msg.getDataSize() - OFFSET_CODE;
+	}
+
+
+	void
+	LogoProgramRequest::getCode (UInt8* p_code) const throw ()
+	{
+		for ( UInt8 i = 0; i < getCodeSize(); ++i ) {
+			p_code[i] = m_msg.getUInt8( OFFSET_CODE + i );
+		}
+	}
+
+} } }
@@ -0,0 +1,83 @@
+#include "../LogoRunRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	LogoRunRequest::LogoRunRequest (
+		UInt16 task_id,
+		UInt32 current_millis,
+		UInt16 program_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setMillis( current_millis );
+		m_msg.setUInt16( OFFSET_PROGRAM_SIZE, program_size );
+	}
+
+
+	LogoRunRequest::LogoRunRequest (
+		UInt16 task_id,
+		UInt16 program_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt16( OFFSET_PROGRAM_SIZE, program_size );
+	}
+
+
+	LogoRunRequest::LogoRunRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	LogoRunRequest&
+	LogoRunRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	LogoRunRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	LogoRunRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt16
+	LogoRunRequest::getProgramSize () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_PROGRAM_SIZE );
+	}
+
+} } }
@@ -78,6 +78,10 @@ namespace msg
 			return STATUS_E_DIRECTION;
 		}
 
+		if ( getAngle() > MAX_ANGLE ) {
+			return STATUS_E_ANGLE_RANGE;
+		}
+
 		return STATUS_OK;
 	}
 
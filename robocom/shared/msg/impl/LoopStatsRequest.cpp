@@ -0,0 +1,87 @@
+
+#include "../../LoopProfile.hpp"
+
+#include "../LoopStatsRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	LoopStatsRequest::LoopStatsRequest (
+		UInt16 task_id,
+		UInt8 phase,
+		UInt8 flags
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_PHASE, phase );
+		m_msg.setUInt8( OFFSET_FLAGS, flags );
+	}
+
+
+	LoopStatsRequest::LoopStatsRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	LoopStatsRequest&
+	LoopStatsRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	LoopStatsRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	LoopStatsRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getPhase() >= LoopProfile::PHASE_COUNT ) {
+			return STATUS_E_LOOP_PHASE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	LoopStatsRequest::getPhase () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_PHASE );
+	}
+
+
+	bool
+	LoopStatsRequest::isReset () const throw ()
+	{
+		return 0 != ( m_msg.getUInt8( OFFSET_FLAGS ) & FLAG_RESET );
+	}
+
+} } }
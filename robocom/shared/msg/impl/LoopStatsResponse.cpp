@@ -0,0 +1,105 @@
+
+#include "../../LoopProfile.hpp"
+
+#include "../LoopStatsResponse.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	LoopStatsResponse::LoopStatsResponse (
+		UInt16 task_id,
+		UInt8 phase,
+		UInt32 count,
+		UInt32 sum_micros,
+		UInt32 max_micros
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setImmediate();
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setUInt8( OFFSET_PHASE, phase );
+		m_msg.setUInt32( OFFSET_COUNT, count );
+		m_msg.setUInt32( OFFSET_SUM_MICROS, sum_micros );
+		m_msg.setUInt32( OFFSET_MAX_MICROS, max_micros );
+	}
+
+
+	LoopStatsResponse::LoopStatsResponse (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	LoopStatsResponse&
+	LoopStatsResponse::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	LoopStatsResponse::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	LoopStatsResponse::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getPhase() >= LoopProfile::PHASE_COUNT ) {
+			return STATUS_E_LOOP_PHASE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	LoopStatsResponse::getPhase () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_PHASE );
+	}
+
+
+	UInt32
+	LoopStatsResponse::getCount () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_COUNT );
+	}
+
+
+	UInt32
+	LoopStatsResponse::getSumMicros () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_SUM_MICROS );
+	}
+
+
+	UInt32
+	LoopStatsResponse::getMaxMicros () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_MAX_MICROS );
+	}
+
+} } }
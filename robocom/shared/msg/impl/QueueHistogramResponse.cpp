@@ -0,0 +1,128 @@
+
+#include "../../QueueProfile.hpp"
+#include "../QueueStatsRequest.hpp"
+
+#include "../QueueHistogramResponse.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	QueueHistogramResponse::QueueHistogramResponse (
+		UInt16 task_id,
+		UInt8 queue,
+		UInt8 histogram,
+		UInt8 first_bucket,
+		const UInt16* p_buckets,
+		UInt8 bucket_count
+	) throw ()
+		: m_msg( )
+	{
+		USE_CONTRACT_CHECK( bucket_count <= MAX_BUCKET_COUNT );
+
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setImmediate();
+		m_msg.setDataSize( MIN_DATA_SIZE + 2 * bucket_count );
+		m_msg.setTaskId( task_id );
+		m_msg.setUInt8( OFFSET_QUEUE, queue );
+		m_msg.setUInt8( OFFSET_HISTOGRAM, histogram );
+		m_msg.setUInt8( OFFSET_FIRST_BUCKET, first_bucket );
+
+		for ( UInt8 i = 0; i < bucket_count; i++ ) {
+			m_msg.setUInt16( OFFSET_BUCKETS + 2 * i, p_buckets[i] );
+		}
+	}
+
+
+	QueueHistogramResponse::QueueHistogramResponse (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	QueueHistogramResponse&
+	QueueHistogramResponse::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	QueueHistogramResponse::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	QueueHistogramResponse::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		const UInt8 size = m_msg.getDataSize();
+		if ( size < MIN_DATA_SIZE ||
+			 0 != ( size - MIN_DATA_SIZE ) % 2 ||
+			 getBucketCount() > MAX_BUCKET_COUNT )
+		{
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getQueue() >= QueueStatsRequest::QUEUE_COUNT ||
+			 getHistogram() >= QueueProfile::HISTOGRAM_COUNT ||
+			 getFirstBucket() + getBucketCount() >
+			 	QueueProfile::getBucketCount( getHistogram() ) )
+		{
+			return STATUS_E_QUEUE_ID;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	QueueHistogramResponse::getQueue () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_QUEUE );
+	}
+
+
+	UInt8
+	QueueHistogramResponse::getHistogram () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_HISTOGRAM );
+	}
+
+
+	UInt8
+	QueueHistogramResponse::getFirstBucket () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_FIRST_BUCKET );
+	}
+
+
+	UInt8
+	QueueHistogramResponse::getBucketCount () const throw ()
+	{
+		return ( m_msg.getDataSize() - MIN_DATA_SIZE ) / 2;
+	}
+
+
+	UInt16
+	QueueHistogramResponse::getBucket (UInt8 i) const throw ()
+	{
+		USE_CONTRACT_CHECK( i < getBucketCount() );
+		return m_msg.getUInt16( OFFSET_BUCKETS + 2 * i );
+	}
+
+} } }
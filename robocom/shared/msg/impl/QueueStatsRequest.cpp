@@ -0,0 +1,85 @@
+
+#include "../QueueStatsRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	QueueStatsRequest::QueueStatsRequest (
+		UInt16 task_id,
+		UInt8 queue,
+		UInt8 flags
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_QUEUE, queue );
+		m_msg.setUInt8( OFFSET_FLAGS, flags );
+	}
+
+
+	QueueStatsRequest::QueueStatsRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	QueueStatsRequest&
+	QueueStatsRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	QueueStatsRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	QueueStatsRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getQueue() >= QUEUE_COUNT ) {
+			return STATUS_E_QUEUE_ID;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	QueueStatsRequest::getQueue () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_QUEUE );
+	}
+
+
+	bool
+	QueueStatsRequest::isReset () const throw ()
+	{
+		return 0 != ( m_msg.getUInt8( OFFSET_FLAGS ) & FLAG_RESET );
+	}
+
+} } }
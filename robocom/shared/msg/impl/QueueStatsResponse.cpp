@@ -0,0 +1,114 @@
+
+#include "../QueueStatsRequest.hpp"
+
+#include "../QueueStatsResponse.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	QueueStatsResponse::QueueStatsResponse (
+		UInt16 task_id,
+		UInt8 queue,
+		UInt8 size,
+		UInt8 max_size,
+		UInt16 drop_count,
+		UInt16 max_residency_millis
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_QUEUE, queue );
+		m_msg.setUInt8( OFFSET_SIZE, size );
+		m_msg.setUInt8( OFFSET_MAX_SIZE, max_size );
+		m_msg.setUInt16( OFFSET_DROP_COUNT, drop_count );
+		m_msg.setUInt16( OFFSET_MAX_RESIDENCY_MILLIS, max_residency_millis );
+	}
+
+
+	QueueStatsResponse::QueueStatsResponse (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	QueueStatsResponse&
+	QueueStatsResponse::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	QueueStatsResponse::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	QueueStatsResponse::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		if ( getQueue() >= QueueStatsRequest::QUEUE_COUNT ) {
+			return STATUS_E_QUEUE_ID;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	QueueStatsResponse::getQueue () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_QUEUE );
+	}
+
+
+	UInt8
+	QueueStatsResponse::getSize () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_SIZE );
+	}
+
+
+	UInt8
+	QueueStatsResponse::getMaxSize () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_MAX_SIZE );
+	}
+
+
+	UInt16
+	QueueStatsResponse::getDropCount () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_DROP_COUNT );
+	}
+
+
+	UInt16
+	QueueStatsResponse::getMaxResidencyMillis () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_MAX_RESIDENCY_MILLIS );
+	}
+
+} } }
@@ -0,0 +1,72 @@
+
+#include "../RepeatRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	RepeatRequest::RepeatRequest (
+		UInt16 task_id,
+		UInt32 period_millis
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt32( OFFSET_PERIOD_MILLIS, period_millis );
+	}
+
+
+	RepeatRequest::RepeatRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	RepeatRequest&
+	RepeatRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	RepeatRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	RepeatRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( ! m_msg.isImmediate() ) {
+			return STATUS_E_NOT_IMMEDIATE;
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt32
+	RepeatRequest::getPeriodMillis () const throw ()
+	{
+		return m_msg.getUInt32( OFFSET_PERIOD_MILLIS );
+	}
+
+} } }
@@ -0,0 +1,58 @@
+#include "../SensorLogNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	SensorLogNotice::SensorLogNotice (
+		UInt16 task_id,
+		UInt8 status,
+		bool is_running,
+		UInt8 record_count,
+		UInt16 overflow_count,
+		UInt32 next_index,
+		UInt16 missed_count
+	) throw ()
+		: m_msg( )
+	{
+		Layout::initImmediate( m_msg, task_id );
+		Layout::set<StatusField>( m_msg, status );
+		Layout::set<IsRunningField>( m_msg, is_running );
+		Layout::set<RecordCountField>( m_msg, record_count );
+		Layout::set<OverflowCountField>( m_msg, overflow_count );
+		Layout::set<NextIndexField>( m_msg, next_index );
+		Layout::set<MissedCountField>( m_msg, missed_count );
+	}
+
+
+	SensorLogNotice::SensorLogNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	SensorLogNotice&
+	SensorLogNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	SensorLogNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	SensorLogNotice::validate () const throw ()
+	{
+		return Layout::validate( m_msg );
+	}
+
+} } }
@@ -0,0 +1,133 @@
+#include "../../SensorLog.hpp"
+
+#include "../SensorLogRequest.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	SensorLogRequest::SensorLogRequest (
+		UInt16 task_id,
+		UInt32 current_millis,
+		UInt8 command,
+		UInt8 channels,
+		UInt16 period_millis,
+		UInt16 fetch_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setMillis( current_millis );
+		m_msg.setUInt8( OFFSET_COMMAND, command );
+		m_msg.setUInt8( OFFSET_CHANNELS, channels );
+		m_msg.setUInt16( OFFSET_PERIOD_MILLIS, period_millis );
+		m_msg.setUInt16( OFFSET_FETCH_SIZE, fetch_size );
+	}
+
+
+	SensorLogRequest::SensorLogRequest (
+		UInt16 task_id,
+		UInt8 command,
+		UInt8 channels,
+		UInt16 period_millis,
+		UInt16 fetch_size
+	) throw ()
+		: m_msg( )
+	{
+		m_msg.clear();
+		m_msg.setMessageType( MSGID );
+		m_msg.setDataSize( DATA_SIZE );
+		m_msg.setTaskId( task_id );
+		m_msg.setImmediate();
+		m_msg.setUInt8( OFFSET_COMMAND, command );
+		m_msg.setUInt8( OFFSET_CHANNELS, channels );
+		m_msg.setUInt16( OFFSET_PERIOD_MILLIS, period_millis );
+		m_msg.setUInt16( OFFSET_FETCH_SIZE, fetch_size );
+	}
+
+
+	SensorLogRequest::SensorLogRequest (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	SensorLogRequest&
+	SensorLogRequest::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	SensorLogRequest::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	SensorLogRequest::validate () const throw ()
+	{
+		if ( m_msg.getMessageType() != MSGID ) {
+			return STATUS_E_MESSAGE_TYPE;
+		}
+
+		if ( m_msg.getDataSize() != DATA_SIZE ) {
+			return STATUS_E_DATA_SIZE;
+		}
+
+		if ( getCommand() >= COMMAND_COUNT ) {
+			return STATUS_E_LOG_COMMAND;
+		}
+
+		if ( COMMAND_START == getCommand() )
+		{
+			if ( 0 == getChannels() || 0 != ( getChannels() & ~SensorLog::CHANNEL_ALL ) ) {
+				return STATUS_E_LOG_CHANNELS;
+			}
+
+			if ( 0 == getPeriodMillis() ) {
+				return STATUS_E_LOG_PERIOD;
+			}
+		}
+
+		return STATUS_OK;
+	}
+
+
+	UInt8
+	SensorLogRequest::getCommand () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_COMMAND );
+	}
+
+
+	UInt8
+	SensorLogRequest::getChannels () const throw ()
+	{
+		return m_msg.getUInt8( OFFSET_CHANNELS );
+	}
+
+
+	UInt16
+	SensorLogRequest::getPeriodMillis () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_PERIOD_MILLIS );
+	}
+
+
+	UInt16
+	SensorLogRequest::getFetchSize () const throw ()
+	{
+		return m_msg.getUInt16( OFFSET_FETCH_SIZE );
+	}
+
+} } }
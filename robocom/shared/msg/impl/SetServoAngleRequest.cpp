@@ -13,13 +13,9 @@ namespace msg
 	) throw ()
 		: m_msg( )
 	{
-		m_msg.clear();
-		m_msg.setMessageType( MSGID );
-		m_msg.setDataSize( DATA_SIZE );
-		m_msg.setTaskId( task_id );
-		m_msg.setMillis( current_millis );
-		m_msg.setUInt8( OFFSET_SERVO_ID, servo_id );
-		m_msg.setUInt8( OFFSET_ANGLE, angle );
+		Layout::initDelayed( m_msg, task_id, current_millis );
+		Layout::set<ServoIdField>( m_msg, servo_id );
+		Layout::set<AngleField>( m_msg, angle );
 	}
 
 
@@ -30,13 +26,9 @@ namespace msg
 	) throw ()
 		: m_msg( )
 	{
-		m_msg.clear();
-		m_msg.setMessageType( MSGID );
-		m_msg.setDataSize( DATA_SIZE );
-		m_msg.setTaskId( task_id );
-		m_msg.setImmediate();
-		m_msg.setUInt8( OFFSET_SERVO_ID, servo_id );
-		m_msg.setUInt8( OFFSET_ANGLE, angle );
+		Layout::initImmediate( m_msg, task_id );
+		Layout::set<ServoIdField>( m_msg, servo_id );
+		Layout::set<AngleField>( m_msg, angle );
 	}
 
 
@@ -66,29 +58,7 @@ namespace msg
 	MessageStatus
 	SetServoAngleRequest::validate () const throw ()
 	{
-		if ( m_msg.getMessageType() != MSGID ) {
-			return STATUS_E_MESSAGE_TYPE;
-		}
-
-		if ( m_msg.getDataSize() != DATA_SIZE ) {
-			return STATUS_E_DATA_SIZE;
-		}
-
-		return STATUS_OK;
-	}
-
-
-	UInt8
-	SetServoAngleRequest::getServoId () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_SERVO_ID );
-	}
-
-
-	UInt8
-	SetServoAngleRequest::getAngle () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_ANGLE );
+		return Layout::validate( m_msg );
 	}
 
 } } }
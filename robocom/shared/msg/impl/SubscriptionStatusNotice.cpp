@@ -0,0 +1,49 @@
+
+#include "../SubscriptionStatusNotice.hpp"
+
+namespace robocom {
+namespace shared {
+namespace msg
+{
+
+	SubscriptionStatusNotice::SubscriptionStatusNotice (
+		UInt16 task_id,
+		UInt8 status
+	) throw ()
+		: m_msg( )
+	{
+		Layout::initImmediate( m_msg, task_id );
+		Layout::set<StatusField>( m_msg, status );
+	}
+
+
+	SubscriptionStatusNotice::SubscriptionStatusNotice (
+		const Message& msg
+	) throw ()
+		: m_msg( msg )
+	{
+	}
+
+
+	SubscriptionStatusNotice&
+	SubscriptionStatusNotice::operator= (const Message& msg) throw ()
+	{
+		m_msg = msg;
+		return *this;
+	}
+
+
+	const Message&
+	SubscriptionStatusNotice::asMessage () const throw ()
+	{
+		return m_msg;
+	}
+
+
+	MessageStatus
+	SubscriptionStatusNotice::validate () const throw ()
+	{
+		return Layout::validate( m_msg );
+	}
+
+} } }
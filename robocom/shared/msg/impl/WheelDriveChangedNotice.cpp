@@ -15,15 +15,11 @@ namespace msg
 	) throw ()
 		: m_msg( )
 	{
-		m_msg.clear();
-		m_msg.setMessageType( MSGID );
-		m_msg.setDataSize( DATA_SIZE );
-		m_msg.setTaskId( task_id );
-		m_msg.setMillis( current_millis );
-		m_msg.setUInt8( OFFSET_MOTOR_1_DIRECTION, motor_1_direction );
-		m_msg.setUInt8( OFFSET_MOTOR_1_SIGNAL, motor_1_signal );
-		m_msg.setUInt8( OFFSET_MOTOR_2_DIRECTION, motor_2_direction );
-		m_msg.setUInt8( OFFSET_MOTOR_2_SIGNAL, motor_2_signal );
+		Layout::initDelayed( m_msg, task_id, current_millis );
+		Layout::set<Motor1DirectionField>( m_msg, motor_1_direction );
+		Layout::set<Motor1SignalField>( m_msg, motor_1_signal );
+		Layout::set<Motor2DirectionField>( m_msg, motor_2_direction );
+		Layout::set<Motor2SignalField>( m_msg, motor_2_signal );
 	}
 
 
@@ -53,16 +49,9 @@ namespace msg
 	MessageStatus
 	WheelDriveChangedNotice::validate () const throw ()
 	{
-		if ( m_msg.getMessageType() != MSGID ) {
-			return STATUS_E_MESSAGE_TYPE;
-		}
-
-		if ( m_msg.getDataSize() != DATA_SIZE ) {
-			return STATUS_E_DATA_SIZE;
-		}
-
-		if ( m_msg.isImmediate() ) {
-			return STATUS_E_IMMEDIATE;
+		const MessageStatus status = Layout::validate( m_msg );
+		if ( STATUS_OK != status ) {
+			return status;
 		}
 
 		if ( getMotor1Direction() != 0 && getMotor1Direction() != 1 ) {
@@ -76,33 +65,5 @@ namespace msg
 		return STATUS_OK;
 	}
 
-
-	UInt8
-	WheelDriveChangedNotice::getMotor1Direction () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_MOTOR_1_DIRECTION );
-	}
-
-
-	UInt8
-	WheelDriveChangedNotice::getMotor1Signal () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_MOTOR_1_SIGNAL );
-	}
-
-
-	UInt8
-	WheelDriveChangedNotice::getMotor2Direction () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_MOTOR_2_DIRECTION );
-	}
-
-
-	UInt8
-	WheelDriveChangedNotice::getMotor2Signal () const throw ()
-	{
-		return m_msg.getUInt8( OFFSET_MOTOR_2_SIGNAL );
-	}
-
 } } }
 
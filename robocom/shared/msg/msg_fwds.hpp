@@ -15,14 +15,34 @@ namespace msg
 	typedef SimpleMessage<CommonMessageTypes::MSGID_ECHO> EchoResponse;
 	typedef SimpleMessage<CommonMessageTypes::MSGID_FLUSH> FlushRequest;
 	typedef SimpleMessage<CommonMessageTypes::MSGID_RESET> ResetRequest;
-
+	typedef SimpleMessage<RobocomMessageTypes::MSGID_LOGO_CANCEL> LogoCancelRequest;
+
+	class BlobFragment;
+	class BlobStatusNotice;
+	class CapsResponse;
+	class CodecRequest;
+	typedef CodecRequest CodecResponse;
+	class CreditNotice;
 	class EncoderReadingNotice;
 	class EncoderReadingRequest;
+	class EncoderTicksNotice;
+	class GyroQuaternionNotice;
 	class GyroReadingNotice;
 	class GyroReadingRequest;
+	class HelloRequest;
 	class FlushResponse;
+	class LoopHistogramResponse;
+	class LoopStatsRequest;
+	class LoopStatsResponse;
+	class QueueHistogramResponse;
+	class QueueStatsRequest;
+	class QueueStatsResponse;
+	class RepeatRequest;
+	class SensorLogNotice;
+	class SensorLogRequest;
 	class SetWheelDriveRequest;
 	class SetServoAngleRequest;
+	class SubscriptionStatusNotice;
 	class WheelDriveChangedNotice;
 
 	// Commands for LOGO turtle emulation
@@ -30,6 +50,8 @@ namespace msg
 	class LogoMoveRequest;
 	class LogoPenRequest;
 	class LogoCompleteNotice;
+	class LogoProgramRequest;
+	class LogoRunRequest;
 
 	using namespace common;
 
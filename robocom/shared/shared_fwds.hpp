@@ -9,12 +9,22 @@ namespace robocom {
 namespace shared
 {
 
+	class Angle;
+	class BlobAssembler;
+	class BufferStream;
+	class CompactMessagePool;
+	class CompactMessageQueue;
+	class FrameCodec;
+	class LogoInterpreter;
+	class LoopProfile;
 	class Message;
-	class MessageIO;
 	class MessageListNode;
 	class MessagePool;
 	class MessageQueue;
+	class QueueProfile;
+	class SensorLog;
 	class Server;
+	class Subscriptions;
 
 #if defined(AVR)
 	typedef ::Stream StreamIO;
@@ -22,6 +32,9 @@ namespace shared
 	class StreamIO;
 #endif
 
+	template <class STREAM> class BasicMessageIO;
+	typedef BasicMessageIO<StreamIO> MessageIO;
+
 	using namespace common;
 
 } }
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstdlib>
+#include <unittest++/UnitTest++.h>
+
+#include "../Angle.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	// Converts radians to binary angle units without rounding
+	double __toUnits (double radians)
+	{
+		return radians * Angle::HALF_TURN / M_PI;
+	}
+
+	// The float reference: MPU6050::dmpGetQuaternion() followed by the
+	// yaw part of MPU6050::dmpGetYawPitchRoll()
+	double __referenceYaw (SInt16 qw, SInt16 qx, SInt16 qy, SInt16 qz)
+	{
+		const float w = (float) qw / 16384.0f;
+		const float x = (float) qx / 16384.0f;
+		const float y = (float) qy / 16384.0f;
+		const float z = (float) qz / 16384.0f;
+		return atan2( 2*x*y - 2*w*z, 2*w*w + 2*x*x - 1 );
+	}
+
+	SUITE(AngleTester)
+	{
+		TEST(Atan2Axes)
+		{
+			CHECK_EQUAL( 0, Angle::atan2( 0, 0 ) );
+			CHECK_EQUAL( 0, Angle::atan2( 0, 5 ) );
+			CHECK_EQUAL( Angle::QUARTER_TURN, Angle::atan2( 5, 0 ) );
+			CHECK_EQUAL( Angle::HALF_TURN, Angle::atan2( 0, -5 ) );
+			CHECK_EQUAL( -Angle::QUARTER_TURN, Angle::atan2( -5, 0 ) );
+			CHECK_EQUAL( Angle::QUARTER_TURN / 2, Angle::atan2( 7, 7 ) );
+			CHECK_EQUAL( -3 * Angle::QUARTER_TURN / 2, Angle::atan2( -7, -7 ) );
+		}
+
+		TEST(Atan2FullRange)
+		{
+			// Sweep the whole circle at radii from tiny to the
+			// largest ones yawFromQuaternion() produces
+			const double radii[] = { 50.0, 3000.0, 1.0e5, 1.0e8, 2.0e9 };
+			double max_error = 0;
+
+			for ( unsigned r = 0; r < sizeof(radii) / sizeof(radii[0]); r++ )
+			{
+				for ( int i = -18000; i < 18000; i += 7 )
+				{
+					const double a = i * M_PI / 18000;
+					const SInt32 y = (SInt32) std::floor( radii[r] * std::sin( a ) + 0.5 );
+					const SInt32 x = (SInt32) std::floor( radii[r] * std::cos( a ) + 0.5 );
+
+					double error = Angle::atan2( y, x ) - __toUnits( std::atan2( y, x ) );
+					if ( error > Angle::HALF_TURN ) {
+						error -= Angle::FULL_TURN;
+					}
+					else if ( error < -Angle::HALF_TURN ) {
+						error += Angle::FULL_TURN;
+					}
+
+					max_error = std::max( max_error, std::fabs( error ) );
+				}
+			}
+
+			// Two units is about 0.011 degrees
+			CHECK( max_error <= 2.0 );
+		}
+
+		TEST(YawFromQuaternion)
+		{
+			// Pure yaw rotations over the full angle range, plus small
+			// random tilts such as the robot sees on an uneven floor
+			::srand( 1 );
+			double max_error = 0;
+
+			for ( int i = -1800; i <= 1800; i++ )
+			{
+				const double yaw = i * M_PI / 1800;
+				const double tilt = ( ::rand() % 2001 - 1000 ) * 0.0002;
+
+				// Rotation about the (tilted) Z axis
+				const double n = std::sqrt( 1 + tilt * tilt );
+				const double s = std::sin( yaw / 2 );
+				const SInt16 w = (SInt16) std::floor( std::cos( yaw / 2 ) * 16384 + 0.5 );
+				const SInt16 x = (SInt16) std::floor( tilt / n * s * 16384 + 0.5 );
+				const SInt16 y = (SInt16) 0;
+				const SInt16 z = (SInt16) std::floor( 1 / n * s * 16384 + 0.5 );
+
+				double error =
+					Angle::yawFromQuaternion( w, x, y, z ) -
+					__toUnits( __referenceYaw( w, x, y, z ) );
+
+				if ( error > Angle::HALF_TURN ) {
+					error -= Angle::FULL_TURN;
+				}
+				else if ( error < -Angle::HALF_TURN ) {
+					error += Angle::FULL_TURN;
+				}
+
+				max_error = std::max( max_error, std::fabs( error ) );
+			}
+
+			// The float reference itself is only accurate to a few units
+			// since it works with single precision
+			CHECK( Angle::toDegrees( max_error ) < 0.05f );
+		}
+
+		TEST(Conversions)
+		{
+			CHECK_EQUAL( Angle::QUARTER_TURN, Angle::fromDegrees( 90 ) );
+			CHECK_EQUAL( -Angle::HALF_TURN, Angle::fromDegrees( -180 ) );
+			CHECK_EQUAL( Angle::FULL_TURN, Angle::fromDegrees( 360 ) );
+			CHECK_CLOSE( 45.0f, Angle::toDegrees( Angle::fromDegrees( 45 ) ), 0.01f );
+			CHECK_CLOSE( -90.0f, Angle::toDegrees( -Angle::QUARTER_TURN ), 0.001f );
+			CHECK_CLOSE( M_PI, Angle::toRadians( Angle::HALF_TURN ), 0.0001f );
+		}
+	}
+
+} }
@@ -0,0 +1,71 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../BlobAssembler.hpp"
+#include "../msg/BlobFragment.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	SUITE(BlobAssemblerTester)
+	{
+		TEST(EmptyBlob)
+		{
+			UInt8 buffer[4];
+			BlobAssembler assembler( buffer, sizeof( buffer ) );
+
+			CHECK( assembler.add( BlobFragment::makeFragment( 1, buffer, 0, 0 ) ) );
+			CHECK( assembler.isComplete() );
+			CHECK_EQUAL( STATUS_OK, assembler.getStatus() );
+			CHECK_EQUAL( 0, (int) assembler.getSize() );
+		}
+
+		TEST(FinalMarker)
+		{
+			const UInt8 data[] = { 1, 2, 3 };
+			const BlobFragment fragment( 2, 0x1234, data, sizeof( data ), true );
+			CHECK_EQUAL( STATUS_OK, fragment.validate() );
+			CHECK_EQUAL( 0x1234, fragment.getOffset() );
+			CHECK( fragment.isFinal() );
+			CHECK_EQUAL( 3, (int) fragment.getSize() );
+
+			UInt8 copy[3];
+			fragment.getData( copy );
+			CHECK_ARRAY_EQUAL( data, copy, sizeof( data ) );
+		}
+
+		TEST(NewBlobDropsPartialOne)
+		{
+			UInt8 blob[30] = { 0 };
+			UInt8 buffer[64];
+			BlobAssembler assembler( buffer, sizeof( buffer ) );
+
+			CHECK( ! assembler.add( BlobFragment::makeFragment( 1, blob, sizeof( blob ), 0 ) ) );
+			CHECK( ! assembler.add( BlobFragment::makeFragment( 2, blob, sizeof( blob ), 0 ) ) );
+			CHECK_EQUAL( 2, assembler.getTaskId() );
+
+			// A fragment of the abandoned blob does not continue the new one
+			CHECK( assembler.add(
+				BlobFragment::makeFragment( 1, blob, sizeof( blob ), BlobFragment::MAX_FRAGMENT_SIZE )
+			) );
+			CHECK_EQUAL( STATUS_E_BLOB_OFFSET, assembler.getStatus() );
+			CHECK( ! assembler.isComplete() );
+		}
+
+		TEST(DelayedFragmentIsInvalid)
+		{
+			UInt8 buffer[4];
+			BlobAssembler assembler( buffer, sizeof( buffer ) );
+
+			Message msg = BlobFragment::makeFragment( 3, buffer, 0, 0 ).asMessage();
+			msg.setMillis( 10 );
+			CHECK( assembler.add( BlobFragment( msg ) ) );
+			CHECK_EQUAL( STATUS_E_NOT_IMMEDIATE, assembler.getStatus() );
+		}
+	}
+
+} }
@@ -0,0 +1,62 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../BufferStream.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	SUITE(BufferStreamTester)
+	{
+		TEST(ReadsWhatWasWritten)
+		{
+			UInt8 buffer[8];
+			BufferStream stream( buffer, sizeof( buffer ) );
+
+			CHECK_EQUAL( 0, stream.available() );
+			CHECK_EQUAL( -1, stream.peek() );
+			CHECK_EQUAL( -1, stream.read() );
+
+			const UInt8 data[] = { 1, 2, 3 };
+			CHECK_EQUAL( 1u, stream.write( static_cast<UInt8>( 0xFF ) ) );
+			CHECK_EQUAL( 3u, stream.write( data, sizeof( data ) ) );
+			CHECK_EQUAL( 4, stream.available() );
+
+			CHECK_EQUAL( 0xFF, stream.peek() );
+			CHECK_EQUAL( 0xFF, stream.read() );
+
+			char out[8];
+			CHECK_EQUAL( 3u, stream.readBytes( out, sizeof( out ) ) );
+			CHECK_EQUAL( 1, out[0] );
+			CHECK_EQUAL( 3, out[2] );
+			CHECK_EQUAL( 0, stream.available() );
+		}
+
+		TEST(WritesAreCutAtCapacity)
+		{
+			UInt8 buffer[4];
+			BufferStream stream( buffer, sizeof( buffer ) );
+
+			const UInt8 data[] = { 1, 2, 3, 4, 5 };
+			CHECK_EQUAL( 4u, stream.write( data, sizeof( data ) ) );
+			CHECK_EQUAL( 0u, stream.write( static_cast<UInt8>( 6 ) ) );
+
+			// Partly read, the space is not reused yet
+			CHECK_EQUAL( 1, stream.read() );
+			CHECK_EQUAL( 0u, stream.write( static_cast<UInt8>( 6 ) ) );
+
+			// Emptied, the buffer starts over
+			char out[4];
+			CHECK_EQUAL( 3u, stream.readBytes( out, sizeof( out ) ) );
+			CHECK_EQUAL( 4u, stream.write( data, 4 ) );
+			CHECK_EQUAL( 4, stream.available() );
+
+			stream.clear();
+			CHECK_EQUAL( 0, stream.available() );
+		}
+	}
+
+} }
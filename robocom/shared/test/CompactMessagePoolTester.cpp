@@ -0,0 +1,161 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../CompactMessagePool.hpp"
+#include "../MessagePool.hpp"
+#include "../msg/SetWheelDriveRequest.hpp"
+#include "../msg/SimpleMessage.hxx"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	SUITE(CompactMessagePoolTester)
+	{
+		TEST(AllocFree)
+		{
+			CompactMessagePool p;
+			CHECK_EQUAL( (int) CompactMessagePool::SLOT_COUNT, (int) p.getFree() );
+			CHECK_EQUAL( (int) CompactMessagePool::ARENA_SIZE, (int) p.getFreeBytes() );
+
+			const SetWheelDriveRequest r( 7, 1234u, 0, 1, 0, 0 );
+			const UInt8 index = p.alloc( r.asMessage() );
+			CHECK( CompactMessagePool::NIL != index );
+			CHECK_EQUAL( CompactMessagePool::SLOT_COUNT - 1, (int) p.getFree() );
+			CHECK_EQUAL( CompactMessagePool::SLOT_COUNT - 1, (int) p.getMinFree() );
+			CHECK( CompactMessagePool::ARENA_SIZE > p.getFreeBytes() );
+
+			CHECK( ! p.isImmediate( index ) );
+			CHECK_EQUAL( 1234u, p.getMillis( index ) );
+			CHECK_EQUAL( 7, (int) p.getTaskId( index ) );
+
+			Message msg;
+			p.load( index, msg );
+			CHECK_EQUAL( (int) r.asMessage().getMessageType(), (int) msg.getMessageType() );
+			CHECK_EQUAL( r.asMessage().getMillis(), msg.getMillis() );
+			CHECK_EQUAL( (int) r.asMessage().getDataSize(), (int) msg.getDataSize() );
+			for ( int i = 0; i < msg.getDataSize(); i++ ) {
+				CHECK_EQUAL( (int) r.asMessage().getUInt8( i ), (int) msg.getUInt8( i ) );
+			}
+
+			p.free( index );
+			CHECK_EQUAL( (int) CompactMessagePool::SLOT_COUNT, (int) p.getFree() );
+			CHECK_EQUAL( (int) CompactMessagePool::ARENA_SIZE, (int) p.getFreeBytes() );
+			CHECK_EQUAL( CompactMessagePool::SLOT_COUNT - 1, (int) p.getMinFree() );
+		}
+
+		TEST(TwiceTheSmallMessages)
+		{
+			CompactMessagePool p;
+
+			int count = 0;
+			while ( CompactMessagePool::NIL != p.alloc( ResetRequest( count ).asMessage() ) ) {
+				count++;
+			}
+
+			CHECK_EQUAL( 2 * MessagePool::SLOT_COUNT, count );
+			CHECK_EQUAL( 0, (int) p.getFree() );
+		}
+
+		TEST(ArenaLimitsLargeMessages)
+		{
+			CompactMessagePool p;
+
+			Message m;
+			m.clear();
+			m.setImmediate();
+			m.setDataSize( Message::MAX_DATA_SIZE );
+
+			int count = 0;
+			while ( CompactMessagePool::NIL != p.alloc( m ) ) {
+				count++;
+			}
+
+			const int entry_size = 1 + Message::MAX_SERIALIZED_SIZE;
+			CHECK_EQUAL( CompactMessagePool::ARENA_SIZE / entry_size, count );
+			CHECK( p.getFree() > 0 );
+			CHECK( p.getFreeBytes() < entry_size );
+
+			// A smaller message still fits in the rest of the arena
+			CHECK( CompactMessagePool::NIL != p.alloc( ResetRequest( 1 ).asMessage() ) );
+		}
+
+		TEST(HolesAreCompacted)
+		{
+			CompactMessagePool p;
+
+			Message m;
+			m.clear();
+			m.setImmediate();
+			m.setDataSize( Message::MAX_DATA_SIZE );
+
+			UInt8 indices[CompactMessagePool::SLOT_COUNT];
+			int count = 0;
+			for ( UInt16 task_id = 0; ; task_id++ )
+			{
+				m.setTaskId( task_id );
+				indices[count] = p.alloc( m );
+				if ( CompactMessagePool::NIL == indices[count] ) {
+					break;
+				}
+				count++;
+			}
+
+			// Free every other message, none of them at the end
+			for ( int i = 0; i < count - 1; i += 2 ) {
+				p.free( indices[i] );
+			}
+
+			// The new messages fill the holes, and the remaining
+			// messages keep their contents under their indices
+			for ( int i = 0; i < count - 1; i += 2 )
+			{
+				m.setTaskId( 1000 + i );
+				indices[i] = p.alloc( m );
+				CHECK( CompactMessagePool::NIL != indices[i] );
+			}
+			CHECK( CompactMessagePool::NIL == p.alloc( m ) );
+
+			for ( int i = 0; i < count; i++ )
+			{
+				const int expected = ( i % 2 || i == count - 1 ) ? i : 1000 + i;
+				CHECK_EQUAL( expected, (int) p.getTaskId( indices[i] ) );
+
+				Message msg;
+				p.load( indices[i], msg );
+				CHECK_EQUAL( expected, (int) msg.getTaskId() );
+				CHECK_EQUAL( (int) Message::MAX_DATA_SIZE, (int) msg.getDataSize() );
+			}
+		}
+
+		TEST(ComparePriority)
+		{
+			CompactMessagePool p;
+
+			const Message immediate = ResetRequest( 1 ).asMessage();
+			const Message early = SetWheelDriveRequest( 2, 10u, 0, 1, 0, 0 ).asMessage();
+			const Message late = SetWheelDriveRequest( 3, 20u, 0, 1, 0, 0 ).asMessage();
+
+			const UInt8 i_immediate = p.alloc( immediate );
+			const UInt8 i_early = p.alloc( early );
+			const UInt8 i_late = p.alloc( late );
+
+			const Message* msgs[] = { & immediate, & early, & late };
+			const UInt8 indices[] = { i_immediate, i_early, i_late };
+			for ( int i = 0; i < 3; i++ )
+			{
+				for ( int j = 0; j < 3; j++ )
+				{
+					CHECK_EQUAL(
+						msgs[i]->comparePriority( *msgs[j] ),
+						p.comparePriority( indices[i], *msgs[j] )
+					);
+				}
+			}
+		}
+	}
+
+} }
@@ -0,0 +1,281 @@
+#include <unittest++/UnitTest++.h>
+
+#include <vector>
+
+#include "../CompactMessagePool.hpp"
+#include "../CompactMessageQueue.hpp"
+#include "../msg/SetWheelDriveRequest.hpp"
+#include "../msg/SimpleMessage.hxx"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		bool
+		isEqual (const Message& a, const Message& b)
+		{
+			if ( a.getMessageType() != b.getMessageType() ||
+				 a.isImmediate() != b.isImmediate() ||
+				 a.getTaskId() != b.getTaskId() ||
+				 a.getMillis() != b.getMillis() ||
+				 a.getDataSize() != b.getDataSize() )
+			{
+				return false;
+			}
+
+			for ( int i = 0; i < a.getDataSize(); i++ )
+			{
+				if ( a.getUInt8( i ) != b.getUInt8( i ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+
+		/**
+		 * Generates pseudo random numbers, the same ones on every run
+		 */
+		class Random
+		{
+		public:
+
+			Random ()
+				: m_seed( 2013 )
+			{ }
+
+			UInt32 next (UInt32 range)
+			{
+				m_seed = m_seed * 1103515245u + 12345u;
+				return ( m_seed >> 8 ) % range;
+			}
+
+		private:
+
+			UInt32 m_seed;
+		};
+
+
+		Message
+		makeRandomMessage (Random& random, UInt16 task_id)
+		{
+			Message msg;
+			msg.clear();
+			msg.setMessageType( random.next( Message::MAX_MESSAGE_TYPE + 1 ) );
+			msg.setTaskId( task_id );
+
+			if ( random.next( 2 ) ) {
+				msg.setImmediate();
+			}
+			else {
+				msg.setMillis( random.next( 50 ) );
+			}
+
+			msg.setDataSize( random.next( msg.getMaxDataSize() + 1 ) );
+			for ( int i = 0; i < msg.getDataSize(); i++ ) {
+				msg.setUInt8( i, random.next( 256 ) );
+			}
+			return msg;
+		}
+
+
+		/**
+		 * Inserts the message into a reference queue, behind the
+		 * messages of the same priority
+		 */
+		void
+		pushReference (std::vector<Message>& reference, const Message& msg)
+		{
+			std::vector<Message>::iterator it = reference.begin();
+			while ( it != reference.end() && it->comparePriority( msg ) <= 0 ) {
+				++it;
+			}
+			reference.insert( it, msg );
+		}
+
+	}
+
+	SUITE(CompactMessageQueueTester)
+	{
+		TEST(PopOrder)
+		{
+			CompactMessagePool p;
+			CompactMessageQueue q(p);
+
+			SetWheelDriveRequest r1( 88, 5u, 0, 1, 0, 0 );
+			SetWheelDriveRequest r2( 87, 0, 2, 0, 0 );
+			SetWheelDriveRequest r3( 86, 0u, 0, 3, 0, 0 );
+			SetWheelDriveRequest r4( 85, 0, 4, 0, 0 );
+
+			q.push( r1.asMessage() );
+			q.push( r2.asMessage() );
+			q.push( r3.asMessage() );
+			q.push( r4.asMessage() );
+
+			Message msg;
+
+			CHECK( q.pop( msg, 0u ) );
+			CHECK( isEqual( r2.asMessage(), msg ) );
+			CHECK( q.pop( msg, 0u ) );
+			CHECK( isEqual( r4.asMessage(), msg ) );
+			CHECK( q.pop( msg, 0u ) );
+			CHECK( isEqual( r3.asMessage(), msg ) );
+			CHECK( ! q.pop( msg, 4u ) );
+			CHECK( q.pop( msg, 5u ) );
+			CHECK( isEqual( r1.asMessage(), msg ) );
+
+			CHECK_EQUAL( (int) CompactMessagePool::SLOT_COUNT, (int) p.getFree() );
+		}
+
+		TEST(SharedPool)
+		{
+			CompactMessagePool p;
+			CompactMessageQueue q1(p);
+			CompactMessageQueue q2(p);
+
+			int count = 0;
+			for ( ; ; count++ )
+			{
+				CompactMessageQueue& q = count % 2 ? q1 : q2;
+				if ( ! q.push( NoopRequest( count ).asMessage() ) ) {
+					break;
+				}
+			}
+
+			CHECK_EQUAL( (int) CompactMessagePool::SLOT_COUNT, count );
+			CHECK_EQUAL( count / 2, (int) q1.getMaxSize() );
+
+			q1.clear();
+			CHECK_EQUAL( 0, (int) q1.getSize() );
+			CHECK_EQUAL( count / 2, (int) p.getFree() );
+
+			Message msg;
+			for ( int i = 0; i < count; i += 2 )
+			{
+				CHECK( q2.pop( msg, 0u ) );
+				CHECK_EQUAL( i, (int) msg.getTaskId() );
+			}
+			CHECK( ! q2.pop( msg, 0u ) );
+		}
+
+		TEST(Remove)
+		{
+			CompactMessagePool p;
+			CompactMessageQueue q(p);
+
+			SetWheelDriveRequest r1( 11, 5u, 0, 1, 0, 0 );
+			SetWheelDriveRequest r2( 12, 0, 2, 0, 0 );
+			SetWheelDriveRequest r3( 11, 0, 3, 0, 0 );
+			SetWheelDriveRequest r4( 13, 7u, 0, 4, 0, 0 );
+
+			q.push( r1.asMessage() );
+			q.push( r2.asMessage() );
+			q.push( r3.asMessage() );
+			q.push( r4.asMessage() );
+
+			CHECK_EQUAL( 2, (int) q.remove( 11 ) );
+			CHECK_EQUAL( 2, (int) q.getSize() );
+
+			Message msg;
+			CHECK( q.pop( msg, 10u ) );
+			CHECK( isEqual( r2.asMessage(), msg ) );
+			CHECK( q.pop( msg, 10u ) );
+			CHECK( isEqual( r4.asMessage(), msg ) );
+			CHECK( ! q.pop( msg, 10u ) );
+			CHECK_EQUAL( (int) CompactMessagePool::ARENA_SIZE, (int) p.getFreeBytes() );
+		}
+
+		TEST(Stress)
+		{
+			// Random pushes, pops and removes on two queues sharing
+			// the pool, checked against a reference implementation
+			CompactMessagePool p;
+			CompactMessageQueue queues[2] = { CompactMessageQueue( p ), CompactMessageQueue( p ) };
+			std::vector<Message> references[2];
+			Random random;
+
+			UInt32 millis = 0;
+			UInt16 task_id = 0;
+			int push_count = 0;
+			int drop_count = 0;
+
+			for ( int step = 0; step < 100000; step++ )
+			{
+				const int q = random.next( 2 );
+				const UInt32 op = random.next( 10 );
+
+				if ( op < 5 )
+				{
+					const Message msg = makeRandomMessage( random, task_id++ % 32 );
+					if ( queues[q].push( msg ) )
+					{
+						pushReference( references[q], msg );
+						push_count++;
+					}
+					else
+					{
+						// Only a full pool may refuse a message
+						CHECK( 0 == p.getFree() ||
+							   p.getFreeBytes() < msg.getSerializedSize() + 1 );
+						drop_count++;
+					}
+				}
+				else if ( op < 9 )
+				{
+					Message msg;
+					const bool is_due = ! references[q].empty() &&
+						( references[q].front().isImmediate() ||
+						  references[q].front().getMillis() <= millis );
+
+					CHECK_EQUAL( is_due, queues[q].pop( msg, millis ) );
+					if ( is_due )
+					{
+						CHECK( isEqual( references[q].front(), msg ) );
+						references[q].erase( references[q].begin() );
+					}
+				}
+				else
+				{
+					const UInt16 removed_id = random.next( 32 );
+					UInt8 removed = 0;
+					for ( size_t i = 0; i < references[q].size(); )
+					{
+						if ( references[q][i].getTaskId() == removed_id )
+						{
+							references[q].erase( references[q].begin() + i );
+							removed++;
+						}
+						else {
+							i++;
+						}
+					}
+					CHECK_EQUAL( (int) removed, (int) queues[q].remove( removed_id ) );
+				}
+
+				CHECK_EQUAL( (int) references[q].size(), (int) queues[q].getSize() );
+				CHECK_EQUAL(
+					CompactMessagePool::SLOT_COUNT,
+					p.getFree() + queues[0].getSize() + queues[1].getSize()
+				);
+
+				millis = ( millis + random.next( 2 ) ) % 50;
+			}
+
+			CHECK( push_count > 10000 );
+			CHECK( drop_count > 0 );
+
+			queues[0].clear();
+			queues[1].clear();
+			CHECK_EQUAL( (int) CompactMessagePool::SLOT_COUNT, (int) p.getFree() );
+			CHECK_EQUAL( (int) CompactMessagePool::ARENA_SIZE, (int) p.getFreeBytes() );
+		}
+	}
+
+} }
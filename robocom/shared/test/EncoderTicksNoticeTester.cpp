@@ -0,0 +1,172 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../BufferStream.hpp"
+#include "../Message.hpp"
+#include "../MessageIO.hxx"
+#include "../msg/EncoderTicksNotice.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		/**
+		 * Sends the message through a MessageIO and returns what
+		 * the other side reads
+		 */
+		Message
+		roundTrip (const Message& msg)
+		{
+			UInt8 buffer[64];
+			BufferStream stream( buffer, sizeof( buffer ) );
+			BasicMessageIO<BufferStream> io( stream );
+
+			io.write( msg );
+
+			Message result;
+			CHECK( io.read( result ) );
+			return result;
+		}
+
+	}
+
+	SUITE(EncoderTicksNoticeTester)
+	{
+		TEST(SingleTick)
+		{
+			const UInt32 micros[] = { 123456789u };
+			const EncoderTicksNotice notice(
+				roundTrip( EncoderTicksNotice( 7, 1, 42, micros, 1 ).asMessage() )
+			);
+
+			CHECK_EQUAL( STATUS_OK, notice.validate() );
+			CHECK( notice.asMessage().isImmediate() );
+			CHECK_EQUAL( 7, notice.getTaskId() );
+			CHECK_EQUAL( 1, (int) notice.getEncoderId() );
+			CHECK_EQUAL( 1, (int) notice.getTickCount() );
+			CHECK_EQUAL( 42u, notice.getTickIndex() );
+			CHECK_EQUAL( 123456789u, notice.getMeasurementMicros() );
+			CHECK_EQUAL( 123456789u, notice.getTickMicros( 0 ) );
+		}
+
+		TEST(FullBatch)
+		{
+			// The micros wrap around within the batch
+			const UInt32 micros[EncoderTicksNotice::MAX_TICK_COUNT] = {
+				0xFFFFFF00u, 0xFFFFFFF0u, 0x00000100u, 0x00010000u
+			};
+			const EncoderTicksNotice notice(
+				roundTrip(
+					EncoderTicksNotice(
+						3, 0, 1000, micros, EncoderTicksNotice::MAX_TICK_COUNT
+					).asMessage()
+				)
+			);
+
+			CHECK_EQUAL( STATUS_OK, notice.validate() );
+			CHECK_EQUAL( 0, (int) notice.getEncoderId() );
+			CHECK_EQUAL(
+				(int) EncoderTicksNotice::MAX_TICK_COUNT,
+				(int) notice.getTickCount()
+			);
+			CHECK_EQUAL( 1000u, notice.getTickIndex() );
+
+			CHECK_EQUAL( 0xF0, (int) notice.getInterval( 0 ) );
+			CHECK_EQUAL( 0x110, (int) notice.getInterval( 1 ) );
+			CHECK_EQUAL( 0xFF00, (int) notice.getInterval( 2 ) );
+
+			for ( UInt8 i = 0; i < EncoderTicksNotice::MAX_TICK_COUNT; i++ ) {
+				CHECK_EQUAL( micros[i], notice.getTickMicros( i ) );
+			}
+		}
+
+		TEST(LongestInterval)
+		{
+			const UInt32 micros[] = {
+				1000u, 1000u + EncoderTicksNotice::MAX_INTERVAL_MICROS
+			};
+			const EncoderTicksNotice notice( 0, 1, 2, micros, 2 );
+
+			CHECK_EQUAL( STATUS_OK, notice.validate() );
+			CHECK_EQUAL(
+				(int) EncoderTicksNotice::MAX_INTERVAL_MICROS,
+				(int) notice.getInterval( 0 )
+			);
+			CHECK_EQUAL( 1000u, notice.getTickMicros( 0 ) );
+		}
+
+		TEST(TickTimesAcrossNotices)
+		{
+			// Ten ticks, sent the way the robot batches them
+			UInt32 micros[10];
+			for ( UInt32 i = 0; i < 10; i++ ) {
+				micros[i] = 5000000u + i * i * 997u;
+			}
+
+			const EncoderTicksNotice first( 1, 0, 3, micros, 4 );
+			const EncoderTicksNotice second( 1, 0, 7, micros + 4, 4 );
+			const EncoderTicksNotice third( 1, 0, 9, micros + 8, 2 );
+
+			// The client rebuilds the index and time of every tick
+			const EncoderTicksNotice notices[] = {
+				EncoderTicksNotice( roundTrip( first.asMessage() ) ),
+				EncoderTicksNotice( roundTrip( second.asMessage() ) ),
+				EncoderTicksNotice( roundTrip( third.asMessage() ) )
+			};
+
+			UInt32 expected_index = 0;
+			for ( int n = 0; n < 3; n++ )
+			{
+				const EncoderTicksNotice& notice = notices[n];
+				CHECK_EQUAL( STATUS_OK, notice.validate() );
+
+				const UInt32 first_index =
+					notice.getTickIndex() - notice.getTickCount() + 1;
+				CHECK_EQUAL( expected_index, first_index );
+
+				for ( UInt8 i = 0; i < notice.getTickCount(); i++ ) {
+					CHECK_EQUAL( micros[first_index + i], notice.getTickMicros( i ) );
+				}
+				expected_index = notice.getTickIndex() + 1;
+			}
+			CHECK_EQUAL( 10u, expected_index );
+		}
+
+		TEST(Validate)
+		{
+			const UInt32 micros[] = { 1u, 2u, 3u };
+
+			EncoderTicksNotice notice( 1, 0, 2, micros, 3 );
+			Message msg = notice.asMessage();
+			CHECK_EQUAL( STATUS_OK, EncoderTicksNotice( msg ).validate() );
+
+			msg.setUInt8( 0, 2 );
+			CHECK_EQUAL( STATUS_E_ENCODER_ID, EncoderTicksNotice( msg ).validate() );
+
+			// A half interval
+			msg = notice.asMessage();
+			msg.setDataSize( msg.getDataSize() - 1 );
+			CHECK_EQUAL( STATUS_E_DATA_SIZE, EncoderTicksNotice( msg ).validate() );
+
+			// Not even the last tick
+			msg.setDataSize( 8 );
+			CHECK_EQUAL( STATUS_E_DATA_SIZE, EncoderTicksNotice( msg ).validate() );
+
+			// A delayed copy of a notice
+			msg = EncoderTicksNotice( 1, 0, 2, micros, 1 ).asMessage();
+			msg.setMillis( 10 );
+			CHECK_EQUAL( STATUS_E_NOT_IMMEDIATE, EncoderTicksNotice( msg ).validate() );
+
+			msg = notice.asMessage();
+			msg.setMessageType( EncoderTicksNotice::MSGID + 1 );
+			CHECK_EQUAL( STATUS_E_MESSAGE_TYPE, EncoderTicksNotice( msg ).validate() );
+		}
+	}
+
+} }
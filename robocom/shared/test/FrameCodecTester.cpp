@@ -0,0 +1,111 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../FrameCodec.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	namespace
+	{
+
+		const UInt8 CHECK_DATA[] = {
+			'1', '2', '3', '4', '5', '6', '7', '8', '9'
+		};
+
+	}
+
+	SUITE(FrameCodecTester)
+	{
+		TEST(Crc16)
+		{
+			CHECK_EQUAL(
+				0x29B1,
+				FrameCodec::updateCrc16(
+					FrameCodec::CRC16_INIT,
+					CHECK_DATA,
+					sizeof( CHECK_DATA )
+				)
+			);
+		}
+
+		TEST(Crc16OfDataWithCrcIsZero)
+		{
+			UInt8 buffer[sizeof( CHECK_DATA ) + 2];
+			for ( size_t i = 0; i < sizeof( CHECK_DATA ); i++ ) {
+				buffer[i] = CHECK_DATA[i];
+			}
+			buffer[sizeof( CHECK_DATA )] = 0x29;
+			buffer[sizeof( CHECK_DATA ) + 1] = 0xB1;
+
+			CHECK_EQUAL(
+				0,
+				FrameCodec::updateCrc16(
+					FrameCodec::CRC16_INIT,
+					buffer,
+					sizeof( buffer )
+				)
+			);
+		}
+
+		TEST(Crc8)
+		{
+			CHECK_EQUAL(
+				0xF4,
+				(int) FrameCodec::updateCrc8( 0, CHECK_DATA, sizeof( CHECK_DATA ) )
+			);
+		}
+
+		TEST(EncodeCobs)
+		{
+			const UInt8 data[] = { 0x11, 0x22, 0x00, 0x33 };
+			const UInt8 expected[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+
+			UInt8 encoded[sizeof( data ) + 1];
+			CHECK_EQUAL(
+				(int) sizeof( expected ),
+				(int) FrameCodec::encodeCobs( data, sizeof( data ), encoded )
+			);
+			CHECK_ARRAY_EQUAL( expected, encoded, sizeof( expected ) );
+
+			const UInt8 zero[] = { 0x00 };
+			const UInt8 expected_zero[] = { 0x01, 0x01 };
+			CHECK_EQUAL( 2, (int) FrameCodec::encodeCobs( zero, 1, encoded ) );
+			CHECK_ARRAY_EQUAL( expected_zero, encoded, 2 );
+		}
+
+		TEST(CobsRoundTrip)
+		{
+			UInt8 data[40];
+			for ( UInt8 i = 0; i < sizeof( data ); i++ ) {
+				data[i] = ( i % 3 ) ? i : 0;
+			}
+
+			UInt8 buffer[sizeof( data ) + 1];
+			const UInt8 encoded_size =
+				FrameCodec::encodeCobs( data, sizeof( data ), buffer );
+			CHECK_EQUAL( (int) FrameCodec::getEncodedSize( sizeof( data ) ), (int) encoded_size );
+
+			for ( UInt8 i = 0; i < encoded_size; i++ ) {
+				CHECK( 0 != buffer[i] );
+			}
+
+			CHECK_EQUAL(
+				(int) sizeof( data ),
+				(int) FrameCodec::decodeCobs( buffer, encoded_size )
+			);
+			CHECK_ARRAY_EQUAL( data, buffer, sizeof( data ) );
+		}
+
+		TEST(DecodeInvalidCobs)
+		{
+			// The code points past the end of the data
+			UInt8 buffer[] = { 0x05, 0x11, 0x22 };
+			CHECK_EQUAL( 0, (int) FrameCodec::decodeCobs( buffer, sizeof( buffer ) ) );
+		}
+	}
+
+} }
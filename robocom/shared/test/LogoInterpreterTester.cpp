@@ -0,0 +1,305 @@
+#include <cmath>
+#include <vector>
+#include <unittest++/UnitTest++.h>
+
+#include "../LogoInterpreter.hpp"
+
+namespace robocom {
+namespace shared
+{
+
+	// Carries out the actions of a program the way the robot does,
+	// with ideal motors, encoders and gyro
+	class __Turtle
+	{
+	public:
+		__Turtle ()
+			: x( 0 ), y( 0 ), heading( 0 ), is_pen_down( false )
+			, wait_millis( 0 ), action_count( 0 ), max_turn( 0 )
+		{ }
+
+		bool run (LogoInterpreter& interpreter)
+		{
+			if ( ! interpreter.start() ) {
+				return false;
+			}
+
+			LogoInterpreter::Action action;
+			while ( interpreter.next( action ) ) {
+				apply( action );
+			}
+
+			return true;
+		}
+
+		void apply (const LogoInterpreter::Action& action)
+		{
+			++action_count;
+
+			const int sign = 0 == action.direction ? 1 : -1;
+			switch ( action.type )
+			{
+			case LogoInterpreter::ACTION_MOVE:
+				x += sign * action.amount * std::cos( heading * M_PI / 180 );
+				y += sign * action.amount * std::sin( heading * M_PI / 180 );
+				break;
+			case LogoInterpreter::ACTION_TURN:
+				heading -= sign * action.amount;
+				if ( action.amount > max_turn ) {
+					max_turn = action.amount;
+				}
+				break;
+			case LogoInterpreter::ACTION_PEN:
+				is_pen_down = 1 == action.direction;
+				break;
+			case LogoInterpreter::ACTION_WAIT:
+				wait_millis += action.amount;
+				break;
+			}
+		}
+
+		double x;
+		double y;
+		int heading;
+		bool is_pen_down;
+		UInt32 wait_millis;
+		UInt32 action_count;
+		UInt16 max_turn;
+	};
+
+
+	void __load (LogoInterpreter& interpreter, const std::vector<UInt8>& code)
+	{
+		interpreter.clear();
+		interpreter.write( 0, &code[0], code.size() );
+	}
+
+
+	SUITE(LogoInterpreterTester)
+	{
+		TEST(Empty)
+		{
+			LogoInterpreter interpreter;
+			__Turtle turtle;
+
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 0u, turtle.action_count );
+		}
+
+		TEST(Square)
+		{
+			const UInt8 code[] = {
+				LogoInterpreter::OP_PEN_DOWN,
+				LogoInterpreter::OP_REPEAT, 4,
+				  LogoInterpreter::OP_FORWARD, 20, 0,
+				  LogoInterpreter::OP_RIGHT, 90, 0,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_PEN_UP,
+				LogoInterpreter::OP_WAIT, 0xE8, 0x03
+			};
+
+			LogoInterpreter interpreter;
+			__load( interpreter, std::vector<UInt8>( code, code + sizeof(code) ) );
+
+			__Turtle turtle;
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 11u, turtle.action_count );
+			CHECK_CLOSE( 0.0, turtle.x, 1e-9 );
+			CHECK_CLOSE( 0.0, turtle.y, 1e-9 );
+			CHECK_EQUAL( -360, turtle.heading );
+			CHECK( ! turtle.is_pen_down );
+			CHECK_EQUAL( 1000u, turtle.wait_millis );
+
+			// The program can be run again
+			__Turtle again;
+			CHECK( again.run( interpreter ) );
+			CHECK_EQUAL( 11u, again.action_count );
+		}
+
+		TEST(NestedRepeat)
+		{
+			const UInt8 code[] = {
+				LogoInterpreter::OP_REPEAT, 3,
+				  LogoInterpreter::OP_REPEAT, 200,
+				    LogoInterpreter::OP_FORWARD, 1, 0,
+				  LogoInterpreter::OP_END,
+				  LogoInterpreter::OP_BACK, 100, 0,
+				LogoInterpreter::OP_END
+			};
+
+			LogoInterpreter interpreter;
+			__load( interpreter, std::vector<UInt8>( code, code + sizeof(code) ) );
+
+			__Turtle turtle;
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 3u * 201, turtle.action_count );
+			CHECK_CLOSE( 300.0, turtle.x, 1e-9 );
+		}
+
+		TEST(RepeatZero)
+		{
+			const UInt8 code[] = {
+				LogoInterpreter::OP_REPEAT, 0,
+				  LogoInterpreter::OP_REPEAT, 2,
+				    LogoInterpreter::OP_FORWARD, 1, 0,
+				  LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_LEFT, 45, 0
+			};
+
+			LogoInterpreter interpreter;
+			__load( interpreter, std::vector<UInt8>( code, code + sizeof(code) ) );
+
+			__Turtle turtle;
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 1u, turtle.action_count );
+			CHECK_EQUAL( 45, turtle.heading );
+		}
+
+		TEST(EmptyLoopsAreRejected)
+		{
+			// Would spin for millions of steps in one call to next()
+			const UInt8 nested_empty[] = {
+				LogoInterpreter::OP_REPEAT, 255,
+				  LogoInterpreter::OP_REPEAT, 255,
+				    LogoInterpreter::OP_REPEAT, 255,
+				      LogoInterpreter::OP_REPEAT, 20,
+				      LogoInterpreter::OP_END,
+				    LogoInterpreter::OP_END,
+				  LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_PEN_UP
+			};
+			// The inner loop has an action but never runs
+			const UInt8 nested_skipped[] = {
+				LogoInterpreter::OP_REPEAT, 255,
+				  LogoInterpreter::OP_REPEAT, 255,
+				    LogoInterpreter::OP_REPEAT, 0,
+				      LogoInterpreter::OP_FORWARD, 1, 0,
+				    LogoInterpreter::OP_END,
+				  LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END
+			};
+			// An action after the inner loop is enough
+			const UInt8 nested_action[] = {
+				LogoInterpreter::OP_REPEAT, 3,
+				  LogoInterpreter::OP_REPEAT, 0,
+				    LogoInterpreter::OP_FORWARD, 1, 0,
+				  LogoInterpreter::OP_END,
+				  LogoInterpreter::OP_PEN_DOWN,
+				LogoInterpreter::OP_END
+			};
+
+			LogoInterpreter interpreter;
+			__Turtle turtle;
+
+			__load( interpreter, std::vector<UInt8>( nested_empty, nested_empty + sizeof(nested_empty) ) );
+			CHECK( ! interpreter.verify() );
+			CHECK( ! turtle.run( interpreter ) );
+
+			__load( interpreter, std::vector<UInt8>( nested_skipped, nested_skipped + sizeof(nested_skipped) ) );
+			CHECK( ! interpreter.verify() );
+			CHECK( ! turtle.run( interpreter ) );
+			CHECK_EQUAL( 0u, turtle.action_count );
+
+			__load( interpreter, std::vector<UInt8>( nested_action, nested_action + sizeof(nested_action) ) );
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 3u, turtle.action_count );
+			CHECK( turtle.is_pen_down );
+		}
+
+		TEST(LargeTurnsAreSplit)
+		{
+			const UInt8 code[] = {
+				LogoInterpreter::OP_RIGHT, 0x68, 0x01,
+				LogoInterpreter::OP_LEFT, 0xC2, 0x01,
+				LogoInterpreter::OP_RIGHT, 0, 0
+			};
+
+			LogoInterpreter interpreter;
+			__load( interpreter, std::vector<UInt8>( code, code + sizeof(code) ) );
+
+			// 360 = 180 + 180, 450 = 180 + 180 + 90, and the empty turn
+			__Turtle turtle;
+			CHECK( turtle.run( interpreter ) );
+			CHECK_EQUAL( 6u, turtle.action_count );
+			CHECK_EQUAL( 90, turtle.heading );
+			CHECK_EQUAL( LogoInterpreter::MAX_TURN_STEP, turtle.max_turn );
+
+			// Starting again drops the rest of a split turn
+			LogoInterpreter::Action action;
+			CHECK( interpreter.start() );
+			CHECK( interpreter.next( action ) );
+			CHECK( interpreter.start() );
+
+			__Turtle again;
+			CHECK( again.run( interpreter ) );
+			CHECK_EQUAL( 6u, again.action_count );
+			CHECK_EQUAL( 90, again.heading );
+		}
+
+		TEST(Chunks)
+		{
+			const UInt8 code[] = {
+				LogoInterpreter::OP_FORWARD, 10, 0,
+				LogoInterpreter::OP_LEFT, 90, 0,
+				LogoInterpreter::OP_FORWARD, 10, 0
+			};
+
+			LogoInterpreter interpreter;
+			CHECK( interpreter.write( 0, code, 4 ) );
+			CHECK( ! interpreter.verify() );
+			CHECK( interpreter.write( 4, code + 4, 5 ) );
+			CHECK_EQUAL( 9, interpreter.getSize() );
+
+			__Turtle turtle;
+			CHECK( turtle.run( interpreter ) );
+			CHECK_CLOSE( 10.0, turtle.x, 1e-9 );
+			CHECK_CLOSE( 10.0, turtle.y, 1e-9 );
+
+			CHECK( ! interpreter.write( LogoInterpreter::MAX_PROGRAM_SIZE - 2, code, 3 ) );
+			CHECK( interpreter.write( LogoInterpreter::MAX_PROGRAM_SIZE - 3, code, 3 ) );
+		}
+
+		TEST(Malformed)
+		{
+			const UInt8 unknown[] = { 0x7F };
+			const UInt8 truncated[] = { LogoInterpreter::OP_FORWARD, 1 };
+			const UInt8 unbalanced_end[] = { LogoInterpreter::OP_END };
+			const UInt8 unbalanced_repeat[] = { LogoInterpreter::OP_REPEAT, 2 };
+			const UInt8 too_deep[] = {
+				LogoInterpreter::OP_REPEAT, 2,
+				LogoInterpreter::OP_REPEAT, 2,
+				LogoInterpreter::OP_REPEAT, 2,
+				LogoInterpreter::OP_REPEAT, 2,
+				LogoInterpreter::OP_REPEAT, 2,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END,
+				LogoInterpreter::OP_END
+			};
+
+			LogoInterpreter interpreter;
+			__Turtle turtle;
+
+			__load( interpreter, std::vector<UInt8>( unknown, unknown + sizeof(unknown) ) );
+			CHECK( ! turtle.run( interpreter ) );
+
+			__load( interpreter, std::vector<UInt8>( truncated, truncated + sizeof(truncated) ) );
+			CHECK( ! turtle.run( interpreter ) );
+
+			__load( interpreter, std::vector<UInt8>( unbalanced_end, unbalanced_end + sizeof(unbalanced_end) ) );
+			CHECK( ! turtle.run( interpreter ) );
+
+			__load( interpreter, std::vector<UInt8>( unbalanced_repeat, unbalanced_repeat + sizeof(unbalanced_repeat) ) );
+			CHECK( ! turtle.run( interpreter ) );
+
+			__load( interpreter, std::vector<UInt8>( too_deep, too_deep + sizeof(too_deep) ) );
+			CHECK( ! turtle.run( interpreter ) );
+
+			CHECK_EQUAL( 0u, turtle.action_count );
+		}
+	}
+
+} }
@@ -0,0 +1,68 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../LoopProfile.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	SUITE(LoopProfileTester)
+	{
+		TEST(Buckets)
+		{
+			CHECK_EQUAL( 0, (int) LoopProfile::getBucket( 0 ) );
+			CHECK_EQUAL( 0, (int) LoopProfile::getBucket( 1 ) );
+			CHECK_EQUAL( 1, (int) LoopProfile::getBucket( 2 ) );
+			CHECK_EQUAL( 1, (int) LoopProfile::getBucket( 3 ) );
+			CHECK_EQUAL( 2, (int) LoopProfile::getBucket( 4 ) );
+			CHECK_EQUAL( 9, (int) LoopProfile::getBucket( 1023 ) );
+			CHECK_EQUAL( 10, (int) LoopProfile::getBucket( 1024 ) );
+			CHECK_EQUAL( 15, (int) LoopProfile::getBucket( 0x8000 ) );
+			CHECK_EQUAL( 15, (int) LoopProfile::getBucket( 0xFFFFFFFF ) );
+		}
+
+		TEST(Record)
+		{
+			LoopProfile p;
+
+			CHECK_EQUAL( 110u, p.record( LoopProfile::PHASE_POP, 100, 110 ) );
+			p.record( LoopProfile::PHASE_POP, 200, 203 );
+
+			// Wraps around the micros counter
+			p.record( LoopProfile::PHASE_POP, 0xFFFFFFF0, 0x10 );
+
+			const LoopProfile::PhaseStats& stats =
+				p.getPhase( LoopProfile::PHASE_POP );
+			CHECK_EQUAL( 3u, stats.count );
+			CHECK_EQUAL( 45u, stats.sum_micros );
+			CHECK_EQUAL( 32u, stats.max_micros );
+			CHECK_EQUAL( 1, (int) stats.buckets[1] );
+			CHECK_EQUAL( 1, (int) stats.buckets[3] );
+			CHECK_EQUAL( 1, (int) stats.buckets[5] );
+
+			CHECK_EQUAL( 0u, p.getPhase( LoopProfile::PHASE_READ ).count );
+
+			p.clear();
+			CHECK_EQUAL( 0u, p.getPhase( LoopProfile::PHASE_POP ).count );
+			CHECK_EQUAL( 0, (int) p.getPhase( LoopProfile::PHASE_POP ).buckets[1] );
+		}
+
+		TEST(BucketSaturates)
+		{
+			LoopProfile p;
+
+			for ( UInt32 i = 0; i < LoopProfile::MAX_BUCKET_VALUE + 10; i++ ) {
+				p.record( LoopProfile::PHASE_READ, 0, 0 );
+			}
+
+			const LoopProfile::PhaseStats& stats =
+				p.getPhase( LoopProfile::PHASE_READ );
+			CHECK_EQUAL( LoopProfile::MAX_BUCKET_VALUE + 10u, stats.count );
+			CHECK_EQUAL( (int) LoopProfile::MAX_BUCKET_VALUE, (int) stats.buckets[0] );
+		}
+	}
+
+} }
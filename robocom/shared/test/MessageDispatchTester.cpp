@@ -0,0 +1,107 @@
+#include <unittest++/UnitTest++.h>
+
+#include <vector>
+
+#include "../Message.hpp"
+#include "../MessageDispatch.hxx"
+#include "../msg/SetServoAngleRequest.hpp"
+#include "../msg/SimpleMessage.hxx"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		/**
+		 * Target which records the task IDs of the messages it got
+		 */
+		class Target
+		{
+		public:
+
+			typedef MessageDispatch<Target> Dispatch;
+
+			template <int MSGID> struct Route
+				: Dispatch::Unrouted
+			{ };
+
+			static const Dispatch::Handler ROUTES[Dispatch::TABLE_SIZE];
+
+			bool dispatch (const Message& msg)
+			{
+				return Dispatch::dispatch( ROUTES, *this, msg );
+			}
+
+			std::vector<UInt16> m_echoes;
+			std::vector<UInt8> m_angles;
+
+		private:
+
+			void _processMessage (const EchoRequest& req)
+			{
+				m_echoes.push_back( req.getTaskId() );
+			}
+
+			void _processMessage (const SetServoAngleRequest& req)
+			{
+				m_angles.push_back( req.getAngle() );
+			}
+		};
+
+
+		template <> struct Target::Route<EchoRequest::MSGID>
+			: Dispatch::To<EchoRequest, & Target::_processMessage> { };
+		template <> struct Target::Route<SetServoAngleRequest::MSGID>
+			: Dispatch::To<SetServoAngleRequest, & Target::_processMessage> { };
+		template <> struct Target::Route<NoopRequest::MSGID>
+			: Dispatch::Ignored { };
+
+		const Target::Dispatch::Handler Target::ROUTES[] =
+			ROBOCOM_DISPATCH_TABLE( Route );
+
+	}
+
+
+	SUITE(MessageDispatchTester)
+	{
+		TEST(RoutesByType)
+		{
+			Target target;
+
+			CHECK( target.dispatch( EchoRequest( 3 ).asMessage() ) );
+			CHECK( target.dispatch( SetServoAngleRequest( 4, 0, 45 ).asMessage() ) );
+			CHECK( target.dispatch( SetServoAngleRequest( 5, 100u, 0, 90 ).asMessage() ) );
+
+			CHECK_EQUAL( 1u, target.m_echoes.size() );
+			CHECK_EQUAL( 3, target.m_echoes[0] );
+			CHECK_EQUAL( 2u, target.m_angles.size() );
+			CHECK_EQUAL( 45, (int) target.m_angles[0] );
+			CHECK_EQUAL( 90, (int) target.m_angles[1] );
+		}
+
+		TEST(IgnoredAndUnrouted)
+		{
+			Target target;
+
+			CHECK( target.dispatch( NoopRequest( 1 ).asMessage() ) );
+			CHECK( ! target.dispatch( ResetRequest( 2 ).asMessage() ) );
+
+			// The highest type has an entry as well
+			Message msg;
+			msg.clear();
+			msg.setMessageType( Message::MAX_MESSAGE_TYPE );
+			msg.setImmediate();
+			CHECK( ! target.dispatch( msg ) );
+
+			CHECK( target.m_echoes.empty() );
+			CHECK( target.m_angles.empty() );
+		}
+	}
+
+} }
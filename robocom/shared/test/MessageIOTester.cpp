@@ -0,0 +1,476 @@
+#include <unittest++/UnitTest++.h>
+
+#include <deque>
+#include <vector>
+
+#include "../BufferStream.hpp"
+#include "../Message.hpp"
+#include "../MessageIO.hxx"
+#include "../StreamIO.hpp"
+#include "../msg/SimpleMessage.hxx"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		/**
+		 * One end of a link, which reads what the test delivered to it
+		 * and keeps what it wrote until the test delivers it
+		 */
+		class EndStream
+			: public StreamIO
+		{
+		public:
+
+			virtual int available ()
+			{
+				return static_cast<int>( m_in.size() );
+			}
+
+			virtual int peek ()
+			{
+				return m_in.empty() ? -1 : m_in.front();
+			}
+
+			virtual int read ()
+			{
+				if ( m_in.empty() ) {
+					return -1;
+				}
+
+				const int b = m_in.front();
+				m_in.pop_front();
+				return b;
+			}
+
+			virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+			{
+				UInt32 n = 0;
+				for ( ; n < size && ! m_in.empty(); n++ ) {
+					p_buffer[n] = static_cast<char>( read() );
+				}
+				return n;
+			}
+
+			virtual UInt32 write (UInt8 b)
+			{
+				m_out.push_back( b );
+				return 1;
+			}
+
+			virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+			{
+				m_out.insert( m_out.end(), p_buffer, p_buffer + size );
+				return size;
+			}
+
+			std::deque<UInt8> m_in;
+			std::vector<UInt8> m_out;
+		};
+
+
+		/**
+		 * Moves the bytes written by one end to the other, flipping
+		 * a bit in every corrupt_every-th byte if that is not zero
+		 */
+		void
+		deliver (EndStream& from, EndStream& to, unsigned corrupt_every = 0)
+		{
+			static unsigned s_count = 0;
+
+			for ( size_t i = 0; i < from.m_out.size(); i++ )
+			{
+				UInt8 b = from.m_out[i];
+				if ( corrupt_every > 0 && 0 == ++s_count % corrupt_every ) {
+					b ^= 1u << ( s_count % 8 );
+				}
+				to.m_in.push_back( b );
+			}
+			from.m_out.clear();
+		}
+
+
+		Message
+		makeMessage (UInt16 task_id)
+		{
+			return NoopRequest( task_id ).asMessage();
+		}
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		/**
+		 * Streams messages in the reliable mode over a link which
+		 * corrupts about one frame in six in each direction, and checks
+		 * that they all arrive in order
+		 */
+		void
+		checkNoisyLink (UInt8 codec)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			Message msg;
+
+			const unsigned CORRUPT_EVERY = 61;
+			const UInt16 MESSAGE_COUNT = 300;
+
+			io_a.setCodec( codec );
+			io_b.setCodec( codec );
+			io_a.setReliable( true );
+
+			UInt16 next_to_send = 1;
+			UInt16 next_expected = 1;
+			for ( UInt32 millis = 0; millis < 100000 && next_expected <= MESSAGE_COUNT; millis++ )
+			{
+				while ( next_to_send <= MESSAGE_COUNT && io_a.tryWrite( makeMessage( next_to_send ) ) ) {
+					next_to_send++;
+				}
+				io_a.poll( millis );
+				deliver( a, b, CORRUPT_EVERY );
+
+				while ( io_b.read( msg ) )
+				{
+					CHECK_EQUAL( next_expected, msg.getTaskId() );
+					next_expected = msg.getTaskId() + 1;
+				}
+				io_b.poll( millis );
+				deliver( b, a, CORRUPT_EVERY );
+
+				while ( io_a.read( msg ) ) { }
+			}
+
+			CHECK_EQUAL( MESSAGE_COUNT + 1, next_expected );
+			CHECK( io_a.getRetransmitCount() > 0 );
+			CHECK( io_b.getCorruptFrameCount() > 0 );
+		}
+#endif
+
+	}
+
+	SUITE(MessageIOTester)
+	{
+		TEST(PlainRoundTrip)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+
+			io_a.write( makeMessage( 1 ) );
+			io_a.write( makeMessage( 2 ) );
+			deliver( a, b );
+
+			Message msg;
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 1, msg.getTaskId() );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 2, msg.getTaskId() );
+			CHECK( ! io_b.read( msg ) );
+		}
+
+		TEST(CobsRoundTrip)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			io_a.setCodec( MessageIO::CODEC_COBS );
+			io_b.setCodec( MessageIO::CODEC_COBS );
+
+			// Timed messages have zeros in the millis
+			Message timed = makeMessage( 0x0100 );
+			timed.setMillis( 0x00010000 );
+			io_a.write( timed );
+			io_a.write( makeMessage( 2 ) );
+
+			for ( size_t i = 0; i + 1 < a.m_out.size(); i++ )
+			{
+				if ( 0 == a.m_out[i] ) {
+					CHECK( MessageIO::MC_MESSAGE_END != a.m_out[i + 1] );
+				}
+			}
+			deliver( a, b );
+
+			Message msg;
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 0x0100, msg.getTaskId() );
+			CHECK_EQUAL( 0x00010000u, msg.getMillis() );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 2, msg.getTaskId() );
+			CHECK( msg.isImmediate() );
+			CHECK( ! io_b.read( msg ) );
+		}
+
+		TEST(StaticStreamRoundTrip)
+		{
+			UInt8 buffer[256];
+			BufferStream stream( buffer, sizeof( buffer ) );
+			BasicMessageIO<BufferStream> io( stream );
+			Message msg;
+
+			for ( UInt8 codec = 0; codec < MessageIO::CODEC_COUNT; codec++ )
+			{
+				io.setCodec( codec );
+
+				Message timed = makeMessage( 3 );
+				timed.setMillis( 0x00010000 );
+				io.write( timed );
+				io.write( makeMessage( 4 ) );
+
+				CHECK( io.read( msg ) );
+				CHECK_EQUAL( 3, msg.getTaskId() );
+				CHECK_EQUAL( 0x00010000u, msg.getMillis() );
+				CHECK( io.read( msg ) );
+				CHECK_EQUAL( 4, msg.getTaskId() );
+				CHECK( ! io.read( msg ) );
+				CHECK_EQUAL( 0, stream.available() );
+			}
+		}
+
+		TEST(CobsResyncsAfterOneFrame)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			io_a.setCodec( MessageIO::CODEC_COBS );
+			io_b.setCodec( MessageIO::CODEC_COBS );
+
+			io_a.write( makeMessage( 1 ) );
+			io_a.write( makeMessage( 2 ) );
+			io_a.write( makeMessage( 3 ) );
+
+			// A zero in the middle of the first frame splits it in two
+			a.m_out[3] = 0;
+			deliver( a, b );
+
+			Message msg;
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 2, msg.getTaskId() );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 3, msg.getTaskId() );
+			CHECK( ! io_b.read( msg ) );
+			CHECK_EQUAL( 2, (int) io_b.getCorruptFrameCount() );
+		}
+
+		TEST(PlainMisparsesAfterCorruptSize)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+
+			io_a.write( makeMessage( 1 ) );
+			io_a.write( makeMessage( 2 ) );
+			io_a.write( makeMessage( 3 ) );
+
+			// The size of the first frame now takes in the second one,
+			// and the frame still ends where the second one did
+			a.m_out[1] += 6;
+			deliver( a, b );
+
+			std::vector<Message> received;
+			Message msg;
+			while ( io_b.read( msg ) ) {
+				received.push_back( msg );
+			}
+
+			// Nothing tells the garbage from a real message
+			CHECK_EQUAL( 2u, received.size() );
+			CHECK_EQUAL( 1, received.front().getTaskId() );
+			CHECK_EQUAL( 6, (int) received.front().getDataSize() );
+			CHECK_EQUAL( 3, received.back().getTaskId() );
+		}
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		TEST(SyncHoldsMessages)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+
+			io_a.setReliable( true );
+			io_a.write( makeMessage( 1 ) );
+			deliver( a, b );
+
+			// Only the sync went out, the other side answers it
+			Message msg;
+			CHECK( ! io_b.read( msg ) );
+			CHECK( io_b.isReliable() );
+			deliver( b, a );
+
+			// The answer releases the held message
+			CHECK( ! io_a.read( msg ) );
+			deliver( a, b );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 1, msg.getTaskId() );
+		}
+
+		TEST(WindowLimitsWrites)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			Message msg;
+
+			io_a.setReliable( true );
+			deliver( a, b );
+			io_b.read( msg );
+			deliver( b, a );
+			io_a.read( msg );
+
+			for ( UInt16 i = 0; i < MessageIO::WINDOW_SIZE; i++ )
+			{
+				CHECK( io_a.canWrite() );
+				io_a.write( makeMessage( i ) );
+			}
+			CHECK( ! io_a.canWrite() );
+			CHECK( ! io_a.tryWrite( makeMessage( 99 ) ) );
+
+			// The acknowledgement opens the window again
+			deliver( a, b );
+			while ( io_b.read( msg ) ) { }
+			io_b.poll( 0 );
+			deliver( b, a );
+			io_a.read( msg );
+			CHECK( io_a.canWrite() );
+		}
+
+		TEST(FullWindowHoldsBackWrites)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			Message msg;
+
+			io_a.setReliable( true );
+			deliver( a, b );
+			io_b.read( msg );
+			deliver( b, a );
+			io_a.read( msg );
+
+			UInt16 task_id = 0;
+			while ( io_a.tryWrite( makeMessage( task_id ) ) ) {
+				task_id++;
+			}
+			CHECK_EQUAL( (int) MessageIO::WINDOW_SIZE, (int) task_id );
+
+			// Nothing goes out for the refused message
+			const size_t written_size = a.m_out.size();
+			CHECK( ! io_a.tryWrite( makeMessage( task_id ) ) );
+			CHECK_EQUAL( written_size, a.m_out.size() );
+
+			deliver( a, b );
+			for ( UInt16 i = 0; i < task_id; i++ )
+			{
+				CHECK( io_b.read( msg ) );
+				CHECK_EQUAL( i, msg.getTaskId() );
+			}
+			CHECK( ! io_b.read( msg ) );
+
+			// Once acknowledged, the message goes out in a reliable
+			// frame, which the other side takes
+			io_b.poll( 0 );
+			deliver( b, a );
+			io_a.read( msg );
+			CHECK( io_a.tryWrite( makeMessage( task_id ) ) );
+			deliver( a, b );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( task_id, msg.getTaskId() );
+		}
+
+		TEST(LostFrameIsRetransmittedSelectively)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			Message msg;
+
+			io_a.setReliable( true );
+			deliver( a, b );
+			io_b.read( msg );
+			deliver( b, a );
+			io_a.read( msg );
+
+			// The second frame gets lost on the way
+			io_a.write( makeMessage( 1 ) );
+			deliver( a, b );
+			io_a.write( makeMessage( 2 ) );
+			a.m_out.clear();
+			io_a.write( makeMessage( 3 ) );
+			io_a.write( makeMessage( 4 ) );
+			deliver( a, b );
+
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 1, msg.getTaskId() );
+			CHECK( ! io_b.read( msg ) );
+
+			// The selective acknowledgement triggers the retransmission
+			// of the lost frame only
+			io_b.poll( 1 );
+			deliver( b, a );
+			CHECK( ! io_a.read( msg ) );
+			CHECK_EQUAL( 1, (int) io_a.getRetransmitCount() );
+
+			deliver( a, b );
+			for ( UInt16 task_id = 2; task_id <= 4; task_id++ )
+			{
+				CHECK( io_b.read( msg ) );
+				CHECK_EQUAL( task_id, msg.getTaskId() );
+			}
+			CHECK( ! io_b.read( msg ) );
+		}
+
+		TEST(CorruptFrameIsRetransmittedAfterTimeout)
+		{
+			EndStream a;
+			EndStream b;
+			MessageIO io_a( a );
+			MessageIO io_b( b );
+			Message msg;
+
+			io_a.setReliable( true );
+			deliver( a, b );
+			io_b.read( msg );
+			deliver( b, a );
+			io_a.read( msg );
+
+			io_a.write( makeMessage( 7 ) );
+			a.m_out[3] ^= 0x10;
+			deliver( a, b );
+			CHECK( ! io_b.read( msg ) );
+			CHECK_EQUAL( 1, (int) io_b.getCorruptFrameCount() );
+
+			io_a.poll( MessageIO::RETRANSMIT_MILLIS - 1 );
+			CHECK( a.m_out.empty() );
+
+			io_a.poll( MessageIO::RETRANSMIT_MILLIS );
+			deliver( a, b );
+			CHECK( io_b.read( msg ) );
+			CHECK_EQUAL( 7, msg.getTaskId() );
+		}
+
+		TEST(NoisyLinkDeliversInOrder)
+		{
+			checkNoisyLink( MessageIO::CODEC_PLAIN );
+		}
+
+		TEST(NoisyCobsLinkDeliversInOrder)
+		{
+			checkNoisyLink( MessageIO::CODEC_COBS );
+		}
+#endif
+	}
+
+} }
@@ -25,6 +25,43 @@ namespace shared
 		}
 	}
 
+	namespace
+	{
+
+		/**
+		 * Records the visited messages, and pushes each one back to
+		 * the queue delayed by 10 millis if asked to
+		 */
+		class RecordingVisitor
+			: public MessageQueue::Visitor
+		{
+		public:
+
+			RecordingVisitor (MessageQueue* p_requeue = 0)
+				: m_p_requeue( p_requeue )
+				, m_count( 0 )
+			{ }
+
+			virtual void visit (const Message& msg)
+			{
+				m_last = msg;
+				m_count++;
+
+				if ( 0 != m_p_requeue )
+				{
+					Message next = msg;
+					next.setMillis( msg.getMillis() + 10 );
+					m_p_requeue->push( next );
+				}
+			}
+
+			MessageQueue* m_p_requeue;
+			Message m_last;
+			int m_count;
+		};
+
+	}
+
 	SUITE(MessageQueueTester)
 	{
 		TEST(PushPop)
@@ -36,7 +73,7 @@ namespace shared
 			CHECK( ! q.pop( msg, 1000u ) );
 
 			{
-				FlushResponse r( 99, 123u, 3, 5, 7, 6, 4, 2 );
+				FlushResponse r( 99, 123u, 3, 5, 7, 6, 4, 2, 40 );
 				CHECK( q.push( r.asMessage() ) );
 				CHECK( q.pop( msg, 1000u ) );
 				__checkEqual( msg, r.asMessage() );
@@ -149,6 +186,166 @@ namespace shared
 			CHECK_EQUAL( q.getSize(), 0 );
 			CHECK( q.push( m ) );
 		}
+
+		TEST(Remove)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+
+			SetWheelDriveRequest r1( 11, 5u, 0, 1, 0, 0 );
+			SetWheelDriveRequest r2( 12, 0, 2, 0, 0 );
+			SetWheelDriveRequest r3( 11, 0, 3, 0, 0 );
+			SetWheelDriveRequest r4( 13, 7u, 0, 4, 0, 0 );
+
+			q.push( r1.asMessage() );
+			q.push( r2.asMessage() );
+			q.push( r3.asMessage() );
+			q.push( r4.asMessage() );
+
+			// Removes both the head and a message in the middle
+			CHECK_EQUAL( 2, (int) q.remove( 11 ) );
+			CHECK_EQUAL( 2, (int) q.getSize() );
+			CHECK_EQUAL( 0, (int) q.remove( 11 ) );
+
+			Message msg;
+
+			CHECK( q.pop( msg, 10u ) );
+			__checkEqual( msg, r2.asMessage() );
+
+			CHECK( q.pop( msg, 10u ) );
+			__checkEqual( msg, r4.asMessage() );
+
+			CHECK( ! q.pop( msg, 10u ) );
+			CHECK_EQUAL( MessagePool::SLOT_COUNT, p.getFree() );
+		}
+
+		TEST(Reserve)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+
+			SetWheelDriveRequest r1( 11, 5u, 0, 1, 0, 0 );
+			SetWheelDriveRequest r2( 12, 0, 2, 0, 0 );
+			q.push( r1.asMessage() );
+
+			// The reserved message takes a slot but is not queued
+			Message* p_msg = q.reserve();
+			CHECK( 0 != p_msg );
+			CHECK( p_msg == q.reserve() );
+			CHECK_EQUAL( MessagePool::SLOT_COUNT - 2, (int) p.getFree() );
+			CHECK_EQUAL( 1, (int) q.getSize() );
+
+			*p_msg = r2.asMessage();
+			CHECK( q.push( *p_msg ) );
+			CHECK_EQUAL( MessagePool::SLOT_COUNT - 2, (int) p.getFree() );
+			CHECK_EQUAL( 2, (int) q.getSize() );
+
+			// Cancelling a reservation gives the slot back
+			CHECK( 0 != q.reserve() );
+			q.cancel();
+			q.cancel();
+			CHECK_EQUAL( MessagePool::SLOT_COUNT - 2, (int) p.getFree() );
+
+			Message msg;
+			CHECK( q.pop( msg, 10u ) );
+			__checkEqual( msg, r2.asMessage() );
+			CHECK( q.pop( msg, 10u ) );
+			__checkEqual( msg, r1.asMessage() );
+
+			// Clearing the queue releases the reservation too
+			CHECK( 0 != q.reserve() );
+			q.clear();
+			CHECK_EQUAL( MessagePool::SLOT_COUNT, (int) p.getFree() );
+		}
+
+		TEST(ReserveFromFullPool)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+			Message m;
+			m.clear();
+
+			while ( q.push( m ) );
+			CHECK( 0 == q.reserve() );
+		}
+
+		TEST(PopAndVisit)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+			RecordingVisitor visitor;
+
+			SetWheelDriveRequest r1( 11, 5u, 0, 1, 0, 0 );
+			SetWheelDriveRequest r2( 12, 0, 2, 0, 0 );
+			q.push( r1.asMessage() );
+			q.push( r2.asMessage() );
+
+			CHECK( q.popAndVisit( visitor, 0u ) );
+			__checkEqual( visitor.m_last, r2.asMessage() );
+
+			CHECK( ! q.popAndVisit( visitor, 4u ) );
+			CHECK_EQUAL( 1, visitor.m_count );
+
+			CHECK( q.popAndVisit( visitor, 5u ) );
+			__checkEqual( visitor.m_last, r1.asMessage() );
+			CHECK( ! q.popAndVisit( visitor, 5u ) );
+
+			CHECK_EQUAL( 2, visitor.m_count );
+			CHECK_EQUAL( MessagePool::SLOT_COUNT, (int) p.getFree() );
+		}
+
+		TEST(VisitorPushes)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+			RecordingVisitor visitor( & q );
+
+			q.push( SetWheelDriveRequest( 11, 5u, 0, 1, 0, 0 ).asMessage() );
+
+			for ( UInt32 millis = 5; millis < 50; millis += 10 )
+			{
+				CHECK( q.popAndVisit( visitor, millis ) );
+				CHECK_EQUAL( millis, visitor.m_last.getMillis() );
+				CHECK_EQUAL( 1, (int) q.getSize() );
+			}
+
+			CHECK_EQUAL( MessagePool::SLOT_COUNT - 1, (int) p.getFree() );
+		}
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		TEST(Residency)
+		{
+			MessagePool p;
+			MessageQueue q(p);
+
+			// Queued at 100 to run at 150, popped at 153
+			SetWheelDriveRequest r1( 11, 150u, 0, 1, 0, 0 );
+			// Queued at 100 to run right away, popped at 160
+			SetWheelDriveRequest r2( 12, 0, 2, 0, 0 );
+
+			q.push( r1.asMessage(), 100u );
+			q.push( r2.asMessage(), 100u );
+			q.sampleDepth();
+
+			Message msg;
+			CHECK( q.pop( msg, 160u ) );
+			CHECK( q.pop( msg, 153u ) );
+			q.sampleDepth();
+
+			const QueueProfile& profile = q.getProfile();
+			CHECK_EQUAL( 60, (int) profile.getMaxResidencyMillis() );
+			CHECK_EQUAL( 1, (int) profile.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 1 ) );
+			CHECK_EQUAL( 1, (int) profile.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 5 ) );
+			CHECK_EQUAL( 1, (int) profile.getBucket( QueueProfile::HISTOGRAM_DEPTH, 0 ) );
+			CHECK_EQUAL( 1, (int) profile.getBucket( QueueProfile::HISTOGRAM_DEPTH, 1 ) );
+
+			// Drops are counted
+			Message m;
+			m.clear();
+			while ( q.push( m ) );
+			CHECK_EQUAL( 1, (int) profile.getDropCount() );
+		}
+#endif
 	}
 
 } }
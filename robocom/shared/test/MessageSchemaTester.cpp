@@ -0,0 +1,193 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../Message.hpp"
+#include "../msg/CreditNotice.hpp"
+#include "../msg/GyroQuaternionNotice.hpp"
+#include "../msg/MessageSchema.hxx"
+#include "../msg/SensorLogNotice.hpp"
+#include "../msg/SetWheelDriveRequest.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		typedef schema::Field<UInt8> ByteField;
+		typedef schema::Field<SInt16, ByteField> ShortField;
+		typedef schema::Field<UInt32, ShortField> LongField;
+		typedef schema::Field<bool, LongField> FlagField;
+
+		typedef schema::Layout<0x55, FlagField> AnyLayout;
+		typedef schema::Layout<0x55, FlagField, schema::TIMING_IMMEDIATE> ImmediateLayout;
+		typedef schema::Layout<0x55, FlagField, schema::TIMING_DELAYED> DelayedLayout;
+
+
+		/**
+		 * Checks that both messages have the same header and payload
+		 */
+		void
+		checkSameBytes (const Message& expected, const Message& actual)
+		{
+			CHECK_EQUAL( (int) expected.getMessageType(), (int) actual.getMessageType() );
+			CHECK_EQUAL( expected.isImmediate(), actual.isImmediate() );
+			CHECK_EQUAL( expected.getTaskId(), actual.getTaskId() );
+			CHECK_EQUAL( expected.getMillis(), actual.getMillis() );
+			CHECK_EQUAL( (int) expected.getDataSize(), (int) actual.getDataSize() );
+			for ( int i = 0; i < expected.getDataSize(); i++ ) {
+				CHECK_EQUAL( (int) expected.getUInt8( i ), (int) actual.getUInt8( i ) );
+			}
+		}
+
+
+		/**
+		 * Builds a message the way the hand-written classes do
+		 */
+		Message
+		makeMessage (UInt8 type, UInt16 task_id, bool is_immediate, UInt8 size)
+		{
+			Message msg;
+			msg.clear();
+			msg.setMessageType( type );
+			msg.setDataSize( size );
+			msg.setTaskId( task_id );
+			if ( is_immediate ) {
+				msg.setImmediate();
+			}
+			else {
+				msg.setMillis( 0x11223344 );
+			}
+			return msg;
+		}
+
+	}
+
+	SUITE(MessageSchemaTester)
+	{
+		TEST(Offsets)
+		{
+			CHECK_EQUAL( 0, (int) ByteField::OFFSET );
+			CHECK_EQUAL( 1, (int) ShortField::OFFSET );
+			CHECK_EQUAL( 3, (int) LongField::OFFSET );
+			CHECK_EQUAL( 7, (int) FlagField::OFFSET );
+			CHECK_EQUAL( 8, (int) AnyLayout::DATA_SIZE );
+		}
+
+		TEST(SameBytesAsMessageAccessors)
+		{
+			for ( int is_immediate = 0; is_immediate < 2; is_immediate++ )
+			{
+				Message expected = makeMessage( 0x55, 7, is_immediate, 8 );
+				expected.setUInt8( 0, 0xAB );
+				expected.setUInt16( 1, static_cast<UInt16>( -2 ) );
+				expected.setUInt32( 3, 0xDEADBEEF );
+				expected.setUInt8( 7, 1 );
+
+				Message actual;
+				if ( is_immediate ) {
+					AnyLayout::initImmediate( actual, 7 );
+				}
+				else {
+					AnyLayout::initDelayed( actual, 7, 0x11223344 );
+				}
+				AnyLayout::set<ByteField>( actual, 0xAB );
+				AnyLayout::set<ShortField>( actual, -2 );
+				AnyLayout::set<LongField>( actual, 0xDEADBEEF );
+				AnyLayout::set<FlagField>( actual, true );
+
+				checkSameBytes( expected, actual );
+				CHECK_EQUAL( 0xAB, (int) AnyLayout::get<ByteField>( expected ) );
+				CHECK_EQUAL( -2, AnyLayout::get<ShortField>( expected ) );
+				CHECK_EQUAL( 0xDEADBEEFu, AnyLayout::get<LongField>( expected ) );
+				CHECK( AnyLayout::get<FlagField>( expected ) );
+			}
+		}
+
+		TEST(FixedTiming)
+		{
+			Message immediate;
+			ImmediateLayout::initImmediate( immediate, 1 );
+			ImmediateLayout::set<LongField>( immediate, 0x01020304 );
+			CHECK_EQUAL( 0x01020304u, immediate.getUInt32( LongField::OFFSET ) );
+
+			Message delayed;
+			DelayedLayout::initDelayed( delayed, 1, 500 );
+			DelayedLayout::set<LongField>( delayed, 0x01020304 );
+			CHECK_EQUAL( 0x01020304u, delayed.getUInt32( LongField::OFFSET ) );
+			CHECK_EQUAL( 500u, delayed.getMillis() );
+		}
+
+		TEST(Validate)
+		{
+			Message msg;
+			AnyLayout::initDelayed( msg, 1, 500 );
+			CHECK_EQUAL( STATUS_OK, AnyLayout::validate( msg ) );
+			CHECK_EQUAL( STATUS_OK, DelayedLayout::validate( msg ) );
+			CHECK_EQUAL( STATUS_E_NOT_IMMEDIATE, ImmediateLayout::validate( msg ) );
+
+			AnyLayout::initImmediate( msg, 1 );
+			CHECK_EQUAL( STATUS_OK, ImmediateLayout::validate( msg ) );
+			CHECK_EQUAL( STATUS_E_IMMEDIATE, DelayedLayout::validate( msg ) );
+
+			msg.setDataSize( 7 );
+			CHECK_EQUAL( STATUS_E_DATA_SIZE, AnyLayout::validate( msg ) );
+
+			msg.setMessageType( 0x56 );
+			CHECK_EQUAL( STATUS_E_MESSAGE_TYPE, AnyLayout::validate( msg ) );
+		}
+
+		TEST(WireLayoutOfConvertedMessages)
+		{
+			{
+				Message expected = makeMessage( SetWheelDriveRequest::MSGID, 3, false, 4 );
+				expected.setUInt8( 0, 1 );
+				expected.setUInt8( 1, 200 );
+				expected.setUInt8( 2, 0 );
+				expected.setUInt8( 3, 100 );
+				checkSameBytes(
+					expected,
+					SetWheelDriveRequest( 3, 0x11223344, 1, 200, 0, 100 ).asMessage()
+				);
+			}
+
+			{
+				Message expected = makeMessage( GyroQuaternionNotice::MSGID, 4, false, 12 );
+				expected.setUInt16( 0, static_cast<UInt16>( -1 ) );
+				expected.setUInt16( 2, 2 );
+				expected.setUInt16( 4, static_cast<UInt16>( -3 ) );
+				expected.setUInt16( 6, 4 );
+				expected.setUInt32( 8, 123456 );
+				checkSameBytes(
+					expected,
+					GyroQuaternionNotice( 4, 0x11223344, -1, 2, -3, 4, 123456 ).asMessage()
+				);
+			}
+
+			{
+				Message expected = makeMessage( CreditNotice::MSGID, 5, true, 2 );
+				expected.setUInt16( 0, 0x1234 );
+				checkSameBytes( expected, CreditNotice( 5, 0x1234 ).asMessage() );
+			}
+
+			{
+				Message expected = makeMessage( SensorLogNotice::MSGID, 6, true, 11 );
+				expected.setUInt8( 0, STATUS_E_LOG_PERIOD );
+				expected.setUInt8( 1, 1 );
+				expected.setUInt8( 2, 17 );
+				expected.setUInt16( 3, 300 );
+				expected.setUInt32( 5, 70000 );
+				expected.setUInt16( 9, 12 );
+				checkSameBytes(
+					expected,
+					SensorLogNotice( 6, STATUS_E_LOG_PERIOD, true, 17, 300, 70000, 12 ).asMessage()
+				);
+			}
+		}
+	}
+
+} }
@@ -0,0 +1,176 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../MpuFifoReader.hxx"
+
+namespace robocom {
+namespace shared
+{
+
+	// Stands in for the MPU6050, counts the I2C transactions and keeps
+	// the FIFO as a byte count. Each packet read is filled with the
+	// number of packets read so far.
+	class __MockMpu
+	{
+	public:
+		__MockMpu ()
+			: int_status( 0 ), fifo_count( 0 ), transaction_count( 0 )
+			, packet_count( 0 ), reset_count( 0 )
+		{ }
+
+		UInt8 getIntStatus ()
+		{
+			++transaction_count;
+			const UInt8 status = int_status;
+			int_status = 0;
+			return status;
+		}
+
+		UInt16 getFIFOCount ()
+		{
+			++transaction_count;
+			return fifo_count;
+		}
+
+		void getFIFOBytes (UInt8* data, UInt8 length)
+		{
+			++transaction_count;
+			++packet_count;
+			for ( UInt8 i = 0; i < length; ++i ) {
+				data[i] = packet_count;
+			}
+			fifo_count -= length;
+		}
+
+		void resetFIFO ()
+		{
+			++transaction_count;
+			++reset_count;
+			fifo_count = 0;
+		}
+
+		UInt8 int_status;
+		UInt16 fifo_count;
+		int transaction_count;
+		UInt8 packet_count;
+		int reset_count;
+	};
+
+	typedef MpuFifoReader<__MockMpu> __Reader;
+
+	enum { __PACKET_SIZE = 42 };
+
+
+	SUITE(MpuFifoReaderTester)
+	{
+		TEST(NoTransactionsWithoutInterrupt)
+		{
+			__MockMpu mpu;
+			__Reader reader( mpu );
+			reader.setPacketSize( __PACKET_SIZE );
+			volatile bool is_data_ready = false;
+			UInt8 packet[__PACKET_SIZE];
+
+			mpu.fifo_count = __PACKET_SIZE;
+			for ( UInt32 now = 1; now < __Reader::MAX_POLL_INTERVAL_MILLIS; ++now ) {
+				CHECK( ! reader.read( now, is_data_ready, packet ) );
+			}
+			CHECK_EQUAL( 0, mpu.transaction_count );
+
+			// The poll interval catches a missed interrupt
+			CHECK( reader.read(
+				__Reader::MAX_POLL_INTERVAL_MILLIS, is_data_ready, packet ) );
+			CHECK_EQUAL( 3, mpu.transaction_count );
+		}
+
+		TEST(InterruptReadsOnePacket)
+		{
+			__MockMpu mpu;
+			__Reader reader( mpu );
+			reader.setPacketSize( __PACKET_SIZE );
+			volatile bool is_data_ready = true;
+			UInt8 packet[__PACKET_SIZE];
+
+			mpu.int_status = __Reader::INT_STATUS_DATA_READY;
+			mpu.fifo_count = __PACKET_SIZE;
+			CHECK( reader.read( 10, is_data_ready, packet ) );
+			CHECK( ! is_data_ready );
+			CHECK_EQUAL( 3, mpu.transaction_count );
+			CHECK_EQUAL( 0, mpu.fifo_count );
+			CHECK_EQUAL( 1, packet[0] );
+
+			// Nothing more until the next interrupt
+			CHECK( ! reader.read( 11, is_data_ready, packet ) );
+			CHECK_EQUAL( 3, mpu.transaction_count );
+		}
+
+		TEST(BacklogIsDrainedInOneCall)
+		{
+			__MockMpu mpu;
+			__Reader reader( mpu );
+			reader.setPacketSize( __PACKET_SIZE );
+			volatile bool is_data_ready = true;
+			UInt8 packet[__PACKET_SIZE];
+
+			// Three packets and the start of a fourth one
+			mpu.fifo_count = 3 * __PACKET_SIZE + 10;
+			CHECK( reader.read( 10, is_data_ready, packet ) );
+			CHECK_EQUAL( 2 + 3, mpu.transaction_count );
+			CHECK_EQUAL( 10, mpu.fifo_count );
+
+			// The newest packet is kept
+			CHECK_EQUAL( 3, packet[0] );
+			CHECK_EQUAL( 3, packet[__PACKET_SIZE - 1] );
+		}
+
+		TEST(PartialPacketIsCheckedAgain)
+		{
+			__MockMpu mpu;
+			__Reader reader( mpu );
+			reader.setPacketSize( __PACKET_SIZE );
+			volatile bool is_data_ready = true;
+			UInt8 packet[__PACKET_SIZE];
+
+			// The DMP is still writing the packet
+			mpu.int_status = __Reader::INT_STATUS_DATA_READY;
+			mpu.fifo_count = 10;
+			CHECK( ! reader.read( 10, is_data_ready, packet ) );
+			CHECK( is_data_ready );
+			CHECK_EQUAL( 2, mpu.transaction_count );
+
+			mpu.fifo_count = __PACKET_SIZE;
+			CHECK( reader.read( 11, is_data_ready, packet ) );
+			CHECK_EQUAL( 2 + 3, mpu.transaction_count );
+
+			// A spurious edge without data ready is not retried
+			is_data_ready = true;
+			mpu.fifo_count = 10;
+			CHECK( ! reader.read( 12, is_data_ready, packet ) );
+			CHECK( ! is_data_ready );
+			CHECK_EQUAL( 5 + 2, mpu.transaction_count );
+		}
+
+		TEST(OverflowResetsFifo)
+		{
+			__MockMpu mpu;
+			__Reader reader( mpu );
+			reader.setPacketSize( __PACKET_SIZE );
+			volatile bool is_data_ready = true;
+			UInt8 packet[__PACKET_SIZE];
+
+			mpu.int_status = __Reader::INT_STATUS_FIFO_OFLOW;
+			mpu.fifo_count = 5 * __PACKET_SIZE;
+			CHECK( ! reader.read( 10, is_data_ready, packet ) );
+			CHECK_EQUAL( 1, mpu.reset_count );
+			CHECK_EQUAL( 0, mpu.packet_count );
+			CHECK_EQUAL( 3, mpu.transaction_count );
+
+			// A full FIFO is treated the same
+			is_data_ready = true;
+			mpu.fifo_count = __Reader::FIFO_SIZE;
+			CHECK( ! reader.read( 11, is_data_ready, packet ) );
+			CHECK_EQUAL( 2, mpu.reset_count );
+			CHECK_EQUAL( 0, mpu.packet_count );
+		}
+	}
+
+} }
@@ -0,0 +1,70 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../QueueProfile.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	SUITE(QueueProfileTester)
+	{
+		TEST(Residency)
+		{
+			QueueProfile p;
+
+			p.recordResidency( 0 );
+			p.recordResidency( 5 );
+			p.recordResidency( 7 );
+			p.recordResidency( 100000 );
+
+			CHECK_EQUAL( 1, (int) p.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 0 ) );
+			CHECK_EQUAL( 2, (int) p.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 2 ) );
+			CHECK_EQUAL(
+				1,
+				(int) p.getBucket(
+					QueueProfile::HISTOGRAM_RESIDENCY,
+					QueueProfile::RESIDENCY_BUCKET_COUNT - 1
+				)
+			);
+			CHECK_EQUAL(
+				(int) QueueProfile::MAX_RESIDENCY_MILLIS,
+				(int) p.getMaxResidencyMillis()
+			);
+		}
+
+		TEST(Depth)
+		{
+			QueueProfile p;
+
+			p.recordDepth( 0 );
+			p.recordDepth( 3 );
+			p.recordDepth( 32 );
+			p.recordDepth( 200 );
+
+			CHECK_EQUAL( 6, (int) QueueProfile::getBucketCount( QueueProfile::HISTOGRAM_DEPTH ) );
+			CHECK_EQUAL( 1, (int) p.getBucket( QueueProfile::HISTOGRAM_DEPTH, 0 ) );
+			CHECK_EQUAL( 1, (int) p.getBucket( QueueProfile::HISTOGRAM_DEPTH, 1 ) );
+			CHECK_EQUAL( 2, (int) p.getBucket( QueueProfile::HISTOGRAM_DEPTH, 5 ) );
+		}
+
+		TEST(Clear)
+		{
+			QueueProfile p;
+
+			p.recordResidency( 10 );
+			p.recordDepth( 1 );
+			p.recordDrop();
+			CHECK_EQUAL( 1, (int) p.getDropCount() );
+
+			p.clear();
+			CHECK_EQUAL( 0, (int) p.getDropCount() );
+			CHECK_EQUAL( 0, (int) p.getMaxResidencyMillis() );
+			CHECK_EQUAL( 0, (int) p.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 3 ) );
+			CHECK_EQUAL( 0, (int) p.getBucket( QueueProfile::HISTOGRAM_DEPTH, 0 ) );
+		}
+	}
+
+} }
@@ -0,0 +1,281 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../SensorLog.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	namespace
+	{
+
+		SensorLog::Sample
+		makeSample (int n)
+		{
+			SensorLog::Sample sample;
+			for ( int i = 0; i < 4; i++ ) {
+				sample.quaternion[i] = static_cast<SInt16>( n * 4 + i - 1000 );
+			}
+			sample.yaw = static_cast<SInt16>( -n );
+			sample.encoder_ticks[0] = static_cast<UInt16>( n * 3 );
+			sample.encoder_ticks[1] = static_cast<UInt16>( 0xFFFF - n );
+			return sample;
+		}
+
+	}
+
+	SUITE(SensorLogTester)
+	{
+		TEST(RecordSize)
+		{
+			CHECK_EQUAL( 8, (int) SensorLog::getRecordSize( SensorLog::CHANNEL_QUATERNION ) );
+			CHECK_EQUAL( 6, (int) SensorLog::getRecordSize(
+				SensorLog::CHANNEL_YAW | SensorLog::CHANNEL_ENCODERS ) );
+			CHECK_EQUAL(
+				(int) SensorLog::MAX_RECORD_SIZE,
+				(int) SensorLog::getRecordSize( SensorLog::CHANNEL_ALL )
+			);
+		}
+
+		TEST(FetchEmpty)
+		{
+			SensorLog log;
+			UInt8 blob[SensorLog::HEADER_SIZE];
+			CHECK_EQUAL( (int) SensorLog::HEADER_SIZE, (int) log.fetch( blob, sizeof( blob ) ) );
+
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, sizeof( blob ), header ) );
+			CHECK_EQUAL( 0, (int) header.record_count );
+		}
+
+		TEST(RoundTrip)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_ALL, 25, 0x12345678 );
+			CHECK( log.isRunning() );
+
+			for ( int n = 0; n < 3; n++ ) {
+				log.append( makeSample( n ) );
+			}
+			log.stop();
+			CHECK( ! log.isRunning() );
+			CHECK_EQUAL( 3, (int) log.getRecordCount() );
+
+			UInt8 blob[SensorLog::HEADER_SIZE + 3 * SensorLog::MAX_RECORD_SIZE];
+			CHECK_EQUAL( (int) sizeof( blob ), (int) log.fetch( blob, sizeof( blob ) ) );
+			CHECK_EQUAL( 0, (int) log.getRecordCount() );
+
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, sizeof( blob ), header ) );
+			CHECK_EQUAL( 0x12345678u, header.start_millis );
+			CHECK_EQUAL( 0u, header.first_index );
+			CHECK_EQUAL( 25, (int) header.period_millis );
+			CHECK_EQUAL( 0, (int) header.overflow_count );
+			CHECK_EQUAL( (int) SensorLog::CHANNEL_ALL, (int) header.channels );
+			CHECK_EQUAL( 3, (int) header.record_count );
+
+			for ( int n = 0; n < 3; n++ )
+			{
+				SensorLog::Sample sample;
+				SensorLog::unpackRecord(
+					blob + SensorLog::HEADER_SIZE + n * SensorLog::MAX_RECORD_SIZE,
+					header.channels,
+					sample
+				);
+
+				const SensorLog::Sample expected = makeSample( n );
+				CHECK_ARRAY_EQUAL( expected.quaternion, sample.quaternion, 4 );
+				CHECK_EQUAL( expected.yaw, sample.yaw );
+				CHECK_ARRAY_EQUAL( expected.encoder_ticks, sample.encoder_ticks, 2 );
+			}
+
+			// A truncated blob is rejected
+			CHECK( ! SensorLog::parseHeader( blob, sizeof( blob ) - 1, header ) );
+		}
+
+		TEST(FetchInChunks)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_ENCODERS, 10, 0 );
+			for ( int n = 0; n < 10; n++ ) {
+				log.append( makeSample( n ) );
+			}
+
+			// Room for three records and a bit
+			UInt8 blob[SensorLog::HEADER_SIZE + 3 * 4 + 2];
+			SensorLog::Header header;
+			int n = 0;
+			while ( log.getRecordCount() > 0 )
+			{
+				const UInt16 size = log.fetch( blob, sizeof( blob ) );
+				CHECK( SensorLog::parseHeader( blob, size, header ) );
+				CHECK_EQUAL( (UInt32) n, header.first_index );
+
+				for ( UInt8 i = 0; i < header.record_count; i++, n++ )
+				{
+					SensorLog::Sample sample;
+					SensorLog::unpackRecord(
+						blob + SensorLog::HEADER_SIZE + i * 4,
+						header.channels,
+						sample
+					);
+					CHECK_EQUAL( makeSample( n ).encoder_ticks[0], sample.encoder_ticks[0] );
+				}
+			}
+			CHECK_EQUAL( 10, n );
+		}
+
+		TEST(OverflowDropsOldest)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_ALL, 10, 0 );
+
+			const int slots = SensorLog::CAPACITY / SensorLog::MAX_RECORD_SIZE;
+			for ( int n = 0; n < slots + 7; n++ ) {
+				log.append( makeSample( n ) );
+			}
+			CHECK_EQUAL( slots, (int) log.getRecordCount() );
+			CHECK_EQUAL( 7, (int) log.getOverflowCount() );
+			CHECK_EQUAL( (UInt32) ( slots + 7 ), log.getNextIndex() );
+
+			UInt8 blob[SensorLog::HEADER_SIZE + SensorLog::CAPACITY];
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 7u, header.first_index );
+			CHECK_EQUAL( slots, (int) header.record_count );
+
+			// The records follow each other across the end of the buffer
+			for ( int i = 0; i < slots; i++ )
+			{
+				SensorLog::Sample sample;
+				SensorLog::unpackRecord(
+					blob + SensorLog::HEADER_SIZE + i * SensorLog::MAX_RECORD_SIZE,
+					header.channels,
+					sample
+				);
+				CHECK_EQUAL( makeSample( 7 + i ).yaw, sample.yaw );
+			}
+		}
+
+		TEST(LateSampleSkipsMissedSlots)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_YAW, 10, 1000 );
+			CHECK_EQUAL( 1000u, log.getDueMillis() );
+
+			// Less than a period late keeps the slot
+			CHECK_EQUAL( 0u, log.skipMissed( 1009 ) );
+			log.append( makeSample( 0 ) );
+			CHECK_EQUAL( 1010u, log.getDueMillis() );
+
+			// Due at 1010, taken at 1047: the slots of 1010, 1020 and
+			// 1030 are skipped, the sample is the one of 1040
+			CHECK_EQUAL( 3u, log.skipMissed( 1047 ) );
+			log.append( makeSample( 4 ) );
+			CHECK_EQUAL( 1050u, log.getDueMillis() );
+			CHECK_EQUAL( 5u, log.getNextIndex() );
+			CHECK_EQUAL( 3, (int) log.getMissedCount() );
+			CHECK_EQUAL( 0, (int) log.getOverflowCount() );
+			CHECK_EQUAL( 2, (int) log.getRecordCount() );
+
+			log.append( makeSample( 5 ) );
+
+			// Each blob stops at the gap and holds consecutive samples
+			UInt8 blob[SensorLog::HEADER_SIZE + 8 * 2];
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 0u, header.first_index );
+			CHECK_EQUAL( 1, (int) header.record_count );
+
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 4u, header.first_index );
+			CHECK_EQUAL( 2, (int) header.record_count );
+			for ( int i = 0; i < 2; i++ )
+			{
+				SensorLog::Sample sample;
+				SensorLog::unpackRecord(
+					blob + SensorLog::HEADER_SIZE + i * 2, header.channels, sample );
+				CHECK_EQUAL( makeSample( 4 + i ).yaw, sample.yaw );
+			}
+			CHECK_EQUAL( 0, (int) log.getRecordCount() );
+
+			// A gap before the first record only moves the numbering on
+			CHECK_EQUAL( 2u, log.skipMissed( log.getDueMillis() + 25 ) );
+			log.append( makeSample( 8 ) );
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 8u, header.first_index );
+			CHECK_EQUAL( 1, (int) header.record_count );
+			CHECK_EQUAL( 5, (int) log.getMissedCount() );
+		}
+
+		TEST(OnlyNewestGapIsKept)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_YAW, 10, 0 );
+
+			// Samples 0 and 1, gap, 3, gap merged with the next, 7
+			log.append( makeSample( 0 ) );
+			log.append( makeSample( 1 ) );
+			CHECK_EQUAL( 1u, log.skipMissed( 35 ) );
+			log.append( makeSample( 3 ) );
+			CHECK_EQUAL( 2u, log.skipMissed( 65 ) );
+			CHECK_EQUAL( 1u, log.skipMissed( 75 ) );
+			log.append( makeSample( 7 ) );
+
+			// The records before the first gap were given up
+			CHECK_EQUAL( 2, (int) log.getOverflowCount() );
+			CHECK_EQUAL( 4, (int) log.getMissedCount() );
+			CHECK_EQUAL( 2, (int) log.getRecordCount() );
+
+			UInt8 blob[SensorLog::HEADER_SIZE + 8 * 2];
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 3u, header.first_index );
+			CHECK_EQUAL( 1, (int) header.record_count );
+
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 7u, header.first_index );
+			CHECK_EQUAL( 1, (int) header.record_count );
+		}
+
+		TEST(OverflowClosesGap)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_YAW, 10, 0 );
+
+			log.append( makeSample( 0 ) );
+			CHECK_EQUAL( 2u, log.skipMissed( 30 ) );
+
+			// Overwriting the record before the gap leaves consecutive
+			// records, numbered from after the gap
+			const int slots = SensorLog::CAPACITY / 2;
+			for ( int n = 3; n < 3 + slots; n++ ) {
+				log.append( makeSample( n ) );
+			}
+			CHECK_EQUAL( 1, (int) log.getOverflowCount() );
+
+			UInt8 blob[SensorLog::HEADER_SIZE + SensorLog::CAPACITY];
+			SensorLog::Header header;
+			CHECK( SensorLog::parseHeader( blob, log.fetch( blob, sizeof( blob ) ), header ) );
+			CHECK_EQUAL( 3u, header.first_index );
+			CHECK_EQUAL( slots, (int) header.record_count );
+		}
+
+		TEST(StartDiscardsRecords)
+		{
+			SensorLog log;
+			log.start( SensorLog::CHANNEL_YAW, 10, 0 );
+			log.append( makeSample( 1 ) );
+			log.start( SensorLog::CHANNEL_QUATERNION, 20, 500 );
+
+			CHECK_EQUAL( 0, (int) log.getRecordCount() );
+			CHECK_EQUAL( 0u, log.getNextIndex() );
+			CHECK_EQUAL( 500u, log.getStartMillis() );
+			CHECK_EQUAL( (int) SensorLog::CHANNEL_QUATERNION, (int) log.getChannels() );
+		}
+	}
+
+} }
@@ -0,0 +1,1093 @@
+#include <unittest++/UnitTest++.h>
+
+#include <deque>
+#include <vector>
+
+#include "../MessageIO.hpp"
+#include "../Server.hpp"
+#include "../StreamIO.hpp"
+#include "../BlobAssembler.hpp"
+#include "../msg/BlobFragment.hpp"
+#include "../msg/BlobStatusNotice.hpp"
+#include "../msg/CapsResponse.hpp"
+#include "../msg/CodecRequest.hpp"
+#include "../msg/CreditNotice.hpp"
+#include "../msg/FlushResponse.hpp"
+#include "../msg/HelloRequest.hpp"
+#include "../msg/LoopHistogramResponse.hpp"
+#include "../msg/LoopStatsRequest.hpp"
+#include "../msg/LoopStatsResponse.hpp"
+#include "../msg/QueueHistogramResponse.hpp"
+#include "../msg/QueueStatsRequest.hpp"
+#include "../msg/QueueStatsResponse.hpp"
+#include "../msg/RepeatRequest.hpp"
+#include "../msg/SetServoAngleRequest.hpp"
+#include "../msg/SetWheelDriveRequest.hpp"
+#include "../msg/SimpleMessage.hxx"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+	using namespace robocom::shared::msg;
+
+	namespace
+	{
+
+		/**
+		 * Stream which keeps the data sent in both directions in memory
+		 */
+		class MemoryStream
+			: public StreamIO
+		{
+		public:
+
+			virtual int available ()
+			{
+				return static_cast<int>( m_in.size() );
+			}
+
+			virtual int peek ()
+			{
+				return m_in.empty() ? -1 : m_in.front();
+			}
+
+			virtual int read ()
+			{
+				if ( m_in.empty() ) {
+					return -1;
+				}
+
+				const int b = m_in.front();
+				m_in.pop_front();
+				return b;
+			}
+
+			virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+			{
+				UInt32 n = 0;
+				for ( ; n < size && ! m_in.empty(); n++ ) {
+					p_buffer[n] = static_cast<char>( read() );
+				}
+				return n;
+			}
+
+			virtual UInt32 write (UInt8 b)
+			{
+				m_out.push_back( b );
+				return 1;
+			}
+
+			virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+			{
+				m_out.insert( m_out.end(), p_buffer, p_buffer + size );
+				return size;
+			}
+
+			std::deque<UInt8> m_in;
+			std::vector<UInt8> m_out;
+		};
+
+
+		/**
+		 * The client end of a MemoryStream used by a server
+		 */
+		class ClientStream
+			: public StreamIO
+		{
+		public:
+
+			explicit ClientStream (MemoryStream& server)
+				: m_server( server )
+			{ }
+
+			virtual int available ()
+			{
+				return static_cast<int>( m_server.m_out.size() );
+			}
+
+			virtual int peek ()
+			{
+				return m_server.m_out.empty() ? -1 : m_server.m_out.front();
+			}
+
+			virtual int read ()
+			{
+				if ( m_server.m_out.empty() ) {
+					return -1;
+				}
+
+				const int b = m_server.m_out.front();
+				m_server.m_out.erase( m_server.m_out.begin() );
+				return b;
+			}
+
+			virtual UInt32 readBytes (char* p_buffer, UInt32 size)
+			{
+				UInt32 n = 0;
+				for ( ; n < size && ! m_server.m_out.empty(); n++ ) {
+					p_buffer[n] = static_cast<char>( read() );
+				}
+				return n;
+			}
+
+			virtual UInt32 write (UInt8 b)
+			{
+				m_server.m_in.push_back( b );
+				return 1;
+			}
+
+			virtual UInt32 write (const UInt8* p_buffer, UInt32 size)
+			{
+				m_server.m_in.insert( m_server.m_in.end(), p_buffer, p_buffer + size );
+				return size;
+			}
+
+		private:
+
+			MemoryStream& m_server;
+		};
+
+
+		/**
+		 * Server running on a virtual clock, which records the
+		 * handled messages
+		 */
+		class TestServer
+			: public Server
+		{
+		public:
+
+			struct Handled
+			{
+				UInt16 task_id;
+				UInt32 millis;
+			};
+
+			TestServer (MemoryStream& stream)
+				: Server( stream )
+				, m_idle_count( 0 )
+				, m_stream( stream )
+				, m_micros( 0 )
+			{ }
+
+			virtual UInt32 getMillis () const throw ()
+			{
+				return m_micros / 1000;
+			}
+
+			virtual UInt32 getMicros () const throw ()
+			{
+				return m_micros;
+			}
+
+			void advance (UInt32 micros)
+			{
+				m_micros += micros;
+			}
+
+			void send (const Message& msg)
+			{
+				MemoryStream client;
+				MessageIO( client ).write( msg );
+				m_stream.m_in.insert(
+					m_stream.m_in.end(),
+					client.m_out.begin(),
+					client.m_out.end()
+				);
+
+				// One loop step per received message
+				loop();
+			}
+
+			std::vector<Message> receive ()
+			{
+				MemoryStream client;
+				client.m_in.assign( m_stream.m_out.begin(), m_stream.m_out.end() );
+				m_stream.m_out.clear();
+
+				std::vector<Message> result;
+				MessageIO io( client );
+				Message msg;
+				while ( io.read( msg ) ) {
+					result.push_back( msg );
+				}
+				return result;
+			}
+
+			void runUntil (UInt32 millis)
+			{
+				while ( getMillis() < millis )
+				{
+					m_micros += 1000;
+					loop();
+					loop();
+				}
+			}
+
+			void runTasksUntil (UInt32 micros, UInt32 step_micros)
+			{
+				while ( m_micros < micros )
+				{
+					m_micros += step_micros;
+					loop();
+				}
+			}
+
+			using Server::addResponse;
+			using Server::addTask;
+			using Server::writeBlob;
+
+			int m_idle_count;
+
+			std::vector<Handled> m_handled;
+			std::vector<UInt8> m_blob;
+
+		protected:
+
+			virtual bool handleMessage (const Message& msg)
+			{
+				if ( SetWheelDriveRequest::MSGID != msg.getMessageType() ) {
+					return false;
+				}
+
+				const Handled h = { msg.getTaskId(), getMillis() };
+				m_handled.push_back( h );
+				return true;
+			}
+
+			virtual void handleBlob (
+				UInt16 task_id,
+				const UInt8* p_data,
+				UInt16 size
+			)
+			{
+				m_blob.assign( p_data, p_data + size );
+			}
+
+			virtual void handleIdle ()
+			{
+				m_idle_count++;
+			}
+
+		private:
+
+			MemoryStream& m_stream;
+			UInt32 m_micros;
+		};
+
+
+
+		/**
+		 * Task recording the times of its runs, which takes the given
+		 * time on the virtual clock of the server
+		 */
+		class TestTask
+			: public Server::Task
+		{
+		public:
+
+			TestTask (TestServer& server, UInt32 run_micros)
+				: m_is_ready( false )
+				, m_server( server )
+				, m_run_micros( run_micros )
+			{ }
+
+			virtual bool isReady () throw ()
+			{
+				return m_is_ready;
+			}
+
+			virtual void run () throw ()
+			{
+				m_is_ready = false;
+				m_runs.push_back( m_server.getMicros() );
+				m_server.advance( m_run_micros );
+			}
+
+			bool m_is_ready;
+			std::vector<UInt32> m_runs;
+
+		private:
+
+			TestServer& m_server;
+			UInt32 m_run_micros;
+		};
+
+	}
+
+	SUITE(ServerTester)
+	{
+		TEST(RepeatAtPeriod)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			server.send( RepeatRequest( 7, 10 ).asMessage() );
+			server.send( SetWheelDriveRequest( 7, 5u, 0, 1, 0, 0 ).asMessage() );
+
+			server.runUntil( 40 );
+
+			// Executed at 5, 15, 25 and 35 millis
+			CHECK_EQUAL( 4u, server.m_handled.size() );
+			for ( size_t i = 0; i < server.m_handled.size(); i++ )
+			{
+				CHECK_EQUAL( 7, server.m_handled[i].task_id );
+				CHECK_EQUAL( 5u + 10u * i, server.m_handled[i].millis );
+			}
+		}
+
+		TEST(CancelDropsPendingOccurrence)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			server.send( RepeatRequest( 7, 10 ).asMessage() );
+			server.send( RepeatRequest( 8, 20 ).asMessage() );
+			server.send( SetWheelDriveRequest( 7, 5u, 0, 1, 0, 0 ).asMessage() );
+			server.send( SetWheelDriveRequest( 8, 5u, 0, 1, 0, 0 ).asMessage() );
+
+			server.runUntil( 25 );
+			CHECK_EQUAL( 5u, server.m_handled.size() );
+
+			// Cancelling one task leaves the other one running
+			server.send( RepeatRequest( 7, 0 ).asMessage() );
+			server.m_handled.clear();
+			server.runUntil( 100 );
+
+			CHECK_EQUAL( 3u, server.m_handled.size() );
+			for ( size_t i = 0; i < server.m_handled.size(); i++ ) {
+				CHECK_EQUAL( 8, server.m_handled[i].task_id );
+			}
+		}
+
+		TEST(OtherTasksRunOnce)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			server.send( RepeatRequest( 7, 10 ).asMessage() );
+			server.send( SetWheelDriveRequest( 9, 3u, 0, 1, 0, 0 ).asMessage() );
+
+			server.runUntil( 50 );
+
+			CHECK_EQUAL( 1u, server.m_handled.size() );
+		}
+
+		TEST(ResetStopsRepetition)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			server.send( RepeatRequest( 7, 10 ).asMessage() );
+			server.send( SetWheelDriveRequest( 7, 5u, 0, 1, 0, 0 ).asMessage() );
+			server.runUntil( 15 );
+			CHECK_EQUAL( 2u, server.m_handled.size() );
+
+			server.send( ResetRequest( 1 ).asMessage() );
+			server.send( SetWheelDriveRequest( 7, 20u, 0, 1, 0, 0 ).asMessage() );
+			server.runUntil( 100 );
+
+			CHECK_EQUAL( 3u, server.m_handled.size() );
+		}
+
+		TEST(NoCreditsUnlessAsked)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			// Not even a client which said hello without the feature
+			server.send(
+				HelloRequest(
+					2,
+					CapsResponse::PROTOCOL_VERSION,
+					CapsResponse::FEATURE_COBS
+				).asMessage()
+			);
+			CHECK_EQUAL( 1u, server.receive().size() );
+
+			// The reset has no immediate response
+			server.send( ResetRequest( 3 ).asMessage() );
+			CHECK( server.receive().empty() );
+
+			// Neither do the freed slots bring any notice
+			for ( UInt16 i = 0; i < 20; i++ ) {
+				server.send( SetWheelDriveRequest( 7, 0u, 0, 1, 0, 0 ).asMessage() );
+			}
+			server.runUntil( 100 );
+			CHECK_EQUAL( 20u, server.m_handled.size() );
+			CHECK( server.receive().empty() );
+
+			// The flush still carries the limit
+			server.send( FlushRequest( 4 ).asMessage() );
+			const std::vector<Message> out = server.receive();
+			CHECK_EQUAL( 1u, out.size() );
+			const FlushResponse response( out.front() );
+			CHECK_EQUAL( STATUS_OK, response.validate() );
+			CHECK( response.hasCreditLimit() );
+		}
+
+		TEST(FlowControl)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			ClientStream c( s );
+			MessageIO io( c );
+			io.setFlowControl( true );
+
+			// The client asks for the credits
+			Message msg;
+			io.write(
+				HelloRequest(
+					2,
+					CapsResponse::PROTOCOL_VERSION,
+					CapsResponse::FEATURE_CREDIT
+				).asMessage()
+			);
+			server.loop();
+			CHECK( io.read( msg ) );
+			CHECK_EQUAL( (int) CapsResponse::MSGID, (int) msg.getMessageType() );
+
+			// No credits until the server answered the reset
+			io.write( ResetRequest( 3 ).asMessage() );
+			CHECK_EQUAL( 0, (int) io.getCredits() );
+			CHECK( ! io.tryWrite( SetWheelDriveRequest( 7, 0u, 0, 1, 0, 0 ).asMessage() ) );
+
+			server.loop();
+			while ( io.read( msg ) ) { }
+			CHECK_EQUAL(
+				(int) ( MessagePool::SLOT_COUNT - Server::CREDIT_RESERVE_SLOTS ),
+				(int) io.getCredits()
+			);
+
+			// Far more messages than the pool can hold, which all stay
+			// queued for a while
+			const int MESSAGE_COUNT = 100;
+			int sent_count = 0;
+			while ( server.getMillis() < 1000 )
+			{
+				while ( sent_count < MESSAGE_COUNT &&
+						io.tryWrite(
+							SetWheelDriveRequest(
+								7, 20u + sent_count / 4, 0, 1, 0, 0
+							).asMessage()
+						) )
+				{
+					sent_count++;
+				}
+
+				server.advance( 1000 );
+				while ( ! s.m_in.empty() ) {
+					server.loop();
+				}
+				server.loop();
+
+				while ( io.read( msg ) ) { }
+			}
+
+			CHECK_EQUAL( MESSAGE_COUNT, sent_count );
+			CHECK_EQUAL( (size_t) MESSAGE_COUNT, server.m_handled.size() );
+
+			io.write( FlushRequest( 4 ).asMessage() );
+			server.loop();
+
+			bool has_response = false;
+			while ( io.read( msg ) )
+			{
+				if ( msg.getMessageType() != FlushResponse::MSGID ) {
+					continue;
+				}
+
+				const FlushResponse response( msg );
+				CHECK_EQUAL( STATUS_OK, response.validate() );
+				CHECK(
+					response.getInputQueueMaxSize() <=
+					MessagePool::SLOT_COUNT - Server::CREDIT_RESERVE_SLOTS
+				);
+				CHECK( response.hasCreditLimit() );
+				has_response = true;
+			}
+			CHECK( has_response );
+		}
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		TEST(ReliableFlushWaitsForWindow)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			ClientStream c( s );
+			MessageIO io( c );
+
+			// The server answers the sync on its first loop
+			Message msg;
+			io.setReliable( true );
+			server.loop();
+			CHECK( ! io.read( msg ) );
+
+			for ( UInt16 task_id = 1; task_id <= 10; task_id++ ) {
+				server.addResponse( NoopRequest( task_id ).asMessage() );
+			}
+			io.write( FlushRequest( 50 ).asMessage() );
+
+			// Each loop writes only as much as the acknowledgements allow
+			std::vector<UInt16> received;
+			for ( int i = 0; i < 10; i++ )
+			{
+				server.advance( 1000 );
+				server.loop();
+
+				while ( io.read( msg ) ) {
+					received.push_back( msg.getTaskId() );
+				}
+				io.poll( server.getMillis() );
+			}
+
+			CHECK_EQUAL( 11u, received.size() );
+			for ( size_t i = 0; i < 10 && i < received.size(); i++ ) {
+				CHECK_EQUAL( i + 1, received[i] );
+			}
+			CHECK_EQUAL( 50, received.back() );
+			CHECK_EQUAL( 0, (int) io.getRetransmitCount() );
+		}
+#endif
+
+#if defined(ROBOCOM_RELIABLE_IO)
+		TEST(CodecIsKeptWhileWindowIsFull)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			ClientStream c( s );
+			MessageIO io( c );
+			Message msg;
+
+			io.setReliable( true );
+			server.loop();
+			CHECK( ! io.read( msg ) );
+
+			// More responses than the window holds
+			for ( UInt16 task_id = 1; task_id <= 10; task_id++ ) {
+				server.addResponse( NoopRequest( task_id ).asMessage() );
+			}
+			io.write( FlushRequest( 50 ).asMessage() );
+			server.advance( 1000 );
+			server.loop();
+
+			// The response cannot go out right away, so the switch
+			// is refused
+			io.write( CodecRequest( 5, MessageIO::CODEC_COBS ).asMessage() );
+			server.advance( 1000 );
+			server.loop();
+
+			bool has_response = false;
+			for ( int i = 0; i < 10 && ! has_response; i++ )
+			{
+				while ( io.read( msg ) )
+				{
+					if ( msg.getMessageType() != CodecResponse::MSGID ) {
+						continue;
+					}
+
+					const CodecResponse response( msg );
+					CHECK_EQUAL( 5, response.getTaskId() );
+					CHECK_EQUAL( (int) MessageIO::CODEC_PLAIN, (int) response.getCodec() );
+					has_response = true;
+				}
+				io.poll( server.getMillis() );
+
+				server.advance( 1000 );
+				server.loop();
+			}
+			CHECK( has_response );
+
+			// The link still works in the old encoding
+			io.write( EchoRequest( 6 ).asMessage() );
+			bool has_echo = false;
+			for ( int i = 0; i < 10 && ! has_echo; i++ )
+			{
+				server.advance( 1000 );
+				server.loop();
+				while ( io.read( msg ) ) {
+					has_echo = has_echo || msg.getTaskId() == 6;
+				}
+				io.poll( server.getMillis() );
+			}
+			CHECK( has_echo );
+		}
+#endif
+
+		TEST(CodecNegotiation)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			ClientStream c( s );
+			MessageIO io( c );
+			Message msg;
+
+			// An unknown codec is refused
+			io.write( CodecRequest( 4, MessageIO::CODEC_COUNT ).asMessage() );
+			server.loop();
+			CHECK( io.read( msg ) );
+			CHECK_EQUAL( (int) MessageIO::CODEC_PLAIN, (int) CodecResponse( msg ).getCodec() );
+
+			// The response comes in the old encoding
+			io.write( CodecRequest( 5, MessageIO::CODEC_COBS ).asMessage() );
+			server.loop();
+			CHECK( io.read( msg ) );
+			const CodecResponse response( msg );
+			CHECK_EQUAL( STATUS_OK, response.validate() );
+			CHECK_EQUAL( 5, response.getTaskId() );
+			CHECK_EQUAL( (int) MessageIO::CODEC_COBS, (int) response.getCodec() );
+
+			io.setCodec( response.getCodec() );
+			io.write( EchoRequest( 6 ).asMessage() );
+			server.loop();
+			CHECK( io.read( msg ) );
+			CHECK_EQUAL( (int) EchoResponse::MSGID, (int) msg.getMessageType() );
+			CHECK_EQUAL( 6, msg.getTaskId() );
+		}
+
+		TEST(HelloAdvertisesCapabilities)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			ClientStream c( s );
+			MessageIO io( c );
+			Message msg;
+
+			io.write(
+				HelloRequest(
+					7,
+					CapsResponse::PROTOCOL_VERSION,
+					MessageIO::getFeatures()
+				).asMessage()
+			);
+			server.loop();
+			CHECK( io.read( msg ) );
+
+			const CapsResponse caps( msg );
+			CHECK_EQUAL( STATUS_OK, caps.validate() );
+			CHECK_EQUAL( 7, caps.getTaskId() );
+			CHECK_EQUAL( (int) CapsResponse::PROTOCOL_VERSION, (int) caps.getVersion() );
+			CHECK_EQUAL( (int) MessageIO::getFeatures(), caps.getFeatures() & MessageIO::getFeatures() );
+			CHECK_EQUAL( (int) Message::MAX_DATA_SIZE, (int) caps.getMaxDataSize() );
+			CHECK_EQUAL( (int) MessagePool::SLOT_COUNT, (int) caps.getPoolSize() );
+			CHECK_EQUAL( (int) Server::MAX_REPEATED_TASKS, (int) caps.getMaxRepeatedTasks() );
+
+			// The request does not take a credit or reach the application
+			server.runUntil( 10 );
+			CHECK_EQUAL( 0u, server.m_handled.size() );
+		}
+
+		TEST(BlobUpload)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			UInt8 blob[Server::MAX_BLOB_SIZE];
+			for ( UInt16 i = 0; i < sizeof( blob ); i++ ) {
+				blob[i] = static_cast<UInt8>( i * 3 );
+			}
+
+			for ( UInt16 offset = 0; offset < sizeof( blob ); offset += BlobFragment::MAX_FRAGMENT_SIZE ) {
+				server.send( BlobFragment::makeFragment( 5, blob, sizeof( blob ), offset ).asMessage() );
+			}
+
+			const std::vector<Message> out = server.receive();
+			CHECK_EQUAL( 1u, out.size() );
+			const BlobStatusNotice notice( out.front() );
+			CHECK_EQUAL( STATUS_OK, notice.validate() );
+			CHECK_EQUAL( 5, notice.getTaskId() );
+			CHECK_EQUAL( (int) STATUS_OK, (int) notice.getStatus() );
+			CHECK_EQUAL( (int) sizeof( blob ), (int) notice.getSize() );
+
+			CHECK_EQUAL( sizeof( blob ), server.m_blob.size() );
+			CHECK_ARRAY_EQUAL( blob, server.m_blob, sizeof( blob ) );
+			CHECK_EQUAL( 0u, server.m_handled.size() );
+		}
+
+		TEST(BlobWithLostFragmentIsReportedOnce)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			UInt8 blob[50] = { 0 };
+			for ( UInt16 offset = 0; offset < sizeof( blob ); offset += BlobFragment::MAX_FRAGMENT_SIZE )
+			{
+				if ( offset != BlobFragment::MAX_FRAGMENT_SIZE ) {
+					server.send( BlobFragment::makeFragment( 6, blob, sizeof( blob ), offset ).asMessage() );
+				}
+			}
+
+			std::vector<Message> out = server.receive();
+			CHECK_EQUAL( 1u, out.size() );
+			CHECK_EQUAL( (int) STATUS_E_BLOB_OFFSET, (int) BlobStatusNotice( out.front() ).getStatus() );
+			CHECK_EQUAL( 0u, server.m_blob.size() );
+
+			// Sending the blob again starts over
+			for ( UInt16 offset = 0; offset < sizeof( blob ); offset += BlobFragment::MAX_FRAGMENT_SIZE ) {
+				server.send( BlobFragment::makeFragment( 6, blob, sizeof( blob ), offset ).asMessage() );
+			}
+
+			out = server.receive();
+			CHECK_EQUAL( 1u, out.size() );
+			CHECK_EQUAL( (int) STATUS_OK, (int) BlobStatusNotice( out.front() ).getStatus() );
+			CHECK_EQUAL( sizeof( blob ), server.m_blob.size() );
+		}
+
+		TEST(BlobTooLarge)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			UInt8 blob[Server::MAX_BLOB_SIZE + 1] = { 0 };
+			for ( UInt16 offset = 0; offset < sizeof( blob ); offset += BlobFragment::MAX_FRAGMENT_SIZE ) {
+				server.send( BlobFragment::makeFragment( 7, blob, sizeof( blob ), offset ).asMessage() );
+			}
+
+			const std::vector<Message> out = server.receive();
+			CHECK_EQUAL( 1u, out.size() );
+			CHECK_EQUAL( (int) STATUS_E_BLOB_SIZE, (int) BlobStatusNotice( out.front() ).getStatus() );
+			CHECK_EQUAL( 0u, server.m_blob.size() );
+		}
+
+		TEST(BlobDownload)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			UInt8 blob[40];
+			for ( UInt16 i = 0; i < sizeof( blob ); i++ ) {
+				blob[i] = static_cast<UInt8>( 200 - i );
+			}
+			server.writeBlob( 8, blob, sizeof( blob ) );
+
+			UInt8 buffer[100];
+			BlobAssembler assembler( buffer, sizeof( buffer ) );
+			const std::vector<Message> out = server.receive();
+			CHECK_EQUAL( 3u, out.size() );
+			for ( size_t i = 0; i < out.size(); i++ ) {
+				CHECK_EQUAL( i + 1 == out.size(), assembler.add( BlobFragment( out[i] ) ) );
+			}
+
+			CHECK( assembler.isComplete() );
+			CHECK_EQUAL( 8, assembler.getTaskId() );
+			CHECK_EQUAL( (int) sizeof( blob ), (int) assembler.getSize() );
+			CHECK_ARRAY_EQUAL( blob, assembler.getData(), sizeof( blob ) );
+		}
+
+		TEST(TableFull)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			for ( int i = 0; i <= Server::MAX_REPEATED_TASKS; i++ ) {
+				server.send( RepeatRequest( 10 + i, 10 ).asMessage() );
+			}
+
+			// The last task did not fit and runs only once
+			const UInt16 last = 10 + Server::MAX_REPEATED_TASKS;
+			server.send( SetWheelDriveRequest( last, 20u, 0, 1, 0, 0 ).asMessage() );
+			server.runUntil( 50 );
+			CHECK_EQUAL( 1u, server.m_handled.size() );
+
+			// Cancelling a task frees its slot
+			server.send( RepeatRequest( 10, 0 ).asMessage() );
+			server.send( RepeatRequest( last, 10 ).asMessage() );
+			server.send( SetWheelDriveRequest( last, 60u, 0, 1, 0, 0 ).asMessage() );
+			server.runUntil( 100 );
+			CHECK_EQUAL( 6u, server.m_handled.size() );
+		}
+
+		TEST(UnhandledMessagesAreCounted)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			// The framework messages never reach handleMessage()
+			server.send( NoopRequest( 1 ).asMessage() );
+			server.send( SetWheelDriveRequest( 2, 0, 1, 0, 0 ).asMessage() );
+			server.send( SetServoAngleRequest( 3, 0, 90 ).asMessage() );
+			server.send( SetServoAngleRequest( 4, 0, 45 ).asMessage() );
+			server.runUntil( 5 );
+
+			CHECK_EQUAL( 1u, server.m_handled.size() );
+			CHECK_EQUAL( 2, (int) server.getUnhandledCount() );
+		}
+
+		TEST(PeriodicTasks)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask fast( server, 0 );
+			TestTask slow( server, 0 );
+
+			CHECK_EQUAL( 0, (int) server.addTask( fast, 1000, 100 ) );
+			CHECK_EQUAL( 1, (int) server.addTask( slow, 5000, 100 ) );
+			CHECK_EQUAL( 2, (int) server.getTaskCount() );
+
+			server.runTasksUntil( 10000, 100 );
+
+			CHECK_EQUAL( 10u, fast.m_runs.size() );
+			CHECK_EQUAL( 2u, slow.m_runs.size() );
+			for ( size_t i = 0; i < fast.m_runs.size(); i++ ) {
+				CHECK_EQUAL( 1000u * (i + 1), fast.m_runs[i] );
+			}
+
+			// The loop idles when there is nothing to do
+			CHECK_EQUAL( 100 - 10, server.m_idle_count );
+#if defined(ROBOCOM_LOOP_PROFILE)
+			CHECK_EQUAL( 10u, server.getTaskStats( 0 ).run_count );
+			CHECK_EQUAL( 0u, server.getTaskStats( 0 ).late_count );
+#endif
+		}
+
+		TEST(EventTasks)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask task( server, 0 );
+
+			// Runs only on events
+			server.addTask( task, 0, 100 );
+
+			server.runTasksUntil( 5000, 100 );
+			CHECK_EQUAL( 0u, task.m_runs.size() );
+
+			task.m_is_ready = true;
+			server.runTasksUntil( 5100, 100 );
+			CHECK_EQUAL( 1u, task.m_runs.size() );
+			CHECK_EQUAL( 5100u, task.m_runs[0] );
+
+			server.runTasksUntil( 10000, 100 );
+			CHECK_EQUAL( 1u, task.m_runs.size() );
+		}
+
+		TEST(EventRestartsPeriod)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask task( server, 0 );
+
+			server.addTask( task, 1000, 100 );
+
+			server.runTasksUntil( 500, 100 );
+			task.m_is_ready = true;
+			server.runTasksUntil( 3000, 100 );
+
+			CHECK_EQUAL( 3u, task.m_runs.size() );
+			CHECK_EQUAL( 600u, task.m_runs[0] );
+			CHECK_EQUAL( 1600u, task.m_runs[1] );
+			CHECK_EQUAL( 2600u, task.m_runs[2] );
+		}
+
+		TEST(RunTimeAccounting)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask slow( server, 700 );
+			TestTask fast( server, 50 );
+
+			// Both are due at the same time, the one with the earlier
+			// deadline runs first and the other one is late
+			server.addTask( slow, 1000, 500 );
+			server.addTask( fast, 1000, 100 );
+
+			server.runTasksUntil( 1000, 1000 );
+
+			CHECK_EQUAL( 1u, fast.m_runs.size() );
+			CHECK_EQUAL( 1000u, fast.m_runs[0] );
+			CHECK_EQUAL( 1u, slow.m_runs.size() );
+			CHECK_EQUAL( 1050u, slow.m_runs[0] );
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+			const Server::TaskStats& stats = server.getTaskStats( 0 );
+			CHECK_EQUAL( 1u, stats.run_count );
+			CHECK_EQUAL( 700u, stats.total_micros );
+			CHECK_EQUAL( 700u, stats.max_micros );
+			CHECK_EQUAL( 0u, stats.late_count );
+
+			server.runTasksUntil( 10000, 1000 );
+			CHECK_EQUAL(
+				700u * server.getTaskStats( 0 ).run_count,
+				server.getTaskStats( 0 ).total_micros
+			);
+			CHECK_EQUAL(
+				50u * server.getTaskStats( 1 ).run_count,
+				server.getTaskStats( 1 ).total_micros
+			);
+
+			server.clearTaskStats();
+			CHECK_EQUAL( 0u, server.getTaskStats( 0 ).run_count );
+			CHECK_EQUAL( 0u, server.getTaskStats( 1 ).max_micros );
+#endif
+		}
+
+		TEST(LateRuns)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask task( server, 0 );
+
+			server.addTask( task, 1000, 100 );
+
+			// The loop only gets to the task 300 micros after it is due
+			server.runTasksUntil( 3900, 1300 );
+
+			CHECK_EQUAL( 3u, task.m_runs.size() );
+#if defined(ROBOCOM_LOOP_PROFILE)
+			CHECK_EQUAL( 3u, server.getTaskStats( 0 ).late_count );
+#endif
+		}
+
+		TEST(TooManyTasks)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask task( server, 0 );
+
+			for ( int i = 0; i < Server::MAX_TASKS; i++ ) {
+				CHECK_EQUAL( i, (int) server.addTask( task, 1000, 100 ) );
+			}
+
+			CHECK_EQUAL(
+				(int) Server::NO_TASK,
+				(int) server.addTask( task, 1000, 100 )
+			);
+		}
+
+#if defined(ROBOCOM_LOOP_PROFILE)
+		TEST(LoopStats)
+		{
+			MemoryStream s;
+			TestServer server( s );
+			TestTask task( server, 300 );
+			server.addTask( task, 1000, 100 );
+
+			server.runTasksUntil( 3000, 1000 );
+
+			const LoopProfile& profile = server.getLoopProfile();
+			const LoopProfile::PhaseStats& update =
+				profile.getPhase( LoopProfile::PHASE_STATE_UPDATE );
+			CHECK_EQUAL( 3u, update.count );
+			CHECK_EQUAL( 900u, update.sum_micros );
+			CHECK_EQUAL( 300u, update.max_micros );
+			CHECK_EQUAL( 3, (int) update.buckets[8] );
+			CHECK_EQUAL( 3u, profile.getPhase( LoopProfile::PHASE_READ ).count );
+
+			server.send(
+				LoopStatsRequest(
+					5,
+					LoopProfile::PHASE_STATE_UPDATE,
+					LoopStatsRequest::FLAG_RESET
+				).asMessage()
+			);
+
+			const std::vector<Message> responses = server.receive();
+			CHECK_EQUAL( 4u, responses.size() );
+
+			const LoopStatsResponse summary( responses[0] );
+			CHECK_EQUAL( STATUS_OK, summary.validate() );
+			CHECK_EQUAL( 5, summary.getTaskId() );
+			CHECK_EQUAL( 3u, summary.getCount() );
+			CHECK_EQUAL( 900u, summary.getSumMicros() );
+			CHECK_EQUAL( 300u, summary.getMaxMicros() );
+
+			int first_bucket = 0;
+			for ( size_t i = 1; i < responses.size(); i++ )
+			{
+				const LoopHistogramResponse histogram( responses[i] );
+				CHECK_EQUAL( STATUS_OK, histogram.validate() );
+				CHECK_EQUAL( first_bucket, (int) histogram.getFirstBucket() );
+
+				for ( UInt8 j = 0; j < histogram.getBucketCount(); j++ )
+				{
+					const int bucket = histogram.getFirstBucket() + j;
+					CHECK_EQUAL( bucket == 8 ? 3 : 0, (int) histogram.getBucket( j ) );
+				}
+
+				first_bucket += histogram.getBucketCount();
+			}
+			CHECK_EQUAL( (int) LoopProfile::BUCKET_COUNT, first_bucket );
+
+			// The request reset the profile; only the rest of the loop
+			// that handled it has been measured since
+			CHECK_EQUAL( 0u, profile.getPhase( LoopProfile::PHASE_READ ).count );
+			CHECK_EQUAL( 1u, profile.getPhase( LoopProfile::PHASE_STATE_UPDATE ).count );
+		}
+#endif
+
+#if defined(ROBOCOM_QUEUE_PROFILE)
+		TEST(QueueStats)
+		{
+			MemoryStream s;
+			TestServer server( s );
+
+			// Due at 5 millis, handled within the same millisecond
+			server.send( SetWheelDriveRequest( 7, 5u, 0, 1, 0, 0 ).asMessage() );
+			server.runUntil( 10 );
+			CHECK_EQUAL( 1u, server.m_handled.size() );
+
+			const QueueProfile& profile = server.getInputQueueProfile();
+			CHECK_EQUAL( 1, (int) profile.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 0 ) );
+
+			server.send(
+				QueueStatsRequest(
+					5,
+					QueueStatsRequest::QUEUE_INPUT,
+					QueueStatsRequest::FLAG_RESET
+				).asMessage()
+			);
+
+			const std::vector<Message> responses = server.receive();
+			CHECK_EQUAL( 4u, responses.size() );
+
+			const QueueStatsResponse summary( responses[0] );
+			CHECK_EQUAL( STATUS_OK, summary.validate() );
+			CHECK_EQUAL( (int) QueueStatsRequest::QUEUE_INPUT, (int) summary.getQueue() );
+			CHECK_EQUAL( 0, (int) summary.getSize() );
+			CHECK_EQUAL( 1, (int) summary.getMaxSize() );
+			CHECK_EQUAL( 0, (int) summary.getDropCount() );
+			CHECK_EQUAL( 0, (int) summary.getMaxResidencyMillis() );
+
+			// Both histograms are reported bucket by bucket
+			UInt32 depth_samples = 0;
+			int bucket_counts[QueueProfile::HISTOGRAM_COUNT] = { 0, 0 };
+			for ( size_t i = 1; i < responses.size(); i++ )
+			{
+				const QueueHistogramResponse histogram( responses[i] );
+				CHECK_EQUAL( STATUS_OK, histogram.validate() );
+				CHECK_EQUAL(
+					bucket_counts[histogram.getHistogram()],
+					(int) histogram.getFirstBucket()
+				);
+				bucket_counts[histogram.getHistogram()] += histogram.getBucketCount();
+
+				if ( QueueProfile::HISTOGRAM_DEPTH == histogram.getHistogram() )
+				{
+					for ( UInt8 j = 0; j < histogram.getBucketCount(); j++ ) {
+						depth_samples += histogram.getBucket( j );
+					}
+				}
+			}
+
+			CHECK_EQUAL(
+				(int) QueueProfile::RESIDENCY_BUCKET_COUNT,
+				bucket_counts[QueueProfile::HISTOGRAM_RESIDENCY]
+			);
+			CHECK_EQUAL(
+				(int) QueueProfile::DEPTH_BUCKET_COUNT,
+				bucket_counts[QueueProfile::HISTOGRAM_DEPTH]
+			);
+
+			// The depth was sampled on each loop
+			CHECK_EQUAL( 1u + 2u * 10u + 1u, depth_samples );
+
+			// The request reset the statistics
+			CHECK_EQUAL( 0, (int) profile.getBucket( QueueProfile::HISTOGRAM_RESIDENCY, 0 ) );
+		}
+#endif
+	}
+
+} }
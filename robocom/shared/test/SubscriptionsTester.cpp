@@ -0,0 +1,143 @@
+#include <unittest++/UnitTest++.h>
+
+#include "../Subscriptions.hpp"
+
+
+namespace robocom {
+namespace shared
+{
+
+	using namespace robocom::shared;
+
+	SUITE(SubscriptionsTester)
+	{
+		TEST(EveryReadingByDefault)
+		{
+			Subscriptions subscriptions;
+			CHECK( subscriptions.isEmpty() );
+
+			CHECK( subscriptions.subscribe( 7, 1, 0, 0, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.getCount() );
+			CHECK_EQUAL( 7, subscriptions.get( 0 ).task_id );
+			CHECK( subscriptions.hasFormat( 1 ) );
+			CHECK( ! subscriptions.hasFormat( 0 ) );
+
+			for ( UInt32 millis = 0; millis < 5; millis++ ) {
+				CHECK_EQUAL( 1, (int) subscriptions.offer( 100, millis, 0 ) );
+			}
+		}
+
+		TEST(Decimation)
+		{
+			Subscriptions subscriptions;
+			subscriptions.subscribe( 1, 0, 0, 3, 0 );
+			subscriptions.subscribe( 2, 0, 0, 1, 0 );
+
+			// Only every third reading reaches the first subscriber
+			int first_count = 0;
+			int second_count = 0;
+			for ( UInt32 millis = 0; millis < 9; millis++ )
+			{
+				const UInt8 mask = subscriptions.offer( millis, millis, 0 );
+				first_count += mask & 1;
+				second_count += ( mask >> 1 ) & 1;
+				CHECK_EQUAL( 2 == millis % 3, 0 != ( mask & 1 ) );
+			}
+			CHECK_EQUAL( 3, first_count );
+			CHECK_EQUAL( 9, second_count );
+		}
+
+		TEST(MinInterval)
+		{
+			Subscriptions subscriptions;
+			subscriptions.subscribe( 1, 0, 10, 1, 0 );
+
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 0, 1000, 0 ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 1, 1005, 0 ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 2, 1009, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 3, 1010, 0 ) );
+
+			// The interval is measured across the wrap of the millis
+			subscriptions.subscribe( 1, 0, 10, 1, 0 );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 0, 0xFFFFFFFAu, 0 ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 0, 2, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 0, 4, 0 ) );
+		}
+
+		TEST(Threshold)
+		{
+			Subscriptions subscriptions;
+			subscriptions.subscribe( 1, 0, 0, 1, 5 );
+
+			// The first reading is always reported
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 100, 0, 0 ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 105, 1, 0 ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 95, 2, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 94, 3, 0 ) );
+
+			// Measured from the last report, not the last reading
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 98, 4, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 100, 5, 0 ) );
+		}
+
+		TEST(ThresholdWithModulus)
+		{
+			const SInt32 MODULUS = 3600;
+			Subscriptions subscriptions;
+			subscriptions.subscribe( 1, 0, 0, 1, 10 );
+
+			// Across the wrap the change is the short way around
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 3595, 0, MODULUS ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 5, 1, MODULUS ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 6, 2, MODULUS ) );
+			CHECK_EQUAL( 0, (int) subscriptions.offer( 3596, 3, MODULUS ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 3595, 4, MODULUS ) );
+
+			// Without the modulus the same values are far apart
+			subscriptions.subscribe( 1, 0, 0, 1, 10 );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 3595, 0, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 5, 1, 0 ) );
+		}
+
+		TEST(Overflow)
+		{
+			Subscriptions subscriptions;
+			for ( UInt16 i = 0; i < Subscriptions::MAX_SUBSCRIBERS; i++ ) {
+				CHECK( subscriptions.subscribe( 10 + i, 0, 0, 1, 0 ) );
+			}
+			CHECK( ! subscriptions.subscribe( 99, 0, 0, 1, 0 ) );
+			CHECK_EQUAL( (int) Subscriptions::MAX_SUBSCRIBERS, (int) subscriptions.getCount() );
+
+			// Changing an existing subscription still works
+			CHECK( subscriptions.subscribe( 10, 1, 0, 1, 0 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.get( 0 ).format );
+
+			const UInt8 all = ( 1 << Subscriptions::MAX_SUBSCRIBERS ) - 1;
+			CHECK_EQUAL( (int) all, (int) subscriptions.offer( 0, 0, 0 ) );
+		}
+
+		TEST(Unsubscribe)
+		{
+			Subscriptions subscriptions;
+			subscriptions.subscribe( 1, 0, 0, 3, 0 );
+			subscriptions.subscribe( 2, 1, 0, 1, 0 );
+
+			// A stale task ID leaves the others alone
+			CHECK( ! subscriptions.unsubscribe( 4 ) );
+			CHECK_EQUAL( 2, (int) subscriptions.getCount() );
+
+			CHECK( subscriptions.unsubscribe( 1 ) );
+			CHECK_EQUAL( 1, (int) subscriptions.getCount() );
+			CHECK_EQUAL( 2, subscriptions.get( 0 ).task_id );
+			CHECK( ! subscriptions.hasFormat( 0 ) );
+			CHECK( ! subscriptions.unsubscribe( 1 ) );
+
+			// The bits of the mask follow the new positions
+			CHECK_EQUAL( 1, (int) subscriptions.offer( 0, 0, 0 ) );
+
+			subscriptions.clear();
+			CHECK( subscriptions.isEmpty() );
+		}
+	}
+
+} }